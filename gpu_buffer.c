@@ -27,6 +27,7 @@
 
 #include "gpu_buffer.h"
 #include "gpu_assert.h"
+#include "gpu_color_convert.h"
 #include "gpu_log.h"
 #include "gpu_utils.h"
 #include <stdlib.h>
@@ -36,6 +37,9 @@
  *      DEFINES
  *********************/
 
+/* The smallest page size in use, a larger page is touched more than once */
+#define GPU_BUFFER_PAGE_SIZE 4096
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -44,10 +48,14 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static void gpu_buffer_prefault(void* data, size_t size);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+static bool g_prefault = false;
+
 /**********************
  *      MACROS
  **********************/
@@ -70,8 +78,13 @@ struct gpu_buffer_s* gpu_buffer_alloc(uint32_t width, uint32_t height, enum gpu_
     buffer->height = height;
     buffer->stride = stride;
 
-    buffer->data_unaligned = calloc(1, stride * height + align);
+    size_t size = (size_t)stride * height + align;
+    buffer->data_unaligned = calloc(1, size);
     GPU_ASSERT_NULL(buffer->data_unaligned);
+
+    if (g_prefault) {
+        gpu_buffer_prefault(buffer->data_unaligned, size);
+    }
     buffer->data = (void*)GPU_ALIGN_UP(buffer->data_unaligned, align);
 
     GPU_LOG_DEBUG("Allocated buffer %p, format %d, size W%dxH%d, stride %d, data %p",
@@ -105,54 +118,27 @@ uint32_t gpu_buffer_get_pixel(struct gpu_buffer_s* buffer, uint32_t x, uint32_t
 
     const void* pixel = (const uint8_t*)buffer->data + y * buffer->stride + x * gpu_color_format_get_bpp(buffer->format) / 8;
 
-    switch (buffer->format) {
-    case GPU_COLOR_FORMAT_BGR565: {
-        const gpu_color_bgr565_t* c16 = pixel;
-        gpu_color_bgra8888_t c32;
-        c32.ch.blue = c16->ch.blue * 0xFF / 0x1F;
-        c32.ch.green = c16->ch.green * 0xFF / 0x3F;
-        c32.ch.red = c16->ch.red * 0xFF / 0x1F;
-        c32.ch.alpha = 0xFF;
-        return c32.full;
-    }
-
-    case GPU_COLOR_FORMAT_BGR888: {
-        const gpu_color_bgr888_t* c24 = pixel;
-        gpu_color_bgra8888_t c32;
-        c32.ch.blue = c24->ch.blue;
-        c32.ch.green = c24->ch.green;
-        c32.ch.red = c24->ch.red;
-        c32.ch.alpha = 0xFF;
-        return c32.full;
-    }
-
-    case GPU_COLOR_FORMAT_BGRA8888:
-        return *(const uint32_t*)pixel;
-
-    case GPU_COLOR_FORMAT_BGRX8888: {
-        gpu_color_bgra8888_t c32 = *(gpu_color_bgra8888_t*)pixel;
-        c32.ch.alpha = 0xFF;
-        return c32.full;
-    }
-
-    case GPU_COLOR_FORMAT_BGRA5658: {
-        const gpu_color_bgra5658_t* c16a = pixel;
-        gpu_color_bgra8888_t c32;
-        c32.ch.blue = c16a->ch.blue * 0xFF / 0x1F;
-        c32.ch.green = c16a->ch.green * 0xFF / 0x3F;
-        c32.ch.red = c16a->ch.red * 0xFF / 0x1F;
-        c32.ch.alpha = c16a->ch.alpha;
-        return c32.full;
-    }
-
-    default:
-        GPU_LOG_ERROR("Unsupported color format: %d", buffer->format);
-        break;
-    }
+    uint32_t color = 0;
+    gpu_color_convert_row(GPU_COLOR_FORMAT_BGRA8888, &color, buffer->format, pixel, 1, NULL);
+    return color;
+}
 
-    return 0;
+void gpu_buffer_set_prefault(bool en)
+{
+    g_prefault = en;
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static void gpu_buffer_prefault(void* data, size_t size)
+{
+    /* A large calloc maps the zero page and skips the clear, write to fault in every page */
+    volatile uint8_t* bytes = data;
+    for (size_t offset = 0; offset < size; offset += GPU_BUFFER_PAGE_SIZE) {
+        bytes[offset] = 0;
+    }
+
+    bytes[size - 1] = 0;
+}
@@ -33,6 +33,7 @@ extern "C" {
  *********************/
 
 #include "gpu_color.h"
+#include <stdbool.h>
 
 /*********************
  *      DEFINES
@@ -73,6 +74,13 @@ struct gpu_buffer_s* gpu_buffer_alloc(uint32_t width, uint32_t height, enum gpu_
  */
 void gpu_buffer_free(struct gpu_buffer_s* buffer);
 
+/**
+ * Touch every page of the buffers allocated from now on, so that the first
+ * write of a test is not charged with the page faults of the allocation.
+ * @param en True to prefault the new buffers.
+ */
+void gpu_buffer_set_prefault(bool en);
+
 /**
  * Get the pixel at the given position in the buffer.
  * @param buffer The GPU buffer to get the pixel from.
@@ -26,7 +26,10 @@
  *********************/
 
 #include "gpu_cache.h"
+#include "gpu_tick.h"
+#include "gpu_timeline.h"
 #include <stdint.h>
+#include <string.h>
 
 #ifdef GPU_CACHE_INCLUDE_H
 #include GPU_CACHE_INCLUDE_H
@@ -36,18 +39,46 @@
  *      DEFINES
  *********************/
 
+/* Merged ranges kept per operation, a full queue is issued */
+#define CACHE_DEFER_QUEUE_SIZE 16
+
+#define CACHE_ALIGN_DOWN(addr) ((addr) & ~(uintptr_t)(GPU_CACHE_LINE_SIZE - 1))
+#define CACHE_ALIGN_UP(addr) CACHE_ALIGN_DOWN((addr) + GPU_CACHE_LINE_SIZE - 1)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+struct gpu_cache_range_s {
+    uintptr_t start;
+    uintptr_t end;
+};
+
+struct gpu_cache_queue_s {
+    struct gpu_cache_range_s ranges[CACHE_DEFER_QUEUE_SIZE];
+    int count;
+};
+
+struct gpu_cache_s {
+    bool deferred;
+    struct gpu_cache_queue_s queues[_GPU_CACHE_OP_LAST];
+    struct gpu_cache_stats_s stats;
+};
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
+static void cache_request(enum gpu_cache_op_e op, void* addr, size_t len);
+static void cache_enqueue(enum gpu_cache_op_e op, uintptr_t start, uintptr_t end);
+static void cache_issue(enum gpu_cache_op_e op, uintptr_t start, uintptr_t end);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+static struct gpu_cache_s g_cache;
+
 /**********************
  *      MACROS
  **********************/
@@ -58,34 +89,160 @@
 
 void gpu_cache_invalidate(void* addr, size_t len)
 {
-#ifdef GPU_CACHE_INVALIDATE_FUNC
-    GPU_CACHE_INVALIDATE_FUNC((uintptr_t)addr, (uintptr_t)addr + len);
-#else
-    (void)addr;
-    (void)len;
-#endif
+    cache_request(GPU_CACHE_OP_INVALIDATE, addr, len);
 }
 
 void gpu_cache_clean(void* addr, size_t len)
 {
-#ifdef GPU_CACHE_CLEAN_FUNC
-    GPU_CACHE_CLEAN_FUNC((uintptr_t)addr, (uintptr_t)addr + len);
-#else
-    (void)addr;
-    (void)len;
-#endif
+    cache_request(GPU_CACHE_OP_CLEAN, addr, len);
 }
 
 void gpu_cache_flush(void* addr, size_t len)
 {
-#ifdef GPU_CACHE_FLUSH_FUNC
-    GPU_CACHE_FLUSH_FUNC((uintptr_t)addr, (uintptr_t)addr + len);
-#else
-    (void)addr;
-    (void)len;
-#endif
+    cache_request(GPU_CACHE_OP_FLUSH, addr, len);
+}
+
+void gpu_cache_set_deferred(bool en)
+{
+    if (!en) {
+        gpu_cache_sync();
+    }
+
+    g_cache.deferred = en;
+}
+
+void gpu_cache_sync(void)
+{
+    /* Write back before the lines are dropped by a flush of the same range */
+    static const enum gpu_cache_op_e order[] = { GPU_CACHE_OP_CLEAN, GPU_CACHE_OP_FLUSH };
+
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        struct gpu_cache_queue_s* queue = &g_cache.queues[order[i]];
+
+        for (int j = 0; j < queue->count; j++) {
+            cache_issue(order[i], queue->ranges[j].start, queue->ranges[j].end);
+        }
+
+        queue->count = 0;
+    }
+}
+
+void gpu_cache_get_stats(struct gpu_cache_stats_s* stats)
+{
+    *stats = g_cache.stats;
+}
+
+void gpu_cache_reset_stats(void)
+{
+    memset(&g_cache.stats, 0, sizeof(g_cache.stats));
+}
+
+const char* gpu_cache_op_string(enum gpu_cache_op_e op)
+{
+    switch (op) {
+    case GPU_CACHE_OP_INVALIDATE:
+        return "invalidate";
+    case GPU_CACHE_OP_CLEAN:
+        return "clean";
+    case GPU_CACHE_OP_FLUSH:
+        return "flush";
+    default:
+        break;
+    }
+
+    return "unknown";
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static void cache_request(enum gpu_cache_op_e op, void* addr, size_t len)
+{
+    g_cache.stats.requests[op]++;
+
+    if (len == 0) {
+        return;
+    }
+
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end = start + len;
+
+    if (!g_cache.deferred) {
+        cache_issue(op, start, end);
+        return;
+    }
+
+    if (op == GPU_CACHE_OP_INVALIDATE) {
+        /* The CPU is about to read, the queued dirty lines must reach the memory first */
+        gpu_cache_sync();
+
+        /* Exact range as the immediate path, widening it would drop the dirty data of the neighbours */
+        cache_issue(op, start, end);
+        return;
+    }
+
+    /* Writing back a whole edge line is harmless, only clean and flush are aligned for merging */
+    cache_enqueue(op, CACHE_ALIGN_DOWN(start), CACHE_ALIGN_UP(end));
+}
+
+static void cache_enqueue(enum gpu_cache_op_e op, uintptr_t start, uintptr_t end)
+{
+    struct gpu_cache_queue_s* queue = &g_cache.queues[op];
+
+    /* Absorb every overlapping or touching range, the merged range may reach the next one */
+    for (int i = 0; i < queue->count;) {
+        struct gpu_cache_range_s* range = &queue->ranges[i];
+
+        if (range->start <= end && start <= range->end) {
+            start = range->start < start ? range->start : start;
+            end = range->end > end ? range->end : end;
+            *range = queue->ranges[--queue->count];
+            i = 0;
+            continue;
+        }
+
+        i++;
+    }
+
+    if (queue->count >= CACHE_DEFER_QUEUE_SIZE) {
+        gpu_cache_sync();
+    }
+
+    queue->ranges[queue->count].start = start;
+    queue->ranges[queue->count].end = end;
+    queue->count++;
+}
+
+static void cache_issue(enum gpu_cache_op_e op, uintptr_t start, uintptr_t end)
+{
+    uint32_t start_tick = gpu_tick_get();
+
+    switch (op) {
+    case GPU_CACHE_OP_INVALIDATE:
+#ifdef GPU_CACHE_INVALIDATE_FUNC
+        GPU_CACHE_INVALIDATE_FUNC(start, end);
+#endif
+        break;
+
+    case GPU_CACHE_OP_CLEAN:
+#ifdef GPU_CACHE_CLEAN_FUNC
+        GPU_CACHE_CLEAN_FUNC(start, end);
+#endif
+        break;
+
+    case GPU_CACHE_OP_FLUSH:
+#ifdef GPU_CACHE_FLUSH_FUNC
+        GPU_CACHE_FLUSH_FUNC(start, end);
+#endif
+        break;
+
+    default:
+        break;
+    }
+
+    g_cache.stats.ops[op]++;
+    g_cache.stats.bytes[op] += end - start;
+    g_cache.stats.time_us[op] += gpu_tick_elaps(start_tick);
+    gpu_timeline_span("cache", gpu_cache_op_string(op), NULL, start_tick);
+}
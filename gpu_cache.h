@@ -32,16 +32,40 @@ extern "C" {
  *      INCLUDES
  *********************/
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /*********************
  *      DEFINES
  *********************/
 
+/* The deferred ranges are aligned to the cache line */
+#ifndef GPU_CACHE_LINE_SIZE
+#define GPU_CACHE_LINE_SIZE 64
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+enum gpu_cache_op_e {
+    GPU_CACHE_OP_INVALIDATE,
+    GPU_CACHE_OP_CLEAN,
+    GPU_CACHE_OP_FLUSH,
+    _GPU_CACHE_OP_LAST
+};
+
+struct gpu_cache_stats_s {
+    /* Calls of gpu_cache_invalidate, gpu_cache_clean and gpu_cache_flush */
+    uint32_t requests[_GPU_CACHE_OP_LAST];
+
+    /* Operations issued to the cache after coalescing */
+    uint32_t ops[_GPU_CACHE_OP_LAST];
+    uint64_t bytes[_GPU_CACHE_OP_LAST];
+    uint32_t time_us[_GPU_CACHE_OP_LAST];
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -67,6 +91,37 @@ void gpu_cache_clean(void* addr, size_t len);
  */
 void gpu_cache_flush(void* addr, size_t len);
 
+/**
+ * Queue the clean and flush ranges instead of issuing them, until gpu_cache_sync.
+ * The queued ranges are merged and aligned to GPU_CACHE_LINE_SIZE. An invalidate
+ * always issues the queue first, a dirty line must not be discarded.
+ * @param en True to enable the deferred mode, false issues the queue and disables it.
+ */
+void gpu_cache_set_deferred(bool en);
+
+/**
+ * Issue the queued ranges of the deferred mode, call before the GPU reads the memory.
+ */
+void gpu_cache_sync(void);
+
+/**
+ * Get the statistics since the last gpu_cache_reset_stats.
+ * @param stats The statistics.
+ */
+void gpu_cache_get_stats(struct gpu_cache_stats_s* stats);
+
+/**
+ * Reset the statistics.
+ */
+void gpu_cache_reset_stats(void);
+
+/**
+ * Get the name of a cache operation.
+ * @param op The cache operation.
+ * @return The name of the operation.
+ */
+const char* gpu_cache_op_string(enum gpu_cache_op_e op);
+
 /**********************
  *      MACROS
  **********************/
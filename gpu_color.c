@@ -79,6 +79,28 @@ uint32_t gpu_color_format_get_bpp(gpu_color_format_t format)
     return 0;
 }
 
+const char* gpu_color_format_string(gpu_color_format_t format)
+{
+#define GPU_COLOR_FORMAT_TO_STRING(e) \
+    case (GPU_COLOR_FORMAT_##e):      \
+        return #e
+
+    switch (format) {
+        GPU_COLOR_FORMAT_TO_STRING(BGR565);
+        GPU_COLOR_FORMAT_TO_STRING(BGR888);
+        GPU_COLOR_FORMAT_TO_STRING(BGRA8888);
+        GPU_COLOR_FORMAT_TO_STRING(BGRX8888);
+        GPU_COLOR_FORMAT_TO_STRING(BGRA5658);
+        GPU_COLOR_FORMAT_TO_STRING(INDEX8);
+    default:
+        break;
+    }
+
+#undef GPU_COLOR_FORMAT_TO_STRING
+
+    return "UNKNOWN";
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -85,7 +85,7 @@ typedef union gpu_color_bgr565_u {
     uint16_t full;
 } gpu_color16_t, gpu_color_bgr565_t;
 
-typedef struct gpu_color_bgra5658_u {
+typedef union gpu_color_bgra5658_u {
     struct
     {
         uint16_t blue : 5;
@@ -109,6 +109,13 @@ typedef struct gpu_color_bgra5658_u {
  */
 uint32_t gpu_color_format_get_bpp(gpu_color_format_t format);
 
+/**
+ * @brief Get the name of a color format
+ * @param format The color format to get the name for
+ * @return The name of the color format
+ */
+const char* gpu_color_format_string(gpu_color_format_t format);
+
 /**********************
  *      MACROS
  **********************/
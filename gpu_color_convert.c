@@ -0,0 +1,488 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "gpu_color_convert.h"
+#include "gpu_assert.h"
+#include "gpu_buffer.h"
+#include "gpu_log.h"
+#include "gpu_tick.h"
+#include <string.h>
+
+#if defined(__ARM_NEON) && !defined(GPU_COLOR_CONVERT_NO_SIMD)
+#include <arm_neon.h>
+#define CONVERT_USE_NEON 1
+#elif defined(__SSE2__) && !defined(GPU_COLOR_CONVERT_NO_SIMD)
+#include <emmintrin.h>
+#define CONVERT_USE_SSE2 1
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define CONVERT_FORMAT_COUNT (GPU_COLOR_FORMAT_INDEX8 + 1)
+
+/* Pixels converted at once through the intermediate BGRA8888 strip */
+#define CONVERT_STRIP_SIZE 64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef void (*convert_row_cb_t)(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void convert_bgr565_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+static void convert_bgr888_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+static void convert_bgra5658_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+static void convert_index8_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+static void convert_set_alpha_8888(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+static void convert_bgra8888_to_bgr565(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+static void convert_bgra8888_to_bgr888(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+static void convert_bgra8888_to_bgra5658(void* dest, const void* src, uint32_t width, const uint32_t* palette);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/* Direct kernels, the other pairs go through BGRA8888 */
+static const convert_row_cb_t convert_table[CONVERT_FORMAT_COUNT][CONVERT_FORMAT_COUNT] = {
+    [GPU_COLOR_FORMAT_BGR565] = {
+        [GPU_COLOR_FORMAT_BGRA8888] = convert_bgr565_to_bgra8888,
+        [GPU_COLOR_FORMAT_BGRX8888] = convert_bgr565_to_bgra8888,
+    },
+    [GPU_COLOR_FORMAT_BGR888] = {
+        [GPU_COLOR_FORMAT_BGRA8888] = convert_bgr888_to_bgra8888,
+        [GPU_COLOR_FORMAT_BGRX8888] = convert_bgr888_to_bgra8888,
+    },
+    [GPU_COLOR_FORMAT_BGRA8888] = {
+        [GPU_COLOR_FORMAT_BGR565] = convert_bgra8888_to_bgr565,
+        [GPU_COLOR_FORMAT_BGR888] = convert_bgra8888_to_bgr888,
+        [GPU_COLOR_FORMAT_BGRX8888] = convert_set_alpha_8888,
+        [GPU_COLOR_FORMAT_BGRA5658] = convert_bgra8888_to_bgra5658,
+    },
+    [GPU_COLOR_FORMAT_BGRX8888] = {
+        [GPU_COLOR_FORMAT_BGR565] = convert_bgra8888_to_bgr565,
+        [GPU_COLOR_FORMAT_BGR888] = convert_bgra8888_to_bgr888,
+        [GPU_COLOR_FORMAT_BGRA8888] = convert_set_alpha_8888,
+    },
+    [GPU_COLOR_FORMAT_BGRA5658] = {
+        [GPU_COLOR_FORMAT_BGRA8888] = convert_bgra5658_to_bgra8888,
+    },
+    [GPU_COLOR_FORMAT_INDEX8] = {
+        [GPU_COLOR_FORMAT_BGRA8888] = convert_index8_to_bgra8888,
+    },
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Exact round(x * 255 / 31) and round(x * 255 / 63) */
+#define CONVERT_EXPAND5(x) ((uint32_t)((x) * 527 + 23) >> 6)
+#define CONVERT_EXPAND6(x) ((uint32_t)((x) * 259 + 33) >> 6)
+
+/* Exact round(x * 31 / 255) and round(x * 63 / 255) */
+#define CONVERT_REDUCE5(x) ((uint32_t)((x) * 249 + 1014) >> 11)
+#define CONVERT_REDUCE6(x) ((uint32_t)((x) * 253 + 505) >> 10)
+
+#define CONVERT_FORMAT_VALID(format) ((format) > GPU_COLOR_FORMAT_UNKNOWN && (format) < CONVERT_FORMAT_COUNT)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool gpu_color_convert_is_supported(gpu_color_format_t dest_format, gpu_color_format_t src_format)
+{
+    if (!CONVERT_FORMAT_VALID(dest_format) || !CONVERT_FORMAT_VALID(src_format)) {
+        return false;
+    }
+
+    if (dest_format == src_format || convert_table[src_format][dest_format]) {
+        return true;
+    }
+
+    return convert_table[src_format][GPU_COLOR_FORMAT_BGRA8888]
+        && convert_table[GPU_COLOR_FORMAT_BGRA8888][dest_format];
+}
+
+int gpu_color_convert_row(
+    gpu_color_format_t dest_format, void* dest,
+    gpu_color_format_t src_format, const void* src,
+    uint32_t width, const uint32_t* palette)
+{
+    GPU_ASSERT_NULL(dest);
+    GPU_ASSERT_NULL(src);
+
+    if (!gpu_color_convert_is_supported(dest_format, src_format)) {
+        GPU_LOG_ERROR("Unsupported conversion: %d -> %d", src_format, dest_format);
+        return -1;
+    }
+
+    if (src_format == GPU_COLOR_FORMAT_INDEX8 && dest_format != src_format && !palette) {
+        GPU_LOG_ERROR("INDEX8 conversion needs a palette");
+        return -1;
+    }
+
+    if (dest_format == src_format) {
+        memcpy(dest, src, width * gpu_color_format_get_bpp(src_format) / 8);
+        return 0;
+    }
+
+    convert_row_cb_t direct = convert_table[src_format][dest_format];
+    if (direct) {
+        direct(dest, src, width, palette);
+        return 0;
+    }
+
+    convert_row_cb_t to_bgra = convert_table[src_format][GPU_COLOR_FORMAT_BGRA8888];
+    convert_row_cb_t from_bgra = convert_table[GPU_COLOR_FORMAT_BGRA8888][dest_format];
+    const uint32_t src_bytes = gpu_color_format_get_bpp(src_format) / 8;
+    const uint32_t dest_bytes = gpu_color_format_get_bpp(dest_format) / 8;
+
+    /* Small enough to stay in the L1 cache between the two passes */
+    uint32_t strip[CONVERT_STRIP_SIZE];
+    const uint8_t* src_p = src;
+    uint8_t* dest_p = dest;
+
+    while (width > 0) {
+        uint32_t count = width < CONVERT_STRIP_SIZE ? width : CONVERT_STRIP_SIZE;
+        to_bgra(strip, src_p, count, palette);
+        from_bgra(dest_p, strip, count, NULL);
+        src_p += count * src_bytes;
+        dest_p += count * dest_bytes;
+        width -= count;
+    }
+
+    return 0;
+}
+
+int gpu_color_convert_buffer(struct gpu_buffer_s* dest, const struct gpu_buffer_s* src, const uint32_t* palette)
+{
+    GPU_ASSERT_NULL(dest);
+    GPU_ASSERT_NULL(src);
+
+    if (dest->width != src->width || dest->height != src->height) {
+        GPU_LOG_ERROR("Size not matched: dest W%dxH%d vs src W%dxH%d",
+            (int)dest->width, (int)dest->height, (int)src->width, (int)src->height);
+        return -1;
+    }
+
+    if (!gpu_color_convert_is_supported(dest->format, src->format)) {
+        GPU_LOG_ERROR("Unsupported conversion: %d -> %d", src->format, dest->format);
+        return -1;
+    }
+
+    const uint8_t* src_row = src->data;
+    uint8_t* dest_row = dest->data;
+
+    for (uint32_t y = 0; y < src->height; y++) {
+        gpu_color_convert_row(dest->format, dest_row, src->format, src_row, src->width, palette);
+        src_row += src->stride;
+        dest_row += dest->stride;
+    }
+
+    return 0;
+}
+
+double gpu_color_convert_benchmark(
+    gpu_color_format_t dest_format,
+    gpu_color_format_t src_format,
+    uint32_t width, uint32_t height,
+    uint32_t min_time_ms)
+{
+    if (!gpu_color_convert_is_supported(dest_format, src_format)) {
+        return -1;
+    }
+
+    const uint32_t src_stride = width * gpu_color_format_get_bpp(src_format) / 8;
+    const uint32_t dest_stride = width * gpu_color_format_get_bpp(dest_format) / 8;
+    struct gpu_buffer_s* src = gpu_buffer_alloc(width, height, src_format, src_stride, 64);
+    struct gpu_buffer_s* dest = gpu_buffer_alloc(width, height, dest_format, dest_stride, 64);
+
+    /* Noise, so that no channel value is skipped */
+    uint32_t seed = 0x12345678;
+    uint8_t* data = src->data;
+    for (uint32_t i = 0; i < src_stride * height; i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = seed >> 24;
+    }
+
+    uint32_t palette[256];
+    for (int i = 0; i < 256; i++) {
+        seed = seed * 1103515245 + 12345;
+        palette[i] = seed;
+    }
+
+    /* Warm up the caches and the page tables */
+    gpu_color_convert_buffer(dest, src, palette);
+
+    uint32_t loops = 0;
+    uint32_t elapsed = 0;
+    uint32_t start_tick = gpu_tick_get();
+
+    do {
+        gpu_color_convert_buffer(dest, src, palette);
+        loops++;
+        elapsed = gpu_tick_elaps(start_tick);
+    } while (elapsed < min_time_ms * 1000);
+
+    gpu_buffer_free(src);
+    gpu_buffer_free(dest);
+
+    double bytes = (double)loops * (src_stride + dest_stride) * height;
+
+    /* Bytes per microsecond to GB/s */
+    return bytes / (elapsed ? elapsed : 1) / 1000.0;
+}
+
+const char* gpu_color_convert_simd_name(void)
+{
+#if defined(CONVERT_USE_NEON)
+    return "NEON";
+#elif defined(CONVERT_USE_SSE2)
+    return "SSE2";
+#else
+    return "C";
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void convert_bgr565_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint16_t* s = src;
+    uint32_t* d = dest;
+    uint32_t i = 0;
+
+#if defined(CONVERT_USE_NEON)
+    for (; i + 8 <= width; i += 8) {
+        uint16x8_t p = vld1q_u16(s + i);
+        uint16x8_t b = vandq_u16(p, vdupq_n_u16(0x1F));
+        uint16x8_t g = vandq_u16(vshrq_n_u16(p, 5), vdupq_n_u16(0x3F));
+        uint16x8_t r = vshrq_n_u16(p, 11);
+        uint8x8x4_t out;
+        out.val[0] = vmovn_u16(vshrq_n_u16(vmlaq_u16(vdupq_n_u16(23), b, vdupq_n_u16(527)), 6));
+        out.val[1] = vmovn_u16(vshrq_n_u16(vmlaq_u16(vdupq_n_u16(33), g, vdupq_n_u16(259)), 6));
+        out.val[2] = vmovn_u16(vshrq_n_u16(vmlaq_u16(vdupq_n_u16(23), r, vdupq_n_u16(527)), 6));
+        out.val[3] = vdup_n_u8(0xFF);
+        vst4_u8((uint8_t*)(d + i), out);
+    }
+#elif defined(CONVERT_USE_SSE2)
+    const __m128i mask5 = _mm_set1_epi16(0x1F);
+    const __m128i mask6 = _mm_set1_epi16(0x3F);
+    const __m128i mul5 = _mm_set1_epi16(527);
+    const __m128i mul6 = _mm_set1_epi16(259);
+    const __m128i add5 = _mm_set1_epi16(23);
+    const __m128i add6 = _mm_set1_epi16(33);
+    const __m128i alpha = _mm_set1_epi16((short)0xFF00);
+
+    for (; i + 8 <= width; i += 8) {
+        __m128i p = _mm_loadu_si128((const __m128i*)(s + i));
+        __m128i b = _mm_and_si128(p, mask5);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(p, 5), mask6);
+        __m128i r = _mm_srli_epi16(p, 11);
+        b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(b, mul5), add5), 6);
+        g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(g, mul6), add6), 6);
+        r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(r, mul5), add5), 6);
+
+        /* Interleave the B|G and R|A 16 bit pairs into BGRA */
+        __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        __m128i ra = _mm_or_si128(r, alpha);
+        _mm_storeu_si128((__m128i*)(d + i), _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128((__m128i*)(d + i + 4), _mm_unpackhi_epi16(bg, ra));
+    }
+#endif
+
+    for (; i < width; i++) {
+        uint32_t p = s[i];
+        d[i] = CONVERT_EXPAND5(p & 0x1F)
+            | (CONVERT_EXPAND6((p >> 5) & 0x3F) << 8)
+            | (CONVERT_EXPAND5(p >> 11) << 16)
+            | 0xFF000000;
+    }
+}
+
+static void convert_bgr888_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint8_t* s = src;
+    uint32_t* d = dest;
+    uint32_t i = 0;
+
+#if defined(CONVERT_USE_NEON)
+    for (; i + 8 <= width; i += 8) {
+        uint8x8x3_t p = vld3_u8(s + i * 3);
+        uint8x8x4_t out;
+        out.val[0] = p.val[0];
+        out.val[1] = p.val[1];
+        out.val[2] = p.val[2];
+        out.val[3] = vdup_n_u8(0xFF);
+        vst4_u8((uint8_t*)(d + i), out);
+    }
+#endif
+
+    for (; i < width; i++) {
+        const uint8_t* p = s + i * 3;
+        d[i] = p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | 0xFF000000;
+    }
+}
+
+static void convert_bgra5658_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint8_t* s = src;
+    uint32_t* d = dest;
+
+    for (uint32_t i = 0; i < width; i++) {
+        const uint8_t* p = s + i * 3;
+        uint32_t c16 = p[0] | (p[1] << 8);
+        d[i] = CONVERT_EXPAND5(c16 & 0x1F)
+            | (CONVERT_EXPAND6((c16 >> 5) & 0x3F) << 8)
+            | (CONVERT_EXPAND5(c16 >> 11) << 16)
+            | ((uint32_t)p[2] << 24);
+    }
+}
+
+static void convert_index8_to_bgra8888(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint8_t* s = src;
+    uint32_t* d = dest;
+
+    for (uint32_t i = 0; i < width; i++) {
+        d[i] = palette[s[i]];
+    }
+}
+
+static void convert_set_alpha_8888(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint32_t* s = src;
+    uint32_t* d = dest;
+
+    /* Simple enough for the compiler to vectorize */
+    for (uint32_t i = 0; i < width; i++) {
+        d[i] = s[i] | 0xFF000000;
+    }
+}
+
+static void convert_bgra8888_to_bgr565(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint32_t* s = src;
+    uint16_t* d = dest;
+    uint32_t i = 0;
+
+#if defined(CONVERT_USE_NEON)
+    for (; i + 8 <= width; i += 8) {
+        uint8x8x4_t p = vld4_u8((const uint8_t*)(s + i));
+        uint16x8_t b = vshrq_n_u16(vmlal_u8(vdupq_n_u16(1014), p.val[0], vdup_n_u8(249)), 11);
+        uint16x8_t g = vshrq_n_u16(vmlal_u8(vdupq_n_u16(505), p.val[1], vdup_n_u8(253)), 10);
+        uint16x8_t r = vshrq_n_u16(vmlal_u8(vdupq_n_u16(1014), p.val[2], vdup_n_u8(249)), 11);
+        vst1q_u16(d + i, vorrq_u16(vorrq_u16(b, vshlq_n_u16(g, 5)), vshlq_n_u16(r, 11)));
+    }
+#elif defined(CONVERT_USE_SSE2)
+    const __m128i mask8 = _mm_set1_epi32(0xFF);
+    const __m128i mul5 = _mm_set1_epi16(249);
+    const __m128i mul6 = _mm_set1_epi16(253);
+    const __m128i add5 = _mm_set1_epi16(1014);
+    const __m128i add6 = _mm_set1_epi16(505);
+
+    for (; i + 8 <= width; i += 8) {
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(s + i));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(s + i + 4));
+
+        /* The channels fit in 8 bits, the signed saturation never triggers */
+        __m128i b = _mm_packs_epi32(_mm_and_si128(p0, mask8), _mm_and_si128(p1, mask8));
+        __m128i g = _mm_packs_epi32(
+            _mm_and_si128(_mm_srli_epi32(p0, 8), mask8),
+            _mm_and_si128(_mm_srli_epi32(p1, 8), mask8));
+        __m128i r = _mm_packs_epi32(
+            _mm_and_si128(_mm_srli_epi32(p0, 16), mask8),
+            _mm_and_si128(_mm_srli_epi32(p1, 16), mask8));
+
+        /* The products wrap above 32767, only the unsigned shift matters */
+        b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(b, mul5), add5), 11);
+        g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(g, mul6), add6), 10);
+        r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(r, mul5), add5), 11);
+
+        __m128i c16 = _mm_or_si128(_mm_or_si128(b, _mm_slli_epi16(g, 5)), _mm_slli_epi16(r, 11));
+        _mm_storeu_si128((__m128i*)(d + i), c16);
+    }
+#endif
+
+    for (; i < width; i++) {
+        uint32_t p = s[i];
+        d[i] = CONVERT_REDUCE5(p & 0xFF)
+            | (CONVERT_REDUCE6((p >> 8) & 0xFF) << 5)
+            | (CONVERT_REDUCE5((p >> 16) & 0xFF) << 11);
+    }
+}
+
+static void convert_bgra8888_to_bgr888(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint32_t* s = src;
+    uint8_t* d = dest;
+    uint32_t i = 0;
+
+#if defined(CONVERT_USE_NEON)
+    for (; i + 8 <= width; i += 8) {
+        uint8x8x4_t p = vld4_u8((const uint8_t*)(s + i));
+        uint8x8x3_t out;
+        out.val[0] = p.val[0];
+        out.val[1] = p.val[1];
+        out.val[2] = p.val[2];
+        vst3_u8(d + i * 3, out);
+    }
+#endif
+
+    for (; i < width; i++) {
+        uint32_t p = s[i];
+        uint8_t* c = d + i * 3;
+        c[0] = p;
+        c[1] = p >> 8;
+        c[2] = p >> 16;
+    }
+}
+
+static void convert_bgra8888_to_bgra5658(void* dest, const void* src, uint32_t width, const uint32_t* palette)
+{
+    const uint32_t* s = src;
+    uint8_t* d = dest;
+
+    for (uint32_t i = 0; i < width; i++) {
+        uint32_t p = s[i];
+        uint32_t c16 = CONVERT_REDUCE5(p & 0xFF)
+            | (CONVERT_REDUCE6((p >> 8) & 0xFF) << 5)
+            | (CONVERT_REDUCE5((p >> 16) & 0xFF) << 11);
+        uint8_t* c = d + i * 3;
+        c[0] = c16;
+        c[1] = c16 >> 8;
+        c[2] = p >> 24;
+    }
+}
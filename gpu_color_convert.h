@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GPU_COLOR_CONVERT_H
+#define GPU_COLOR_CONVERT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "gpu_color.h"
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_buffer_s;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Check whether a conversion between two color formats is supported.
+ * @param dest_format The destination color format.
+ * @param src_format The source color format.
+ * @return True if supported. INDEX8 is only supported as a source.
+ */
+bool gpu_color_convert_is_supported(gpu_color_format_t dest_format, gpu_color_format_t src_format);
+
+/**
+ * @brief Convert a row of pixels, 5/6 bit channels are expanded and reduced with rounding.
+ * @param dest_format The destination color format.
+ * @param dest The destination pixels.
+ * @param src_format The source color format.
+ * @param src The source pixels, must not overlap with dest.
+ * @param width The number of pixels.
+ * @param palette The BGRA8888 palette for INDEX8 sources, 256 entries, NULL otherwise.
+ * @return 0 on success, -1 if the conversion is not supported.
+ */
+int gpu_color_convert_row(
+    gpu_color_format_t dest_format, void* dest,
+    gpu_color_format_t src_format, const void* src,
+    uint32_t width, const uint32_t* palette);
+
+/**
+ * @brief Convert a buffer into another buffer of the same size.
+ * @param dest The destination buffer.
+ * @param src The source buffer.
+ * @param palette The BGRA8888 palette for INDEX8 sources, 256 entries, NULL otherwise.
+ * @return 0 on success, -1 if the conversion is not supported or the sizes differ.
+ */
+int gpu_color_convert_buffer(struct gpu_buffer_s* dest, const struct gpu_buffer_s* src, const uint32_t* palette);
+
+/**
+ * @brief Measure the conversion throughput between two color formats.
+ * @param dest_format The destination color format.
+ * @param src_format The source color format.
+ * @param width The width of the test image.
+ * @param height The height of the test image.
+ * @param min_time_ms Keep converting the image until at least this time passed.
+ * @return The throughput in GB/s counting the source and destination bytes, negative if not supported.
+ */
+double gpu_color_convert_benchmark(
+    gpu_color_format_t dest_format,
+    gpu_color_format_t src_format,
+    uint32_t width, uint32_t height,
+    uint32_t min_time_ms);
+
+/**
+ * @brief Get the name of the SIMD instruction set used by the conversion kernels.
+ * @return "NEON", "SSE2" or "C".
+ */
+const char* gpu_color_convert_simd_name(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*GPU_COLOR_CONVERT_H*/
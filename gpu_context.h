@@ -33,6 +33,8 @@ extern "C" {
  *********************/
 
 #include "gpu_buffer.h"
+#include "gpu_isolate.h"
+#include "gpu_screenshot.h"
 #include <stdbool.h>
 
 /*********************
@@ -42,6 +44,9 @@ extern "C" {
 #define GPU_TEST_DESIGN_WIDTH 480
 #define GPU_TEST_DESIGN_HEIGHT 480
 
+/* Target sizes and target formats a run can sweep */
+#define GPU_TEST_TARGET_SWEEP_MAX 16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -52,6 +57,15 @@ struct gpu_fb_s;
 enum gpu_test_mode_e {
     GPU_TEST_MODE_DEFAULT = 0,
     GPU_TEST_MODE_STRESS,
+    GPU_TEST_MODE_COLOR_CONVERT,
+    GPU_TEST_MODE_PNG_ENCODE,
+    GPU_TEST_MODE_CROSSOVER,
+    GPU_TEST_MODE_CONTENTION,
+};
+
+struct gpu_test_target_size_s {
+    int width;
+    int height;
 };
 
 struct gpu_test_param_s {
@@ -61,11 +75,36 @@ struct gpu_test_param_s {
     const char* output_dir;
     const char* testcase_name;
     const char* fbdev_path;
+    const char* trace_path;
+    const char* replay_path;
+    const char* fault_spec;
+    const char* timeline_path;
+    const char* asset_path;
+    const char* crossover_header_path;
+    const char* contention_locks;
+    const char* budget_path;
+    const char* budget_update_spec;
+    const char* isolate_spec;
     int target_width;
     int target_height;
+    gpu_color_format_t target_format;
+    struct gpu_test_target_size_s target_sizes[GPU_TEST_TARGET_SWEEP_MAX];
+    int target_size_count;
+    gpu_color_format_t target_formats[GPU_TEST_TARGET_SWEEP_MAX];
+    int target_format_count;
     int run_loop_count;
     int cpu_freq;
+    int busy_sample_rate;
+    int contention_threads;
     bool screenshot_en;
+    bool ref_en;
+    bool leak_check_en;
+    bool full_metrics_en;
+    bool perf_en;
+    bool cache_defer_en;
+    bool pipeline_en;
+    bool roofline_en;
+    struct gpu_screenshot_png_options_s png_options;
 };
 
 struct gpu_test_context_s {
@@ -73,6 +112,7 @@ struct gpu_test_context_s {
     struct gpu_fb_s* fb;
     struct gpu_test_param_s param;
     struct gpu_buffer_s target_buffer;
+    struct gpu_isolate_state_s isolate;
 };
 
 /**********************
@@ -0,0 +1,266 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* sched_setaffinity and CPU_SET are GNU extensions */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "gpu_isolate.h"
+#include "gpu_assert.h"
+#include "gpu_log.h"
+#include <errno.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool isolate_parse(const char* spec, int* cpu, int* fifo_priority);
+static bool isolate_pin_cpu(int cpu, int* pinned_cpu);
+static bool isolate_set_fifo(int priority);
+static enum gpu_isolate_lock_e isolate_lock_memory(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool gpu_isolate_apply(const char* spec, struct gpu_isolate_state_s* state)
+{
+    GPU_ASSERT_NULL(state);
+    memset(state, 0, sizeof(struct gpu_isolate_state_s));
+    state->cpu = -1;
+
+    if (!spec) {
+        return true;
+    }
+
+    int cpu = -1;
+    int fifo_priority = 0;
+    if (!isolate_parse(spec, &cpu, &fifo_priority)) {
+        GPU_LOG_ERROR("Invalid isolate spec: %s", spec);
+        return false;
+    }
+
+    state->requested = true;
+    bool retval = true;
+
+    /* Pin first, the locked pages and the priority then belong to the chosen core */
+    if (!isolate_pin_cpu(cpu, &state->cpu)) {
+        retval = false;
+    }
+
+    if (fifo_priority > 0) {
+        if (isolate_set_fifo(fifo_priority)) {
+            state->fifo_priority = fifo_priority;
+        } else {
+            retval = false;
+        }
+    }
+
+    state->memory_lock = isolate_lock_memory();
+    if (state->memory_lock == GPU_ISOLATE_LOCK_NONE) {
+        retval = false;
+    }
+
+    /* Works everywhere, the first touch of a calloc'd page is a fault on any system with virtual memory */
+    state->prefault = true;
+
+    char str[128];
+    gpu_isolate_state_to_string(state, str, sizeof(str));
+    if (retval) {
+        GPU_LOG_INFO("Isolation: %s", str);
+    } else {
+        GPU_LOG_WARN("Isolation partially applied: %s", str);
+    }
+
+    return retval;
+}
+
+bool gpu_isolate_check_spec(const char* spec)
+{
+    GPU_ASSERT_NULL(spec);
+
+    int cpu = -1;
+    int fifo_priority = 0;
+    return isolate_parse(spec, &cpu, &fifo_priority);
+}
+
+int gpu_isolate_state_to_string(const struct gpu_isolate_state_s* state, char* buf, size_t size)
+{
+    GPU_ASSERT_NULL(state);
+    GPU_ASSERT_NULL(buf);
+
+    if (!state->requested) {
+        return snprintf(buf, size, "disable");
+    }
+
+    static const char* const lock_names[] = { "no", "current pages", "yes" };
+
+    char cpu_str[16];
+    char fifo_str[16];
+    snprintf(cpu_str, sizeof(cpu_str), "%d", state->cpu);
+    snprintf(fifo_str, sizeof(fifo_str), "SCHED_FIFO %d", state->fifo_priority);
+
+    return snprintf(buf, size, "CPU: %s | Scheduler: %s | Memory lock: %s | Prefault: %s",
+        state->cpu >= 0 ? cpu_str : "not pinned",
+        state->fifo_priority > 0 ? fifo_str : "default",
+        lock_names[state->memory_lock],
+        state->prefault ? "yes" : "no");
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool isolate_parse(const char* spec, int* cpu, int* fifo_priority)
+{
+    /* A truncated copy would apply another spec than the given one */
+    char buf[64];
+    if (strlen(spec) >= sizeof(buf)) {
+        return false;
+    }
+
+    strcpy(buf, spec);
+
+    char* saveptr = NULL;
+    for (char* token = strtok_r(buf, ",", &saveptr); token; token = strtok_r(NULL, ",", &saveptr)) {
+        char* end;
+        if (strncmp(token, "cpu=", 4) == 0) {
+            *cpu = (int)strtol(token + 4, &end, 10);
+            if (end == token + 4 || *end != '\0' || *cpu < 0) {
+                return false;
+            }
+        } else if (strcmp(token, "fifo") == 0) {
+            int min = sched_get_priority_min(SCHED_FIFO);
+            int max = sched_get_priority_max(SCHED_FIFO);
+
+            /* High enough to preempt the normal tasks, low enough to leave the interrupt threads above */
+            *fifo_priority = (min + max) / 2;
+        } else if (strncmp(token, "fifo=", 5) == 0) {
+            *fifo_priority = (int)strtol(token + 5, &end, 10);
+            if (end == token + 5 || *end != '\0'
+                || *fifo_priority < sched_get_priority_min(SCHED_FIFO)
+                || *fifo_priority > sched_get_priority_max(SCHED_FIFO)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool isolate_pin_cpu(int cpu, int* pinned_cpu)
+{
+#ifdef CPU_SET
+    if (cpu < 0) {
+        cpu = sched_getcpu();
+        if (cpu < 0) {
+            GPU_LOG_WARN("sched_getcpu failed: %d", errno);
+            return false;
+        }
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+        GPU_LOG_WARN("Pin to CPU %d failed: %d", cpu, errno);
+        return false;
+    }
+
+    *pinned_cpu = cpu;
+    return true;
+#else
+    GPU_LOG_WARN("CPU affinity not supported");
+    return false;
+#endif
+}
+
+static bool isolate_set_fifo(int priority)
+{
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+
+    if (sched_setscheduler(0, SCHED_FIFO, &param) < 0) {
+        /* Usually EPERM without CAP_SYS_NICE or an RLIMIT_RTPRIO */
+        GPU_LOG_WARN("SCHED_FIFO priority %d failed: %d", priority, errno);
+        return false;
+    }
+
+    return true;
+}
+
+static enum gpu_isolate_lock_e isolate_lock_memory(void)
+{
+#ifdef MCL_CURRENT
+    int flags = MCL_CURRENT | MCL_FUTURE;
+
+    /* Under a lock limit MCL_FUTURE turns the later allocations into failures once it is reached */
+    struct rlimit limit;
+    if (geteuid() != 0 && getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        GPU_LOG_WARN("RLIMIT_MEMLOCK is %lu bytes, only the current pages are locked", (unsigned long)limit.rlim_cur);
+        flags = MCL_CURRENT;
+    }
+
+    if (mlockall(flags) < 0) {
+        /* Usually ENOMEM from RLIMIT_MEMLOCK or EPERM */
+        GPU_LOG_WARN("mlockall failed: %d", errno);
+        return GPU_ISOLATE_LOCK_NONE;
+    }
+
+    return flags & MCL_FUTURE ? GPU_ISOLATE_LOCK_ALL : GPU_ISOLATE_LOCK_CURRENT;
+#else
+    GPU_LOG_WARN("mlockall not supported");
+    return GPU_ISOLATE_LOCK_NONE;
+#endif
+}
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GPU_ISOLATE_H
+#define GPU_ISOLATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum gpu_isolate_lock_e {
+    GPU_ISOLATE_LOCK_NONE,
+    GPU_ISOLATE_LOCK_CURRENT,
+    GPU_ISOLATE_LOCK_ALL,
+};
+
+/* The isolation actually reached, a request the system refused is left unset */
+struct gpu_isolate_state_s {
+    bool requested;
+    int cpu;
+    int fifo_priority;
+    enum gpu_isolate_lock_e memory_lock;
+    bool prefault;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Isolate the calling thread from the scheduler and the page faults for stable timings.
+ * @param spec Comma separated settings, "cpu=<int>" pins to the core (default is the current one),
+ *             "fifo[=<priority>]" raises to SCHED_FIFO (default is the middle of the range).
+ *             The memory is always locked with mlockall and the buffers are prefaulted.
+ *             Example: "cpu=2,fifo=50".
+ * @param state The isolation reached, cleared if spec is NULL.
+ * @return True if every setting was applied, false if any was refused or the spec is invalid.
+ */
+bool gpu_isolate_apply(const char* spec, struct gpu_isolate_state_s* state);
+
+/**
+ * @brief Check an isolate spec without applying it.
+ * @param spec The isolate spec, see gpu_isolate_apply.
+ * @return True if the spec is valid, false otherwise.
+ */
+bool gpu_isolate_check_spec(const char* spec);
+
+/**
+ * @brief Format the isolation state on one line, without commas.
+ * @param state The isolation state.
+ * @param buf The buffer to write to.
+ * @param size The size of the buffer.
+ * @return The number of characters written, as snprintf.
+ */
+int gpu_isolate_state_to_string(const struct gpu_isolate_state_s* state, char* buf, size_t size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*GPU_ISOLATE_H*/
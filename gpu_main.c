@@ -26,9 +26,11 @@
  *********************/
 
 #include "gpu_context.h"
+#include "gpu_isolate.h"
 #include "gpu_log.h"
 #include "gpu_test.h"
 #include "gpu_utils.h"
+#include "vg_lite/vg_lite_test_fault.h"
 #include <getopt.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -69,6 +71,9 @@ int main(int argc, char* argv[])
     struct gpu_test_context_s ctx = { 0 };
     parse_commandline(argc, argv, &ctx.param);
     gpu_dir_create(ctx.param.output_dir);
+
+    /* Isolate before the setup, the CPU frequency is measured on the pinned core */
+    gpu_isolate_apply(ctx.param.isolate_spec, &ctx.isolate);
     gpu_test_context_setup(&ctx);
     int retval = gpu_test_run(&ctx);
     gpu_test_context_teardown(&ctx);
@@ -88,20 +93,58 @@ static void show_usage(const char* progname, int exitcode)
 {
     printf("\nUsage: %s"
            " -m <string> -o <string> -t <string> -s\n"
-           " --target <string> --loop-count <int> --cpu-freq <int> --fbdev <string>\\n",
+           " --target <string> --loop-count <int> --cpu-freq <int> --fbdev <string>"
+           " --trace <string> --replay <string> --ref --fault <string> --leak-check --full-metrics"
+           " --png-level <int> --png-filter <string> --png-strategy <string> --perf"
+           " --timeline <string> --cache-defer --asset <string> --pipeline --gpu-busy <int> --target-format <string>"
+           " --roofline --crossover-header <string> --threads <int> --lock <string>"
+           " --budgets <string> --update-budgets <string>"
+           " --isolate <string>\n",
         progname);
 
     printf("\nWhere:\n");
-    printf("  -m <string> Test mode: default; stress.\n");
+    printf("  -m <string> Test mode: default; stress; convert (color conversion benchmark); png (PNG encoder benchmark); "
+           "crossover (CPU vs GPU break-even size benchmark); contention (multithreaded submission benchmark).\n");
     printf("  -o <string> GPU report file output path, default is " GPU_OUTPUT_DIR_DEFAULT "\n");
     printf("  -t <string> Testcase name.\n");
     printf("  -s Enable screenshot.\n");
 
-    printf("  --target <string> Target render image size(px), default is 480x480. Example: "
-           "<decimal-value width>x<decimal-value height>\n");
+    printf("  --target <string> Target render image sizes(px), default is 480x480. A comma separated list of "
+           "<width>x<height> or <width>x<height>-<width>x<height>:<count> ranges, every size is run. "
+           "Example: 320x240,480x480-960x960:3\n");
     printf("  --loop-count <int> Stress mode loop count, default is 10000.\n");
     printf("  --cpu-freq <int> CPU frequency in MHz, default is 0 (auto).\n");
     printf("  --fbdev <string> Framebuffer device path.\n");
+    printf("  --trace <string> Capture the vg_lite calls of the test cases into a trace file.\n");
+    printf("  --replay <string> Replay a trace file instead of running the test cases.\n");
+    printf("  --ref Check the results against the software reference renderer, missing screenshots are created from it.\n");
+    printf("  --fault <string> Inject errors into the vg_lite calls and measure the recovery. Example: "
+           "draw=oom@3,finish=timeout@0.5%%,all=pressure:1048576@10%%,seed=1\n");
+    printf("  --leak-check Fail a test case whose GPU memory grows in consecutive runs, use with -m stress.\n");
+    printf("  --full-metrics Compare the whole screenshot instead of stopping at the first failed row.\n");
+    printf("  --png-level <int> Screenshot PNG compression level 0-9, default is the zlib default.\n");
+    printf("  --png-filter <string> Screenshot PNG row filter: auto; none; sub; up; avg; paeth.\n");
+    printf("  --png-strategy <string> Screenshot PNG compression strategy: default; filtered; huffman; rle; fixed.\n");
+    printf("  --perf Record the CPU performance counters of the setup, draw and finish phases.\n");
+    printf("  --timeline <string> Save a Chrome trace-event JSON timeline of the run, open it in Perfetto or chrome://tracing.\n");
+    printf("  --cache-defer Queue and merge the cache clean and flush ranges until the next vg_lite call.\n");
+    printf("  --asset <string> Asset pack drawn by the asset_pack test case, see vg_lite/resource/asset_pack_gen.py.\n");
+    printf("  --pipeline Set up the next test case while the GPU renders the current one, report the overlap.\n");
+    printf("  --gpu-busy <int> Sample the GPU idle state <int> times per second in a background thread, "
+           "report the GPU busy time and the idle gaps of each test case. "
+           "Needs a driver with a thread safe VG_LITE_GPU_IDLE_STATE query.\n");
+    printf("  --target-format <string> Comma separated target formats, every format is run with every target size: "
+           "BGR565; BGR888; BGRA8888; BGRX8888; BGRA5658. Default is BGRA8888.\n");
+    printf("  --roofline Measure the CPU and GPU memory bandwidth first, report the fraction of it reached by each test case.\n");
+    printf("  --crossover-header <string> Write the break-even areas of -m crossover as a C header.\n");
+    printf("  --threads <int> Most submitting threads of -m contention, the count doubles from 1, default is 4.\n");
+    printf("  --lock <string> Comma separated locks of -m contention: mutex; ticket; queue (lock-free queue to one "
+           "submission thread). Default is all.\n");
+    printf("  --budgets <string> Budgets file of the setup, draw and finish times, a test case over its budget is SLOW and fails.\n");
+    printf("  --update-budgets <string> Write the budgets of this run to <path>[:<headroom percent>], "
+           "from the 95th percentile of repeated runs, default headroom is 50%%.\n");
+    printf("  --isolate <string> Comma separated timing isolation: cpu=<int> pins to the core (default is the current one); "
+           "fifo[=<int>] raises to SCHED_FIFO. Also locks the memory and prefaults the buffers. Example: cpu=2,fifo=50.\n");
 
     exit(exitcode);
 }
@@ -122,6 +165,10 @@ static enum gpu_test_mode_e gpu_test_string_to_mode(const char* str)
 
     GPU_TEST_MODE_NAME_MATCH("default", GPU_TEST_MODE_DEFAULT);
     GPU_TEST_MODE_NAME_MATCH("stress", GPU_TEST_MODE_STRESS);
+    GPU_TEST_MODE_NAME_MATCH("convert", GPU_TEST_MODE_COLOR_CONVERT);
+    GPU_TEST_MODE_NAME_MATCH("png", GPU_TEST_MODE_PNG_ENCODE);
+    GPU_TEST_MODE_NAME_MATCH("crossover", GPU_TEST_MODE_CROSSOVER);
+    GPU_TEST_MODE_NAME_MATCH("contention", GPU_TEST_MODE_CONTENTION);
 
 #undef GPU_TEST_MODE_NAME_MATCH
 
@@ -129,6 +176,130 @@ static enum gpu_test_mode_e gpu_test_string_to_mode(const char* str)
     return GPU_TEST_MODE_DEFAULT;
 }
 
+/**
+ * @brief Convert string to index of a name table
+ * @param str The string to convert
+ * @param names The name table, NULL terminated
+ * @return The index of the name, -1 if not found
+ */
+static int gpu_test_string_to_index(const char* str, const char* const* names)
+{
+    for (int i = 0; names[i]; i++) {
+        if (strcmp(str, names[i]) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Parse the list of target sizes
+ * @param str The comma separated sizes, each one is WxH or a range W0xH0-W1xH1:N of N evenly spaced sizes
+ * @param param The test parameters
+ * @return True if the list is valid
+ */
+static bool parse_target_sizes(const char* str, struct gpu_test_param_s* param)
+{
+    int count = 0;
+    const char* token = str;
+
+    while (true) {
+        int width0 = 0;
+        int height0 = 0;
+        int width1 = 0;
+        int height1 = 0;
+        int steps = 0;
+        int len = 0;
+
+        /* %n is only stored when the whole pattern matched, the token must end right after it */
+        if (sscanf(token, "%dx%d-%dx%d:%d%n", &width0, &height0, &width1, &height1, &steps, &len) == 5 && len > 0) {
+            if (steps < 2) {
+                return false;
+            }
+        } else if (sscanf(token, "%dx%d%n", &width0, &height0, &len) == 2 && len > 0) {
+            width1 = width0;
+            height1 = height0;
+            steps = 1;
+        } else {
+            return false;
+        }
+
+        if (token[len] != ',' && token[len] != '\0') {
+            return false;
+        }
+
+        if (width0 <= 0 || height0 <= 0 || width1 <= 0 || height1 <= 0) {
+            return false;
+        }
+
+        for (int i = 0; i < steps; i++) {
+            if (count >= GPU_TEST_TARGET_SWEEP_MAX) {
+                return false;
+            }
+
+            int div = steps > 1 ? steps - 1 : 1;
+            param->target_sizes[count].width = width0 + (width1 - width0) * i / div;
+            param->target_sizes[count].height = height0 + (height1 - height0) * i / div;
+            count++;
+        }
+
+        token = strchr(token, ',');
+        if (!token) {
+            break;
+        }
+
+        token++;
+    }
+
+    param->target_size_count = count;
+    param->target_width = param->target_sizes[0].width;
+    param->target_height = param->target_sizes[0].height;
+    return true;
+}
+
+/**
+ * @brief Parse the list of target formats
+ * @param str The comma separated format names
+ * @param param The test parameters
+ * @return True if the list is valid
+ */
+static bool parse_target_formats(const char* str, struct gpu_test_param_s* param)
+{
+    int count = 0;
+    const char* token = str;
+
+    while (true) {
+        size_t len = strcspn(token, ",");
+        gpu_color_format_t format = GPU_COLOR_FORMAT_UNKNOWN;
+
+        /* INDEX8 can not be rendered to */
+        for (int i = GPU_COLOR_FORMAT_BGR565; i <= GPU_COLOR_FORMAT_BGRA5658; i++) {
+            const char* name = gpu_color_format_string(i);
+            if (strlen(name) == len && strncmp(token, name, len) == 0) {
+                format = (gpu_color_format_t)i;
+                break;
+            }
+        }
+
+        if (format == GPU_COLOR_FORMAT_UNKNOWN || count >= GPU_TEST_TARGET_SWEEP_MAX) {
+            return false;
+        }
+
+        param->target_formats[count++] = format;
+
+        if (token[len] == '\0') {
+            break;
+        }
+
+        token += len + 1;
+    }
+
+    param->target_format_count = count;
+    param->target_format = param->target_formats[0];
+    return true;
+}
+
 /**
  * @brief Parse long command line arguments
  * @param argc The number of arguments
@@ -147,18 +318,12 @@ static void parse_long_commandline(
 {
     switch (longindex) {
 
-    case 0: {
-        int width = 0;
-        int height = 0;
-        int converted = sscanf(optarg, "%dx%d", &width, &height);
-        if (converted == 2 && width >= 0 && height >= 0) {
-            param->target_width = width;
-            param->target_height = height;
-        } else {
+    case 0:
+        if (!parse_target_sizes(optarg, param)) {
             GPU_LOG_ERROR("Error target image size: %s", optarg);
             show_usage(argv[0], EXIT_FAILURE);
         }
-    } break;
+        break;
 
     case 1:
         param->run_loop_count = atoi(optarg);
@@ -172,6 +337,141 @@ static void parse_long_commandline(
         param->fbdev_path = optarg;
         break;
 
+    case 4:
+        param->trace_path = optarg;
+        break;
+
+    case 5:
+        param->replay_path = optarg;
+        break;
+
+    case 6:
+        param->ref_en = true;
+        break;
+
+    case 7:
+        param->fault_spec = optarg;
+        if (!vg_lite_test_fault_check_spec(param->fault_spec)) {
+            GPU_LOG_ERROR("Error fault spec: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+        break;
+
+    case 8:
+        param->leak_check_en = true;
+        break;
+
+    case 9:
+        param->full_metrics_en = true;
+        break;
+
+    case 10:
+        param->png_options.level = atoi(optarg);
+        if (param->png_options.level < 0 || param->png_options.level > 9) {
+            GPU_LOG_ERROR("Error PNG level: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+        break;
+
+    case 11: {
+        /* Same order as enum gpu_screenshot_png_filter_e */
+        static const char* const filters[] = { "auto", "none", "sub", "up", "avg", "paeth", NULL };
+        int index = gpu_test_string_to_index(optarg, filters);
+        if (index < 0) {
+            GPU_LOG_ERROR("Error PNG filter: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+        param->png_options.filter = (enum gpu_screenshot_png_filter_e)index;
+    } break;
+
+    case 12: {
+        /* Same order as enum gpu_screenshot_png_strategy_e */
+        static const char* const strategies[] = { "default", "filtered", "huffman", "rle", "fixed", NULL };
+        int index = gpu_test_string_to_index(optarg, strategies);
+        if (index < 0) {
+            GPU_LOG_ERROR("Error PNG strategy: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+        param->png_options.strategy = (enum gpu_screenshot_png_strategy_e)index;
+    } break;
+
+    case 13:
+        param->perf_en = true;
+        break;
+
+    case 14:
+        param->timeline_path = optarg;
+        break;
+
+    case 15:
+        param->cache_defer_en = true;
+        break;
+
+    case 16:
+        param->asset_path = optarg;
+        break;
+
+    case 17:
+        param->pipeline_en = true;
+        break;
+
+    case 18:
+        param->busy_sample_rate = atoi(optarg);
+        if (param->busy_sample_rate <= 0 || param->busy_sample_rate > 1000000) {
+            GPU_LOG_ERROR("Error GPU busy sample rate: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+#ifndef VG_LITE_TEST_IDLE_QUERY_THREAD_SAFE
+        /* vg_lite is not thread safe, the sampler thread may only query a driver that guarantees it */
+        GPU_LOG_ERROR("GPU busy sampling needs a thread safe VG_LITE_GPU_IDLE_STATE query, "
+                      "build with VG_LITE_TEST_IDLE_QUERY_THREAD_SAFE");
+        show_usage(argv[0], EXIT_FAILURE);
+#endif
+        break;
+
+    case 19:
+        if (!parse_target_formats(optarg, param)) {
+            GPU_LOG_ERROR("Error target format: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+        break;
+
+    case 20:
+        param->roofline_en = true;
+        break;
+
+    case 21:
+        param->crossover_header_path = optarg;
+        break;
+
+    case 22:
+        param->contention_threads = atoi(optarg);
+        if (param->contention_threads <= 0 || param->contention_threads > 1024) {
+            GPU_LOG_ERROR("Error thread count: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+        break;
+
+    case 23:
+        param->contention_locks = optarg;
+        break;
+
+    case 24:
+        param->budget_path = optarg;
+        break;
+
+    case 25:
+        param->budget_update_spec = optarg;
+        break;
+
+    case 26:
+        param->isolate_spec = optarg;
+        if (!gpu_isolate_check_spec(param->isolate_spec)) {
+            GPU_LOG_ERROR("Error isolate spec: %s", optarg);
+            show_usage(argv[0], EXIT_FAILURE);
+        }
+        break;
+
     default:
         GPU_LOG_WARN("Unknown longindex: %d", longindex);
         show_usage(argv[0], EXIT_FAILURE);
@@ -195,7 +495,15 @@ static void parse_commandline(int argc, char** argv, struct gpu_test_param_s* pa
     param->output_dir = GPU_OUTPUT_DIR_DEFAULT;
     param->target_width = GPU_TEST_DESIGN_WIDTH;
     param->target_height = GPU_TEST_DESIGN_WIDTH;
+    param->target_format = GPU_COLOR_FORMAT_BGRA8888;
+    param->target_sizes[0].width = param->target_width;
+    param->target_sizes[0].height = param->target_height;
+    param->target_size_count = 1;
+    param->target_formats[0] = param->target_format;
+    param->target_format_count = 1;
     param->run_loop_count = 10000;
+    param->contention_threads = 4;
+    param->png_options.level = -1;
 
     int ch;
     int longindex = 0;
@@ -205,6 +513,29 @@ static void parse_commandline(int argc, char** argv, struct gpu_test_param_s* pa
         { "loop-count", required_argument, NULL, 0 },
         { "cpu-freq", required_argument, NULL, 0 },
         { "fbdev", required_argument, NULL, 0 },
+        { "trace", required_argument, NULL, 0 },
+        { "replay", required_argument, NULL, 0 },
+        { "ref", no_argument, NULL, 0 },
+        { "fault", required_argument, NULL, 0 },
+        { "leak-check", no_argument, NULL, 0 },
+        { "full-metrics", no_argument, NULL, 0 },
+        { "png-level", required_argument, NULL, 0 },
+        { "png-filter", required_argument, NULL, 0 },
+        { "png-strategy", required_argument, NULL, 0 },
+        { "perf", no_argument, NULL, 0 },
+        { "timeline", required_argument, NULL, 0 },
+        { "cache-defer", no_argument, NULL, 0 },
+        { "asset", required_argument, NULL, 0 },
+        { "pipeline", no_argument, NULL, 0 },
+        { "gpu-busy", required_argument, NULL, 0 },
+        { "target-format", required_argument, NULL, 0 },
+        { "roofline", no_argument, NULL, 0 },
+        { "crossover-header", required_argument, NULL, 0 },
+        { "threads", required_argument, NULL, 0 },
+        { "lock", required_argument, NULL, 0 },
+        { "budgets", required_argument, NULL, 0 },
+        { "update-budgets", required_argument, NULL, 0 },
+        { "isolate", required_argument, NULL, 0 },
         { 0, 0, NULL, 0 }
     };
 
@@ -250,10 +581,32 @@ static void parse_commandline(int argc, char** argv, struct gpu_test_param_s* pa
 
     GPU_LOG_INFO("Test mode: %d", param->mode);
     GPU_LOG_INFO("Output DIR: %s", param->output_dir);
-    GPU_LOG_INFO("Target render image size: %dx%d", param->target_width, param->target_height);
+    GPU_LOG_INFO("Target render image size: %dx%d, format: %s", param->target_width, param->target_height,
+        gpu_color_format_string(param->target_format));
+    GPU_LOG_INFO("Target sweep: %d sizes x %d formats", param->target_size_count, param->target_format_count);
     GPU_LOG_INFO("Testcase name: %s", param->testcase_name);
     GPU_LOG_INFO("Screenshot: %s", param->screenshot_en ? "enable" : "disable");
     GPU_LOG_INFO("Loop count: %d", param->run_loop_count);
     GPU_LOG_INFO("CPU frequency: %d MHz (0 means auto)", param->cpu_freq);
     GPU_LOG_INFO("Framebuffer device: %s", param->fbdev_path);
+    GPU_LOG_INFO("Trace file: %s", param->trace_path);
+    GPU_LOG_INFO("Replay file: %s", param->replay_path);
+    GPU_LOG_INFO("Reference renderer: %s", param->ref_en ? "enable" : "disable");
+    GPU_LOG_INFO("Fault injection: %s", param->fault_spec);
+    GPU_LOG_INFO("Leak check: %s", param->leak_check_en ? "enable" : "disable");
+    GPU_LOG_INFO("Screenshot full metrics: %s", param->full_metrics_en ? "enable" : "disable");
+    GPU_LOG_INFO("Screenshot PNG level: %d, filter: %d, strategy: %d (negative level means zlib default)",
+        param->png_options.level, param->png_options.filter, param->png_options.strategy);
+    GPU_LOG_INFO("Performance counters: %s", param->perf_en ? "enable" : "disable");
+    GPU_LOG_INFO("Timeline file: %s", param->timeline_path);
+    GPU_LOG_INFO("Deferred cache maintenance: %s", param->cache_defer_en ? "enable" : "disable");
+    GPU_LOG_INFO("Asset pack: %s", param->asset_path);
+    GPU_LOG_INFO("Pipelined items: %s", param->pipeline_en ? "enable" : "disable");
+    GPU_LOG_INFO("GPU busy sample rate: %d Hz (0 means disable)", param->busy_sample_rate);
+    GPU_LOG_INFO("Roofline: %s", param->roofline_en ? "enable" : "disable");
+    GPU_LOG_INFO("Crossover header: %s", param->crossover_header_path);
+    GPU_LOG_INFO("Contention threads: %d, locks: %s", param->contention_threads,
+        param->contention_locks ? param->contention_locks : "all");
+    GPU_LOG_INFO("Budgets file: %s, update: %s", param->budget_path, param->budget_update_spec);
+    GPU_LOG_INFO("Isolation: %s", param->isolate_spec);
 }
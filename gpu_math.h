@@ -59,6 +59,8 @@ extern "C" {
 
 #define MATH_MIN(a, b) ((a) < (b) ? (a) : (b))
 #define MATH_MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MATH_CLAMP(v, min, max) MATH_MIN(MATH_MAX(v, min), max)
+#define MATH_ABS(a) ((a) < 0 ? -(a) : (a))
 
 /**********************
  *      TYPEDEFS
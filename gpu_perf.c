@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "gpu_perf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+const char* gpu_perf_event_string(enum gpu_perf_event_e event)
+{
+    switch (event) {
+    case GPU_PERF_EVENT_CYCLES:
+        return "Cycles";
+    case GPU_PERF_EVENT_INSTRUCTIONS:
+        return "Instructions";
+    case GPU_PERF_EVENT_CACHE_MISSES:
+        return "Cache Misses";
+    case GPU_PERF_EVENT_BRANCH_MISSES:
+        return "Branch Misses";
+    case GPU_PERF_EVENT_PAGE_FAULTS:
+        return "Page Faults";
+    case GPU_PERF_EVENT_CONTEXT_SWITCHES:
+        return "Context Switches";
+    default:
+        break;
+    }
+
+    return "UNKNOWN";
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
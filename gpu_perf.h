@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GPU_PERF_H
+#define GPU_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_perf_s;
+
+enum gpu_perf_event_e {
+    GPU_PERF_EVENT_CYCLES,
+    GPU_PERF_EVENT_INSTRUCTIONS,
+    GPU_PERF_EVENT_CACHE_MISSES,
+    GPU_PERF_EVENT_BRANCH_MISSES,
+    GPU_PERF_EVENT_PAGE_FAULTS,
+    GPU_PERF_EVENT_CONTEXT_SWITCHES,
+    _GPU_PERF_EVENT_LAST
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Open the performance counters of the calling thread.
+ * @return The performance counters, NULL if no counter is available.
+ */
+struct gpu_perf_s* gpu_perf_create(void);
+
+/**
+ * @brief Close the performance counters.
+ * @param perf The performance counters.
+ */
+void gpu_perf_delete(struct gpu_perf_s* perf);
+
+/**
+ * @brief Check if a counter is available.
+ * @param perf The performance counters.
+ * @param event The counter event.
+ * @return True if the counter is available.
+ */
+bool gpu_perf_is_supported(const struct gpu_perf_s* perf, enum gpu_perf_event_e event);
+
+/**
+ * @brief Reset and start counting.
+ * @param perf The performance counters.
+ */
+void gpu_perf_start(struct gpu_perf_s* perf);
+
+/**
+ * @brief Stop counting and read the counts since gpu_perf_start.
+ * @param perf The performance counters.
+ * @param values The counts of each event, the unavailable counters are 0.
+ */
+void gpu_perf_stop(struct gpu_perf_s* perf, uint64_t values[_GPU_PERF_EVENT_LAST]);
+
+/**
+ * @brief Get the name of a counter event.
+ * @param event The counter event.
+ * @return The name of the event.
+ */
+const char* gpu_perf_event_string(enum gpu_perf_event_e event);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*GPU_PERF_H*/
@@ -0,0 +1,186 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#ifndef GPU_TEST_CONTEXT_LINUX_DISABLE
+
+#include "gpu_assert.h"
+#include "gpu_log.h"
+#include "gpu_perf.h"
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_perf_s {
+    int fd[_GPU_PERF_EVENT_LAST];
+};
+
+struct gpu_perf_event_attr_s {
+    uint32_t type;
+    uint64_t config;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static int perf_event_open(const struct gpu_perf_event_attr_s* event);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const struct gpu_perf_event_attr_s g_events[_GPU_PERF_EVENT_LAST] = {
+    [GPU_PERF_EVENT_CYCLES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    [GPU_PERF_EVENT_INSTRUCTIONS] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    [GPU_PERF_EVENT_CACHE_MISSES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    [GPU_PERF_EVENT_BRANCH_MISSES] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    [GPU_PERF_EVENT_PAGE_FAULTS] = { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+    [GPU_PERF_EVENT_CONTEXT_SWITCHES] = { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct gpu_perf_s* gpu_perf_create(void)
+{
+    struct gpu_perf_s* perf = malloc(sizeof(struct gpu_perf_s));
+    GPU_ASSERT_NULL(perf);
+
+    int opened = 0;
+    for (int i = 0; i < _GPU_PERF_EVENT_LAST; i++) {
+        perf->fd[i] = perf_event_open(&g_events[i]);
+        if (perf->fd[i] < 0) {
+            GPU_LOG_WARN("Perf event '%s' not available: %s", gpu_perf_event_string(i), strerror(errno));
+            continue;
+        }
+
+        opened++;
+    }
+
+    if (opened == 0) {
+        GPU_LOG_ERROR("No perf event available, check /proc/sys/kernel/perf_event_paranoid");
+        free(perf);
+        return NULL;
+    }
+
+    return perf;
+}
+
+void gpu_perf_delete(struct gpu_perf_s* perf)
+{
+    GPU_ASSERT_NULL(perf);
+
+    for (int i = 0; i < _GPU_PERF_EVENT_LAST; i++) {
+        if (perf->fd[i] >= 0) {
+            close(perf->fd[i]);
+        }
+    }
+
+    free(perf);
+}
+
+bool gpu_perf_is_supported(const struct gpu_perf_s* perf, enum gpu_perf_event_e event)
+{
+    GPU_ASSERT_NULL(perf);
+    return perf->fd[event] >= 0;
+}
+
+void gpu_perf_start(struct gpu_perf_s* perf)
+{
+    GPU_ASSERT_NULL(perf);
+
+    for (int i = 0; i < _GPU_PERF_EVENT_LAST; i++) {
+        if (perf->fd[i] >= 0) {
+            ioctl(perf->fd[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(perf->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void gpu_perf_stop(struct gpu_perf_s* perf, uint64_t values[_GPU_PERF_EVENT_LAST])
+{
+    GPU_ASSERT_NULL(perf);
+
+    for (int i = 0; i < _GPU_PERF_EVENT_LAST; i++) {
+        values[i] = 0;
+
+        if (perf->fd[i] < 0) {
+            continue;
+        }
+
+        ioctl(perf->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+
+        uint64_t value;
+        if (read(perf->fd[i], &value, sizeof(value)) == sizeof(value)) {
+            values[i] = value;
+        }
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static int perf_event_open(const struct gpu_perf_event_attr_s* event)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = event->type;
+    attr.config = event->config;
+    attr.disabled = 1;
+    attr.exclude_hv = 1;
+
+    /* Count this thread on any CPU, including the time spent in the GPU driver */
+    int fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+    if (fd >= 0 || errno != EACCES) {
+        return fd;
+    }
+
+    /* A perf_event_paranoid of 2 or higher only allows counting the user space */
+    attr.exclude_kernel = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+#endif /* GPU_TEST_CONTEXT_LINUX_DISABLE */
@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#ifdef GPU_TEST_CONTEXT_NUTTX_ENABLE
+
+#include "gpu_assert.h"
+#include "gpu_log.h"
+#include "gpu_perf.h"
+#include <nuttx/arch.h>
+#include <stdlib.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_perf_s {
+    uint32_t start_cycles;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct gpu_perf_s* gpu_perf_create(void)
+{
+    struct gpu_perf_s* perf = malloc(sizeof(struct gpu_perf_s));
+    GPU_ASSERT_NULL(perf);
+    perf->start_cycles = 0;
+
+    /* up_perf only provides the cycle counter, it is already started by the context setup */
+    GPU_LOG_INFO("Perf events: only '%s' available", gpu_perf_event_string(GPU_PERF_EVENT_CYCLES));
+    return perf;
+}
+
+void gpu_perf_delete(struct gpu_perf_s* perf)
+{
+    GPU_ASSERT_NULL(perf);
+    free(perf);
+}
+
+bool gpu_perf_is_supported(const struct gpu_perf_s* perf, enum gpu_perf_event_e event)
+{
+    GPU_ASSERT_NULL(perf);
+    return event == GPU_PERF_EVENT_CYCLES;
+}
+
+void gpu_perf_start(struct gpu_perf_s* perf)
+{
+    GPU_ASSERT_NULL(perf);
+    perf->start_cycles = up_perf_gettime();
+}
+
+void gpu_perf_stop(struct gpu_perf_s* perf, uint64_t values[_GPU_PERF_EVENT_LAST])
+{
+    GPU_ASSERT_NULL(perf);
+
+    for (int i = 0; i < _GPU_PERF_EVENT_LAST; i++) {
+        values[i] = 0;
+    }
+
+    /* The unsigned subtraction handles one wrap of the 32-bit counter */
+    values[GPU_PERF_EVENT_CYCLES] = (uint32_t)(up_perf_gettime() - perf->start_cycles);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#endif /* GPU_TEST_CONTEXT_NUTTX_ENABLE */
@@ -28,6 +28,8 @@
 #include "gpu_recorder.h"
 #include "gpu_assert.h"
 #include "gpu_log.h"
+#include "gpu_tick.h"
+#include "gpu_timeline.h"
 #include "gpu_utils.h"
 #include <errno.h>
 #include <fcntl.h>
@@ -103,18 +105,21 @@ int gpu_recorder_write_string(struct gpu_recorder_s* recorder, const char* str)
     GPU_ASSERT_NULL(str);
     size_t len = strlen(str);
     size_t written = 0;
+    uint32_t start_tick = gpu_tick_get();
 
     while (written < len) {
         ssize_t ret = write(recorder->fd, str + written, len - written);
 
         if (ret < 0) {
             GPU_LOG_ERROR("write failed: %d", errno);
+            gpu_timeline_instant("recorder", "write failed", NULL);
             return -1;
         }
 
         written += ret;
     }
 
+    gpu_timeline_span("recorder", "write", NULL, start_tick);
     return 0;
 }
 
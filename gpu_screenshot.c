@@ -29,10 +29,23 @@
 #include "gpu_assert.h"
 #include "gpu_buffer.h"
 #include "gpu_cache.h"
+#include "gpu_color_convert.h"
 #include "gpu_log.h"
+#include "gpu_math.h"
+#include "gpu_tick.h"
+#include "gpu_timeline.h"
 #include <png.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <zlib.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Rows converted at once when the buffer format can not be written directly */
+#define SCREENSHOT_STRIP_ROWS 16
 
 /**********************
  *      TYPEDEFS
@@ -42,10 +55,45 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static int screenshot_write_png(
+    FILE* fp,
+    const struct gpu_buffer_s* buffer,
+    const struct gpu_screenshot_png_options_s* options,
+    size_t* encoded_size);
+static int screenshot_write_rows(
+    png_structp png,
+    png_infop info,
+    const struct gpu_buffer_s* buffer,
+    const struct gpu_screenshot_png_options_s* options,
+    gpu_color_format_t row_format,
+    int color_type,
+    uint8_t* strip);
+static void screenshot_set_png_options(png_structp png, const struct gpu_screenshot_png_options_s* options);
+static void screenshot_count_data(png_structp png, png_bytep data, png_size_t length);
+static void screenshot_count_flush(png_structp png);
+static enum gpu_screenshot_cmp_result_e screenshot_compare_rows(
+    FILE* fp,
+    const struct gpu_buffer_s* buffer,
+    struct gpu_screenshot_cmp_s* cmp,
+    uint32_t* golden_row,
+    uint32_t* target_row);
+static void screenshot_compare_row(
+    struct gpu_screenshot_cmp_s* cmp,
+    uint32_t y,
+    const uint32_t* target_row,
+    const uint32_t* golden_row,
+    uint32_t width);
+
 /**********************
  *  STATIC VARIABLES
  **********************/
 
+static struct gpu_screenshot_png_options_s g_png_options = {
+    .level = -1,
+    .filter = GPU_SCREENSHOT_PNG_FILTER_AUTO,
+    .strategy = GPU_SCREENSHOT_PNG_STRATEGY_DEFAULT,
+};
+
 /**********************
  *      MACROS
  **********************/
@@ -60,36 +108,29 @@ int gpu_screenshot_save(const char* path, const struct gpu_buffer_s* buffer)
     GPU_ASSERT_NULL(buffer);
 
     GPU_LOG_INFO("Taking screenshot of '%s' ...", path);
+    uint32_t start_tick = gpu_tick_get();
 
-    /* Construct the PNG image structure. */
-    png_image image;
-    memset(&image, 0, sizeof(image));
-
-    image.version = PNG_IMAGE_VERSION;
-    image.width = buffer->width;
-    image.height = buffer->height;
+    /* Invalidate the cache to ensure that the buffer data is up-to-date. */
+    gpu_cache_invalidate(buffer->data, buffer->stride * buffer->height);
 
-    switch (buffer->format) {
-    case GPU_COLOR_FORMAT_BGR888:
-        image.format = PNG_FORMAT_BGR;
-        break;
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        GPU_LOG_ERROR("Open %s failed", path);
+        return -1;
+    }
 
-    case GPU_COLOR_FORMAT_BGRA8888:
-    case GPU_COLOR_FORMAT_BGRX8888:
-        image.format = PNG_FORMAT_BGRA;
-        break;
+    int retval = screenshot_write_png(fp, buffer, &g_png_options, NULL);
 
-    default:
-        GPU_LOG_ERROR("Unsupported color format: %d", buffer->format);
-        return -1;
+    if (fclose(fp) != 0) {
+        retval = -1;
     }
 
-    /* Invalidate the cache to ensure that the buffer data is up-to-date. */
-    gpu_cache_invalidate(buffer->data, buffer->stride * buffer->height);
+    gpu_timeline_span("screenshot", "save", NULL, start_tick);
 
-    /* Write the PNG image. */
-    if (!png_image_write_to_file(&image, path, 0, buffer->data, buffer->stride, NULL)) {
+    if (retval < 0) {
         GPU_LOG_ERROR("Failed");
+        gpu_timeline_instant("screenshot", "save failed", NULL);
+        remove(path);
         return -1;
     }
 
@@ -97,8 +138,33 @@ int gpu_screenshot_save(const char* path, const struct gpu_buffer_s* buffer)
     return 0;
 }
 
+void gpu_screenshot_set_png_options(const struct gpu_screenshot_png_options_s* options)
+{
+    if (!options) {
+        g_png_options.level = -1;
+        g_png_options.filter = GPU_SCREENSHOT_PNG_FILTER_AUTO;
+        g_png_options.strategy = GPU_SCREENSHOT_PNG_STRATEGY_DEFAULT;
+        return;
+    }
+
+    g_png_options = *options;
+}
+
+int gpu_screenshot_encode_size(
+    const struct gpu_buffer_s* buffer,
+    const struct gpu_screenshot_png_options_s* options,
+    size_t* encoded_size)
+{
+    GPU_ASSERT_NULL(buffer);
+    GPU_ASSERT_NULL(encoded_size);
+
+    *encoded_size = 0;
+    return screenshot_write_png(NULL, buffer, options ? options : &g_png_options, encoded_size);
+}
+
 struct gpu_buffer_s* gpu_screenshot_load(const char* path)
 {
+    uint32_t start_tick = gpu_tick_get();
     png_image image;
     memset(&image, 0, sizeof(image));
     image.version = PNG_IMAGE_VERSION;
@@ -119,9 +185,329 @@ struct gpu_buffer_s* gpu_screenshot_load(const char* path)
     }
 
     png_image_free(&image);
+    gpu_timeline_span("screenshot", "load", NULL, start_tick);
     return buffer;
 }
 
+enum gpu_screenshot_cmp_result_e gpu_screenshot_compare(
+    const char* path,
+    const struct gpu_buffer_s* buffer,
+    struct gpu_screenshot_cmp_s* cmp)
+{
+    GPU_ASSERT_NULL(path);
+    GPU_ASSERT_NULL(buffer);
+    GPU_ASSERT_NULL(cmp);
+
+    cmp->golden_width = 0;
+    cmp->golden_height = 0;
+    cmp->compared_rows = 0;
+    cmp->mismatch_count = 0;
+    cmp->max_diff = 0;
+    cmp->first_x = -1;
+    cmp->first_y = -1;
+    cmp->first_pixel = 0;
+    cmp->first_golden_pixel = 0;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return GPU_SCREENSHOT_CMP_NOT_FOUND;
+    }
+
+    /* One decoded golden row and one converted target row */
+    uint32_t* rows = malloc(buffer->width * sizeof(uint32_t) * 2);
+    if (!rows) {
+        GPU_LOG_ERROR("Malloc compare rows failed");
+        fclose(fp);
+        return GPU_SCREENSHOT_CMP_ERROR;
+    }
+
+    /* Invalidate the cache to ensure that the buffer data is up-to-date. */
+    gpu_cache_invalidate(buffer->data, buffer->stride * buffer->height);
+
+    uint32_t start_tick = gpu_tick_get();
+    enum gpu_screenshot_cmp_result_e result = screenshot_compare_rows(fp, buffer, cmp, rows, rows + buffer->width);
+    gpu_timeline_span("screenshot", "compare", NULL, start_tick);
+
+    free(rows);
+    fclose(fp);
+    return result;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+static enum gpu_screenshot_cmp_result_e screenshot_compare_rows(
+    FILE* fp,
+    const struct gpu_buffer_s* buffer,
+    struct gpu_screenshot_cmp_s* cmp,
+    uint32_t* golden_row,
+    uint32_t* target_row)
+{
+    png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if (!png) {
+        return GPU_SCREENSHOT_CMP_ERROR;
+    }
+
+    png_infop info = png_create_info_struct(png);
+    if (!info) {
+        png_destroy_read_struct(&png, NULL, NULL);
+        return GPU_SCREENSHOT_CMP_ERROR;
+    }
+
+    /* libpng jumps back here on any error */
+    if (setjmp(png_jmpbuf(png))) {
+        png_destroy_read_struct(&png, &info, NULL);
+        return GPU_SCREENSHOT_CMP_ERROR;
+    }
+
+    png_init_io(png, fp);
+    png_read_info(png, info);
+
+    cmp->golden_width = png_get_image_width(png, info);
+    cmp->golden_height = png_get_image_height(png, info);
+
+    if (cmp->golden_width != buffer->width || cmp->golden_height != buffer->height) {
+        png_destroy_read_struct(&png, &info, NULL);
+        return GPU_SCREENSHOT_CMP_SIZE_MISMATCH;
+    }
+
+    if (png_get_interlace_type(png, info) != PNG_INTERLACE_NONE) {
+        /* The rows of an interlaced image are only complete after the last pass */
+        GPU_LOG_ERROR("Interlaced image is not supported");
+        png_destroy_read_struct(&png, &info, NULL);
+        return GPU_SCREENSHOT_CMP_ERROR;
+    }
+
+    /* Decode any PNG color type to BGRA8888 */
+    png_set_expand(png);
+    png_set_strip_16(png);
+    png_set_gray_to_rgb(png);
+    png_set_filler(png, 0xFF, PNG_FILLER_AFTER);
+    png_set_bgr(png);
+    png_read_update_info(png, info);
+
+    enum gpu_screenshot_cmp_result_e result = GPU_SCREENSHOT_CMP_MATCH;
+    const uint8_t* src_row = buffer->data;
+
+    for (uint32_t y = 0; y < buffer->height; y++) {
+        png_read_row(png, (png_bytep)golden_row, NULL);
+        gpu_color_convert_row(GPU_COLOR_FORMAT_BGRA8888, target_row, buffer->format, src_row, buffer->width, NULL);
+        src_row += buffer->stride;
+
+        screenshot_compare_row(cmp, y, target_row, golden_row, buffer->width);
+        cmp->compared_rows++;
+
+        if (cmp->mismatch_count > cmp->max_mismatch) {
+            result = GPU_SCREENSHOT_CMP_MISMATCH;
+            if (!cmp->full_metrics) {
+                break;
+            }
+        }
+    }
+
+    /* The rest of the image is not needed after an early exit */
+    png_destroy_read_struct(&png, &info, NULL);
+    return result;
+}
+
+static void screenshot_compare_row(
+    struct gpu_screenshot_cmp_s* cmp,
+    uint32_t y,
+    const uint32_t* target_row,
+    const uint32_t* golden_row,
+    uint32_t width)
+{
+    for (uint32_t x = 0; x < width; x++) {
+        uint32_t pixel = target_row[x];
+        uint32_t golden_pixel = golden_row[x];
+
+        /* Skip checking alpha channel */
+        if (((pixel ^ golden_pixel) & 0x00FFFFFF) == 0) {
+            continue;
+        }
+
+        uint32_t diff = 0;
+        for (int shift = 0; shift < 24; shift += 8) {
+            int ch_diff = (int)((pixel >> shift) & 0xFF) - (int)((golden_pixel >> shift) & 0xFF);
+            diff = MATH_MAX(diff, (uint32_t)MATH_ABS(ch_diff));
+        }
+
+        cmp->max_diff = MATH_MAX(cmp->max_diff, diff);
+        if (diff <= cmp->tolerance) {
+            continue;
+        }
+
+        if (cmp->mismatch_count == 0) {
+            cmp->first_x = x;
+            cmp->first_y = y;
+            cmp->first_pixel = pixel;
+            cmp->first_golden_pixel = golden_pixel;
+        }
+
+        cmp->mismatch_count++;
+    }
+}
+
+static int screenshot_write_png(
+    FILE* fp,
+    const struct gpu_buffer_s* buffer,
+    const struct gpu_screenshot_png_options_s* options,
+    size_t* encoded_size)
+{
+    /* The PNG keeps the alpha channel only if the buffer has one */
+    gpu_color_format_t row_format;
+    int color_type;
+
+    switch (buffer->format) {
+    case GPU_COLOR_FORMAT_BGR565:
+    case GPU_COLOR_FORMAT_BGR888:
+        row_format = GPU_COLOR_FORMAT_BGR888;
+        color_type = PNG_COLOR_TYPE_RGB;
+        break;
+
+    case GPU_COLOR_FORMAT_BGRA8888:
+    case GPU_COLOR_FORMAT_BGRX8888:
+    case GPU_COLOR_FORMAT_BGRA5658:
+        row_format = GPU_COLOR_FORMAT_BGRA8888;
+        color_type = PNG_COLOR_TYPE_RGB_ALPHA;
+        break;
+
+    default:
+        GPU_LOG_ERROR("Unsupported color format: %d", buffer->format);
+        return -1;
+    }
+
+    /* Matching rows are written in place, the others are converted a strip at a time */
+    uint8_t* strip = NULL;
+    if (buffer->format != row_format) {
+        strip = malloc(SCREENSHOT_STRIP_ROWS * buffer->width * gpu_color_format_get_bpp(row_format) / 8);
+        if (!strip) {
+            GPU_LOG_ERROR("Malloc strip failed");
+            return -1;
+        }
+    }
+
+    png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if (!png) {
+        free(strip);
+        return -1;
+    }
+
+    png_infop info = png_create_info_struct(png);
+    if (!info) {
+        png_destroy_write_struct(&png, NULL);
+        free(strip);
+        return -1;
+    }
+
+    if (fp) {
+        png_init_io(png, fp);
+    } else {
+        /* Only count the encoded bytes */
+        png_set_write_fn(png, encoded_size, screenshot_count_data, screenshot_count_flush);
+    }
+
+    int retval = screenshot_write_rows(png, info, buffer, options, row_format, color_type, strip);
+
+    png_destroy_write_struct(&png, &info);
+    free(strip);
+    return retval;
+}
+
+static int screenshot_write_rows(
+    png_structp png,
+    png_infop info,
+    const struct gpu_buffer_s* buffer,
+    const struct gpu_screenshot_png_options_s* options,
+    gpu_color_format_t row_format,
+    int color_type,
+    uint8_t* strip)
+{
+    /* libpng jumps back here on any error */
+    if (setjmp(png_jmpbuf(png))) {
+        return -1;
+    }
+
+    screenshot_set_png_options(png, options);
+
+    png_set_IHDR(png, info, buffer->width, buffer->height, 8, color_type,
+        PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png, info);
+
+    /* The rows are stored as BGR(A) */
+    png_set_bgr(png);
+
+    const uint32_t strip_stride = buffer->width * gpu_color_format_get_bpp(row_format) / 8;
+    const uint8_t* src_row = buffer->data;
+
+    for (uint32_t y = 0; y < buffer->height; y += SCREENSHOT_STRIP_ROWS) {
+        uint32_t rows = MATH_MIN(SCREENSHOT_STRIP_ROWS, buffer->height - y);
+
+        if (!strip) {
+            for (uint32_t i = 0; i < rows; i++) {
+                png_write_row(png, src_row);
+                src_row += buffer->stride;
+            }
+
+            continue;
+        }
+
+        for (uint32_t i = 0; i < rows; i++) {
+            gpu_color_convert_row(row_format, strip + i * strip_stride, buffer->format, src_row, buffer->width, NULL);
+            src_row += buffer->stride;
+        }
+
+        for (uint32_t i = 0; i < rows; i++) {
+            png_write_row(png, strip + i * strip_stride);
+        }
+    }
+
+    png_write_end(png, NULL);
+    return 0;
+}
+
+static void screenshot_set_png_options(png_structp png, const struct gpu_screenshot_png_options_s* options)
+{
+    if (options->level >= 0) {
+        png_set_compression_level(png, MATH_MIN(options->level, Z_BEST_COMPRESSION));
+    }
+
+    static const int filters[] = {
+        [GPU_SCREENSHOT_PNG_FILTER_AUTO] = PNG_ALL_FILTERS,
+        [GPU_SCREENSHOT_PNG_FILTER_NONE] = PNG_FILTER_NONE,
+        [GPU_SCREENSHOT_PNG_FILTER_SUB] = PNG_FILTER_SUB,
+        [GPU_SCREENSHOT_PNG_FILTER_UP] = PNG_FILTER_UP,
+        [GPU_SCREENSHOT_PNG_FILTER_AVG] = PNG_FILTER_AVG,
+        [GPU_SCREENSHOT_PNG_FILTER_PAETH] = PNG_FILTER_PAETH,
+    };
+
+    if (options->filter != GPU_SCREENSHOT_PNG_FILTER_AUTO) {
+        png_set_filter(png, PNG_FILTER_TYPE_BASE, filters[options->filter]);
+    }
+
+    static const int strategies[] = {
+        [GPU_SCREENSHOT_PNG_STRATEGY_DEFAULT] = Z_DEFAULT_STRATEGY,
+        [GPU_SCREENSHOT_PNG_STRATEGY_FILTERED] = Z_FILTERED,
+        [GPU_SCREENSHOT_PNG_STRATEGY_HUFFMAN] = Z_HUFFMAN_ONLY,
+        [GPU_SCREENSHOT_PNG_STRATEGY_RLE] = Z_RLE,
+        [GPU_SCREENSHOT_PNG_STRATEGY_FIXED] = Z_FIXED,
+    };
+
+    /* libpng picks Z_FILTERED for filtered rows, keep it unless asked otherwise */
+    if (options->strategy != GPU_SCREENSHOT_PNG_STRATEGY_DEFAULT) {
+        png_set_compression_strategy(png, strategies[options->strategy]);
+    }
+}
+
+static void screenshot_count_data(png_structp png, png_bytep data, png_size_t length)
+{
+    (void)data;
+    size_t* encoded_size = png_get_io_ptr(png);
+    *encoded_size += length;
+}
+
+static void screenshot_count_flush(png_structp png)
+{
+    (void)png;
+}
@@ -32,6 +32,10 @@ extern "C" {
  *      INCLUDES
  *********************/
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
 /*********************
  *      DEFINES
  *********************/
@@ -42,6 +46,60 @@ extern "C" {
 
 struct gpu_buffer_s;
 
+enum gpu_screenshot_png_filter_e {
+    GPU_SCREENSHOT_PNG_FILTER_AUTO, /* Adaptive choice between all filters, the libpng default */
+    GPU_SCREENSHOT_PNG_FILTER_NONE,
+    GPU_SCREENSHOT_PNG_FILTER_SUB,
+    GPU_SCREENSHOT_PNG_FILTER_UP,
+    GPU_SCREENSHOT_PNG_FILTER_AVG,
+    GPU_SCREENSHOT_PNG_FILTER_PAETH,
+};
+
+enum gpu_screenshot_png_strategy_e {
+    GPU_SCREENSHOT_PNG_STRATEGY_DEFAULT, /* Keep the libpng choice */
+    GPU_SCREENSHOT_PNG_STRATEGY_FILTERED,
+    GPU_SCREENSHOT_PNG_STRATEGY_HUFFMAN,
+    GPU_SCREENSHOT_PNG_STRATEGY_RLE,
+    GPU_SCREENSHOT_PNG_STRATEGY_FIXED,
+};
+
+struct gpu_screenshot_png_options_s {
+    /* zlib compression level 0 - 9, negative keeps the zlib default */
+    int level;
+    enum gpu_screenshot_png_filter_e filter;
+    enum gpu_screenshot_png_strategy_e strategy;
+};
+
+enum gpu_screenshot_cmp_result_e {
+    GPU_SCREENSHOT_CMP_MATCH,
+    GPU_SCREENSHOT_CMP_MISMATCH,
+    GPU_SCREENSHOT_CMP_SIZE_MISMATCH,
+    GPU_SCREENSHOT_CMP_NOT_FOUND,
+    GPU_SCREENSHOT_CMP_ERROR,
+};
+
+struct gpu_screenshot_cmp_s {
+    /* Max difference of the red, green and blue channels of a matching pixel, alpha is not checked */
+    uint32_t tolerance;
+
+    /* Mismatched pixels allowed before the result is a mismatch */
+    uint32_t max_mismatch;
+
+    /* Keep comparing after the result is known to count all mismatched pixels */
+    bool full_metrics;
+
+    /* Results */
+    uint32_t golden_width;
+    uint32_t golden_height;
+    uint32_t compared_rows;
+    uint32_t mismatch_count;
+    uint32_t max_diff;
+    int32_t first_x;
+    int32_t first_y;
+    uint32_t first_pixel;
+    uint32_t first_golden_pixel;
+};
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -50,6 +108,7 @@ struct gpu_buffer_s;
  * @brief Take a screenshot of the given buffer and save it to the given directory with the given name.
  * @param name The name of the screenshot file.
  * @param buffer The buffer to take the screenshot of.
+ *        BGR565, BGR888, BGRA8888, BGRX8888 and BGRA5658 are supported, the rows are converted in strips.
  * @return 0 on success, -1 on failure.
  */
 int gpu_screenshot_save(const char* path, const struct gpu_buffer_s* buffer);
@@ -61,6 +120,36 @@ int gpu_screenshot_save(const char* path, const struct gpu_buffer_s* buffer);
  */
 struct gpu_buffer_s* gpu_screenshot_load(const char* path);
 
+/**
+ * @brief Set the PNG encoder options used by gpu_screenshot_save.
+ * @param options The encoder options, NULL restores the defaults.
+ */
+void gpu_screenshot_set_png_options(const struct gpu_screenshot_png_options_s* options);
+
+/**
+ * @brief Encode a buffer to PNG in memory without storing the result, for measuring the encoder.
+ * @param buffer The buffer to encode.
+ * @param options The encoder options, NULL uses the options of gpu_screenshot_save.
+ * @param encoded_size The size of the encoded PNG.
+ * @return 0 on success, -1 on failure.
+ */
+int gpu_screenshot_encode_size(
+    const struct gpu_buffer_s* buffer,
+    const struct gpu_screenshot_png_options_s* options,
+    size_t* encoded_size);
+
+/**
+ * @brief Compare a buffer with a PNG file, decoding and comparing one row at a time.
+ * @param path The path of the PNG file.
+ * @param buffer The buffer to compare, any format supported by gpu_color_convert.
+ * @param cmp The compare settings, the results are written back.
+ * @return The compare result. Without full_metrics it stops at the first row that exceeds max_mismatch.
+ */
+enum gpu_screenshot_cmp_result_e gpu_screenshot_compare(
+    const char* path,
+    const struct gpu_buffer_s* buffer,
+    struct gpu_screenshot_cmp_s* cmp);
+
 /**********************
  *      MACROS
  **********************/
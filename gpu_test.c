@@ -26,18 +26,40 @@
  *********************/
 
 #include "gpu_test.h"
+#include "gpu_cache.h"
+#include "gpu_color_convert.h"
 #include "gpu_context.h"
+#include "gpu_log.h"
 #include "gpu_recorder.h"
+#include "gpu_screenshot.h"
 #include "gpu_tick.h"
+#include "gpu_timeline.h"
 #include "gpu_utils.h"
 #include "vg_lite/vg_lite_test.h"
+#include "vg_lite/vg_lite_test_contention.h"
+#include "vg_lite/vg_lite_test_crossover.h"
+#include "vg_lite/vg_lite_test_latency.h"
+#include "vg_lite/vg_lite_test_trace.h"
+#include "vg_lite/vg_lite_test_utils.h"
+#include <dirent.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
 
+/* Minimum measuring time of each color conversion pair */
+#define COLOR_CONVERT_BENCHMARK_TIME_MS 200
+
+/* Minimum measuring time of each PNG encoder setting */
+#define PNG_ENCODE_BENCHMARK_TIME_MS 200
+
+/* Images encoded by the PNG benchmark at most */
+#define PNG_ENCODE_BENCHMARK_MAX_IMAGES 64
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -46,6 +68,14 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static int gpu_test_run_mode(struct gpu_test_context_s* ctx);
+static int gpu_test_run_replay(struct gpu_test_context_s* ctx);
+static int gpu_test_run_color_convert(struct gpu_test_context_s* ctx);
+static int gpu_test_run_png_encode(struct gpu_test_context_s* ctx);
+static int gpu_test_run_crossover(struct gpu_test_context_s* ctx);
+static int gpu_test_run_contention(struct gpu_test_context_s* ctx);
+static int gpu_test_load_png_images(struct gpu_test_context_s* ctx, struct gpu_buffer_s** images, int max_count);
+static struct gpu_buffer_s* gpu_test_create_ui_image(uint32_t width, uint32_t height);
 static void gpu_test_write_header(struct gpu_test_context_s* ctx);
 
 /**********************
@@ -62,6 +92,49 @@ static void gpu_test_write_header(struct gpu_test_context_s* ctx);
 
 int gpu_test_run(struct gpu_test_context_s* ctx)
 {
+    gpu_screenshot_set_png_options(&ctx->param.png_options);
+
+    if (ctx->param.timeline_path) {
+        gpu_timeline_start(ctx->param.timeline_path, GPU_TIMELINE_CAPACITY_DEFAULT);
+    }
+
+    gpu_cache_set_deferred(ctx->param.cache_defer_en);
+    gpu_buffer_set_prefault(ctx->isolate.prefault);
+
+    int ret = gpu_test_run_mode(ctx);
+
+    gpu_buffer_set_prefault(false);
+    gpu_cache_set_deferred(false);
+    gpu_timeline_stop();
+    return ret;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static int gpu_test_run_mode(struct gpu_test_context_s* ctx)
+{
+    if (ctx->param.replay_path) {
+        return gpu_test_run_replay(ctx);
+    }
+
+    if (ctx->param.mode == GPU_TEST_MODE_COLOR_CONVERT) {
+        return gpu_test_run_color_convert(ctx);
+    }
+
+    if (ctx->param.mode == GPU_TEST_MODE_PNG_ENCODE) {
+        return gpu_test_run_png_encode(ctx);
+    }
+
+    if (ctx->param.mode == GPU_TEST_MODE_CROSSOVER) {
+        return gpu_test_run_crossover(ctx);
+    }
+
+    if (ctx->param.mode == GPU_TEST_MODE_CONTENTION) {
+        return gpu_test_run_contention(ctx);
+    }
+
     switch (ctx->param.mode) {
     case GPU_TEST_MODE_DEFAULT:
         ctx->recorder = gpu_recorder_create(ctx->param.output_dir, "vg_lite");
@@ -77,8 +150,17 @@ int gpu_test_run(struct gpu_test_context_s* ctx)
         break;
     }
 
+    if (ctx->param.trace_path) {
+        vg_lite_test_trace_start(ctx->param.trace_path);
+    }
+
+    vg_lite_test_latency_start(ctx->param.output_dir);
+
     int ret = vg_lite_test_run(ctx);
 
+    vg_lite_test_latency_stop();
+    vg_lite_test_trace_stop();
+
     if (ctx->recorder) {
         gpu_recorder_delete(ctx->recorder);
     }
@@ -86,9 +168,235 @@ int gpu_test_run(struct gpu_test_context_s* ctx)
     return ret;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+static int gpu_test_run_replay(struct gpu_test_context_s* ctx)
+{
+    ctx->recorder = gpu_recorder_create(ctx->param.output_dir, "replay");
+    gpu_test_write_header(ctx);
+
+    int ret = vg_lite_test_trace_replay(ctx, ctx->param.replay_path);
+
+    if (ctx->recorder) {
+        gpu_recorder_delete(ctx->recorder);
+        ctx->recorder = NULL;
+    }
+
+    return ret;
+}
+
+static int gpu_test_run_crossover(struct gpu_test_context_s* ctx)
+{
+    ctx->recorder = gpu_recorder_create(ctx->param.output_dir, "crossover");
+    gpu_test_write_header(ctx);
+
+    int ret = vg_lite_test_crossover_run(ctx);
+
+    if (ctx->recorder) {
+        gpu_recorder_delete(ctx->recorder);
+        ctx->recorder = NULL;
+    }
+
+    return ret;
+}
+
+static int gpu_test_run_contention(struct gpu_test_context_s* ctx)
+{
+    ctx->recorder = gpu_recorder_create(ctx->param.output_dir, "contention");
+    gpu_test_write_header(ctx);
+
+    int ret = vg_lite_test_contention_run(ctx);
+
+    if (ctx->recorder) {
+        gpu_recorder_delete(ctx->recorder);
+        ctx->recorder = NULL;
+    }
+
+    return ret;
+}
+
+static int gpu_test_run_color_convert(struct gpu_test_context_s* ctx)
+{
+    ctx->recorder = gpu_recorder_create(ctx->param.output_dir, "color_convert");
+    gpu_test_write_header(ctx);
+
+    if (ctx->recorder) {
+        gpu_recorder_write_string(ctx->recorder,
+            "Source Format,Target Format,Image Size,SIMD,Throughput(GB/s),Pixel Rate(MPix/s)\n");
+    }
+
+    const uint32_t width = ctx->param.target_width;
+    const uint32_t height = ctx->param.target_height;
+
+    for (int src = GPU_COLOR_FORMAT_BGR565; src <= GPU_COLOR_FORMAT_INDEX8; src++) {
+        for (int dest = GPU_COLOR_FORMAT_BGR565; dest <= GPU_COLOR_FORMAT_INDEX8; dest++) {
+            if (!gpu_color_convert_is_supported(dest, src)) {
+                continue;
+            }
+
+            double gbps = gpu_color_convert_benchmark(dest, src, width, height, COLOR_CONVERT_BENCHMARK_TIME_MS);
+            uint32_t pixel_bytes = (gpu_color_format_get_bpp(src) + gpu_color_format_get_bpp(dest)) / 8;
+            double mpix = gbps * 1000.0 / pixel_bytes;
+
+            GPU_LOG_INFO("Convert %s -> %s: %0.3f GB/s, %0.1f MPix/s",
+                gpu_color_format_string(src), gpu_color_format_string(dest), gbps, mpix);
+
+            if (ctx->recorder) {
+                char result[128];
+                snprintf(result, sizeof(result), "%s,%s,%" PRIu32 "x%" PRIu32 ",%s,%0.3f,%0.1f\n",
+                    gpu_color_format_string(src), gpu_color_format_string(dest),
+                    width, height, gpu_color_convert_simd_name(), gbps, mpix);
+                gpu_recorder_write_string(ctx->recorder, result);
+            }
+        }
+    }
+
+    if (ctx->recorder) {
+        gpu_recorder_delete(ctx->recorder);
+        ctx->recorder = NULL;
+    }
+
+    return 0;
+}
+
+static int gpu_test_run_png_encode(struct gpu_test_context_s* ctx)
+{
+    /* The existing golden images are the real workload, a synthetic UI image stands in without them */
+    struct gpu_buffer_s* images[PNG_ENCODE_BENCHMARK_MAX_IMAGES];
+    int image_count = gpu_test_load_png_images(ctx, images, PNG_ENCODE_BENCHMARK_MAX_IMAGES);
+    if (image_count == 0) {
+        GPU_LOG_INFO("No golden image found, use a synthetic image");
+        images[image_count++] = gpu_test_create_ui_image(ctx->param.target_width, ctx->param.target_height);
+    }
+
+    uint64_t raw_size = 0;
+    for (int i = 0; i < image_count; i++) {
+        raw_size += (uint64_t)images[i]->stride * images[i]->height;
+    }
+
+    ctx->recorder = gpu_recorder_create(ctx->param.output_dir, "png_encode");
+    gpu_test_write_header(ctx);
+
+    if (ctx->recorder) {
+        gpu_recorder_write_string(ctx->recorder,
+            "Strategy,Filter,Level,Images,Raw Size(bytes),Encoded Size(bytes),Ratio(%),Throughput(MB/s)\n");
+    }
+
+    static const char* const strategy_names[] = { "default", "filtered", "huffman", "rle", "fixed" };
+    static const char* const filter_names[] = { "auto", "none", "sub", "up", "avg", "paeth" };
+
+    struct gpu_screenshot_png_options_s options = ctx->param.png_options;
+    int retval = 0;
+
+    for (int strategy = GPU_SCREENSHOT_PNG_STRATEGY_DEFAULT; strategy <= GPU_SCREENSHOT_PNG_STRATEGY_FIXED; strategy++) {
+        for (int level = 0; level <= 9; level++) {
+            options.strategy = (enum gpu_screenshot_png_strategy_e)strategy;
+            options.level = level;
+
+            uint64_t encoded_size = 0;
+            uint32_t passes = 0;
+            uint32_t start = gpu_tick_get();
+            uint32_t elaps;
+
+            /* Encode all images at least once, repeat to get a stable result */
+            do {
+                for (int i = 0; i < image_count; i++) {
+                    size_t size;
+                    if (gpu_screenshot_encode_size(images[i], &options, &size) < 0) {
+                        retval = -1;
+                        goto failed;
+                    }
+
+                    if (passes == 0) {
+                        encoded_size += size;
+                    }
+                }
+
+                passes++;
+                elaps = gpu_tick_elaps(start);
+            } while (elaps < PNG_ENCODE_BENCHMARK_TIME_MS * 1000);
+
+            double mbps = (double)raw_size * passes / elaps;
+            double ratio = raw_size ? (double)encoded_size * 100 / raw_size : 0;
+
+            GPU_LOG_INFO("PNG strategy %s filter %s level %d: %" PRIu64 " -> %" PRIu64 " bytes (%0.1f%%), %0.2f MB/s",
+                strategy_names[strategy], filter_names[options.filter], level, raw_size, encoded_size, ratio, mbps);
+
+            if (ctx->recorder) {
+                char result[192];
+                snprintf(result, sizeof(result), "%s,%s,%d,%d,%" PRIu64 ",%" PRIu64 ",%0.1f,%0.2f\n",
+                    strategy_names[strategy], filter_names[options.filter], level, image_count,
+                    raw_size, encoded_size, ratio, mbps);
+                gpu_recorder_write_string(ctx->recorder, result);
+            }
+        }
+    }
+
+failed:
+    if (ctx->recorder) {
+        gpu_recorder_delete(ctx->recorder);
+        ctx->recorder = NULL;
+    }
+
+    for (int i = 0; i < image_count; i++) {
+        gpu_buffer_free(images[i]);
+    }
+
+    return retval;
+}
+
+static int gpu_test_load_png_images(struct gpu_test_context_s* ctx, struct gpu_buffer_s** images, int max_count)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/ref_images", ctx->param.output_dir);
+
+    DIR* dir = opendir(path);
+    if (!dir) {
+        return 0;
+    }
+
+    int count = 0;
+    struct dirent* entry;
+
+    while (count < max_count && (entry = readdir(dir))) {
+        size_t len = strlen(entry->d_name);
+        if (len < 4 || strcmp(entry->d_name + len - 4, ".png") != 0) {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%s/ref_images/%s", ctx->param.output_dir, entry->d_name);
+        struct gpu_buffer_s* image = gpu_screenshot_load(path);
+        if (image) {
+            images[count++] = image;
+        }
+    }
+
+    closedir(dir);
+    GPU_LOG_INFO("Loaded %d golden images", count);
+    return count;
+}
+
+static struct gpu_buffer_s* gpu_test_create_ui_image(uint32_t width, uint32_t height)
+{
+    struct gpu_buffer_s* buffer = gpu_buffer_alloc(width, height, GPU_COLOR_FORMAT_BGRA8888, width * sizeof(uint32_t), 8);
+
+    /* Flat background and widgets with a gradient bar, like the test case screenshots */
+    for (uint32_t y = 0; y < height; y++) {
+        uint32_t* row = (uint32_t*)((uint8_t*)buffer->data + y * buffer->stride);
+        for (uint32_t x = 0; x < width; x++) {
+            uint32_t color = 0xFFF0F0F0;
+
+            if ((x / 64 + y / 64) % 3 == 0 && x % 64 > 8 && y % 64 > 8) {
+                color = 0xFF2196F3;
+            } else if (y > height / 2 && y < height / 2 + 32) {
+                uint32_t level = x * 255 / width;
+                color = 0xFF000000 | (level << 16) | ((255 - level) << 8) | 0x40;
+            }
+
+            row[x] = color;
+        }
+    }
+
+    return buffer;
+}
 
 static void gpu_test_write_header(struct gpu_test_context_s* ctx)
 {
@@ -103,5 +411,17 @@ static void gpu_test_write_header(struct gpu_test_context_s* ctx)
         gpu_recorder_write_string(ctx->recorder, " ");
     }
 
+    /* Results of different drivers or chips must not be compared as the same build */
+    char info[256];
+    vg_lite_test_info_to_string(info, sizeof(info));
+    gpu_recorder_write_string(ctx->recorder, "\nProduct Info,");
+    gpu_recorder_write_string(ctx->recorder, info);
+
+    /* What the system granted, not what was asked for */
+    char isolate[128];
+    gpu_isolate_state_to_string(&ctx->isolate, isolate, sizeof(isolate));
+    gpu_recorder_write_string(ctx->recorder, "\nIsolation,");
+    gpu_recorder_write_string(ctx->recorder, isolate);
+
     gpu_recorder_write_string(ctx->recorder, "\n\n");
 }
@@ -0,0 +1,304 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "gpu_timeline.h"
+#include "gpu_assert.h"
+#include "gpu_log.h"
+#include "gpu_tick.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define TIMELINE_PHASE_COMPLETE 'X'
+#define TIMELINE_PHASE_INSTANT 'i'
+
+/* The event strings are interned, the names repeat for every item and phase */
+#define TIMELINE_STRING_POOL_SIZE (64 * 1024)
+#define TIMELINE_STRING_SLOTS 4096
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_timeline_event_s {
+    const char* category;
+    const char* name;
+    const char* arg;
+    uint32_t ts;
+    uint32_t dur;
+    char phase;
+};
+
+struct gpu_timeline_s {
+    const char* path;
+    struct gpu_timeline_event_s* events;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t dropped;
+    uint32_t start_tick;
+    char* string_pool;
+    uint32_t string_pool_used;
+
+    /* Open addressing table of string pool offsets plus one, 0 is empty */
+    uint32_t* string_slots;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static struct gpu_timeline_event_s* timeline_event_alloc(void);
+static bool timeline_event_set_strings(struct gpu_timeline_event_s* event, const char* category, const char* name, const char* arg);
+static const char* timeline_intern(const char* str);
+static void timeline_write_string(FILE* fp, const char* str);
+static void timeline_write_event(FILE* fp, const struct gpu_timeline_event_s* event);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static struct gpu_timeline_s g_timeline;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool gpu_timeline_start(const char* path, uint32_t capacity)
+{
+    GPU_ASSERT_NULL(path);
+
+    if (g_timeline.events) {
+        GPU_LOG_WARN("Timeline already started");
+        return false;
+    }
+
+    /* Allocate everything up front, recording must not touch the heap */
+    g_timeline.events = calloc(capacity, sizeof(struct gpu_timeline_event_s));
+    g_timeline.string_pool = malloc(TIMELINE_STRING_POOL_SIZE);
+    g_timeline.string_slots = calloc(TIMELINE_STRING_SLOTS, sizeof(uint32_t));
+    if (!g_timeline.events || !g_timeline.string_pool || !g_timeline.string_slots) {
+        GPU_LOG_ERROR("Malloc %" PRIu32 " timeline events failed", capacity);
+        free(g_timeline.events);
+        free(g_timeline.string_pool);
+        free(g_timeline.string_slots);
+        memset(&g_timeline, 0, sizeof(g_timeline));
+        return false;
+    }
+
+    g_timeline.path = path;
+    g_timeline.capacity = capacity;
+    g_timeline.count = 0;
+    g_timeline.dropped = 0;
+    g_timeline.string_pool_used = 0;
+    g_timeline.start_tick = gpu_tick_get();
+
+    GPU_LOG_INFO("Timeline started: %s, capacity %" PRIu32 " events", path, capacity);
+    return true;
+}
+
+void gpu_timeline_stop(void)
+{
+    if (!g_timeline.events) {
+        return;
+    }
+
+    if (g_timeline.dropped) {
+        GPU_LOG_WARN("Timeline full, %" PRIu32 " events dropped", g_timeline.dropped);
+    }
+
+    FILE* fp = fopen(g_timeline.path, "w");
+    if (fp) {
+        fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", fp);
+
+        for (uint32_t i = 0; i < g_timeline.count; i++) {
+            timeline_write_event(fp, &g_timeline.events[i]);
+            fputs(i + 1 < g_timeline.count ? ",\n" : "\n", fp);
+        }
+
+        fputs("]}\n", fp);
+        fclose(fp);
+        GPU_LOG_INFO("Timeline saved: %s, %" PRIu32 " events", g_timeline.path, g_timeline.count);
+    } else {
+        GPU_LOG_ERROR("Open %s failed", g_timeline.path);
+    }
+
+    free(g_timeline.events);
+    free(g_timeline.string_pool);
+    free(g_timeline.string_slots);
+    memset(&g_timeline, 0, sizeof(g_timeline));
+}
+
+void gpu_timeline_span(const char* category, const char* name, const char* arg, uint32_t start_tick)
+{
+    struct gpu_timeline_event_s* event = timeline_event_alloc();
+    if (!event) {
+        return;
+    }
+
+    if (!timeline_event_set_strings(event, category, name, arg)) {
+        return;
+    }
+
+    event->ts = start_tick - g_timeline.start_tick;
+    event->dur = gpu_tick_elaps(start_tick);
+    event->phase = TIMELINE_PHASE_COMPLETE;
+}
+
+void gpu_timeline_instant(const char* category, const char* name, const char* arg)
+{
+    struct gpu_timeline_event_s* event = timeline_event_alloc();
+    if (!event) {
+        return;
+    }
+
+    if (!timeline_event_set_strings(event, category, name, arg)) {
+        return;
+    }
+
+    event->ts = gpu_tick_get() - g_timeline.start_tick;
+    event->dur = 0;
+    event->phase = TIMELINE_PHASE_INSTANT;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static struct gpu_timeline_event_s* timeline_event_alloc(void)
+{
+    if (!g_timeline.events) {
+        return NULL;
+    }
+
+    if (g_timeline.count >= g_timeline.capacity) {
+        g_timeline.dropped++;
+        return NULL;
+    }
+
+    return &g_timeline.events[g_timeline.count++];
+}
+
+static bool timeline_event_set_strings(struct gpu_timeline_event_s* event, const char* category, const char* name, const char* arg)
+{
+    event->category = timeline_intern(category);
+    event->name = timeline_intern(name);
+    event->arg = arg ? timeline_intern(arg) : NULL;
+
+    if (!event->category || !event->name || (arg && !event->arg)) {
+        /* Give the slot back, it is always the last one */
+        g_timeline.count--;
+        g_timeline.dropped++;
+        return false;
+    }
+
+    return true;
+}
+
+static const char* timeline_intern(const char* str)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    for (const char* p = str; *p; p++) {
+        hash = (hash ^ (unsigned char)*p) * 16777619u;
+    }
+
+    for (uint32_t i = 0; i < TIMELINE_STRING_SLOTS; i++) {
+        uint32_t* slot = &g_timeline.string_slots[(hash + i) % TIMELINE_STRING_SLOTS];
+
+        if (*slot == 0) {
+            size_t size = strlen(str) + 1;
+            if (g_timeline.string_pool_used + size > TIMELINE_STRING_POOL_SIZE) {
+                return NULL;
+            }
+
+            char* copy = g_timeline.string_pool + g_timeline.string_pool_used;
+            memcpy(copy, str, size);
+            *slot = g_timeline.string_pool_used + 1;
+            g_timeline.string_pool_used += size;
+            return copy;
+        }
+
+        const char* interned = g_timeline.string_pool + *slot - 1;
+        if (strcmp(interned, str) == 0) {
+            return interned;
+        }
+    }
+
+    return NULL;
+}
+
+static void timeline_write_string(FILE* fp, const char* str)
+{
+    fputc('"', fp);
+
+    for (; *str; str++) {
+        unsigned char ch = *str;
+        if (ch == '"' || ch == '\\') {
+            fputc('\\', fp);
+            fputc(ch, fp);
+        } else if (ch < 0x20) {
+            fprintf(fp, "\\u%04x", ch);
+        } else {
+            fputc(ch, fp);
+        }
+    }
+
+    fputc('"', fp);
+}
+
+static void timeline_write_event(FILE* fp, const struct gpu_timeline_event_s* event)
+{
+    fputs("{\"name\":", fp);
+    timeline_write_string(fp, event->name);
+    fputs(",\"cat\":", fp);
+    timeline_write_string(fp, event->category);
+    fprintf(fp, ",\"ph\":\"%c\",\"ts\":%" PRIu32 ",\"pid\":1,\"tid\":1", event->phase, event->ts);
+
+    if (event->phase == TIMELINE_PHASE_COMPLETE) {
+        fprintf(fp, ",\"dur\":%" PRIu32, event->dur);
+    } else {
+        /* Thread scoped instant event */
+        fputs(",\"s\":\"t\"", fp);
+    }
+
+    if (event->arg) {
+        fputs(",\"args\":{\"detail\":", fp);
+        timeline_write_string(fp, event->arg);
+        fputc('}', fp);
+    }
+
+    fputc('}', fp);
+}
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef GPU_TIMELINE_H
+#define GPU_TIMELINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Events kept in memory by default, 24 bytes each on 32-bit targets */
+#define GPU_TIMELINE_CAPACITY_DEFAULT (64 * 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Start recording the timeline into a preallocated event buffer.
+ * @param path The path of the Chrome trace-event JSON file written by gpu_timeline_stop.
+ * @param capacity The maximum number of events, the events after it are dropped.
+ * @return True if the event buffer was allocated, false otherwise.
+ */
+bool gpu_timeline_start(const char* path, uint32_t capacity);
+
+/**
+ * @brief Stop recording and write the events to the JSON file.
+ */
+void gpu_timeline_stop(void);
+
+/**
+ * @brief Record a span that started at start_tick and ends now.
+ * @param category The category of the span.
+ * @param name The name of the span.
+ * @param arg The optional argument shown with the span, NULL for none.
+ * @param start_tick The gpu_tick_get value at the start of the span.
+ * @note The strings are copied, the event is dropped when the string pool is full. Call from the test thread only.
+ */
+void gpu_timeline_span(const char* category, const char* name, const char* arg, uint32_t start_tick);
+
+/**
+ * @brief Record an instant event, such as an error.
+ * @param category The category of the event.
+ * @param name The name of the event.
+ * @param arg The optional argument shown with the event, NULL for none.
+ * @note The strings are copied, the event is dropped when the string pool is full. Call from the test thread only.
+ */
+void gpu_timeline_instant(const char* category, const char* name, const char* arg);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*GPU_TIMELINE_H*/
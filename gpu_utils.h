@@ -45,6 +45,12 @@ extern "C" {
 #define GPU_ALIGN_UP(number, align_bytes) \
     ((((uintptr_t)number) + ((align_bytes) - 1)) & ~(((uintptr_t)align_bytes) - 1))
 
+#if defined(__GNUC__) || defined(__clang__)
+#define GPU_ATTRIBUTE_ALIGNED(align_bytes) __attribute__((aligned(align_bytes)))
+#else
+#define GPU_ATTRIBUTE_ALIGNED(align_bytes)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
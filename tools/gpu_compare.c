@@ -0,0 +1,668 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../gpu_log.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define COMPARE_MAX_FILES 64
+#define COMPARE_MAX_METRICS 8
+#define COMPARE_MAX_FIELDS 128
+
+#define COMPARE_EXIT_OK 0
+#define COMPARE_EXIT_REGRESSION 1
+#define COMPARE_EXIT_ERROR 2
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum compare_set_e {
+    COMPARE_SET_BASE,
+    COMPARE_SET_CAND,
+    _COMPARE_SET_LAST
+};
+
+struct compare_samples_s {
+    double* values;
+    int count;
+    int capacity;
+};
+
+struct compare_item_s {
+    /* Testcase|Target Format|Source Format|Target Area */
+    char* key;
+    struct compare_samples_s samples[_COMPARE_SET_LAST];
+};
+
+struct compare_param_s {
+    const char* files[_COMPARE_SET_LAST][COMPARE_MAX_FILES];
+    int file_count[_COMPARE_SET_LAST];
+    char* metrics[COMPARE_MAX_METRICS];
+    int metric_count;
+    double threshold;
+    double alpha;
+    bool higher_is_better;
+    bool strict_product;
+    const char* output_path;
+};
+
+struct compare_context_s {
+    struct compare_param_s param;
+    struct compare_item_s* items;
+    int item_count;
+    int item_capacity;
+    char* product_info[_COMPARE_SET_LAST];
+    bool product_mismatch;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void show_usage(const char* progname, int exitcode);
+static bool parse_metrics(struct compare_param_s* param, const char* str);
+static bool load_file(struct compare_context_s* ctx, enum compare_set_e set, const char* path);
+static int split_fields(char* line, char** fields, int max_count);
+static struct compare_item_s* find_item(struct compare_context_s* ctx, const char* key);
+static void samples_add(struct compare_samples_s* samples, double value);
+static double samples_median(const struct compare_samples_s* samples);
+static double mann_whitney_p(const struct compare_samples_s* a, const struct compare_samples_s* b);
+static double mann_whitney_min_p(int n1, int n2);
+static int compare_double(const void* a, const void* b);
+static int compare_items(struct compare_context_s* ctx, FILE* fp);
+static void compare_context_free(struct compare_context_s* ctx);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const char* const set_names[_COMPARE_SET_LAST] = { "Base", "Candidate" };
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char* argv[])
+{
+    struct compare_context_s ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    struct compare_param_s* param = &ctx.param;
+    param->threshold = 5.0;
+    param->alpha = 0.05;
+
+    int ch;
+    while ((ch = getopt(argc, argv, "b:c:k:t:a:o:gph")) != -1) {
+        switch (ch) {
+        case 'b':
+        case 'c': {
+            enum compare_set_e set = ch == 'b' ? COMPARE_SET_BASE : COMPARE_SET_CAND;
+            if (param->file_count[set] >= COMPARE_MAX_FILES) {
+                GPU_LOG_ERROR("Too many %s files, max %d", set_names[set], COMPARE_MAX_FILES);
+                show_usage(argv[0], COMPARE_EXIT_ERROR);
+            }
+            param->files[set][param->file_count[set]++] = optarg;
+        } break;
+
+        case 'k':
+            if (!parse_metrics(param, optarg)) {
+                show_usage(argv[0], COMPARE_EXIT_ERROR);
+            }
+            break;
+
+        case 't':
+            param->threshold = atof(optarg);
+            if (param->threshold < 0) {
+                GPU_LOG_ERROR("Invalid threshold: %s", optarg);
+                show_usage(argv[0], COMPARE_EXIT_ERROR);
+            }
+            break;
+
+        case 'a':
+            param->alpha = atof(optarg);
+            if (param->alpha <= 0 || param->alpha >= 1) {
+                GPU_LOG_ERROR("Invalid alpha: %s", optarg);
+                show_usage(argv[0], COMPARE_EXIT_ERROR);
+            }
+            break;
+
+        case 'o':
+            param->output_path = optarg;
+            break;
+
+        case 'g':
+            param->higher_is_better = true;
+            break;
+
+        case 'p':
+            param->strict_product = true;
+            break;
+
+        case 'h':
+            show_usage(argv[0], COMPARE_EXIT_OK);
+            break;
+
+        default:
+            show_usage(argv[0], COMPARE_EXIT_ERROR);
+            break;
+        }
+    }
+
+    if (param->file_count[COMPARE_SET_BASE] == 0 || param->file_count[COMPARE_SET_CAND] == 0) {
+        GPU_LOG_ERROR("At least one base and one candidate report are required");
+        show_usage(argv[0], COMPARE_EXIT_ERROR);
+    }
+
+    if (param->metric_count == 0 && !parse_metrics(param, "Draw Time(ms)+Finish Time(ms)")) {
+        return COMPARE_EXIT_ERROR;
+    }
+
+    int retval = COMPARE_EXIT_OK;
+
+    for (int set = 0; set < _COMPARE_SET_LAST; set++) {
+        for (int i = 0; i < param->file_count[set]; i++) {
+            if (!load_file(&ctx, set, param->files[set][i])) {
+                retval = COMPARE_EXIT_ERROR;
+                goto failed;
+            }
+        }
+    }
+
+    if (ctx.product_mismatch) {
+        if (param->strict_product) {
+            GPU_LOG_ERROR("Product info differs between the reports, refusing to compare");
+            retval = COMPARE_EXIT_ERROR;
+            goto failed;
+        }
+
+        GPU_LOG_WARN("Product info differs between the reports, the changes may come from the driver or the chip");
+    }
+
+    FILE* fp = stdout;
+    if (param->output_path) {
+        fp = fopen(param->output_path, "w");
+        if (!fp) {
+            GPU_LOG_ERROR("open %s failed", param->output_path);
+            retval = COMPARE_EXIT_ERROR;
+            goto failed;
+        }
+    }
+
+    retval = compare_items(&ctx, fp);
+
+    if (fp != stdout) {
+        fclose(fp);
+    }
+
+failed:
+    compare_context_free(&ctx);
+    return retval;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void show_usage(const char* progname, int exitcode)
+{
+    printf("\nUsage: %s -b <file> [-b <file> ...] -c <file> [-c <file> ...]"
+           " -k <string> -t <float> -a <float> -o <file> -g -p\n",
+        progname);
+
+    printf("\nWhere:\n");
+    printf("  -b <file> Baseline report_vg_lite.csv, repeat for more runs of the baseline build.\n");
+    printf("  -c <file> Candidate report_vg_lite.csv, repeat for more runs of the candidate build.\n");
+    printf("  -k <string> Columns summed into the compared metric, joined by '+'. "
+           "Default: \"Draw Time(ms)+Finish Time(ms)\".\n");
+    printf("  -t <float> Change of the median in percent below which an item is unchanged. Default: 5.\n");
+    printf("  -a <float> Significance level of the Mann-Whitney U test. Default: 0.05.\n");
+    printf("  -o <file> Write the comparison CSV to the file instead of stdout.\n");
+    printf("  -g Higher values of the metric are better, e.g. for the throughput columns.\n");
+    printf("  -p Fail if the product info of the reports differs.\n");
+    printf("\nItems are matched by testcase, target format, source format and target area.\n"
+           "Each report is one sample of an item. With enough samples (4 or more per side at the default\n"
+           "significance level) a change must also be significant to be reported, else the threshold decides alone.\n"
+           "Exit code: %d no regression, %d regression found, %d usage or input error.\n",
+        COMPARE_EXIT_OK, COMPARE_EXIT_REGRESSION, COMPARE_EXIT_ERROR);
+
+    exit(exitcode);
+}
+
+static bool parse_metrics(struct compare_param_s* param, const char* str)
+{
+    for (int i = 0; i < param->metric_count; i++) {
+        free(param->metrics[i]);
+    }
+    param->metric_count = 0;
+
+    const char* start = str;
+    while (*start) {
+        const char* end = strchr(start, '+');
+        size_t len = end ? (size_t)(end - start) : strlen(start);
+
+        if (len == 0 || param->metric_count >= COMPARE_MAX_METRICS) {
+            GPU_LOG_ERROR("Invalid metric: %s", str);
+            return false;
+        }
+
+        param->metrics[param->metric_count++] = strndup(start, len);
+
+        if (!end) {
+            break;
+        }
+
+        start = end + 1;
+    }
+
+    return param->metric_count > 0;
+}
+
+static bool load_file(struct compare_context_s* ctx, enum compare_set_e set, const char* path)
+{
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        GPU_LOG_ERROR("open %s failed", path);
+        return false;
+    }
+
+    const struct compare_param_s* param = &ctx->param;
+    int key_index[4] = { -1, -1, -1, -1 };
+    static const char* const key_names[4] = { "Testcase", "Target Format", "Source Format", "Target Area" };
+    int metric_index[COMPARE_MAX_METRICS];
+    int result_index = -1;
+    int header_count = 0;
+    bool has_header = false;
+    bool retval = false;
+    int rows = 0;
+
+    char* line = NULL;
+    size_t line_size = 0;
+    char* fields[COMPARE_MAX_FIELDS];
+
+    while (getline(&line, &line_size, fp) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (strncmp(line, "Product Info,", 13) == 0) {
+            const char* info = line + 13;
+            if (!ctx->product_info[set]) {
+                ctx->product_info[set] = strdup(info);
+            } else if (strcmp(ctx->product_info[set], info) != 0) {
+                GPU_LOG_WARN("%s: product info '%s' differs from '%s'", path, info, ctx->product_info[set]);
+                ctx->product_mismatch = true;
+            }
+            continue;
+        }
+
+        int count = split_fields(line, fields, COMPARE_MAX_FIELDS);
+
+        if (!has_header) {
+            if (count == 0 || strcmp(fields[0], "Testcase") != 0) {
+                continue;
+            }
+
+            header_count = count;
+            for (int i = 0; i < count; i++) {
+                if (strcmp(fields[i], "Result") == 0) {
+                    result_index = i;
+                }
+
+                for (int k = 0; k < 4; k++) {
+                    if (strcmp(fields[i], key_names[k]) == 0) {
+                        key_index[k] = i;
+                    }
+                }
+            }
+
+            for (int m = 0; m < param->metric_count; m++) {
+                metric_index[m] = -1;
+                for (int i = 0; i < count; i++) {
+                    if (strcmp(fields[i], param->metrics[m]) == 0) {
+                        metric_index[m] = i;
+                        break;
+                    }
+                }
+
+                if (metric_index[m] < 0) {
+                    GPU_LOG_ERROR("%s: column '%s' not found", path, param->metrics[m]);
+                    goto failed;
+                }
+            }
+
+            if (result_index < 0) {
+                GPU_LOG_ERROR("%s: column 'Result' not found", path);
+                goto failed;
+            }
+
+            has_header = true;
+            continue;
+        }
+
+        /* Remarks may contain commas, they shift the result but not the columns before them */
+        int index = result_index + count - header_count;
+        if (result_index < 0 || index < result_index || index >= count
+            || (strcmp(fields[index], "PASS") != 0 && strcmp(fields[index], "SLOW") != 0)) {
+            continue;
+        }
+
+        char key[256] = { 0 };
+        size_t key_len = 0;
+        for (int k = 0; k < 4; k++) {
+            const char* value = key_index[k] >= 0 && key_index[k] < count ? fields[key_index[k]] : "";
+            key_len += snprintf(key + key_len, sizeof(key) - key_len, k ? "|%s" : "%s", value);
+            if (key_len >= sizeof(key)) {
+                key_len = sizeof(key) - 1;
+            }
+        }
+
+        double value = 0;
+        bool valid = true;
+        for (int m = 0; m < param->metric_count; m++) {
+            if (metric_index[m] >= count) {
+                valid = false;
+                break;
+            }
+
+            char* end;
+            value += strtod(fields[metric_index[m]], &end);
+            if (end == fields[metric_index[m]]) {
+                valid = false;
+                break;
+            }
+        }
+
+        if (!valid) {
+            GPU_LOG_WARN("%s: invalid metric of item '%s', skipped", path, key);
+            continue;
+        }
+
+        struct compare_item_s* item = find_item(ctx, key);
+        samples_add(&item->samples[set], value);
+        rows++;
+    }
+
+    if (!has_header) {
+        GPU_LOG_ERROR("%s: no 'Testcase' header row found", path);
+        goto failed;
+    }
+
+    if (!ctx->product_info[set]) {
+        GPU_LOG_WARN("%s: no product info, the report comes from an older build", path);
+    }
+
+    GPU_LOG_INFO("%s: %s report %s, %d passed items loaded", set_names[set], path,
+        ctx->product_info[set] ? ctx->product_info[set] : "(unknown product)", rows);
+    retval = true;
+
+failed:
+    free(line);
+    fclose(fp);
+    return retval;
+}
+
+static int split_fields(char* line, char** fields, int max_count)
+{
+    if (*line == '\0') {
+        return 0;
+    }
+
+    int count = 0;
+    char* start = line;
+    while (count < max_count) {
+        fields[count++] = start;
+        char* comma = strchr(start, ',');
+        if (!comma) {
+            break;
+        }
+
+        *comma = '\0';
+        start = comma + 1;
+    }
+
+    return count;
+}
+
+static struct compare_item_s* find_item(struct compare_context_s* ctx, const char* key)
+{
+    for (int i = 0; i < ctx->item_count; i++) {
+        if (strcmp(ctx->items[i].key, key) == 0) {
+            return &ctx->items[i];
+        }
+    }
+
+    if (ctx->item_count >= ctx->item_capacity) {
+        ctx->item_capacity = ctx->item_capacity ? ctx->item_capacity * 2 : 64;
+        ctx->items = realloc(ctx->items, ctx->item_capacity * sizeof(struct compare_item_s));
+        if (!ctx->items) {
+            GPU_LOG_ERROR("alloc items failed");
+            exit(COMPARE_EXIT_ERROR);
+        }
+    }
+
+    struct compare_item_s* item = &ctx->items[ctx->item_count++];
+    memset(item, 0, sizeof(struct compare_item_s));
+    item->key = strdup(key);
+    return item;
+}
+
+static void samples_add(struct compare_samples_s* samples, double value)
+{
+    if (samples->count >= samples->capacity) {
+        samples->capacity = samples->capacity ? samples->capacity * 2 : 8;
+        samples->values = realloc(samples->values, samples->capacity * sizeof(double));
+        if (!samples->values) {
+            GPU_LOG_ERROR("alloc samples failed");
+            exit(COMPARE_EXIT_ERROR);
+        }
+    }
+
+    samples->values[samples->count++] = value;
+}
+
+static double samples_median(const struct compare_samples_s* samples)
+{
+    /* The values are sorted by compare_items before use */
+    const double* v = samples->values;
+    int n = samples->count;
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static double mann_whitney_p(const struct compare_samples_s* a, const struct compare_samples_s* b)
+{
+    int n1 = a->count;
+    int n2 = b->count;
+    int n = n1 + n2;
+
+    /* Rank the pooled sorted samples by merging, ties get the average rank */
+    double rank_sum = 0;
+    double tie_sum = 0;
+    int i = 0;
+    int j = 0;
+    while (i < n1 || j < n2) {
+        double value = (j >= n2 || (i < n1 && a->values[i] <= b->values[j])) ? a->values[i] : b->values[j];
+        int count_a = 0;
+        int count_b = 0;
+        while (i < n1 && a->values[i] == value) {
+            i++;
+            count_a++;
+        }
+        while (j < n2 && b->values[j] == value) {
+            j++;
+            count_b++;
+        }
+
+        int t = count_a + count_b;
+        double first = i + j - t + 1;
+        rank_sum += count_a * (first + (t - 1) / 2.0);
+        tie_sum += (double)t * t * t - t;
+    }
+
+    double u = rank_sum - n1 * (n1 + 1) / 2.0;
+    double mean = n1 * (double)n2 / 2;
+    double var = n1 * (double)n2 / 12 * ((n + 1) - tie_sum / ((double)n * (n - 1)));
+    if (var <= 0) {
+        /* All samples are equal */
+        return 1;
+    }
+
+    /* Normal approximation with continuity correction, two-sided */
+    double z = (fabs(u - mean) - 0.5) / sqrt(var);
+    if (z < 0) {
+        z = 0;
+    }
+
+    return erfc(z / sqrt(2));
+}
+
+static double mann_whitney_min_p(int n1, int n2)
+{
+    /* The p-value of two fully separated sets, the test can not go lower */
+    double mean = n1 * (double)n2 / 2;
+    double var = n1 * (double)n2 * (n1 + n2 + 1) / 12;
+    return erfc((mean - 0.5) / sqrt(var) / sqrt(2));
+}
+
+static int compare_double(const void* a, const void* b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_items(struct compare_context_s* ctx, FILE* fp)
+{
+    const struct compare_param_s* param = &ctx->param;
+    int regressions = 0;
+    int improvements = 0;
+    int unchanged = 0;
+    int unmatched = 0;
+
+    fprintf(fp, "Metric,");
+    for (int m = 0; m < param->metric_count; m++) {
+        fprintf(fp, m ? "+%s" : "%s", param->metrics[m]);
+    }
+    fprintf(fp, "\n");
+
+    for (int set = 0; set < _COMPARE_SET_LAST; set++) {
+        fprintf(fp, "%s Product Info,%s\n", set_names[set],
+            ctx->product_info[set] ? ctx->product_info[set] : "");
+    }
+
+    fprintf(fp, "\nTestcase,Target Format,Source Format,Target Area,"
+                "Base Samples,Base Median,Candidate Samples,Candidate Median,"
+                "Change(%%),p-value,Verdict\n");
+
+    for (int i = 0; i < ctx->item_count; i++) {
+        struct compare_item_s* item = &ctx->items[i];
+        struct compare_samples_s* base = &item->samples[COMPARE_SET_BASE];
+        struct compare_samples_s* cand = &item->samples[COMPARE_SET_CAND];
+
+        char key[256];
+        snprintf(key, sizeof(key), "%s", item->key);
+        for (char* p = key; *p; p++) {
+            if (*p == '|') {
+                *p = ',';
+            }
+        }
+
+        if (base->count == 0 || cand->count == 0) {
+            fprintf(fp, "%s,%d,,%d,,,,%s\n", key, base->count, cand->count,
+                base->count ? "MISSING" : "NEW");
+            unmatched++;
+            continue;
+        }
+
+        qsort(base->values, base->count, sizeof(double), compare_double);
+        qsort(cand->values, cand->count, sizeof(double), compare_double);
+
+        double base_median = samples_median(base);
+        double cand_median = samples_median(cand);
+        double change = base_median > 0 ? (cand_median - base_median) * 100 / base_median : 0;
+
+        /* Positive is worse */
+        double worse = param->higher_is_better ? -change : change;
+
+        bool has_stats = mann_whitney_min_p(base->count, cand->count) < param->alpha;
+        double p = has_stats ? mann_whitney_p(base, cand) : 1;
+        bool significant = has_stats ? p < param->alpha : true;
+
+        const char* verdict = "SAME";
+        if (significant && worse > param->threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+            GPU_LOG_WARN("Regression: %s %0.3f -> %0.3f (%+0.1f%%)", item->key, base_median, cand_median, change);
+        } else if (significant && worse < -param->threshold) {
+            verdict = "IMPROVEMENT";
+            improvements++;
+        } else {
+            unchanged++;
+        }
+
+        char p_str[32] = "-";
+        if (has_stats) {
+            snprintf(p_str, sizeof(p_str), "%0.4f", p);
+        }
+
+        fprintf(fp, "%s,%d,%0.3f,%d,%0.3f,%+0.2f,%s,%s\n", key,
+            base->count, base_median, cand->count, cand_median, change, p_str, verdict);
+    }
+
+    GPU_LOG_INFO("Compared %d items: %d regressions, %d improvements, %d unchanged, %d unmatched",
+        ctx->item_count, regressions, improvements, unchanged, unmatched);
+
+    return regressions ? COMPARE_EXIT_REGRESSION : COMPARE_EXIT_OK;
+}
+
+static void compare_context_free(struct compare_context_s* ctx)
+{
+    for (int i = 0; i < ctx->item_count; i++) {
+        free(ctx->items[i].key);
+        for (int set = 0; set < _COMPARE_SET_LAST; set++) {
+            free(ctx->items[i].samples[set].values);
+        }
+    }
+    free(ctx->items);
+
+    for (int set = 0; set < _COMPARE_SET_LAST; set++) {
+        free(ctx->product_info[set]);
+    }
+
+    for (int m = 0; m < ctx->param.metric_count; m++) {
+        free(ctx->param.metrics[m]);
+    }
+}
@@ -0,0 +1,572 @@
+"""
+MIT License
+
+Copyright (c) 2023 - 2025 _VIFEXTech
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+"""
+
+# Convert SVG and PNG files into an asset pack for the asset_pack test case:
+#   python asset_pack_gen.py -o assets.vgap tiger.svg icon.png@100,200
+# The layout must match vg_lite/vg_lite_test_asset.c, only the standard
+# library is used so the tool runs on any host.
+
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+import xml.etree.ElementTree as ET
+import zlib
+
+ASSET_MAGIC = b'VGAP'
+ASSET_VERSION = 1
+ASSET_NAME_LEN = 32
+ASSET_ALIGN = 64
+
+ASSET_PATH = 1
+ASSET_IMAGE = 2
+
+# vg_lite enum values
+VG_LITE_FP32 = 3
+VG_LITE_HIGH = 0
+VG_LITE_FILL_NON_ZERO = 0
+VG_LITE_FILL_EVEN_ODD = 1
+VG_LITE_BGRA8888 = 1
+VG_LITE_A8 = 10
+VG_LITE_L8 = 11
+VG_LITE_INDEX_8 = 0x203
+
+VLC_OP_END = 0x00
+VLC_OP_CLOSE = 0x01
+VLC_OP_MOVE = 0x02
+VLC_OP_LINE = 0x04
+VLC_OP_QUAD = 0x06
+VLC_OP_CUBIC = 0x08
+
+NAMED_COLORS = {
+    'black': (0, 0, 0), 'white': (255, 255, 255), 'red': (255, 0, 0),
+    'green': (0, 128, 0), 'lime': (0, 255, 0), 'blue': (0, 0, 255),
+    'yellow': (255, 255, 0), 'cyan': (0, 255, 255), 'magenta': (255, 0, 255),
+    'gray': (128, 128, 128), 'grey': (128, 128, 128), 'orange': (255, 165, 0),
+}
+
+NUMBER_RE = re.compile(r'[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?')
+
+
+def align_up(value, align):
+    return (value + align - 1) // align * align
+
+
+# ---------------------------------------------------------------------------
+# SVG
+# ---------------------------------------------------------------------------
+
+def matrix_mul(a, b):
+    # Affine matrices as (a, b, c, d, e, f): x' = a*x + c*y + e, y' = b*x + d*y + f
+    return (a[0] * b[0] + a[2] * b[1], a[1] * b[0] + a[3] * b[1],
+            a[0] * b[2] + a[2] * b[3], a[1] * b[2] + a[3] * b[3],
+            a[0] * b[4] + a[2] * b[5] + a[4], a[1] * b[4] + a[3] * b[5] + a[5])
+
+
+def parse_transform(text):
+    matrix = (1, 0, 0, 1, 0, 0)
+    for name, args in re.findall(r'(\w+)\s*\(([^)]*)\)', text or ''):
+        v = [float(n) for n in NUMBER_RE.findall(args)]
+        if name == 'matrix' and len(v) == 6:
+            m = tuple(v)
+        elif name == 'translate' and v:
+            m = (1, 0, 0, 1, v[0], v[1] if len(v) > 1 else 0)
+        elif name == 'scale' and v:
+            m = (v[0], 0, 0, v[1] if len(v) > 1 else v[0], 0, 0)
+        elif name == 'rotate' and v:
+            r = math.radians(v[0])
+            m = (math.cos(r), math.sin(r), -math.sin(r), math.cos(r), 0, 0)
+            if len(v) == 3:
+                m = matrix_mul(matrix_mul((1, 0, 0, 1, v[1], v[2]), m), (1, 0, 0, 1, -v[1], -v[2]))
+        elif name == 'skewX' and v:
+            m = (1, 0, math.tan(math.radians(v[0])), 1, 0, 0)
+        elif name == 'skewY' and v:
+            m = (1, math.tan(math.radians(v[0])), 0, 1, 0, 0)
+        else:
+            print(f"Unsupported transform '{name}({args})' ignored")
+            continue
+        matrix = matrix_mul(matrix, m)
+    return matrix
+
+
+def parse_color(text, opacity):
+    text = text.strip().lower()
+    if text == 'none':
+        return None
+    if text.startswith('#') and len(text) == 4:
+        rgb = tuple(int(c * 2, 16) for c in text[1:])
+    elif text.startswith('#') and len(text) == 7:
+        rgb = tuple(int(text[i:i + 2], 16) for i in (1, 3, 5))
+    elif text.startswith('rgb('):
+        rgb = tuple(int(float(n)) for n in NUMBER_RE.findall(text)[:3])
+    elif text in NAMED_COLORS:
+        rgb = NAMED_COLORS[text]
+    else:
+        print(f"Unsupported color '{text}', using black")
+        rgb = (0, 0, 0)
+    alpha = max(0, min(255, round(opacity * 255)))
+    # vg_lite_color_t is 0xAABBGGRR
+    return (alpha << 24) | (rgb[2] << 16) | (rgb[1] << 8) | rgb[0]
+
+
+def get_style(elem, parent_style):
+    style = dict(parent_style)
+    style['opacity'] = 1.0
+    attrs = dict(elem.attrib)
+    for item in attrs.pop('style', '').split(';'):
+        if ':' in item:
+            key, value = item.split(':', 1)
+            attrs[key.strip()] = value.strip()
+    for key in ('fill', 'fill-rule'):
+        if key in attrs:
+            style[key] = attrs[key]
+    for key in ('fill-opacity', 'opacity'):
+        if key in attrs:
+            style[key] = float(attrs[key])
+    # Group opacity is folded into the fill, overlapping children are not composited as a group
+    style['inherited-opacity'] = parent_style.get('inherited-opacity', 1.0) * style['opacity']
+    return style
+
+
+class PathBuilder:
+    def __init__(self, matrix):
+        self.matrix = matrix
+        self.ops = []
+
+    def point(self, x, y):
+        m = self.matrix
+        return (m[0] * x + m[2] * y + m[4], m[1] * x + m[3] * y + m[5])
+
+    def add(self, op, *points):
+        self.ops.append((op, [self.point(x, y) for x, y in points]))
+
+
+def arc_to_cubics(x1, y1, rx, ry, phi, large, sweep, x2, y2):
+    # SVG implementation notes F.6: endpoint to center parameterization
+    if rx == 0 or ry == 0 or (x1 == x2 and y1 == y2):
+        return [[(x2, y2)]]
+    rx, ry = abs(rx), abs(ry)
+    cos_phi, sin_phi = math.cos(math.radians(phi)), math.sin(math.radians(phi))
+    dx, dy = (x1 - x2) / 2, (y1 - y2) / 2
+    x1p = cos_phi * dx + sin_phi * dy
+    y1p = -sin_phi * dx + cos_phi * dy
+    lam = (x1p * x1p) / (rx * rx) + (y1p * y1p) / (ry * ry)
+    if lam > 1:
+        rx, ry = rx * math.sqrt(lam), ry * math.sqrt(lam)
+    num = rx * rx * ry * ry - rx * rx * y1p * y1p - ry * ry * x1p * x1p
+    den = rx * rx * y1p * y1p + ry * ry * x1p * x1p
+    coef = math.sqrt(max(0, num / den)) if den else 0
+    if large == sweep:
+        coef = -coef
+    cxp, cyp = coef * rx * y1p / ry, -coef * ry * x1p / rx
+    cx = cos_phi * cxp - sin_phi * cyp + (x1 + x2) / 2
+    cy = sin_phi * cxp + cos_phi * cyp + (y1 + y2) / 2
+
+    def angle(ux, uy, vx, vy):
+        a = math.atan2(ux * vy - uy * vx, ux * vx + uy * vy)
+        return a
+
+    theta = angle(1, 0, (x1p - cxp) / rx, (y1p - cyp) / ry)
+    delta = angle((x1p - cxp) / rx, (y1p - cyp) / ry, (-x1p - cxp) / rx, (-y1p - cyp) / ry)
+    if not sweep and delta > 0:
+        delta -= 2 * math.pi
+    elif sweep and delta < 0:
+        delta += 2 * math.pi
+
+    segments = max(1, math.ceil(abs(delta) / (math.pi / 2)))
+    step = delta / segments
+    kappa = 4 / 3 * math.tan(step / 4)
+    curves = []
+    for i in range(segments):
+        t1, t2 = theta + i * step, theta + (i + 1) * step
+        pts = []
+        for ex, ey in ((math.cos(t1) - kappa * math.sin(t1), math.sin(t1) + kappa * math.cos(t1)),
+                       (math.cos(t2) + kappa * math.sin(t2), math.sin(t2) - kappa * math.cos(t2)),
+                       (math.cos(t2), math.sin(t2))):
+            ex, ey = ex * rx, ey * ry
+            pts.append((cos_phi * ex - sin_phi * ey + cx, sin_phi * ex + cos_phi * ey + cy))
+        curves.append(pts)
+    return curves
+
+
+def parse_path_data(builder, d):
+    tokens = re.findall(r'[MmLlHhVvCcSsQqTtAaZz]|[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?', d)
+    pos = 0
+    cmd = None
+    cur = start = (0.0, 0.0)
+    last_ctrl = None
+    last_cmd = None
+
+    def take(count):
+        nonlocal pos
+        values = [float(t) for t in tokens[pos:pos + count]]
+        if len(values) != count:
+            raise ValueError(f"Truncated path data: {d[:40]}")
+        pos += count
+        return values
+
+    while pos < len(tokens):
+        if tokens[pos].isalpha():
+            cmd = tokens[pos]
+            pos += 1
+        elif cmd is None:
+            raise ValueError(f"Path data without command: {d[:40]}")
+
+        rel = cmd.islower()
+        ox, oy = cur if rel else (0.0, 0.0)
+        upper = cmd.upper()
+
+        if upper == 'Z':
+            builder.add(VLC_OP_CLOSE)
+            cur = start
+            last_ctrl = None
+            last_cmd = upper
+            continue
+        if upper == 'M':
+            x, y = take(2)
+            cur = start = (ox + x, oy + y)
+            builder.add(VLC_OP_MOVE, cur)
+            # Following pairs are implicit line-to
+            cmd = 'l' if rel else 'L'
+            last_ctrl = None
+        elif upper == 'L':
+            x, y = take(2)
+            cur = (ox + x, oy + y)
+            builder.add(VLC_OP_LINE, cur)
+            last_ctrl = None
+        elif upper == 'H':
+            (x,) = take(1)
+            cur = ((ox if rel else 0) + x, cur[1])
+            builder.add(VLC_OP_LINE, cur)
+            last_ctrl = None
+        elif upper == 'V':
+            (y,) = take(1)
+            cur = (cur[0], (oy if rel else 0) + y)
+            builder.add(VLC_OP_LINE, cur)
+            last_ctrl = None
+        elif upper in 'CS':
+            if upper == 'C':
+                v = take(6)
+                c1 = (ox + v[0], oy + v[1])
+                c2, end = (ox + v[2], oy + v[3]), (ox + v[4], oy + v[5])
+            else:
+                v = take(4)
+                c1 = (2 * cur[0] - last_ctrl[0], 2 * cur[1] - last_ctrl[1]) if last_cmd in ('C', 'S') else cur
+                c2, end = (ox + v[0], oy + v[1]), (ox + v[2], oy + v[3])
+            builder.add(VLC_OP_CUBIC, c1, c2, end)
+            last_ctrl, cur = c2, end
+        elif upper in 'QT':
+            if upper == 'Q':
+                v = take(4)
+                c1, end = (ox + v[0], oy + v[1]), (ox + v[2], oy + v[3])
+            else:
+                v = take(2)
+                c1 = (2 * cur[0] - last_ctrl[0], 2 * cur[1] - last_ctrl[1]) if last_cmd in ('Q', 'T') else cur
+                end = (ox + v[0], oy + v[1])
+            builder.add(VLC_OP_QUAD, c1, end)
+            last_ctrl, cur = c1, end
+        elif upper == 'A':
+            # The flags may be written without separators, e.g. "a1 1 0 01.5 2"
+            v = take(3)
+            flags = []
+            while len(flags) < 2:
+                token = tokens[pos]
+                flags.append(int(token[0]))
+                tokens[pos] = token[1:]
+                if not tokens[pos]:
+                    pos += 1
+            x, y = take(2)
+            end = (ox + x, oy + y)
+            for curve in arc_to_cubics(cur[0], cur[1], v[0], v[1], v[2], flags[0], flags[1], end[0], end[1]):
+                builder.add(VLC_OP_CUBIC if len(curve) == 3 else VLC_OP_LINE, *curve)
+            cur = end
+            last_ctrl = None
+        last_cmd = upper
+
+
+def shape_to_path(builder, elem):
+    tag = elem.tag.split('}')[-1]
+    get = lambda name, default=0.0: float(NUMBER_RE.match(elem.get(name, str(default))).group())
+
+    if tag == 'path':
+        parse_path_data(builder, elem.get('d', ''))
+    elif tag == 'rect':
+        x, y, w, h = get('x'), get('y'), get('width'), get('height')
+        rx = get('rx', elem.get('ry', 0))
+        ry = get('ry', elem.get('rx', 0))
+        rx, ry = min(rx, w / 2), min(ry, h / 2)
+        if rx <= 0 or ry <= 0:
+            parse_path_data(builder, f'M{x},{y} h{w} v{h} h{-w} z')
+        else:
+            parse_path_data(builder,
+                            f'M{x + rx},{y} h{w - 2 * rx} a{rx},{ry} 0 0 1 {rx},{ry} v{h - 2 * ry} '
+                            f'a{rx},{ry} 0 0 1 {-rx},{ry} h{2 * rx - w} a{rx},{ry} 0 0 1 {-rx},{-ry} '
+                            f'v{2 * ry - h} a{rx},{ry} 0 0 1 {rx},{-ry} z')
+    elif tag in ('circle', 'ellipse'):
+        cx, cy = get('cx'), get('cy')
+        rx = get('r') if tag == 'circle' else get('rx')
+        ry = get('r') if tag == 'circle' else get('ry')
+        parse_path_data(builder,
+                        f'M{cx - rx},{cy} a{rx},{ry} 0 1 0 {2 * rx},0 a{rx},{ry} 0 1 0 {-2 * rx},0 z')
+    elif tag in ('polygon', 'polyline'):
+        v = [float(n) for n in NUMBER_RE.findall(elem.get('points', ''))]
+        if len(v) >= 4:
+            d = f'M{v[0]},{v[1]} ' + ' '.join(f'L{v[i]},{v[i + 1]}' for i in range(2, len(v) - 1, 2))
+            parse_path_data(builder, d + ' z')
+    else:
+        return False
+    return True
+
+
+def encode_path(name, builder, style):
+    data = bytearray()
+    xs, ys = [], []
+    for op, points in builder.ops:
+        # FP32 paths store each op code in a 32-bit word
+        data += struct.pack('<I', op)
+        for x, y in points:
+            data += struct.pack('<ff', x, y)
+            xs.append(x)
+            ys.append(y)
+    data += struct.pack('<I', VLC_OP_END)
+
+    fill_rule = VG_LITE_FILL_EVEN_ODD if style.get('fill-rule') == 'evenodd' else VG_LITE_FILL_NON_ZERO
+    opacity = style['inherited-opacity'] * style.get('fill-opacity', 1.0)
+    color = parse_color(style.get('fill', 'black'), opacity)
+    header = struct.pack('<IIII4f', VG_LITE_FP32, VG_LITE_HIGH, fill_rule, color,
+                         min(xs), min(ys), max(xs), max(ys))
+    return (ASSET_PATH, name, header + data)
+
+
+def load_svg(file_path):
+    root = ET.parse(file_path).getroot()
+    base = os.path.splitext(os.path.basename(file_path))[0]
+
+    # Map the viewBox onto the document size
+    matrix = (1, 0, 0, 1, 0, 0)
+    view_box = [float(n) for n in NUMBER_RE.findall(root.get('viewBox', ''))]
+    if len(view_box) == 4 and root.get('width') and root.get('height'):
+        sx = float(NUMBER_RE.match(root.get('width')).group()) / view_box[2]
+        sy = float(NUMBER_RE.match(root.get('height')).group()) / view_box[3]
+        matrix = (sx, 0, 0, sy, -view_box[0] * sx, -view_box[1] * sy)
+
+    entries = []
+
+    def walk(elem, matrix, parent_style):
+        tag = elem.tag.split('}')[-1]
+        if tag in ('defs', 'clipPath', 'mask', 'style', 'title', 'desc', 'metadata'):
+            return
+        matrix = matrix_mul(matrix, parse_transform(elem.get('transform')))
+        style = get_style(elem, parent_style)
+        builder = PathBuilder(matrix)
+        if shape_to_path(builder, elem):
+            if builder.ops and style.get('fill', 'black').strip().lower() != 'none':
+                entries.append(encode_path(f'{base}_{len(entries)}', builder, style))
+            return
+        for child in elem:
+            walk(child, matrix, style)
+
+    walk(root, matrix, {})
+    print(f"{file_path}: {len(entries)} paths")
+    return entries
+
+
+# ---------------------------------------------------------------------------
+# PNG
+# ---------------------------------------------------------------------------
+
+def png_unfilter(raw, width, height, bpp):
+    row_size = width * bpp
+    rows = []
+    prev = bytearray(row_size)
+    pos = 0
+    for _ in range(height):
+        filter_type = raw[pos]
+        row = bytearray(raw[pos + 1:pos + 1 + row_size])
+        pos += 1 + row_size
+        for i in range(row_size):
+            a = row[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if filter_type == 1:
+                row[i] = (row[i] + a) & 0xFF
+            elif filter_type == 2:
+                row[i] = (row[i] + b) & 0xFF
+            elif filter_type == 3:
+                row[i] = (row[i] + ((a + b) >> 1)) & 0xFF
+            elif filter_type == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                row[i] = (row[i] + pred) & 0xFF
+        rows.append(row)
+        prev = row
+    return rows
+
+
+def load_png(file_path):
+    with open(file_path, 'rb') as file:
+        data = file.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError(f"{file_path} is not a PNG file")
+
+    pos = 8
+    idat = bytearray()
+    palette, trns = b'', b''
+    while pos < len(data):
+        length, chunk_type = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if chunk_type == b'IHDR':
+            width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif chunk_type == b'PLTE':
+            palette = chunk
+        elif chunk_type == b'tRNS':
+            trns = chunk
+        elif chunk_type == b'IDAT':
+            idat += chunk
+        elif chunk_type == b'IEND':
+            break
+
+    if depth != 8 or interlace != 0:
+        raise ValueError(f"{file_path}: only 8-bit non-interlaced PNG is supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    rows = png_unfilter(zlib.decompress(bytes(idat)), width, height, channels)
+    return width, height, color_type, rows, palette, trns
+
+
+def encode_image(name, file_path, x, y, image_format, color):
+    width, height, color_type, rows, palette, trns = load_png(file_path)
+
+    if image_format == 'auto':
+        image_format = {0: 'l8', 3: 'index8'}.get(color_type, 'bgra8888')
+
+    clut = []
+    if image_format == 'index8':
+        if color_type != 3:
+            raise ValueError(f"{file_path}: index8 needs a palette PNG")
+        for i in range(len(palette) // 3):
+            r, g, b = palette[i * 3:i * 3 + 3]
+            a = trns[i] if i < len(trns) else 255
+            # The CLUT entries are 0xAARRGGBB
+            clut.append((a << 24) | (r << 16) | (g << 8) | b)
+        # vg_lite_set_CLUT takes the full table of the index format
+        clut += [0] * (256 - len(clut))
+
+    def rgba(row, i):
+        if color_type == 0:
+            return row[i], row[i], row[i], 255
+        if color_type == 2:
+            return row[i * 3], row[i * 3 + 1], row[i * 3 + 2], 255
+        if color_type == 3:
+            r, g, b = palette[row[i] * 3:row[i] * 3 + 3]
+            return r, g, b, trns[row[i]] if row[i] < len(trns) else 255
+        if color_type == 4:
+            return row[i * 2], row[i * 2], row[i * 2], row[i * 2 + 1]
+        return tuple(row[i * 4:i * 4 + 4])
+
+    formats = {
+        'bgra8888': (VG_LITE_BGRA8888, 4, lambda row, i: bytes((lambda p: (p[2], p[1], p[0], p[3]))(rgba(row, i)))),
+        'a8': (VG_LITE_A8, 1, lambda row, i: bytes((rgba(row, i)[3],))),
+        'l8': (VG_LITE_L8, 1, lambda row, i: bytes((rgba(row, i)[0],))),
+        'index8': (VG_LITE_INDEX_8, 1, lambda row, i: bytes((row[i],))),
+    }
+    vg_format, bpp, convert = formats[image_format]
+
+    # Pad the rows to the buffer alignment, the GPU can then read the pixels in place
+    stride = align_up(width * bpp, ASSET_ALIGN)
+    pixels = bytearray()
+    for row in rows:
+        line = b''.join(convert(row, i) for i in range(width))
+        pixels += line + bytes(stride - len(line))
+
+    print(f"{file_path}: {image_format} W{width}xH{height} stride {stride}, {len(clut)} CLUT entries")
+    return (ASSET_IMAGE, name, (vg_format, width, height, stride, x, y, color, clut, bytes(pixels)))
+
+
+# ---------------------------------------------------------------------------
+# Pack
+# ---------------------------------------------------------------------------
+
+def write_pack(output_file, entries):
+    table_size = 16 + len(entries) * (16 + ASSET_NAME_LEN)
+    offset = align_up(table_size, ASSET_ALIGN)
+    table = bytearray(struct.pack('<4sIII', ASSET_MAGIC, ASSET_VERSION, len(entries), 0))
+    payloads = bytearray(offset - table_size)
+
+    for entry_type, name, payload in entries:
+        if entry_type == ASSET_IMAGE:
+            vg_format, width, height, stride, x, y, color, clut, pixels = payload
+            header_size = 36 + len(clut) * 4
+            pixel_offset = align_up(offset + header_size, ASSET_ALIGN)
+            payload = struct.pack('<IIIIiiIII', vg_format, width, height, stride, x, y, color,
+                                  len(clut), pixel_offset)
+            payload += struct.pack(f'<{len(clut)}I', *clut)
+            payload += bytes(pixel_offset - offset - len(payload)) + pixels
+
+        encoded_name = name.encode('utf-8')[:ASSET_NAME_LEN]
+        table += struct.pack(f'<IIII{ASSET_NAME_LEN}s', entry_type, offset, len(payload), 0, encoded_name)
+        padding = align_up(len(payload), ASSET_ALIGN) - len(payload)
+        payloads += payload + bytes(padding)
+        offset += len(payload) + padding
+
+    with open(output_file, 'wb') as file:
+        file.write(table)
+        file.write(payloads)
+
+    print(f"Asset pack generated: {output_file}, {len(entries)} items, {len(table) + len(payloads)} bytes")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Convert SVG and PNG files into a vg_lite test asset pack.')
+    parser.add_argument('inputs', nargs='+', help='SVG or PNG files, a PNG may be placed with "<file>@<x>,<y>"')
+    parser.add_argument('-o', '--output', required=True, help='Output pack file')
+    parser.add_argument('--image-format', default='auto', choices=['auto', 'bgra8888', 'a8', 'l8', 'index8'],
+                        help='Image format, auto picks index8 for palette, l8 for gray and bgra8888 otherwise')
+    parser.add_argument('--image-color', default='0xFFFFFFFF',
+                        help='Multiply color of the a8 images, vg_lite_color_t 0xAABBGGRR')
+    args = parser.parse_args()
+
+    entries = []
+    for spec in args.inputs:
+        file_path, _, position = spec.partition('@')
+        x, y = (int(v) for v in position.split(',')) if position else (0, 0)
+        name = os.path.splitext(os.path.basename(file_path))[0]
+        if file_path.lower().endswith('.svg'):
+            entries += load_svg(file_path)
+        elif file_path.lower().endswith('.png'):
+            color = int(args.image_color, 0) if args.image_format == 'a8' else 0
+            entries.append(encode_image(name, file_path, x, y, args.image_format, color))
+        else:
+            print(f"Unsupported input file: {file_path}")
+            sys.exit(1)
+
+    if not entries:
+        print("Nothing to pack.")
+        sys.exit(1)
+
+    write_pack(args.output, entries)
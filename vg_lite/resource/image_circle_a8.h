@@ -24,6 +24,7 @@
 #ifndef IMAGE_CIRCLE_A8_H
 #define IMAGE_CIRCLE_A8_H
 
+#include "../../gpu_utils.h"
 #include <stdint.h>
 
 #define IMAGE_CIRCLE_A8_FORMAT VG_LITE_A8
@@ -31,7 +32,7 @@
 #define IMAGE_CIRCLE_A8_HEIGHT 100
 #define IMAGE_CIRCLE_A8_STRIDE (IMAGE_CIRCLE_A8_WIDTH * sizeof(uint8_t))
 
-static const uint32_t image_circle_a8_map[] = {
+static const uint32_t image_circle_a8_map[] GPU_ATTRIBUTE_ALIGNED(64) = {
     0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, /* 1 */
     0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
     0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
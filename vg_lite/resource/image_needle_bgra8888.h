@@ -24,6 +24,7 @@
 #ifndef IMAGE_BGRA8888_H
 #define IMAGE_BGRA8888_H
 
+#include "../../gpu_utils.h"
 #include <stdint.h>
 
 #define IMAGE_NEEDLE_BGRA8888_FORMAT VG_LITE_BGRA8888
@@ -33,7 +34,7 @@
 
 /* clang-format off */
 
-static const uint8_t image_needle_bgra8888_map[] = {
+static const uint8_t image_needle_bgra8888_map[] GPU_ATTRIBUTE_ALIGNED(64) = {
     0,  0,  0,   0,   0,  0,  0,   0,   0,  0,  0,   0,   0,  0,  0,   0,
     0,  0,  0,   0,   0,  0,  0,   0,   0,  0,  0,   0,   0,  0,  0,   0,
     0,  0,  0,   0,   0,  0,  0,   0,   0,  0,  0,   0,   0,  0,  0,   0,
@@ -0,0 +1,882 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#ifdef GPU_TEST_VG_LITE_STUB
+
+#include "../../gpu_log.h"
+#include "../../gpu_math.h"
+#include "../../gpu_tick.h"
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define STUB_PRODUCT_NAME "VGLite-Stub"
+#define STUB_CHIP_ID 0x0
+#define STUB_CHIP_REV 0x0
+#define STUB_CID 0x0
+
+#define STUB_MEM_SIZE_DEFAULT (16 * 1024 * 1024)
+
+/* Size of the color ramp image that update_grad() allocates */
+#define STUB_GRAD_IMAGE_SIZE (256 * 4)
+
+#define STUB_CHECK_ARG(expr)                                      \
+    do {                                                          \
+        if (!(expr)) {                                            \
+            GPU_LOG_ERROR("Invalid argument: '" #expr "' failed"); \
+            stub_ctx.invalid_count++;                             \
+            return VG_LITE_INVALID_ARGUMENT;                      \
+        }                                                         \
+    } while (0)
+
+#define STUB_CHECK_ERROR(func)              \
+    do {                                    \
+        vg_lite_error_t err = func;         \
+        if (err != VG_LITE_SUCCESS) {       \
+            return err;                     \
+        }                                   \
+    } while (0)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum stub_api_e {
+    STUB_API_CLEAR,
+    STUB_API_BLIT,
+    STUB_API_BLIT_RECT,
+    STUB_API_DRAW,
+    STUB_API_DRAW_PATTERN,
+    STUB_API_DRAW_GRAD,
+    STUB_API_DRAW_LINEAR_GRAD,
+    STUB_API_DRAW_RADIAL_GRAD,
+    STUB_API_FLUSH,
+    STUB_API_FINISH,
+    STUB_API_OTHER,
+    _STUB_API_LAST
+};
+
+struct vg_lite_stub_context_s {
+    bool initialized;
+
+    /* Configuration */
+    uint32_t draw_latency_us;
+    uint32_t finish_latency_us;
+    uint32_t error_rate;
+    vg_lite_error_t error_code;
+    uint32_t mem_size;
+    unsigned int seed;
+
+    /* Simulated GPU timeline */
+    uint32_t pending_us;
+    uint32_t busy_start_tick;
+    uint32_t busy_us;
+
+    /* Simulated GPU memory heap */
+    uint32_t mem_used;
+
+    /* State */
+    bool scissor_enabled;
+    uint32_t clut_count;
+
+    /* Statistics */
+    uint32_t call_count[_STUB_API_LAST];
+    uint32_t invalid_count;
+    uint32_t injected_count;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void stub_load_config(void);
+static vg_lite_error_t stub_submit(enum stub_api_e api);
+static vg_lite_error_t stub_check_buffer(const vg_lite_buffer_t* buffer);
+static vg_lite_error_t stub_check_path(const vg_lite_path_t* path);
+static vg_lite_error_t stub_mem_alloc(uint32_t size);
+static void stub_mem_free(uint32_t size);
+static void stub_matrix_multiply(vg_lite_matrix_t* matrix, const vg_lite_matrix_t* mult);
+static uint32_t stub_env_get_uint(const char* name, uint32_t def_value);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static struct vg_lite_stub_context_s stub_ctx;
+
+/* Guards the simulated GPU timeline, VG_LITE_GPU_IDLE_STATE may be queried from another thread */
+static pthread_mutex_t stub_busy_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char* stub_api_names[_STUB_API_LAST] = {
+    "clear",
+    "blit",
+    "blit_rect",
+    "draw",
+    "draw_pattern",
+    "draw_grad",
+    "draw_linear_grad",
+    "draw_radial_grad",
+    "flush",
+    "finish",
+    "other",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void gpu_init(void)
+{
+    memset(&stub_ctx, 0, sizeof(stub_ctx));
+    stub_load_config();
+    stub_ctx.initialized = true;
+
+    GPU_LOG_INFO("VG-Lite stub initialized: draw latency %" PRIu32 " us, finish latency %" PRIu32
+                 " us, error rate %" PRIu32 "/10000 (%d), memory %" PRIu32 " bytes",
+        stub_ctx.draw_latency_us,
+        stub_ctx.finish_latency_us,
+        stub_ctx.error_rate,
+        (int)stub_ctx.error_code,
+        stub_ctx.mem_size);
+}
+
+void gpu_deinit(void)
+{
+    GPU_LOG_INFO("VG-Lite stub statistics:");
+    for (int i = 0; i < _STUB_API_LAST; i++) {
+        GPU_LOG_INFO("  %-18s: %" PRIu32, stub_api_names[i], stub_ctx.call_count[i]);
+    }
+
+    GPU_LOG_INFO("  invalid arguments : %" PRIu32, stub_ctx.invalid_count);
+    GPU_LOG_INFO("  injected errors   : %" PRIu32, stub_ctx.injected_count);
+    GPU_LOG_INFO("  memory in use     : %" PRIu32 " bytes", stub_ctx.mem_used);
+
+    stub_ctx.initialized = false;
+}
+
+vg_lite_error_t vg_lite_init(vg_lite_int32_t tess_width, vg_lite_int32_t tess_height)
+{
+    if (!stub_ctx.initialized) {
+        gpu_init();
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_close(void)
+{
+    gpu_deinit();
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_flush(void)
+{
+    stub_ctx.call_count[STUB_API_FLUSH]++;
+
+    if (stub_ctx.pending_us == 0) {
+        return VG_LITE_SUCCESS;
+    }
+
+    /* Queue the pending work behind whatever the GPU is still executing */
+    pthread_mutex_lock(&stub_busy_lock);
+    uint32_t remain_us = 0;
+    uint32_t elaps_us = gpu_tick_elaps(stub_ctx.busy_start_tick);
+    if (elaps_us < stub_ctx.busy_us) {
+        remain_us = stub_ctx.busy_us - elaps_us;
+    }
+
+    stub_ctx.busy_start_tick = gpu_tick_get();
+    stub_ctx.busy_us = remain_us + stub_ctx.pending_us;
+    pthread_mutex_unlock(&stub_busy_lock);
+    stub_ctx.pending_us = 0;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_finish(void)
+{
+    STUB_CHECK_ERROR(stub_submit(STUB_API_FINISH));
+    STUB_CHECK_ERROR(vg_lite_flush());
+
+    /* Wait for the simulated GPU to become idle */
+    pthread_mutex_lock(&stub_busy_lock);
+    uint32_t elaps_us = gpu_tick_elaps(stub_ctx.busy_start_tick);
+    uint32_t wait_us = stub_ctx.finish_latency_us;
+    if (elaps_us < stub_ctx.busy_us) {
+        wait_us += stub_ctx.busy_us - elaps_us;
+    }
+    pthread_mutex_unlock(&stub_busy_lock);
+
+    if (wait_us > 0) {
+        uint32_t start_tick = gpu_tick_get();
+        while (gpu_tick_elaps(start_tick) < wait_us) {
+            /* Busy wait to keep the latency accurate */
+        }
+    }
+
+    pthread_mutex_lock(&stub_busy_lock);
+    stub_ctx.busy_us = 0;
+    pthread_mutex_unlock(&stub_busy_lock);
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_allocate(vg_lite_buffer_t* buffer)
+{
+    STUB_CHECK_ARG(buffer != NULL);
+    STUB_CHECK_ARG(buffer->width > 0 && buffer->height > 0);
+
+    /* Assume 32bpp when the stride is not given */
+    if (buffer->stride == 0) {
+        buffer->stride = buffer->width * 4;
+    }
+
+    uint32_t size = buffer->stride * buffer->height;
+    STUB_CHECK_ERROR(stub_mem_alloc(size));
+
+    buffer->memory = calloc(1, size);
+    if (!buffer->memory) {
+        stub_mem_free(size);
+        return VG_LITE_OUT_OF_MEMORY;
+    }
+
+    buffer->handle = buffer->memory;
+    buffer->address = (vg_lite_uint32_t)(uintptr_t)buffer->memory;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_free(vg_lite_buffer_t* buffer)
+{
+    STUB_CHECK_ARG(buffer != NULL);
+    STUB_CHECK_ARG(buffer->handle != NULL);
+
+    stub_mem_free(buffer->stride * buffer->height);
+    free(buffer->handle);
+    buffer->handle = NULL;
+    buffer->memory = NULL;
+    buffer->address = 0;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_get_register(vg_lite_uint32_t address, vg_lite_uint32_t* result)
+{
+    STUB_CHECK_ARG(result != NULL);
+    *result = (address == 0x30) ? STUB_CID : 0;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_get_info(vg_lite_info_t* info)
+{
+    STUB_CHECK_ARG(info != NULL);
+    memset(info, 0, sizeof(vg_lite_info_t));
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_uint32_t vg_lite_get_product_info(vg_lite_char* name, vg_lite_uint32_t* chip_id, vg_lite_uint32_t* chip_rev)
+{
+    if (name) {
+        strcpy(name, STUB_PRODUCT_NAME);
+    }
+
+    if (chip_id) {
+        *chip_id = STUB_CHIP_ID;
+    }
+
+    if (chip_rev) {
+        *chip_rev = STUB_CHIP_REV;
+    }
+
+    return sizeof(STUB_PRODUCT_NAME);
+}
+
+vg_lite_uint32_t vg_lite_query_feature(vg_lite_feature_t feature)
+{
+    switch (feature) {
+    case gcFEATURE_BIT_VG_16PIXELS_ALIGN:
+        return 0;
+
+    default:
+        break;
+    }
+
+    return (feature >= 0 && feature < gcFEATURE_COUNT) ? 1 : 0;
+}
+
+vg_lite_error_t vg_lite_get_mem_size(vg_lite_uint32_t* size)
+{
+    STUB_CHECK_ARG(size != NULL);
+    *size = stub_ctx.mem_size - stub_ctx.mem_used;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_dump_command_buffer(void)
+{
+    GPU_LOG_INFO("Stub command buffer: %" PRIu32 " us pending, %" PRIu32 " us busy",
+        stub_ctx.pending_us, stub_ctx.busy_us);
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_get_parameter(vg_lite_param_type_t type, vg_lite_int32_t count, vg_lite_pointer params)
+{
+    STUB_CHECK_ARG(params != NULL);
+    STUB_CHECK_ARG(count > 0);
+
+    switch (type) {
+    case VG_LITE_GPU_IDLE_STATE: {
+        pthread_mutex_lock(&stub_busy_lock);
+        uint32_t elaps_us = gpu_tick_elaps(stub_ctx.busy_start_tick);
+        *(vg_lite_uint32_t*)params = (elaps_us >= stub_ctx.busy_us);
+        pthread_mutex_unlock(&stub_busy_lock);
+    } break;
+
+    default:
+        memset(params, 0, count * sizeof(vg_lite_uint32_t));
+        break;
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_clear(vg_lite_buffer_t* target, vg_lite_rectangle_t* rect, vg_lite_color_t color)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    if (rect) {
+        STUB_CHECK_ARG(rect->width >= 0 && rect->height >= 0);
+    }
+
+    return stub_submit(STUB_API_CLEAR);
+}
+
+vg_lite_error_t vg_lite_blit(
+    vg_lite_buffer_t* target,
+    vg_lite_buffer_t* source,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    STUB_CHECK_ERROR(stub_check_buffer(source));
+    if (source->format == VG_LITE_INDEX_8) {
+        STUB_CHECK_ARG(stub_ctx.clut_count == 256);
+    }
+
+    return stub_submit(STUB_API_BLIT);
+}
+
+vg_lite_error_t vg_lite_blit_rect(
+    vg_lite_buffer_t* target,
+    vg_lite_buffer_t* source,
+    vg_lite_rectangle_t* rect,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    STUB_CHECK_ERROR(stub_check_buffer(source));
+    STUB_CHECK_ARG(rect != NULL);
+    STUB_CHECK_ARG(rect->x >= 0 && rect->y >= 0);
+    STUB_CHECK_ARG(rect->x + rect->width <= source->width);
+    STUB_CHECK_ARG(rect->y + rect->height <= source->height);
+    return stub_submit(STUB_API_BLIT_RECT);
+}
+
+vg_lite_error_t vg_lite_draw(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    STUB_CHECK_ERROR(stub_check_path(path));
+    STUB_CHECK_ARG(matrix != NULL);
+    STUB_CHECK_ARG(fill_rule == VG_LITE_FILL_NON_ZERO || fill_rule == VG_LITE_FILL_EVEN_ODD);
+    return stub_submit(STUB_API_DRAW);
+}
+
+vg_lite_error_t vg_lite_draw_pattern(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_buffer_t* pattern_image,
+    vg_lite_matrix_t* pattern_matrix,
+    vg_lite_blend_t blend,
+    vg_lite_pattern_mode_t pattern_mode,
+    vg_lite_color_t pattern_color,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    STUB_CHECK_ERROR(stub_check_path(path));
+    STUB_CHECK_ERROR(stub_check_buffer(pattern_image));
+    STUB_CHECK_ARG(path_matrix != NULL);
+    STUB_CHECK_ARG(pattern_matrix != NULL);
+    return stub_submit(STUB_API_DRAW_PATTERN);
+}
+
+vg_lite_error_t vg_lite_draw_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* matrix,
+    vg_lite_linear_gradient_t* grad,
+    vg_lite_blend_t blend)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    STUB_CHECK_ERROR(stub_check_path(path));
+    STUB_CHECK_ARG(matrix != NULL);
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(grad->image.handle != NULL);
+    return stub_submit(STUB_API_DRAW_GRAD);
+}
+
+vg_lite_error_t vg_lite_draw_linear_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_ext_linear_gradient_t* grad,
+    vg_lite_color_t paint_color,
+    vg_lite_blend_t blend,
+    vg_lite_filter_t filter)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    STUB_CHECK_ERROR(stub_check_path(path));
+    STUB_CHECK_ARG(path_matrix != NULL);
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(grad->image.handle != NULL);
+    return stub_submit(STUB_API_DRAW_LINEAR_GRAD);
+}
+
+vg_lite_error_t vg_lite_draw_radial_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_radial_gradient_t* grad,
+    vg_lite_color_t paint_color,
+    vg_lite_blend_t blend,
+    vg_lite_filter_t filter)
+{
+    STUB_CHECK_ERROR(stub_check_buffer(target));
+    STUB_CHECK_ERROR(stub_check_path(path));
+    STUB_CHECK_ARG(path_matrix != NULL);
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(grad->image.handle != NULL);
+    return stub_submit(STUB_API_DRAW_RADIAL_GRAD);
+}
+
+vg_lite_error_t vg_lite_init_path(
+    vg_lite_path_t* path,
+    vg_lite_format_t data_format,
+    vg_lite_quality_t quality,
+    vg_lite_uint32_t path_length,
+    vg_lite_pointer path_data,
+    vg_lite_float_t min_x, vg_lite_float_t min_y,
+    vg_lite_float_t max_x, vg_lite_float_t max_y)
+{
+    STUB_CHECK_ARG(path != NULL);
+    STUB_CHECK_ARG(data_format >= VG_LITE_S8 && data_format <= VG_LITE_FP32);
+
+    memset(path, 0, sizeof(vg_lite_path_t));
+    path->format = data_format;
+    path->quality = quality;
+    path->path_length = path_length;
+    path->path = path_data;
+    path->bounding_box[0] = min_x;
+    path->bounding_box[1] = min_y;
+    path->bounding_box[2] = max_x;
+    path->bounding_box[3] = max_y;
+    path->path_changed = 1;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_clear_path(vg_lite_path_t* path)
+{
+    STUB_CHECK_ARG(path != NULL);
+    path->path_length = 0;
+    path->path = NULL;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_init_grad(vg_lite_linear_gradient_t* grad)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    memset(grad, 0, sizeof(vg_lite_linear_gradient_t));
+    vg_lite_identity(&grad->matrix);
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_set_grad(vg_lite_linear_gradient_t* grad, vg_lite_uint32_t count, vg_lite_uint32_t* colors, vg_lite_uint32_t* stops)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(colors != NULL && stops != NULL);
+    STUB_CHECK_ARG(count > 0 && count <= VLC_MAX_GRADIENT_STOPS);
+
+    grad->count = count;
+    memcpy(grad->colors, colors, count * sizeof(vg_lite_uint32_t));
+    memcpy(grad->stops, stops, count * sizeof(vg_lite_uint32_t));
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_update_grad(vg_lite_linear_gradient_t* grad)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(grad->count > 0);
+
+    if (grad->image.handle) {
+        return VG_LITE_SUCCESS;
+    }
+
+    grad->image.width = STUB_GRAD_IMAGE_SIZE / 4;
+    grad->image.height = 1;
+    grad->image.stride = STUB_GRAD_IMAGE_SIZE;
+    grad->image.format = VG_LITE_BGRA8888;
+    return vg_lite_allocate(&grad->image);
+}
+
+vg_lite_error_t vg_lite_clear_grad(vg_lite_linear_gradient_t* grad)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    grad->count = 0;
+    if (grad->image.handle) {
+        return vg_lite_free(&grad->image);
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_matrix_t* vg_lite_get_grad_matrix(vg_lite_linear_gradient_t* grad)
+{
+    return grad ? &grad->matrix : NULL;
+}
+
+vg_lite_error_t vg_lite_set_linear_grad(
+    vg_lite_ext_linear_gradient_t* grad,
+    vg_lite_uint32_t count,
+    vg_lite_color_ramp_t* color_ramp,
+    vg_lite_linear_gradient_parameter_t grad_param,
+    vg_lite_gradient_spreadmode_t spread_mode,
+    vg_lite_uint8_t color_ramp_premultiplied)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(color_ramp != NULL);
+    STUB_CHECK_ARG(count > 0 && count <= MAX_COLOR_RAMP_STOPS);
+
+    grad->count = count;
+    grad->ramp_length = count;
+    memcpy(grad->color_ramp, color_ramp, count * sizeof(vg_lite_color_ramp_t));
+    grad->linear_grad = grad_param;
+    grad->spread_mode = spread_mode;
+    grad->pre_multiplied = color_ramp_premultiplied;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_update_linear_grad(vg_lite_ext_linear_gradient_t* grad)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(grad->ramp_length > 0);
+
+    if (grad->image.handle) {
+        return VG_LITE_SUCCESS;
+    }
+
+    grad->image.width = STUB_GRAD_IMAGE_SIZE / 4;
+    grad->image.height = 1;
+    grad->image.stride = STUB_GRAD_IMAGE_SIZE;
+    grad->image.format = VG_LITE_BGRA8888;
+    return vg_lite_allocate(&grad->image);
+}
+
+vg_lite_error_t vg_lite_clear_linear_grad(vg_lite_ext_linear_gradient_t* grad)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    grad->count = 0;
+    if (grad->image.handle) {
+        return vg_lite_free(&grad->image);
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_matrix_t* vg_lite_get_linear_grad_matrix(vg_lite_ext_linear_gradient_t* grad)
+{
+    return grad ? &grad->matrix : NULL;
+}
+
+vg_lite_error_t vg_lite_set_radial_grad(
+    vg_lite_radial_gradient_t* grad,
+    vg_lite_uint32_t count,
+    vg_lite_color_ramp_t* color_ramp,
+    vg_lite_radial_gradient_parameter_t grad_param,
+    vg_lite_gradient_spreadmode_t spread_mode,
+    vg_lite_uint8_t color_ramp_premultiplied)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(color_ramp != NULL);
+    STUB_CHECK_ARG(count > 0 && count <= MAX_COLOR_RAMP_STOPS);
+    STUB_CHECK_ARG(grad_param.r > 0);
+
+    grad->count = count;
+    grad->ramp_length = count;
+    memcpy(grad->color_ramp, color_ramp, count * sizeof(vg_lite_color_ramp_t));
+    grad->radial_grad = grad_param;
+    grad->spread_mode = spread_mode;
+    grad->pre_multiplied = color_ramp_premultiplied;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_update_radial_grad(vg_lite_radial_gradient_t* grad)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    STUB_CHECK_ARG(grad->ramp_length > 0);
+
+    if (grad->image.handle) {
+        return VG_LITE_SUCCESS;
+    }
+
+    grad->image.width = STUB_GRAD_IMAGE_SIZE / 4;
+    grad->image.height = 1;
+    grad->image.stride = STUB_GRAD_IMAGE_SIZE;
+    grad->image.format = VG_LITE_BGRA8888;
+    return vg_lite_allocate(&grad->image);
+}
+
+vg_lite_error_t vg_lite_clear_radial_grad(vg_lite_radial_gradient_t* grad)
+{
+    STUB_CHECK_ARG(grad != NULL);
+    grad->count = 0;
+    if (grad->image.handle) {
+        return vg_lite_free(&grad->image);
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_matrix_t* vg_lite_get_radial_grad_matrix(vg_lite_radial_gradient_t* grad)
+{
+    return grad ? &grad->matrix : NULL;
+}
+
+vg_lite_error_t vg_lite_identity(vg_lite_matrix_t* matrix)
+{
+    STUB_CHECK_ARG(matrix != NULL);
+    memset(matrix, 0, sizeof(vg_lite_matrix_t));
+    matrix->m[0][0] = 1.0f;
+    matrix->m[1][1] = 1.0f;
+    matrix->m[2][2] = 1.0f;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_translate(vg_lite_float_t x, vg_lite_float_t y, vg_lite_matrix_t* matrix)
+{
+    STUB_CHECK_ARG(matrix != NULL);
+    vg_lite_matrix_t t = {
+        { { 1.0f, 0.0f, x },
+            { 0.0f, 1.0f, y },
+            { 0.0f, 0.0f, 1.0f } }
+    };
+    stub_matrix_multiply(matrix, &t);
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_rotate(vg_lite_float_t degrees, vg_lite_matrix_t* matrix)
+{
+    STUB_CHECK_ARG(matrix != NULL);
+    float angle = MATH_RADIANS(degrees);
+    float c = MATH_COSF(angle);
+    float s = MATH_SINF(angle);
+    vg_lite_matrix_t r = {
+        { { c, -s, 0.0f },
+            { s, c, 0.0f },
+            { 0.0f, 0.0f, 1.0f } }
+    };
+    stub_matrix_multiply(matrix, &r);
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_scale(vg_lite_float_t scale_x, vg_lite_float_t scale_y, vg_lite_matrix_t* matrix)
+{
+    STUB_CHECK_ARG(matrix != NULL);
+    vg_lite_matrix_t s = {
+        { { scale_x, 0.0f, 0.0f },
+            { 0.0f, scale_y, 0.0f },
+            { 0.0f, 0.0f, 1.0f } }
+    };
+    stub_matrix_multiply(matrix, &s);
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_set_CLUT(vg_lite_uint32_t count, vg_lite_uint32_t* colors)
+{
+    STUB_CHECK_ARG(colors != NULL);
+    STUB_CHECK_ARG(count == 2 || count == 4 || count == 16 || count == 256);
+    stub_ctx.clut_count = count;
+    stub_ctx.call_count[STUB_API_OTHER]++;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_set_scissor(vg_lite_int32_t x, vg_lite_int32_t y, vg_lite_int32_t right, vg_lite_int32_t bottom)
+{
+    STUB_CHECK_ARG(right >= x && bottom >= y);
+    stub_ctx.call_count[STUB_API_OTHER]++;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_enable_scissor(void)
+{
+    stub_ctx.scissor_enabled = true;
+    stub_ctx.call_count[STUB_API_OTHER]++;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_disable_scissor(void)
+{
+    stub_ctx.scissor_enabled = false;
+    stub_ctx.call_count[STUB_API_OTHER]++;
+    return VG_LITE_SUCCESS;
+}
+
+vg_lite_error_t vg_lite_gaussian_filter(vg_lite_float_t w0, vg_lite_float_t w1, vg_lite_float_t w2)
+{
+    STUB_CHECK_ARG(w0 >= 0 && w1 >= 0 && w2 >= 0);
+    stub_ctx.call_count[STUB_API_OTHER]++;
+    return VG_LITE_SUCCESS;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * The stub is configured from the environment:
+ * VG_LITE_STUB_DRAW_LATENCY_US   simulated GPU time of each draw call
+ * VG_LITE_STUB_FINISH_LATENCY_US fixed cost of vg_lite_finish
+ * VG_LITE_STUB_ERROR_RATE        injected errors per 10000 submitted calls
+ * VG_LITE_STUB_ERROR_CODE        the injected vg_lite_error_t, default VG_LITE_OUT_OF_MEMORY
+ * VG_LITE_STUB_MEM_SIZE          size of the simulated GPU heap in bytes
+ * VG_LITE_STUB_SEED              seed of the error injection
+ */
+static void stub_load_config(void)
+{
+    stub_ctx.draw_latency_us = stub_env_get_uint("VG_LITE_STUB_DRAW_LATENCY_US", 0);
+    stub_ctx.finish_latency_us = stub_env_get_uint("VG_LITE_STUB_FINISH_LATENCY_US", 0);
+    stub_ctx.error_rate = stub_env_get_uint("VG_LITE_STUB_ERROR_RATE", 0);
+    stub_ctx.error_code = (vg_lite_error_t)stub_env_get_uint("VG_LITE_STUB_ERROR_CODE", VG_LITE_OUT_OF_MEMORY);
+    stub_ctx.mem_size = stub_env_get_uint("VG_LITE_STUB_MEM_SIZE", STUB_MEM_SIZE_DEFAULT);
+    stub_ctx.seed = stub_env_get_uint("VG_LITE_STUB_SEED", 1);
+}
+
+static vg_lite_error_t stub_submit(enum stub_api_e api)
+{
+    stub_ctx.call_count[api]++;
+
+    if (stub_ctx.error_rate > 0 && (uint32_t)(rand_r(&stub_ctx.seed) % 10000) < stub_ctx.error_rate) {
+        stub_ctx.injected_count++;
+        GPU_LOG_WARN("Injecting error %d into '%s'", (int)stub_ctx.error_code, stub_api_names[api]);
+        return stub_ctx.error_code;
+    }
+
+    if (api != STUB_API_FINISH) {
+        stub_ctx.pending_us += stub_ctx.draw_latency_us;
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t stub_check_buffer(const vg_lite_buffer_t* buffer)
+{
+    STUB_CHECK_ARG(buffer != NULL);
+    STUB_CHECK_ARG(buffer->memory != NULL);
+    STUB_CHECK_ARG(buffer->width > 0 && buffer->height > 0);
+    STUB_CHECK_ARG(buffer->stride > 0);
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t stub_check_path(const vg_lite_path_t* path)
+{
+    STUB_CHECK_ARG(path != NULL);
+    STUB_CHECK_ARG(path->format >= VG_LITE_S8 && path->format <= VG_LITE_FP32);
+    STUB_CHECK_ARG(path->path_length == 0 || path->path != NULL);
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t stub_mem_alloc(uint32_t size)
+{
+    if (stub_ctx.mem_used + size > stub_ctx.mem_size) {
+        GPU_LOG_WARN("Stub memory exhausted: %" PRIu32 " + %" PRIu32 " > %" PRIu32,
+            stub_ctx.mem_used, size, stub_ctx.mem_size);
+        return VG_LITE_OUT_OF_MEMORY;
+    }
+
+    stub_ctx.mem_used += size;
+    return VG_LITE_SUCCESS;
+}
+
+static void stub_mem_free(uint32_t size)
+{
+    stub_ctx.mem_used = (size > stub_ctx.mem_used) ? 0 : stub_ctx.mem_used - size;
+}
+
+static void stub_matrix_multiply(vg_lite_matrix_t* matrix, const vg_lite_matrix_t* mult)
+{
+    vg_lite_matrix_t temp;
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) {
+            temp.m[row][column] = matrix->m[row][0] * mult->m[0][column]
+                + matrix->m[row][1] * mult->m[1][column]
+                + matrix->m[row][2] * mult->m[2][column];
+        }
+    }
+
+    *matrix = temp;
+}
+
+static uint32_t stub_env_get_uint(const char* name, uint32_t def_value)
+{
+    const char* value = getenv(name);
+    if (!value || value[0] == '\0') {
+        return def_value;
+    }
+
+    return (uint32_t)strtoul(value, NULL, 0);
+}
+
+#endif /* GPU_TEST_VG_LITE_STUB */
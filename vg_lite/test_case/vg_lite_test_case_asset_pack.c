@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../vg_lite_test_asset.h"
+#include "../vg_lite_test_context.h"
+#include "../vg_lite_test_utils.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static vg_lite_error_t draw_image(struct vg_lite_test_context_s* ctx, struct vg_lite_test_asset_item_s* item)
+{
+    vg_lite_matrix_t matrix;
+    vg_lite_test_context_get_transform(ctx, &matrix);
+    vg_lite_translate(item->x, item->y, &matrix);
+
+    if (item->clut_count) {
+        VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_set_CLUT(item->clut_count, (vg_lite_uint32_t*)item->clut));
+    }
+
+    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_blit(
+        vg_lite_test_context_get_target_buffer(ctx),
+        &item->image,
+        &matrix,
+        VG_LITE_BLEND_SRC_OVER,
+        item->color,
+        VG_LITE_FILTER_BI_LINEAR));
+
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t on_setup(struct vg_lite_test_context_s* ctx)
+{
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t on_draw(struct vg_lite_test_context_s* ctx)
+{
+    struct vg_lite_test_asset_s* asset = vg_lite_test_context_get_asset(ctx);
+
+    vg_lite_matrix_t matrix;
+    vg_lite_test_context_get_transform(ctx, &matrix);
+
+    vg_lite_buffer_t* target_buffer = vg_lite_test_context_get_target_buffer(ctx);
+
+    /* Draw in the pack order, the paths and images are layered as in the source files */
+    uint32_t count = vg_lite_test_asset_get_count(asset);
+    for (uint32_t i = 0; i < count; i++) {
+        struct vg_lite_test_asset_item_s* item = vg_lite_test_asset_get_item(asset, i);
+
+        switch (item->type) {
+        case VG_LITE_TEST_ASSET_PATH:
+            VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_draw(
+                target_buffer,
+                &item->path,
+                item->fill_rule,
+                &matrix,
+                VG_LITE_BLEND_SRC_OVER,
+                item->color));
+            break;
+
+        case VG_LITE_TEST_ASSET_IMAGE:
+            VG_LITE_TEST_CHECK_ERROR_RETURN(draw_image(ctx, item));
+            break;
+
+        default:
+            return VG_LITE_INVALID_ARGUMENT;
+        }
+
+        VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_test_idle_flush());
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t on_teardown(struct vg_lite_test_context_s* ctx)
+{
+    return VG_LITE_SUCCESS;
+}
+
+VG_LITE_TEST_CASE_ITEM_DEF(asset_pack, ASSET_PACK, "Draw the paths and images of the --asset pack");
@@ -62,7 +62,7 @@ static vg_lite_error_t on_setup(struct vg_lite_test_context_s* ctx)
 {
     vg_lite_buffer_t* target_buffer = vg_lite_test_context_get_target_buffer(ctx);
 
-    vg_lite_test_context_load_src_image(
+    vg_lite_test_context_bind_src_image(
         ctx,
         image_needle_bgra8888_map,
         IMAGE_NEEDLE_BGRA8888_WIDTH,
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../vg_lite_test_context.h"
+#include "../vg_lite_test_utils.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* The blits of a variant are spread over a grid to avoid drawing the same pixels only */
+#define BLIT_GRID_COLUMNS 4
+#define BLIT_GRID_STEP 16
+
+#define BLIT_COUNT 16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const struct vg_lite_test_param_s blit_sweep_params[] = {
+    /* Throughput versus source size */
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 32, 32, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 64, 64, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 128, 128, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 256, 256, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 480, 480, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+
+    /* Format conversion at a fixed size */
+    { VG_LITE_BGRA8888, VG_LITE_BGR565, 256, 256, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGRA8888, VG_LITE_BGRX8888, 256, 256, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGR565, VG_LITE_BGRA8888, 256, 256, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGR565, VG_LITE_BGR565, 256, 256, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_BI_LINEAR },
+
+    /* Blending and filtering cost */
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 256, 256, BLIT_COUNT, VG_LITE_BLEND_NONE, VG_LITE_FILTER_POINT },
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 256, 256, BLIT_COUNT, VG_LITE_BLEND_NONE, VG_LITE_FILTER_BI_LINEAR },
+    { VG_LITE_BGRA8888, VG_LITE_BGRA8888, 256, 256, BLIT_COUNT, VG_LITE_BLEND_SRC_OVER, VG_LITE_FILTER_POINT },
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static vg_lite_error_t on_setup(struct vg_lite_test_context_s* ctx)
+{
+    const struct vg_lite_test_param_s* param = vg_lite_test_context_get_param(ctx);
+    vg_lite_buffer_t* target_buffer = vg_lite_test_context_get_target_buffer(ctx);
+
+    vg_lite_buffer_t* image = vg_lite_test_context_alloc_src_buffer(
+        ctx, param->width, param->height, param->src_format, VG_LITE_TEST_STRIDE_AUTO);
+
+    /* Let the GPU draw the source, the CPU would need a writer for every format of the table */
+    int32_t half_width = param->width / 2;
+    int32_t half_height = param->height / 2;
+    vg_lite_rectangle_t quarter_0 = { 0, 0, half_width, half_height };
+    vg_lite_rectangle_t quarter_1 = { half_width, half_height, param->width - half_width, param->height - half_height };
+    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_clear(image, NULL, 0xFF0000FF));
+    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_clear(image, &quarter_0, 0xFF00FF00));
+    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_clear(image, &quarter_1, 0x7FFF0000));
+
+    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_clear(target_buffer, NULL, 0xFFFFFFFF));
+    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_finish());
+
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t on_draw(struct vg_lite_test_context_s* ctx)
+{
+    const struct vg_lite_test_param_s* param = vg_lite_test_context_get_param(ctx);
+    vg_lite_buffer_t* target_buffer = vg_lite_test_context_get_target_buffer(ctx);
+    vg_lite_buffer_t* image = vg_lite_test_context_get_src_buffer(ctx);
+
+    vg_lite_matrix_t base_matrix;
+    vg_lite_test_context_get_transform(ctx, &base_matrix);
+
+    for (uint32_t i = 0; i < param->count; i++) {
+        vg_lite_matrix_t matrix = base_matrix;
+        vg_lite_translate(
+            (i % BLIT_GRID_COLUMNS) * BLIT_GRID_STEP,
+            (i / BLIT_GRID_COLUMNS) * BLIT_GRID_STEP,
+            &matrix);
+
+        VG_LITE_TEST_CHECK_ERROR_RETURN(
+            vg_lite_blit(
+                target_buffer,
+                image,
+                &matrix,
+                param->blend,
+                0,
+                param->filter));
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t on_teardown(struct vg_lite_test_context_s* ctx)
+{
+    return VG_LITE_SUCCESS;
+}
+
+VG_LITE_TEST_CASE_ITEM_PARAM_DEF(blit_sweep, NONE, "Blit a generated image over a sweep of sizes formats blend modes and filters", blit_sweep_params);
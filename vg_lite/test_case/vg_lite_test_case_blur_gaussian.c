@@ -59,7 +59,7 @@
 
 static vg_lite_error_t on_setup(struct vg_lite_test_context_s* ctx)
 {
-    vg_lite_test_context_load_src_image(
+    vg_lite_test_context_bind_src_image(
         ctx,
         imgae_cogwheel_index8_map,
         IMAGE_COGWHEEL_INDEX8_WIDTH,
@@ -25,9 +25,11 @@
  *      INCLUDES
  *********************/
 
+#include "../../gpu_assert.h"
 #include "../vg_lite_test_context.h"
 #include "../vg_lite_test_path.h"
 #include "../vg_lite_test_utils.h"
+#include <stdlib.h>
 
 /*********************
  *      DEFINES
@@ -72,23 +74,23 @@ static vg_lite_error_t on_setup(struct vg_lite_test_context_s* ctx)
         .Y1 = 100,
     };
 
-    static vg_lite_ext_linear_gradient_t linear_grad;
+    vg_lite_ext_linear_gradient_t* linear_grad = calloc(1, sizeof(vg_lite_ext_linear_gradient_t));
+    GPU_ASSERT_NULL(linear_grad);
+    vg_lite_test_context_set_user_data(ctx, linear_grad);
 
     VG_LITE_TEST_CHECK_ERROR_RETURN(
         vg_lite_set_linear_grad(
-            &linear_grad,
+            linear_grad,
             sizeof(color_ramp) / sizeof(vg_lite_color_ramp_t),
             color_ramp,
             grad_param,
             VG_LITE_GRADIENT_SPREAD_PAD,
             1));
 
-    vg_lite_matrix_t* grad_mat_p = vg_lite_get_linear_grad_matrix(&linear_grad);
+    vg_lite_matrix_t* grad_mat_p = vg_lite_get_linear_grad_matrix(linear_grad);
     vg_lite_identity(grad_mat_p);
 
-    vg_lite_test_context_set_user_data(ctx, &linear_grad);
-
-    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_update_linear_grad(&linear_grad));
+    VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_update_linear_grad(linear_grad));
 
     return VG_LITE_SUCCESS;
 }
@@ -123,7 +125,8 @@ static vg_lite_error_t on_teardown(struct vg_lite_test_context_s* ctx)
 {
     vg_lite_ext_linear_gradient_t* linear_grad = vg_lite_test_context_get_user_data(ctx);
     if (linear_grad) {
-        VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_clear_linear_grad(linear_grad));
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_clear_linear_grad(linear_grad));
+        free(linear_grad);
     }
     return VG_LITE_SUCCESS;
 }
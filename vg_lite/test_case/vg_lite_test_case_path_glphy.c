@@ -26,8 +26,10 @@
  *********************/
 
 #include "../resource/glphy_paths.h"
+#include "../../gpu_assert.h"
 #include "../vg_lite_test_context.h"
 #include "../vg_lite_test_utils.h"
+#include <stdlib.h>
 
 /*********************
  *      DEFINES
@@ -59,19 +61,25 @@
 
 static vg_lite_error_t on_setup(struct vg_lite_test_context_s* ctx)
 {
-    return VG_LITE_SUCCESS;
-}
+    /* The GPU reads the path until the finish after on_draw, it is released in the teardown */
+    vg_lite_path_t* path = calloc(1, sizeof(vg_lite_path_t));
+    GPU_ASSERT_NULL(path);
+    vg_lite_test_context_set_user_data(ctx, path);
 
-static vg_lite_error_t on_draw(struct vg_lite_test_context_s* ctx)
-{
-    vg_lite_path_t path;
     VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_init_path(
-        &path,
+        path,
         VG_LITE_S16,
         VG_LITE_HIGH,
         sizeof(glphy_u9f8d_path_data),
         (void*)glphy_u9f8d_path_data, -10000, -10000, 10000, 10000));
 
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t on_draw(struct vg_lite_test_context_s* ctx)
+{
+    vg_lite_path_t* path = vg_lite_test_context_get_user_data(ctx);
+
     vg_lite_matrix_t matrix;
     vg_lite_test_context_get_transform(ctx, &matrix);
     vg_lite_translate(0, 50, &matrix);
@@ -84,7 +92,7 @@ static vg_lite_error_t on_draw(struct vg_lite_test_context_s* ctx)
         VG_LITE_TEST_CHECK_ERROR_RETURN(
             vg_lite_draw(
                 target_buffer,
-                &path,
+                path,
                 VG_LITE_FILL_NON_ZERO,
                 &matrix,
                 VG_LITE_BLEND_SRC_OVER,
@@ -96,6 +104,12 @@ static vg_lite_error_t on_draw(struct vg_lite_test_context_s* ctx)
 
 static vg_lite_error_t on_teardown(struct vg_lite_test_context_s* ctx)
 {
+    vg_lite_path_t* path = vg_lite_test_context_get_user_data(ctx);
+    if (path) {
+        /* Release the memory the driver attached to the path */
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_clear_path(path));
+        free(path);
+    }
     return VG_LITE_SUCCESS;
 }
 
@@ -73,7 +73,7 @@ static vg_lite_error_t on_setup(struct vg_lite_test_context_s* ctx)
     VG_LITE_TEST_CHECK_ERROR_RETURN(vg_lite_enable_scissor());
 #endif
 
-    vg_lite_test_context_load_src_image(
+    vg_lite_test_context_bind_src_image(
         ctx,
         image_circle_a8_map,
         IMAGE_CIRCLE_A8_WIDTH,
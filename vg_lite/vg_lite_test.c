@@ -25,13 +25,17 @@
  *      INCLUDES
  *********************/
 
+#include "../gpu_assert.h"
 #include "../gpu_context.h"
 #include "../gpu_log.h"
 #include "../gpu_recorder.h"
 #include "../gpu_screenshot.h"
 #include "../gpu_tick.h"
 #include "vg_lite_test_context.h"
+#include "vg_lite_test_latency.h"
 #include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -39,20 +43,33 @@
  *      DEFINES
  *********************/
 
+/* vg_lite_finish waits for all the submitted work, one item in flight is all that can be told apart */
+#define PIPELINE_DEPTH 2
+
+/* Enough for the item name and every parameter of a variant */
+#define VARIANT_NAME_LEN 128
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+struct vg_lite_test_variant_s {
+    struct vg_lite_test_item_s item;
+    char name[VARIANT_NAME_LEN];
+};
+
 struct vg_lite_test_iter_s {
     enum gpu_test_mode_e mode;
     const struct vg_lite_test_item_s* item;
     const struct vg_lite_test_item_s** group;
     int group_size;
     int name_to_index;
+    int name_match_count;
     int current_index;
     int current_loop_count;
     int total_loop_count;
     int failed_count;
+    bool keep_going;
 };
 
 /**********************
@@ -60,6 +77,13 @@ struct vg_lite_test_iter_s {
  **********************/
 
 static void vg_lite_test_run_group(struct gpu_test_context_s* ctx);
+static struct vg_lite_test_variant_s* vg_lite_test_expand_group(
+    const struct vg_lite_test_item_s** group,
+    int group_size,
+    int* variant_count);
+static void vg_lite_test_variant_name(char* buf, size_t size, const struct vg_lite_test_item_s* item, int index);
+static bool vg_lite_test_pipeline_check(struct gpu_test_context_s* ctx);
+static void vg_lite_test_run_pipeline(struct vg_lite_test_iter_s* iter, struct vg_lite_test_context_s* vg_lite_ctx);
 
 /**********************
  *  STATIC VARIABLES
@@ -85,19 +109,30 @@ int vg_lite_test_run(struct gpu_test_context_s* ctx)
  *   STATIC FUNCTIONS
  **********************/
 
-static int vg_lite_test_name_to_index(const struct vg_lite_test_item_s** group, int group_size, const char* name)
+static int vg_lite_test_name_to_index(const struct vg_lite_test_item_s** group, int group_size, const char* name, int* match_count)
 {
+    *match_count = 0;
+
     if (!name) {
         return -1;
     }
 
+    /* The base name of a parameterized item selects all of its variants, they are next to each other */
+    size_t len = strlen(name);
+    int first = -1;
     for (int i = 0; i < group_size; i++) {
-        if (strcmp(group[i]->name, name) == 0) {
-            return i;
+        const char* item_name = group[i]->name;
+        if (strcmp(item_name, name) == 0
+            || (strncmp(item_name, name, len) == 0 && item_name[len] == '[')) {
+            if (first < 0) {
+                first = i;
+            }
+
+            (*match_count)++;
         }
     }
 
-    return -1;
+    return first;
 }
 
 static bool vg_lite_test_iter_next(struct vg_lite_test_iter_s* iter)
@@ -108,12 +143,12 @@ static bool vg_lite_test_iter_next(struct vg_lite_test_iter_s* iter)
     case GPU_TEST_MODE_DEFAULT: {
         /* Check if there is a specific test case to run */
         if (iter->name_to_index >= 0) {
-            if (iter->current_loop_count == 1) {
-                iter->item = iter->group[iter->name_to_index];
-                return true;
+            if (iter->current_index >= iter->name_match_count) {
+                return false;
             }
 
-            return false;
+            iter->item = iter->group[iter->name_to_index + iter->current_index++];
+            return true;
         }
 
         if (iter->current_index >= iter->group_size) {
@@ -125,7 +160,7 @@ static bool vg_lite_test_iter_next(struct vg_lite_test_iter_s* iter)
     }
 
     case GPU_TEST_MODE_STRESS: {
-        if (iter->failed_count > 0) {
+        if (iter->failed_count > 0 && !iter->keep_going) {
             return false;
         }
 
@@ -135,7 +170,9 @@ static bool vg_lite_test_iter_next(struct vg_lite_test_iter_s* iter)
             return false;
         }
 
-        iter->current_index = iter->name_to_index >= 0 ? iter->name_to_index : (rand() % iter->group_size);
+        iter->current_index = iter->name_to_index >= 0
+            ? iter->name_to_index + rand() % iter->name_match_count
+            : rand() % iter->group_size;
         iter->item = iter->group[iter->current_index];
         return true;
     }
@@ -162,34 +199,261 @@ static void vg_lite_test_run_group(struct gpu_test_context_s* ctx)
     };
 #undef ITEM_DEF
 
-    const int group_size = sizeof(vg_lite_test_group) / sizeof(vg_lite_test_group[0]);
-    const int name_to_index = vg_lite_test_name_to_index(vg_lite_test_group, group_size, ctx->param.testcase_name);
+    /* Each entry of a parameter table runs as a test case of its own */
+    int group_size = 0;
+    struct vg_lite_test_variant_s* variants = vg_lite_test_expand_group(
+        vg_lite_test_group,
+        sizeof(vg_lite_test_group) / sizeof(vg_lite_test_group[0]),
+        &group_size);
+
+    const struct vg_lite_test_item_s** group = malloc(group_size * sizeof(struct vg_lite_test_item_s*));
+    GPU_ASSERT_NULL(group);
+    for (int i = 0; i < group_size; i++) {
+        group[i] = &variants[i].item;
+    }
+
+    int name_match_count = 0;
+    const int name_to_index = vg_lite_test_name_to_index(group, group_size, ctx->param.testcase_name, &name_match_count);
 
     /* Check if test case is valid */
     if (ctx->param.testcase_name && name_to_index < 0) {
         GPU_LOG_WARN("Test case not found: %s, Available test cases:", ctx->param.testcase_name);
         for (int i = 0; i < group_size; i++) {
-            GPU_LOG_WARN("[%d/%d]: %s", i, group_size, vg_lite_test_group[i]->name);
+            GPU_LOG_WARN("[%d/%d]: %s", i, group_size, group[i]->name);
         }
+        free(group);
+        free(variants);
         return;
     }
 
-    struct vg_lite_test_iter_s iter = { 0 };
-    iter.mode = ctx->param.mode;
-    iter.group = vg_lite_test_group;
-    iter.group_size = group_size;
-    iter.name_to_index = name_to_index;
-    iter.total_loop_count = ctx->param.run_loop_count;
+    struct vg_lite_test_iter_s base_iter = { 0 };
+    base_iter.mode = ctx->param.mode;
+    base_iter.group = group;
+    base_iter.group_size = group_size;
+    base_iter.name_to_index = name_to_index;
+    base_iter.name_match_count = name_match_count;
+    base_iter.total_loop_count = ctx->param.run_loop_count;
+
+    /* Injected faults fail items on purpose, keep running to measure the recovery */
+    base_iter.keep_going = ctx->param.fault_spec != NULL;
+
+    int size_count = ctx->param.target_size_count;
+    int format_count = ctx->param.target_format_count;
+    if ((size_count > 1 || format_count > 1) && ctx->target_buffer.data) {
+        GPU_LOG_WARN("The external target buffer can not be resized, target sweep disabled");
+        size_count = format_count = 1;
+    }
+
+    const bool sweep = size_count > 1 || format_count > 1;
+    int failed_count = 0;
+    int total_count = 0;
 
     struct vg_lite_test_context_s* vg_lite_ctx = vg_lite_test_context_create(ctx);
 
-    while (vg_lite_test_iter_next(&iter)) {
-        if (!vg_lite_test_context_run_item(vg_lite_ctx, iter.item)) {
-            iter.failed_count++;
+    for (int size_index = 0; size_index < size_count; size_index++) {
+        for (int format_index = 0; format_index < format_count; format_index++) {
+            if (sweep) {
+                ctx->param.target_width = ctx->param.target_sizes[size_index].width;
+                ctx->param.target_height = ctx->param.target_sizes[size_index].height;
+                ctx->param.target_format = ctx->param.target_formats[format_index];
+
+                char tag[48];
+                snprintf(tag, sizeof(tag), "@%dx%d-%s",
+                    ctx->param.target_width, ctx->param.target_height, gpu_color_format_string(ctx->param.target_format));
+                GPU_LOG_WARN("Target sweep %d/%d: %s",
+                    size_index * format_count + format_index + 1, size_count * format_count, tag + 1);
+                vg_lite_test_context_set_target(vg_lite_ctx, tag);
+            }
+
+            struct vg_lite_test_iter_s iter = base_iter;
+
+            if (ctx->param.pipeline_en && vg_lite_test_pipeline_check(ctx)) {
+                vg_lite_test_run_pipeline(&iter, vg_lite_ctx);
+            } else {
+                while (vg_lite_test_iter_next(&iter)) {
+                    if (!vg_lite_test_context_run_item(vg_lite_ctx, iter.item)) {
+                        iter.failed_count++;
+                    }
+                }
+            }
+
+            failed_count += iter.failed_count;
+            total_count += iter.current_loop_count - 1;
         }
     }
 
     vg_lite_test_context_destroy(vg_lite_ctx);
+    free(group);
+    free(variants);
+
+    GPU_LOG_WARN("Test result: %d failed / %d total", failed_count, total_count);
+}
+
+static struct vg_lite_test_variant_s* vg_lite_test_expand_group(
+    const struct vg_lite_test_item_s** group,
+    int group_size,
+    int* variant_count)
+{
+    int count = 0;
+    for (int i = 0; i < group_size; i++) {
+        count += group[i]->params ? group[i]->param_count : 1;
+    }
+
+    struct vg_lite_test_variant_s* variants = calloc(count, sizeof(struct vg_lite_test_variant_s));
+    GPU_ASSERT_NULL(variants);
+
+    struct vg_lite_test_variant_s* variant = variants;
+    for (int i = 0; i < group_size; i++) {
+        const struct vg_lite_test_item_s* item = group[i];
+
+        if (!item->params) {
+            variant->item = *item;
+            variant++;
+            continue;
+        }
+
+        GPU_ASSERT(item->param_count > 0);
+        for (int j = 0; j < item->param_count; j++) {
+            variant->item = *item;
+            variant->item.params = &item->params[j];
+            variant->item.param_count = 1;
+            vg_lite_test_variant_name(variant->name, sizeof(variant->name), item, j);
+            variant->item.name = variant->name;
+            variant++;
+        }
+    }
+
+    *variant_count = count;
+    return variants;
+}
+
+static void vg_lite_test_variant_name(char* buf, size_t size, const struct vg_lite_test_item_s* item, int index)
+{
+    /* The formats and the size are always named, the other fields only when they differ within the table */
+    const struct vg_lite_test_param_s* first = &item->params[0];
+    bool count_varies = false;
+    bool blend_varies = false;
+    bool filter_varies = false;
+    for (int i = 1; i < item->param_count; i++) {
+        count_varies |= item->params[i].count != first->count;
+        blend_varies |= item->params[i].blend != first->blend;
+        filter_varies |= item->params[i].filter != first->filter;
+    }
+
+    /* No ',' or '>', the name is a CSV field and a screenshot file name */
+    const struct vg_lite_test_param_s* param = &item->params[index];
+    int len = snprintf(buf, size, "%s[%s-%s-%" PRIu32 "x%" PRIu32,
+        item->name,
+        vg_lite_test_buffer_format_string(param->target_format),
+        vg_lite_test_buffer_format_string(param->src_format),
+        param->width,
+        param->height);
+
+    if (count_varies && len > 0 && (size_t)len < size) {
+        len += snprintf(buf + len, size - len, "-n%" PRIu32, param->count);
+    }
+
+    if (blend_varies && len > 0 && (size_t)len < size) {
+        len += snprintf(buf + len, size - len, "-%s", vg_lite_test_blend_string(param->blend));
+    }
+
+    if (filter_varies && len > 0 && (size_t)len < size) {
+        len += snprintf(buf + len, size - len, "-%s", vg_lite_test_filter_string(param->filter));
+    }
+
+    if (len > 0 && (size_t)len < size) {
+        snprintf(buf + len, size - len, "]");
+    }
+}
 
-    GPU_LOG_WARN("Test result: %d failed / %d total", iter.failed_count, iter.current_loop_count - 1);
+static bool vg_lite_test_pipeline_check(struct gpu_test_context_s* ctx)
+{
+    /* These follow one item at a time or show a single target */
+    const char* reason = NULL;
+    if (ctx->param.trace_path) {
+        reason = "--trace";
+    } else if (ctx->param.ref_en) {
+        reason = "--ref";
+    } else if (ctx->param.fault_spec) {
+        reason = "--fault";
+    } else if (ctx->param.leak_check_en) {
+        reason = "--leak-check";
+    } else if (ctx->target_buffer.data) {
+        reason = "--fbdev";
+    }
+
+    if (reason) {
+        GPU_LOG_WARN("Pipelined items can not be used with %s, running serially", reason);
+        return false;
+    }
+
+    return true;
+}
+
+static void vg_lite_test_run_pipeline(struct vg_lite_test_iter_s* iter, struct vg_lite_test_context_s* vg_lite_ctx)
+{
+    struct vg_lite_test_context_s* slots[PIPELINE_DEPTH];
+    slots[0] = vg_lite_ctx;
+    for (int i = 1; i < PIPELINE_DEPTH; i++) {
+        slots[i] = vg_lite_test_context_create_slot(vg_lite_ctx);
+    }
+
+    /* The items overlap, the latency histograms cover the run as one item */
+    vg_lite_test_latency_item_begin();
+
+    uint32_t start_tick = gpu_tick_get();
+    uint64_t setup_us = 0;
+    uint64_t hidden_us = 0;
+    int item_count = 0;
+    int current = 0;
+
+    bool pending = vg_lite_test_iter_next(iter);
+    if (pending) {
+        vg_lite_test_context_begin_item(slots[current], iter->item);
+        vg_lite_test_context_submit_item(slots[current]);
+    }
+
+    while (pending) {
+        int next = (current + 1) % PIPELINE_DEPTH;
+        bool has_next = vg_lite_test_iter_next(iter);
+
+        if (has_next) {
+            uint32_t setup_start_tick = gpu_tick_get();
+            vg_lite_test_context_begin_item(slots[next], iter->item);
+            uint32_t elaps = gpu_tick_elaps(setup_start_tick);
+            setup_us += elaps;
+
+            /* A setup that ended with the GPU still busy was fully hidden, a partial overlap is not counted */
+            vg_lite_uint32_t is_gpu_idle = 1;
+            vg_lite_get_parameter(VG_LITE_GPU_IDLE_STATE, 1, (vg_lite_pointer)&is_gpu_idle);
+            if (!is_gpu_idle) {
+                hidden_us += elaps;
+            }
+        }
+
+        if (!vg_lite_test_context_end_item(slots[current])) {
+            iter->failed_count++;
+        }
+
+        item_count++;
+
+        if (has_next) {
+            vg_lite_test_context_submit_item(slots[next]);
+            current = next;
+        }
+
+        pending = has_next;
+    }
+
+    uint32_t total_us = gpu_tick_elaps(start_tick);
+    vg_lite_test_latency_item_end("pipeline");
+
+    GPU_LOG_WARN("Pipeline: %d items in %0.3f ms, %0.1f items/s",
+        item_count, total_us / 1000.0f, total_us ? item_count * 1000000.0f / total_us : 0.0f);
+    GPU_LOG_WARN("Pipeline: setup %0.3f ms, at least %0.3f ms (%0.1f%%) overlapped with the GPU",
+        setup_us / 1000.0f, hidden_us / 1000.0f, setup_us ? hidden_us * 100.0f / setup_us : 0.0f);
+
+    for (int i = 1; i < PIPELINE_DEPTH; i++) {
+        vg_lite_test_context_destroy(slots[i]);
+    }
 }
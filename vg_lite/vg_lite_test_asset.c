@@ -0,0 +1,437 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_asset.h"
+#include "../gpu_assert.h"
+#include "../gpu_buffer.h"
+#include "../gpu_cache.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_utils.h"
+#include "vg_lite_test_path.h"
+#include "vg_lite_test_utils.h"
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define ASSET_MAGIC "VGAP"
+#define ASSET_VERSION 1
+#define ASSET_NAME_LEN 32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The pack is a header, an entry table and the entry payloads, all in host
+ * endian 32-bit words. Every payload starts on a VG_LITE_TEST_BUFFER_ALIGN
+ * boundary of the file, so the mapped data keeps the alignment of the GPU
+ * buffers. The format fields hold the vg_lite enum values.
+ *
+ * Path payload: asset_file_path_s followed by the op stream.
+ * Image payload: asset_file_image_s followed by the CLUT, the pixels are at
+ * pixel_offset of the file.
+ */
+struct asset_file_header_s {
+    char magic[4];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t reserved;
+};
+
+struct asset_file_entry_s {
+    uint32_t type;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t reserved;
+    char name[ASSET_NAME_LEN];
+};
+
+struct asset_file_path_s {
+    uint32_t format;
+    uint32_t quality;
+    uint32_t fill_rule;
+    uint32_t color;
+    float bounding_box[4];
+};
+
+struct asset_file_image_s {
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;
+    int32_t x;
+    int32_t y;
+    uint32_t color;
+    uint32_t clut_count;
+    uint32_t pixel_offset;
+};
+
+struct vg_lite_test_asset_s {
+    uint8_t* file_data;
+    void* file_data_unaligned;
+    size_t file_size;
+    bool mapped;
+    struct vg_lite_test_asset_item_s* items;
+    struct gpu_buffer_s** copies;
+    char (*names)[ASSET_NAME_LEN + 1];
+    uint32_t item_count;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool asset_load(struct vg_lite_test_asset_s* asset, const char* path);
+static bool asset_parse(struct vg_lite_test_asset_s* asset, const char* path);
+static bool asset_parse_path(struct vg_lite_test_asset_item_s* item, const uint8_t* payload, uint32_t size);
+static bool asset_parse_image(
+    struct vg_lite_test_asset_s* asset,
+    struct vg_lite_test_asset_item_s* item,
+    struct gpu_buffer_s** copy,
+    const uint8_t* payload,
+    uint32_t size);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct vg_lite_test_asset_s* vg_lite_test_asset_open(const char* path)
+{
+    GPU_ASSERT_NULL(path);
+
+    struct vg_lite_test_asset_s* asset = calloc(1, sizeof(struct vg_lite_test_asset_s));
+    GPU_ASSERT_NULL(asset);
+
+    if (!asset_load(asset, path) || !asset_parse(asset, path)) {
+        vg_lite_test_asset_close(asset);
+        return NULL;
+    }
+
+    uint32_t zero_copy_count = 0;
+    for (uint32_t i = 0; i < asset->item_count; i++) {
+        if (asset->items[i].type == VG_LITE_TEST_ASSET_IMAGE && asset->items[i].zero_copy) {
+            zero_copy_count++;
+        }
+    }
+
+    GPU_LOG_INFO("Asset pack %s %s: %zu bytes, %" PRIu32 " items, %" PRIu32 " images used in place",
+        path, asset->mapped ? "mapped" : "loaded", asset->file_size, asset->item_count, zero_copy_count);
+    return asset;
+}
+
+void vg_lite_test_asset_close(struct vg_lite_test_asset_s* asset)
+{
+    GPU_ASSERT_NULL(asset);
+
+    if (asset->copies) {
+        for (uint32_t i = 0; i < asset->item_count; i++) {
+            if (asset->copies[i]) {
+                gpu_buffer_free(asset->copies[i]);
+            }
+        }
+
+        free(asset->copies);
+    }
+
+    free(asset->items);
+    free(asset->names);
+
+    if (asset->mapped) {
+        munmap(asset->file_data, asset->file_size);
+    } else {
+        free(asset->file_data_unaligned);
+    }
+
+    memset(asset, 0, sizeof(struct vg_lite_test_asset_s));
+    free(asset);
+}
+
+uint32_t vg_lite_test_asset_get_count(const struct vg_lite_test_asset_s* asset)
+{
+    GPU_ASSERT_NULL(asset);
+    return asset->item_count;
+}
+
+struct vg_lite_test_asset_item_s* vg_lite_test_asset_get_item(struct vg_lite_test_asset_s* asset, uint32_t index)
+{
+    GPU_ASSERT_NULL(asset);
+    GPU_ASSERT(index < asset->item_count);
+    return &asset->items[index];
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool asset_load(struct vg_lite_test_asset_s* asset, const char* path)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        GPU_LOG_ERROR("Open asset pack %s failed", path);
+        return false;
+    }
+
+    bool retval = false;
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        GPU_LOG_ERROR("Get size of asset pack %s failed", path);
+        goto failed;
+    }
+
+    if ((size_t)st.st_size < sizeof(struct asset_file_header_s)) {
+        GPU_LOG_ERROR("Asset pack %s is too small: %lld bytes", path, (long long)st.st_size);
+        goto failed;
+    }
+
+    asset->file_size = st.st_size;
+
+    /* Private mapping, the pages are only read and are shared with the page cache */
+    void* data = mmap(NULL, asset->file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+        asset->file_data = data;
+        asset->mapped = true;
+        retval = true;
+        goto failed;
+    }
+
+    /* Not all the file systems can be mapped, read it into an aligned buffer instead */
+    GPU_LOG_WARN("Map asset pack %s failed, reading it into memory", path);
+    asset->file_data_unaligned = malloc(asset->file_size + VG_LITE_TEST_BUFFER_ALIGN);
+    GPU_ASSERT_NULL(asset->file_data_unaligned);
+    asset->file_data = (uint8_t*)GPU_ALIGN_UP(asset->file_data_unaligned, VG_LITE_TEST_BUFFER_ALIGN);
+
+    size_t total = 0;
+    while (total < asset->file_size) {
+        ssize_t ret = read(fd, asset->file_data + total, asset->file_size - total);
+        if (ret <= 0) {
+            GPU_LOG_ERROR("Read asset pack %s failed", path);
+            goto failed;
+        }
+
+        total += ret;
+    }
+
+    retval = true;
+
+failed:
+    close(fd);
+    return retval;
+}
+
+static bool asset_parse(struct vg_lite_test_asset_s* asset, const char* path)
+{
+    struct asset_file_header_s header;
+    memcpy(&header, asset->file_data, sizeof(header));
+    if (memcmp(header.magic, ASSET_MAGIC, sizeof(header.magic)) != 0 || header.version != ASSET_VERSION) {
+        GPU_LOG_ERROR("Invalid asset pack %s: version %" PRIu32, path, header.version);
+        return false;
+    }
+
+    size_t table_size = (size_t)header.entry_count * sizeof(struct asset_file_entry_s);
+    if (header.entry_count == 0 || table_size > asset->file_size - sizeof(header)) {
+        GPU_LOG_ERROR("Invalid entry count %" PRIu32 " of asset pack %s", header.entry_count, path);
+        return false;
+    }
+
+    asset->items = calloc(header.entry_count, sizeof(struct vg_lite_test_asset_item_s));
+    GPU_ASSERT_NULL(asset->items);
+    asset->copies = calloc(header.entry_count, sizeof(struct gpu_buffer_s*));
+    GPU_ASSERT_NULL(asset->copies);
+    asset->names = calloc(header.entry_count, sizeof(asset->names[0]));
+    GPU_ASSERT_NULL(asset->names);
+    asset->item_count = header.entry_count;
+
+    /* The GPU reads the pack through the memory, write back what the loading left in the cache */
+    gpu_cache_clean(asset->file_data, asset->file_size);
+
+    const uint8_t* table = asset->file_data + sizeof(header);
+    for (uint32_t i = 0; i < header.entry_count; i++) {
+        struct asset_file_entry_s entry;
+        memcpy(&entry, table + i * sizeof(entry), sizeof(entry));
+
+        struct vg_lite_test_asset_item_s* item = &asset->items[i];
+        memcpy(asset->names[i], entry.name, ASSET_NAME_LEN);
+        item->name = asset->names[i];
+        item->type = entry.type;
+
+        if (entry.offset % VG_LITE_TEST_BUFFER_ALIGN != 0
+            || entry.offset > asset->file_size
+            || entry.size > asset->file_size - entry.offset) {
+            GPU_LOG_ERROR("Asset '%s' out of the pack: offset %" PRIu32 " size %" PRIu32, item->name, entry.offset, entry.size);
+            return false;
+        }
+
+        const uint8_t* payload = asset->file_data + entry.offset;
+        bool parsed = false;
+
+        switch (entry.type) {
+        case VG_LITE_TEST_ASSET_PATH:
+            parsed = asset_parse_path(item, payload, entry.size);
+            break;
+
+        case VG_LITE_TEST_ASSET_IMAGE:
+            parsed = asset_parse_image(asset, item, &asset->copies[i], payload, entry.size);
+            break;
+
+        default:
+            GPU_LOG_ERROR("Asset '%s' has unknown type %" PRIu32, item->name, entry.type);
+            break;
+        }
+
+        if (!parsed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool asset_parse_path(struct vg_lite_test_asset_item_s* item, const uint8_t* payload, uint32_t size)
+{
+    struct asset_file_path_s info;
+    if (size < sizeof(info)) {
+        GPU_LOG_ERROR("Path '%s' is too small: %" PRIu32 " bytes", item->name, size);
+        return false;
+    }
+
+    memcpy(&info, payload, sizeof(info));
+
+    if (info.format > VG_LITE_FP32) {
+        GPU_LOG_ERROR("Path '%s' has unknown format %" PRIu32, item->name, info.format);
+        return false;
+    }
+
+    uint32_t data_size = size - sizeof(info);
+    if (data_size == 0 || data_size % vg_lite_test_path_format_len(info.format) != 0) {
+        GPU_LOG_ERROR("Path '%s' has invalid data size %" PRIu32, item->name, data_size);
+        return false;
+    }
+
+    /* The op stream is used in place, the GPU only reads it */
+    vg_lite_error_t error = vg_lite_init_path(
+        &item->path,
+        info.format,
+        info.quality,
+        data_size,
+        (void*)(payload + sizeof(info)),
+        info.bounding_box[0], info.bounding_box[1],
+        info.bounding_box[2], info.bounding_box[3]);
+    if (error != VG_LITE_SUCCESS) {
+        GPU_LOG_ERROR("Path '%s' init failed: %d (%s)", item->name, (int)error, vg_lite_test_error_string(error));
+        return false;
+    }
+
+    item->fill_rule = info.fill_rule;
+    item->color = info.color;
+    return true;
+}
+
+static bool asset_parse_image(
+    struct vg_lite_test_asset_s* asset,
+    struct vg_lite_test_asset_item_s* item,
+    struct gpu_buffer_s** copy,
+    const uint8_t* payload,
+    uint32_t size)
+{
+    struct asset_file_image_s info;
+    if (size < sizeof(info)) {
+        GPU_LOG_ERROR("Image '%s' is too small: %" PRIu32 " bytes", item->name, size);
+        return false;
+    }
+
+    memcpy(&info, payload, sizeof(info));
+
+    /* A corrupt pack must not reach the buffer helpers, they assert on an unknown format */
+    if (!vg_lite_test_buffer_format_is_valid((vg_lite_buffer_format_t)info.format)) {
+        GPU_LOG_ERROR("Image '%s' has unknown format 0x%" PRIx32, item->name, info.format);
+        return false;
+    }
+
+    if (info.clut_count > (size - sizeof(info)) / sizeof(uint32_t)) {
+        GPU_LOG_ERROR("Image '%s' has invalid CLUT count %" PRIu32, item->name, info.clut_count);
+        return false;
+    }
+
+    uint64_t pixel_size = (uint64_t)info.stride * info.height;
+    if (info.width == 0 || info.height == 0
+        || info.pixel_offset > asset->file_size
+        || pixel_size > asset->file_size - info.pixel_offset) {
+        GPU_LOG_ERROR("Image '%s' pixels out of the pack: W%" PRIu32 "xH%" PRIu32 " stride %" PRIu32,
+            item->name, info.width, info.height, info.stride);
+        return false;
+    }
+
+    /* Shorter rows would leave the end of every row of the copy uninitialized */
+    if (info.stride < vg_lite_test_buffer_row_size((vg_lite_buffer_format_t)info.format, info.width)) {
+        GPU_LOG_ERROR("Image '%s' stride %" PRIu32 " is too small for W%" PRIu32 " %s",
+            item->name, info.stride, info.width, vg_lite_test_buffer_format_string((vg_lite_buffer_format_t)info.format));
+        return false;
+    }
+
+    item->x = info.x;
+    item->y = info.y;
+    item->color = info.color;
+    item->clut_count = info.clut_count;
+    item->clut = info.clut_count ? (uint32_t*)(payload + sizeof(info)) : NULL;
+
+    const uint8_t* pixels = asset->file_data + info.pixel_offset;
+    item->zero_copy = vg_lite_test_buffer_wrap(&item->image, pixels, info.width, info.height, info.format, info.stride);
+    if (item->zero_copy) {
+        return true;
+    }
+
+    /* The image does not meet the buffer alignment of this GPU, copy it row by row */
+    *copy = vg_lite_test_buffer_alloc(&item->image, info.width, info.height, info.format, VG_LITE_TEST_STRIDE_AUTO);
+    uint32_t row_size = MATH_MIN(info.stride, (uint32_t)item->image.stride);
+    uint8_t* dest = item->image.memory;
+    for (uint32_t y = 0; y < info.height; y++) {
+        memcpy(dest, pixels, row_size);
+        dest += item->image.stride;
+        pixels += info.stride;
+    }
+
+    gpu_cache_flush(item->image.memory, item->image.stride * item->image.height);
+    return true;
+}
@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_ASSET_H
+#define VG_LITE_TEST_ASSET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_asset_s;
+
+enum vg_lite_test_asset_type_e {
+    VG_LITE_TEST_ASSET_PATH = 1,
+    VG_LITE_TEST_ASSET_IMAGE,
+};
+
+struct vg_lite_test_asset_item_s {
+    enum vg_lite_test_asset_type_e type;
+    const char* name;
+
+    /* The fill color of a path, the multiply color of an alpha image */
+    vg_lite_color_t color;
+
+    /* VG_LITE_TEST_ASSET_PATH, the path data points into the pack */
+    vg_lite_path_t path;
+    vg_lite_fill_t fill_rule;
+
+    /* VG_LITE_TEST_ASSET_IMAGE, the memory points into the pack if zero_copy is set */
+    vg_lite_buffer_t image;
+    int32_t x;
+    int32_t y;
+    uint32_t* clut;
+    uint32_t clut_count;
+    bool zero_copy;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Map an asset pack generated by vg_lite/resource/asset_pack_gen.py.
+ * @param path The path of the pack file.
+ * @return The asset pack, NULL if the file can not be read or is not a valid pack.
+ * @note The paths and the aligned images are used in place, the rest of the images are copied to GPU buffers.
+ */
+struct vg_lite_test_asset_s* vg_lite_test_asset_open(const char* path);
+
+/**
+ * @brief Unmap the asset pack and free the copied images.
+ * @param asset The asset pack.
+ */
+void vg_lite_test_asset_close(struct vg_lite_test_asset_s* asset);
+
+/**
+ * @brief Get the number of items in the asset pack.
+ * @param asset The asset pack.
+ * @return The number of items.
+ */
+uint32_t vg_lite_test_asset_get_count(const struct vg_lite_test_asset_s* asset);
+
+/**
+ * @brief Get an item of the asset pack.
+ * @param asset The asset pack.
+ * @param index The index of the item.
+ * @return The item, valid until the pack is closed.
+ */
+struct vg_lite_test_asset_item_s* vg_lite_test_asset_get_item(struct vg_lite_test_asset_s* asset, uint32_t index);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_ASSET_H*/
@@ -0,0 +1,469 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_budget.h"
+#include "../gpu_assert.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define BUDGET_HEADROOM_DEFAULT 50
+
+/* Percentile of the repeated runs taken as the baseline, the slowest runs are mostly preemption */
+#define BUDGET_PERCENTILE 95
+
+/* Added to every budget, the times of the short phases are within the tick jitter */
+#define BUDGET_SLACK_US 100
+
+/* Time of a phase that is not checked */
+#define BUDGET_UNLIMITED UINT32_MAX
+
+#define BUDGET_HEADER "Testcase,Target Area,Target Format,Setup Time(ms),Draw Time(ms),Finish Time(ms)"
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum budget_phase_e {
+    BUDGET_PHASE_SETUP,
+    BUDGET_PHASE_DRAW,
+    BUDGET_PHASE_FINISH,
+    _BUDGET_PHASE_LAST
+};
+
+struct budget_entry_s {
+    char name[128];
+    char format[32];
+    uint32_t width;
+    uint32_t height;
+    bool has_limit;
+    uint32_t limit_us[_BUDGET_PHASE_LAST];
+
+    /* Times of the repeated runs for the update */
+    uint32_t* samples[_BUDGET_PHASE_LAST];
+    int sample_count;
+    int sample_capacity;
+};
+
+struct vg_lite_test_budget_s {
+    struct budget_entry_s* entries;
+    int entry_count;
+    int entry_capacity;
+    bool check_en;
+    char update_path[256];
+    int headroom;
+
+    /* Summary */
+    uint32_t checked_items;
+    uint32_t slow_items;
+    uint32_t missing_items;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool budget_load(struct vg_lite_test_budget_s* budget, const char* path);
+static bool budget_parse_line(struct vg_lite_test_budget_s* budget, char* line);
+static bool budget_parse_time(const char* str, uint32_t* time_us);
+static struct budget_entry_s* budget_find(struct vg_lite_test_budget_s* budget, const char* name, const char* format, uint32_t width, uint32_t height);
+static struct budget_entry_s* budget_add(struct vg_lite_test_budget_s* budget, const char* name, const char* format, uint32_t width, uint32_t height);
+static void budget_add_sample(struct budget_entry_s* entry, const uint32_t times_us[_BUDGET_PHASE_LAST]);
+static uint32_t budget_percentile(uint32_t* samples, int count);
+static int budget_compare_u32(const void* a, const void* b);
+static void budget_write(struct vg_lite_test_budget_s* budget);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const char* const budget_phase_names[_BUDGET_PHASE_LAST] = { "Setup", "Draw", "Finish" };
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct vg_lite_test_budget_s* vg_lite_test_budget_create(const char* path, const char* update_spec)
+{
+    if (!path && !update_spec) {
+        return NULL;
+    }
+
+    struct vg_lite_test_budget_s* budget = calloc(1, sizeof(struct vg_lite_test_budget_s));
+    GPU_ASSERT_NULL(budget);
+    budget->headroom = BUDGET_HEADROOM_DEFAULT;
+
+    if (update_spec) {
+        snprintf(budget->update_path, sizeof(budget->update_path), "%s", update_spec);
+
+        /* The headroom follows the last colon, a path may not end with a number */
+        char* colon = strrchr(budget->update_path, ':');
+        if (colon) {
+            char* end;
+            long headroom = strtol(colon + 1, &end, 10);
+            if (end != colon + 1 && *end == '\0') {
+                if (headroom < 0 || headroom > 1000) {
+                    GPU_LOG_ERROR("Invalid budget headroom: %s", colon + 1);
+                    vg_lite_test_budget_destroy(budget);
+                    return NULL;
+                }
+
+                budget->headroom = (int)headroom;
+                *colon = '\0';
+            }
+        }
+    }
+
+    if (path) {
+        if (!budget_load(budget, path)) {
+            vg_lite_test_budget_destroy(budget);
+            return NULL;
+        }
+
+        budget->check_en = true;
+    }
+
+    GPU_LOG_INFO("Budgets: %d loaded from %s, update %s with %d%% headroom",
+        budget->entry_count, path ? path : "(none)",
+        budget->update_path[0] ? budget->update_path : "(none)", budget->headroom);
+
+    return budget;
+}
+
+void vg_lite_test_budget_destroy(struct vg_lite_test_budget_s* budget)
+{
+    GPU_ASSERT_NULL(budget);
+
+    if (budget->check_en) {
+        GPU_LOG_INFO("Budgets: %" PRIu32 " items checked, %" PRIu32 " over budget, %" PRIu32 " without budget",
+            budget->checked_items, budget->slow_items, budget->missing_items);
+    }
+
+    if (budget->update_path[0]) {
+        budget_write(budget);
+    }
+
+    for (int i = 0; i < budget->entry_count; i++) {
+        for (int phase = 0; phase < _BUDGET_PHASE_LAST; phase++) {
+            free(budget->entries[i].samples[phase]);
+        }
+    }
+
+    free(budget->entries);
+    memset(budget, 0, sizeof(struct vg_lite_test_budget_s));
+    free(budget);
+}
+
+bool vg_lite_test_budget_check(
+    struct vg_lite_test_budget_s* budget,
+    const char* name,
+    const vg_lite_buffer_t* target,
+    uint32_t setup_us,
+    uint32_t draw_us,
+    uint32_t finish_us,
+    char* remark,
+    size_t remark_size)
+{
+    GPU_ASSERT_NULL(budget);
+    GPU_ASSERT_NULL(name);
+    GPU_ASSERT_NULL(target);
+    GPU_ASSERT_NULL(remark);
+
+    const uint32_t times_us[_BUDGET_PHASE_LAST] = { setup_us, draw_us, finish_us };
+    const char* format = vg_lite_test_buffer_format_string(target->format);
+    uint32_t width = target->width;
+    uint32_t height = target->height;
+    remark[0] = '\0';
+
+    struct budget_entry_s* entry = budget_find(budget, name, format, width, height);
+
+    if (budget->update_path[0]) {
+        if (!entry) {
+            entry = budget_add(budget, name, format, width, height);
+        }
+
+        budget_add_sample(entry, times_us);
+    }
+
+    if (!budget->check_en) {
+        return true;
+    }
+
+    budget->checked_items++;
+
+    if (!entry || !entry->has_limit) {
+        budget->missing_items++;
+        snprintf(remark, remark_size, "No budget");
+        return true;
+    }
+
+    bool passed = true;
+    size_t len = 0;
+    for (int phase = 0; phase < _BUDGET_PHASE_LAST; phase++) {
+        if (entry->limit_us[phase] == BUDGET_UNLIMITED || times_us[phase] <= entry->limit_us[phase]) {
+            continue;
+        }
+
+        /* No commas, the remark is a field of the CSV report */
+        int ret = snprintf(remark + len, remark_size - len, "%s%s %0.3f ms > %0.3f ms",
+            passed ? "" : "; ",
+            budget_phase_names[phase],
+            times_us[phase] / 1000.0f,
+            entry->limit_us[phase] / 1000.0f);
+        if (ret > 0) {
+            len = MATH_MIN(len + ret, remark_size - 1);
+        }
+
+        passed = false;
+    }
+
+    if (!passed) {
+        budget->slow_items++;
+    }
+
+    return passed;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool budget_load(struct vg_lite_test_budget_s* budget, const char* path)
+{
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        GPU_LOG_ERROR("open %s failed", path);
+        return false;
+    }
+
+    bool retval = true;
+    int line_num = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        line_num++;
+        line[strcspn(line, "\r\n")] = '\0';
+
+        if (line[0] == '\0' || line[0] == '#' || strncmp(line, "Testcase,", 9) == 0) {
+            continue;
+        }
+
+        if (!budget_parse_line(budget, line)) {
+            GPU_LOG_ERROR("%s:%d: invalid budget, expected '" BUDGET_HEADER "'", path, line_num);
+            retval = false;
+            break;
+        }
+    }
+
+    fclose(fp);
+    return retval;
+}
+
+static bool budget_parse_line(struct vg_lite_test_budget_s* budget, char* line)
+{
+    char* fields[3 + _BUDGET_PHASE_LAST];
+    int count = 0;
+    char* saveptr = NULL;
+    for (char* token = strtok_r(line, ",", &saveptr); token; token = strtok_r(NULL, ",", &saveptr)) {
+        if (count >= (int)(sizeof(fields) / sizeof(fields[0]))) {
+            return false;
+        }
+
+        fields[count++] = token;
+    }
+
+    if (count != 3 + _BUDGET_PHASE_LAST) {
+        return false;
+    }
+
+    uint32_t width;
+    uint32_t height;
+    if (sscanf(fields[1], "%" SCNu32 "x%" SCNu32, &width, &height) != 2) {
+        return false;
+    }
+
+    uint32_t limit_us[_BUDGET_PHASE_LAST];
+    for (int phase = 0; phase < _BUDGET_PHASE_LAST; phase++) {
+        if (!budget_parse_time(fields[3 + phase], &limit_us[phase])) {
+            return false;
+        }
+    }
+
+    struct budget_entry_s* entry = budget_find(budget, fields[0], fields[2], width, height);
+    if (!entry) {
+        entry = budget_add(budget, fields[0], fields[2], width, height);
+    }
+
+    entry->has_limit = true;
+    memcpy(entry->limit_us, limit_us, sizeof(limit_us));
+    return true;
+}
+
+static bool budget_parse_time(const char* str, uint32_t* time_us)
+{
+    if (strcmp(str, "-") == 0) {
+        *time_us = BUDGET_UNLIMITED;
+        return true;
+    }
+
+    /* BUDGET_UNLIMITED is reserved for "-" */
+    char* end;
+    double time_ms = strtod(str, &end);
+    if (end == str || *end != '\0' || !(time_ms >= 0) || time_ms * 1000 + 0.5 >= BUDGET_UNLIMITED) {
+        return false;
+    }
+
+    *time_us = (uint32_t)(time_ms * 1000 + 0.5);
+    return true;
+}
+
+static struct budget_entry_s* budget_find(struct vg_lite_test_budget_s* budget, const char* name, const char* format, uint32_t width, uint32_t height)
+{
+    for (int i = 0; i < budget->entry_count; i++) {
+        struct budget_entry_s* entry = &budget->entries[i];
+        if (entry->width == width && entry->height == height
+            && strcmp(entry->name, name) == 0 && strcmp(entry->format, format) == 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+static struct budget_entry_s* budget_add(struct vg_lite_test_budget_s* budget, const char* name, const char* format, uint32_t width, uint32_t height)
+{
+    if (budget->entry_count >= budget->entry_capacity) {
+        budget->entry_capacity = budget->entry_capacity ? budget->entry_capacity * 2 : 64;
+        budget->entries = realloc(budget->entries, budget->entry_capacity * sizeof(struct budget_entry_s));
+        GPU_ASSERT_NULL(budget->entries);
+    }
+
+    struct budget_entry_s* entry = &budget->entries[budget->entry_count++];
+    memset(entry, 0, sizeof(struct budget_entry_s));
+    snprintf(entry->name, sizeof(entry->name), "%s", name);
+    snprintf(entry->format, sizeof(entry->format), "%s", format);
+    entry->width = width;
+    entry->height = height;
+    return entry;
+}
+
+static void budget_add_sample(struct budget_entry_s* entry, const uint32_t times_us[_BUDGET_PHASE_LAST])
+{
+    if (entry->sample_count >= entry->sample_capacity) {
+        entry->sample_capacity = entry->sample_capacity ? entry->sample_capacity * 2 : 4;
+        for (int phase = 0; phase < _BUDGET_PHASE_LAST; phase++) {
+            entry->samples[phase] = realloc(entry->samples[phase], entry->sample_capacity * sizeof(uint32_t));
+            GPU_ASSERT_NULL(entry->samples[phase]);
+        }
+    }
+
+    for (int phase = 0; phase < _BUDGET_PHASE_LAST; phase++) {
+        entry->samples[phase][entry->sample_count] = times_us[phase];
+    }
+
+    entry->sample_count++;
+}
+
+static uint32_t budget_percentile(uint32_t* samples, int count)
+{
+    qsort(samples, count, sizeof(uint32_t), budget_compare_u32);
+
+    /* Nearest rank */
+    int rank = (count * BUDGET_PERCENTILE + 99) / 100;
+    return samples[MATH_CLAMP(rank - 1, 0, count - 1)];
+}
+
+static int budget_compare_u32(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void budget_write(struct vg_lite_test_budget_s* budget)
+{
+    FILE* fp = fopen(budget->update_path, "w");
+    if (!fp) {
+        GPU_LOG_ERROR("open %s failed", budget->update_path);
+        return;
+    }
+
+    /* The budgets only hold for the chip and driver they were measured on */
+    char info[256];
+    vg_lite_test_info_to_string(info, sizeof(info));
+    fprintf(fp, "# Budgets with %d%% headroom, %s\n" BUDGET_HEADER "\n", budget->headroom, info);
+
+    int count = 0;
+    int kept = 0;
+    for (int i = 0; i < budget->entry_count; i++) {
+        struct budget_entry_s* entry = &budget->entries[i];
+
+        /* A loaded budget of an item that did not run this time is kept as is */
+        if (entry->sample_count == 0 && !entry->has_limit) {
+            continue;
+        }
+
+        fprintf(fp, "%s,%" PRIu32 "x%" PRIu32 ",%s", entry->name, entry->width, entry->height, entry->format);
+
+        for (int phase = 0; phase < _BUDGET_PHASE_LAST; phase++) {
+            uint64_t limit_us = entry->limit_us[phase];
+
+            if (entry->sample_count > 0) {
+                limit_us = budget_percentile(entry->samples[phase], entry->sample_count);
+                limit_us = MATH_MIN(limit_us * (100 + budget->headroom) / 100 + BUDGET_SLACK_US, BUDGET_UNLIMITED - 1);
+            }
+
+            if (limit_us == BUDGET_UNLIMITED) {
+                fprintf(fp, ",-");
+            } else {
+                fprintf(fp, ",%0.3f", limit_us / 1000.0);
+            }
+        }
+
+        fprintf(fp, "\n");
+
+        if (entry->sample_count > 0) {
+            count++;
+        } else {
+            kept++;
+        }
+    }
+
+    fclose(fp);
+    GPU_LOG_INFO("Budgets: %d updated and %d kept in %s", count, kept, budget->update_path);
+}
@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_BUDGET_H
+#define VG_LITE_TEST_BUDGET_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_budget_s;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Create the timing budgets of the test case items.
+ * @param path The budgets file to check the items against, NULL for none.
+ *             Each line is "<testcase>,<WxH>,<target format>,<setup ms>,<draw ms>,<finish ms>",
+ *             a time of "-" is not checked, lines starting with '#' are comments.
+ * @param update_spec "<path>[:<headroom percent>]" to write fresh budgets from this run on destroy, NULL for none.
+ *                    The budget of a phase is the 95th percentile of its repeated runs plus the headroom, 50% by default.
+ * @return The budgets, NULL if both are NULL or the budgets file can not be read.
+ */
+struct vg_lite_test_budget_s* vg_lite_test_budget_create(const char* path, const char* update_spec);
+
+/**
+ * @brief Write the updated budgets file if requested, log the summary and free the budgets.
+ * @param budget The budgets.
+ */
+void vg_lite_test_budget_destroy(struct vg_lite_test_budget_s* budget);
+
+/**
+ * @brief Check the times of a passed test case item against its budget, record them for the update.
+ * @param budget The budgets.
+ * @param name The name of the test case item.
+ * @param target The target buffer the item was drawn to.
+ * @param setup_us The setup time in microseconds.
+ * @param draw_us The draw time in microseconds.
+ * @param finish_us The finish time in microseconds.
+ * @param remark Buffer for the exceeded phases or the missing budget.
+ * @param remark_size The size of the remark buffer.
+ * @return False if any phase exceeds its budget, true otherwise or if the item has no budget.
+ */
+bool vg_lite_test_budget_check(
+    struct vg_lite_test_budget_s* budget,
+    const char* name,
+    const vg_lite_buffer_t* target,
+    uint32_t setup_us,
+    uint32_t draw_us,
+    uint32_t finish_us,
+    char* remark,
+    size_t remark_size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_BUDGET_H*/
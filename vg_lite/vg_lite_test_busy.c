@@ -0,0 +1,234 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_busy.h"
+#include "../gpu_assert.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_tick.h"
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_busy_s {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    uint32_t interval_us;
+
+    /* Shared with the sampler thread, only accessed with the lock held */
+    bool exit;
+    bool item_active;
+    bool seen_busy;
+    uint32_t item_begin_tick;
+    uint32_t idle_run_us;
+    struct vg_lite_test_busy_stats_s item;
+    struct vg_lite_test_busy_stats_s run;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void* busy_thread(void* arg);
+static void busy_sample(struct vg_lite_test_busy_s* busy, bool is_busy, uint32_t elaps_us);
+static void busy_stats_merge(struct vg_lite_test_busy_stats_s* dest, const struct vg_lite_test_busy_stats_s* src);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct vg_lite_test_busy_s* vg_lite_test_busy_create(uint32_t rate_hz)
+{
+    GPU_ASSERT(rate_hz > 0);
+
+    struct vg_lite_test_busy_s* busy = calloc(1, sizeof(struct vg_lite_test_busy_s));
+    GPU_ASSERT_NULL(busy);
+    busy->interval_us = MATH_MAX(1000000 / rate_hz, 1);
+    pthread_mutex_init(&busy->lock, NULL);
+
+    int ret = pthread_create(&busy->thread, NULL, busy_thread, busy);
+    if (ret != 0) {
+        GPU_LOG_ERROR("Create GPU busy sampler thread failed: %d", ret);
+        pthread_mutex_destroy(&busy->lock);
+        free(busy);
+        return NULL;
+    }
+
+    GPU_LOG_INFO("GPU busy sampler started, interval: %" PRIu32 " us", busy->interval_us);
+    return busy;
+}
+
+void vg_lite_test_busy_destroy(struct vg_lite_test_busy_s* busy)
+{
+    GPU_ASSERT_NULL(busy);
+
+    pthread_mutex_lock(&busy->lock);
+    busy->exit = true;
+    pthread_mutex_unlock(&busy->lock);
+    pthread_join(busy->thread, NULL);
+    pthread_mutex_destroy(&busy->lock);
+
+    const struct vg_lite_test_busy_stats_s* run = &busy->run;
+    GPU_LOG_WARN("GPU busy: %0.1f%% of %0.3f ms sampled (%" PRIu32 " samples), "
+                 "%" PRIu32 " idle gaps, %0.3f ms total, %0.3f ms max",
+        vg_lite_test_busy_percent(run),
+        run->sampled_us / 1000.0f,
+        run->samples,
+        run->gap_count,
+        run->gap_total_us / 1000.0f,
+        run->gap_max_us / 1000.0f);
+
+    free(busy);
+}
+
+void vg_lite_test_busy_item_begin(struct vg_lite_test_busy_s* busy)
+{
+    GPU_ASSERT_NULL(busy);
+
+    pthread_mutex_lock(&busy->lock);
+    GPU_ASSERT(!busy->item_active);
+    memset(&busy->item, 0, sizeof(busy->item));
+    busy->item_active = true;
+    busy->seen_busy = false;
+    busy->idle_run_us = 0;
+    busy->item_begin_tick = gpu_tick_get();
+    pthread_mutex_unlock(&busy->lock);
+}
+
+void vg_lite_test_busy_item_end(struct vg_lite_test_busy_s* busy, struct vg_lite_test_busy_stats_s* stats)
+{
+    GPU_ASSERT_NULL(busy);
+    GPU_ASSERT_NULL(stats);
+
+    pthread_mutex_lock(&busy->lock);
+    GPU_ASSERT(busy->item_active);
+    busy->item_active = false;
+    *stats = busy->item;
+    busy_stats_merge(&busy->run, &busy->item);
+    pthread_mutex_unlock(&busy->lock);
+}
+
+float vg_lite_test_busy_percent(const struct vg_lite_test_busy_stats_s* stats)
+{
+    GPU_ASSERT_NULL(stats);
+    return stats->sampled_us ? stats->busy_us * 100.0f / stats->sampled_us : 0.0f;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void* busy_thread(void* arg)
+{
+    struct vg_lite_test_busy_s* busy = arg;
+    uint32_t last_tick = gpu_tick_get();
+
+    while (true) {
+        /* No lock, the build guarantees that this query is thread safe (VG_LITE_TEST_IDLE_QUERY_THREAD_SAFE) */
+        vg_lite_uint32_t is_gpu_idle = 1;
+        vg_lite_get_parameter(VG_LITE_GPU_IDLE_STATE, 1, (vg_lite_pointer)&is_gpu_idle);
+
+        /* The sleep overshoots, weight each sample by the real time since the previous one */
+        uint32_t elaps = gpu_tick_elaps(last_tick);
+        last_tick += elaps;
+
+        pthread_mutex_lock(&busy->lock);
+
+        if (busy->exit) {
+            pthread_mutex_unlock(&busy->lock);
+            break;
+        }
+
+        if (busy->item_active) {
+            /* Do not count the time before the item began */
+            elaps = MATH_MIN(elaps, gpu_tick_elaps(busy->item_begin_tick));
+            busy_sample(busy, !is_gpu_idle, elaps);
+        }
+
+        pthread_mutex_unlock(&busy->lock);
+
+        usleep(busy->interval_us);
+    }
+
+    return NULL;
+}
+
+static void busy_sample(struct vg_lite_test_busy_s* busy, bool is_busy, uint32_t elaps_us)
+{
+    struct vg_lite_test_busy_stats_s* stats = &busy->item;
+    stats->samples++;
+    stats->sampled_us += elaps_us;
+
+    if (!is_busy) {
+        /* The idle time before the first submission is not a gap */
+        if (busy->seen_busy) {
+            busy->idle_run_us += elaps_us;
+        }
+        return;
+    }
+
+    stats->busy_us += elaps_us;
+
+    if (busy->idle_run_us > 0) {
+        stats->gap_count++;
+        stats->gap_total_us += busy->idle_run_us;
+        stats->gap_max_us = MATH_MAX(stats->gap_max_us, busy->idle_run_us);
+        busy->idle_run_us = 0;
+    }
+
+    busy->seen_busy = true;
+}
+
+static void busy_stats_merge(struct vg_lite_test_busy_stats_s* dest, const struct vg_lite_test_busy_stats_s* src)
+{
+    dest->samples += src->samples;
+    dest->sampled_us += src->sampled_us;
+    dest->busy_us += src->busy_us;
+    dest->gap_count += src->gap_count;
+    dest->gap_total_us += src->gap_total_us;
+    dest->gap_max_us = MATH_MAX(dest->gap_max_us, src->gap_max_us);
+}
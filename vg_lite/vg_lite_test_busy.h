@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_BUSY_H
+#define VG_LITE_TEST_BUSY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_busy_s;
+
+struct vg_lite_test_busy_stats_s {
+    uint32_t samples;
+    uint32_t sampled_us;
+    uint32_t busy_us;
+
+    /* Idle runs with busy samples on both sides, the GPU waited for the next submission */
+    uint32_t gap_count;
+    uint32_t gap_total_us;
+    uint32_t gap_max_us;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Start the thread that polls VG_LITE_GPU_IDLE_STATE.
+ * @param rate_hz The number of samples per second.
+ * @return The sampler, or NULL if the thread can not be created.
+ * @note vg_lite_get_parameter is called from the sampler thread without any lock, it is not hooked.
+ *       Only build it with VG_LITE_TEST_IDLE_QUERY_THREAD_SAFE when the driver guarantees
+ *       that VG_LITE_GPU_IDLE_STATE can be queried while another thread is in vg_lite.
+ */
+struct vg_lite_test_busy_s* vg_lite_test_busy_create(uint32_t rate_hz);
+
+/**
+ * @brief Stop the sampler thread and log the busy time of the whole run.
+ * @param busy The sampler.
+ */
+void vg_lite_test_busy_destroy(struct vg_lite_test_busy_s* busy);
+
+/**
+ * @brief Start accumulating the samples of a test item.
+ * @param busy The sampler.
+ */
+void vg_lite_test_busy_item_begin(struct vg_lite_test_busy_s* busy);
+
+/**
+ * @brief Stop accumulating and get the samples of the test item.
+ * @param busy The sampler.
+ * @param stats The samples since vg_lite_test_busy_item_begin.
+ */
+void vg_lite_test_busy_item_end(struct vg_lite_test_busy_s* busy, struct vg_lite_test_busy_stats_s* stats);
+
+/**
+ * @brief Get the GPU busy percentage of the samples.
+ * @param stats The samples.
+ * @return The busy percentage, 0 if there are no samples.
+ */
+float vg_lite_test_busy_percent(const struct vg_lite_test_busy_stats_s* stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_BUSY_H*/
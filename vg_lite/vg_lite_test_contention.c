@@ -0,0 +1,534 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_contention.h"
+#include "../gpu_assert.h"
+#include "../gpu_context.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_recorder.h"
+#include "../gpu_tick.h"
+#include "vg_lite_test_path.h"
+#include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Measuring time of each lock and thread count */
+#define CONTENTION_BENCHMARK_TIME_MS 200
+
+/* Target of each thread, a small UI layer */
+#define CONTENTION_TARGET_WIDTH 128
+#define CONTENTION_TARGET_HEIGHT 128
+
+/* Latencies kept per thread for the percentile, the oldest are overwritten */
+#define CONTENTION_SAMPLE_MAX 4096
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum contention_lock_e {
+    CONTENTION_LOCK_MUTEX,
+    CONTENTION_LOCK_TICKET,
+    CONTENTION_LOCK_QUEUE,
+    _CONTENTION_LOCK_LAST
+};
+
+struct contention_worker_s;
+
+struct contention_job_s {
+    struct contention_job_s* next;
+    struct contention_worker_s* worker;
+    uint32_t start_tick;
+    vg_lite_error_t error;
+    int done;
+};
+
+/* Intrusive multi-producer single-consumer queue, the producers only exchange the head */
+struct contention_queue_s {
+    struct contention_job_s* head;
+    struct contention_job_s* tail;
+    struct contention_job_s stub;
+};
+
+struct contention_bench_s {
+    enum contention_lock_e lock;
+    pthread_mutex_t mutex;
+    uint32_t ticket_next;
+    uint32_t ticket_serving;
+    struct contention_queue_s queue;
+    pthread_t submitter;
+    int running_workers;
+    uint32_t start_tick;
+};
+
+struct contention_worker_s {
+    struct contention_bench_s* bench;
+    pthread_t thread;
+    struct gpu_buffer_s* target_gpu_buffer;
+    vg_lite_buffer_t target;
+    vg_lite_test_path_t* path;
+    vg_lite_matrix_t matrix;
+    struct contention_job_s job;
+
+    uint32_t jobs;
+    uint32_t errors;
+    uint64_t latency_sum;
+    uint32_t latency_max;
+    uint64_t wait_sum;
+    uint32_t wait_max;
+    uint32_t samples[CONTENTION_SAMPLE_MAX];
+    uint32_t sample_count;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool contention_parse_locks(const char* str, bool* enabled);
+static int contention_run_point(struct gpu_test_context_s* ctx, enum contention_lock_e lock, int thread_count);
+static void* contention_worker_thread(void* arg);
+static void* contention_submitter_thread(void* arg);
+static void contention_submit(struct contention_worker_s* worker);
+static vg_lite_error_t contention_job_run(struct contention_job_s* job);
+static void contention_queue_init(struct contention_queue_s* queue);
+static void contention_queue_push(struct contention_queue_s* queue, struct contention_job_s* job);
+static struct contention_job_s* contention_queue_pop(struct contention_queue_s* queue);
+static uint32_t contention_percentile(uint32_t* samples, uint32_t count, uint32_t permille);
+static int contention_compare_u32(const void* a, const void* b);
+static void contention_record(struct gpu_test_context_s* ctx, enum contention_lock_e lock, int thread_count,
+    const char* thread_name, uint32_t time_us, uint32_t jobs, uint32_t errors, uint64_t latency_sum, uint32_t latency_p99,
+    uint32_t latency_max, uint64_t wait_sum, uint32_t wait_max);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const char* const contention_lock_names[_CONTENTION_LOCK_LAST] = {
+    [CONTENTION_LOCK_MUTEX] = "mutex",
+    [CONTENTION_LOCK_TICKET] = "ticket",
+    [CONTENTION_LOCK_QUEUE] = "queue",
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int vg_lite_test_contention_run(struct gpu_test_context_s* ctx)
+{
+    GPU_ASSERT_NULL(ctx);
+
+    bool enabled[_CONTENTION_LOCK_LAST];
+    if (!contention_parse_locks(ctx->param.contention_locks, enabled)) {
+        GPU_LOG_ERROR("Invalid lock list: %s", ctx->param.contention_locks);
+        return -1;
+    }
+
+    if (ctx->recorder) {
+        gpu_recorder_write_string(ctx->recorder,
+            "Lock,Threads,Thread,Jobs,Errors,Throughput(jobs/s),"
+            "Latency Avg(us),Latency P99(us),Latency Max(us),"
+            "Lock Wait Avg(us),Lock Wait Max(us),Lock Wait(%)\n");
+    }
+
+    const int thread_max = ctx->param.contention_threads;
+
+    for (int lock = 0; lock < _CONTENTION_LOCK_LAST; lock++) {
+        if (!enabled[lock]) {
+            continue;
+        }
+
+        for (int thread_count = 1;; thread_count *= 2) {
+            thread_count = MATH_MIN(thread_count, thread_max);
+            if (contention_run_point(ctx, lock, thread_count) < 0) {
+                return -1;
+            }
+
+            if (thread_count == thread_max) {
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool contention_parse_locks(const char* str, bool* enabled)
+{
+    if (!str) {
+        for (int lock = 0; lock < _CONTENTION_LOCK_LAST; lock++) {
+            enabled[lock] = true;
+        }
+
+        return true;
+    }
+
+    memset(enabled, 0, sizeof(bool) * _CONTENTION_LOCK_LAST);
+
+    char* str_copy = strdup(str);
+    GPU_ASSERT_NULL(str_copy);
+
+    bool valid = true;
+    char* saveptr = NULL;
+    for (char* name = strtok_r(str_copy, ",", &saveptr); name; name = strtok_r(NULL, ",", &saveptr)) {
+        int lock = 0;
+        while (lock < _CONTENTION_LOCK_LAST && strcasecmp(name, contention_lock_names[lock]) != 0) {
+            lock++;
+        }
+
+        if (lock == _CONTENTION_LOCK_LAST) {
+            valid = false;
+            break;
+        }
+
+        enabled[lock] = true;
+    }
+
+    free(str_copy);
+    return valid;
+}
+
+static int contention_run_point(struct gpu_test_context_s* ctx, enum contention_lock_e lock, int thread_count)
+{
+    struct contention_bench_s bench;
+    memset(&bench, 0, sizeof(bench));
+    bench.lock = lock;
+    pthread_mutex_init(&bench.mutex, NULL);
+    contention_queue_init(&bench.queue);
+
+    struct contention_worker_s* workers = calloc(thread_count, sizeof(struct contention_worker_s));
+    GPU_ASSERT_NULL(workers);
+
+    /* The buffers and the paths are built up front, only the submission is measured */
+    for (int i = 0; i < thread_count; i++) {
+        struct contention_worker_s* worker = &workers[i];
+        worker->bench = &bench;
+        worker->job.worker = worker;
+        worker->target_gpu_buffer = vg_lite_test_buffer_alloc(
+            &worker->target, CONTENTION_TARGET_WIDTH, CONTENTION_TARGET_HEIGHT, VG_LITE_BGRA8888, VG_LITE_TEST_STRIDE_AUTO);
+        worker->path = vg_lite_test_path_create(VG_LITE_FP32);
+        vg_lite_test_path_append_circle(worker->path,
+            CONTENTION_TARGET_WIDTH / 2, CONTENTION_TARGET_HEIGHT / 2,
+            CONTENTION_TARGET_WIDTH / 3, CONTENTION_TARGET_HEIGHT / 3);
+        vg_lite_test_path_end(worker->path);
+        vg_lite_identity(&worker->matrix);
+    }
+
+    bench.running_workers = thread_count;
+    bench.start_tick = gpu_tick_get();
+
+    int ret = 0;
+    bool submitter_created = false;
+    if (lock == CONTENTION_LOCK_QUEUE) {
+        if (pthread_create(&bench.submitter, NULL, contention_submitter_thread, &bench) != 0) {
+            GPU_LOG_ERROR("Create submission thread failed");
+            bench.running_workers = 0;
+            ret = -1;
+        } else {
+            submitter_created = true;
+        }
+    }
+
+    int created = 0;
+    for (; ret == 0 && created < thread_count; created++) {
+        if (pthread_create(&workers[created].thread, NULL, contention_worker_thread, &workers[created]) != 0) {
+            GPU_LOG_ERROR("Create worker thread %d failed", created);
+
+            /* The submission thread waits for the workers that never started */
+            __atomic_sub_fetch(&bench.running_workers, thread_count - created, __ATOMIC_ACQ_REL);
+            ret = -1;
+            break;
+        }
+    }
+
+    for (int i = 0; i < created; i++) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    if (submitter_created) {
+        pthread_join(bench.submitter, NULL);
+    }
+
+    const uint32_t time_us = gpu_tick_elaps(bench.start_tick);
+
+    uint32_t* all_samples = malloc(sizeof(uint32_t) * CONTENTION_SAMPLE_MAX * thread_count);
+    GPU_ASSERT_NULL(all_samples);
+    uint32_t all_sample_count = 0;
+    uint32_t jobs = 0, errors = 0, latency_max = 0, wait_max = 0;
+    uint64_t latency_sum = 0, wait_sum = 0;
+
+    for (int i = 0; i < thread_count; i++) {
+        struct contention_worker_s* worker = &workers[i];
+        uint32_t sample_count = MATH_MIN(worker->sample_count, CONTENTION_SAMPLE_MAX);
+        memcpy(all_samples + all_sample_count, worker->samples, sizeof(uint32_t) * sample_count);
+        all_sample_count += sample_count;
+
+        jobs += worker->jobs;
+        errors += worker->errors;
+        latency_sum += worker->latency_sum;
+        latency_max = MATH_MAX(latency_max, worker->latency_max);
+        wait_sum += worker->wait_sum;
+        wait_max = MATH_MAX(wait_max, worker->wait_max);
+
+        char thread_name[16];
+        snprintf(thread_name, sizeof(thread_name), "%d", i);
+        contention_record(ctx, lock, thread_count, thread_name, time_us, worker->jobs, worker->errors,
+            worker->latency_sum, contention_percentile(worker->samples, sample_count, 990), worker->latency_max,
+            worker->wait_sum, worker->wait_max);
+
+        vg_lite_test_path_destroy(worker->path);
+        gpu_buffer_free(worker->target_gpu_buffer);
+    }
+
+    contention_record(ctx, lock, thread_count, "all", time_us, jobs, errors,
+        latency_sum, contention_percentile(all_samples, all_sample_count, 990), latency_max, wait_sum, wait_max);
+
+    free(all_samples);
+    free(workers);
+    pthread_mutex_destroy(&bench.mutex);
+    return ret;
+}
+
+static void* contention_worker_thread(void* arg)
+{
+    struct contention_worker_s* worker = arg;
+    struct contention_bench_s* bench = worker->bench;
+
+    while (gpu_tick_elaps(bench->start_tick) < CONTENTION_BENCHMARK_TIME_MS * 1000) {
+        contention_submit(worker);
+    }
+
+    __atomic_sub_fetch(&bench->running_workers, 1, __ATOMIC_ACQ_REL);
+    return NULL;
+}
+
+static void* contention_submitter_thread(void* arg)
+{
+    struct contention_bench_s* bench = arg;
+
+    /* A worker only leaves after its last job is done, the queue is empty once they are all gone */
+    while (__atomic_load_n(&bench->running_workers, __ATOMIC_ACQUIRE) > 0) {
+        struct contention_job_s* job = contention_queue_pop(&bench->queue);
+        if (!job) {
+            sched_yield();
+            continue;
+        }
+
+        job->start_tick = gpu_tick_get();
+        job->error = contention_job_run(job);
+        __atomic_store_n(&job->done, 1, __ATOMIC_RELEASE);
+    }
+
+    return NULL;
+}
+
+static void contention_submit(struct contention_worker_s* worker)
+{
+    struct contention_bench_s* bench = worker->bench;
+    struct contention_job_s* job = &worker->job;
+    const uint32_t submit_tick = gpu_tick_get();
+
+    switch (bench->lock) {
+    case CONTENTION_LOCK_MUTEX:
+        pthread_mutex_lock(&bench->mutex);
+        job->start_tick = gpu_tick_get();
+        job->error = contention_job_run(job);
+        pthread_mutex_unlock(&bench->mutex);
+        break;
+
+    case CONTENTION_LOCK_TICKET: {
+        /* First come first served, the mutex gives no such guarantee */
+        const uint32_t ticket = __atomic_fetch_add(&bench->ticket_next, 1, __ATOMIC_RELAXED);
+        while (__atomic_load_n(&bench->ticket_serving, __ATOMIC_ACQUIRE) != ticket) {
+            sched_yield();
+        }
+
+        job->start_tick = gpu_tick_get();
+        job->error = contention_job_run(job);
+        __atomic_store_n(&bench->ticket_serving, ticket + 1, __ATOMIC_RELEASE);
+    } break;
+
+    case CONTENTION_LOCK_QUEUE:
+        __atomic_store_n(&job->done, 0, __ATOMIC_RELAXED);
+        contention_queue_push(&bench->queue, job);
+        while (!__atomic_load_n(&job->done, __ATOMIC_ACQUIRE)) {
+            sched_yield();
+        }
+        break;
+
+    default:
+        GPU_ASSERT(false);
+        break;
+    }
+
+    const uint32_t latency = gpu_tick_elaps(submit_tick);
+    const uint32_t wait = job->start_tick - submit_tick;
+
+    worker->jobs++;
+    worker->errors += job->error != VG_LITE_SUCCESS;
+    worker->latency_sum += latency;
+    worker->latency_max = MATH_MAX(worker->latency_max, latency);
+    worker->wait_sum += wait;
+    worker->wait_max = MATH_MAX(worker->wait_max, wait);
+    worker->samples[worker->sample_count++ % CONTENTION_SAMPLE_MAX] = latency;
+}
+
+static vg_lite_error_t contention_job_run(struct contention_job_s* job)
+{
+    struct contention_worker_s* worker = job->worker;
+
+    /* vg_lite is not thread safe, every call of the job runs under the lock */
+    vg_lite_error_t error = vg_lite_draw(
+        &worker->target,
+        vg_lite_test_path_get_path(worker->path),
+        VG_LITE_FILL_NON_ZERO,
+        &worker->matrix,
+        VG_LITE_BLEND_SRC_OVER,
+        0xFF0000FF);
+
+    if (error == VG_LITE_SUCCESS) {
+        error = vg_lite_finish();
+    }
+
+    return error;
+}
+
+static void contention_queue_init(struct contention_queue_s* queue)
+{
+    memset(queue, 0, sizeof(struct contention_queue_s));
+    queue->head = &queue->stub;
+    queue->tail = &queue->stub;
+}
+
+static void contention_queue_push(struct contention_queue_s* queue, struct contention_job_s* job)
+{
+    __atomic_store_n(&job->next, NULL, __ATOMIC_RELAXED);
+    struct contention_job_s* prev = __atomic_exchange_n(&queue->head, job, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&prev->next, job, __ATOMIC_RELEASE);
+}
+
+static struct contention_job_s* contention_queue_pop(struct contention_queue_s* queue)
+{
+    struct contention_job_s* tail = queue->tail;
+    struct contention_job_s* next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+
+    if (tail == &queue->stub) {
+        if (!next) {
+            return NULL;
+        }
+
+        queue->tail = next;
+        tail = next;
+        next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    }
+
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+
+    /* A producer is between the exchange and the link, try again later */
+    if (tail != __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+
+    /* The last job can only be taken with the stub queued behind it */
+    contention_queue_push(queue, &queue->stub);
+    next = __atomic_load_n(&tail->next, __ATOMIC_ACQUIRE);
+    if (next) {
+        queue->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+static uint32_t contention_percentile(uint32_t* samples, uint32_t count, uint32_t permille)
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    qsort(samples, count, sizeof(uint32_t), contention_compare_u32);
+    return samples[(uint64_t)(count - 1) * permille / 1000];
+}
+
+static int contention_compare_u32(const void* a, const void* b)
+{
+    const uint32_t va = *(const uint32_t*)a;
+    const uint32_t vb = *(const uint32_t*)b;
+    return (va > vb) - (va < vb);
+}
+
+static void contention_record(struct gpu_test_context_s* ctx, enum contention_lock_e lock, int thread_count,
+    const char* thread_name, uint32_t time_us, uint32_t jobs, uint32_t errors, uint64_t latency_sum, uint32_t latency_p99,
+    uint32_t latency_max, uint64_t wait_sum, uint32_t wait_max)
+{
+    const float throughput = time_us ? jobs * 1000000.0f / time_us : 0.0f;
+    const float latency_avg = jobs ? (float)latency_sum / jobs : 0.0f;
+    const float wait_avg = jobs ? (float)wait_sum / jobs : 0.0f;
+    const float wait_percent = latency_sum ? wait_sum * 100.0f / latency_sum : 0.0f;
+
+    /* The per thread lines are details, the total is the result */
+    if (strcmp(thread_name, "all") == 0) {
+        GPU_LOG_WARN("Contention %s x%d: %0.1f jobs/s, latency avg %0.1f p99 %" PRIu32 " max %" PRIu32
+                     " us, lock wait avg %0.1f us (%0.1f%%), %" PRIu32 " errors",
+            contention_lock_names[lock], thread_count, throughput, latency_avg, latency_p99, latency_max,
+            wait_avg, wait_percent, errors);
+    } else {
+        GPU_LOG_INFO("Contention %s x%d thread %s: %" PRIu32 " jobs, latency avg %0.1f p99 %" PRIu32 " us",
+            contention_lock_names[lock], thread_count, thread_name, jobs, latency_avg, latency_p99);
+    }
+
+    if (!ctx->recorder) {
+        return;
+    }
+
+    char result[256];
+    snprintf(result, sizeof(result),
+        "%s,%d,%s,%" PRIu32 ",%" PRIu32 ",%0.1f,%0.1f,%" PRIu32 ",%" PRIu32 ",%0.1f,%" PRIu32 ",%0.1f\n",
+        contention_lock_names[lock], thread_count, thread_name, jobs, errors, throughput,
+        latency_avg, latency_p99, latency_max, wait_avg, wait_max, wait_percent);
+    gpu_recorder_write_string(ctx->recorder, result);
+}
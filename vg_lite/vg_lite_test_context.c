@@ -30,13 +30,26 @@
 #include "../gpu_buffer.h"
 #include "../gpu_cache.h"
 #include "../gpu_context.h"
+#include "../gpu_math.h"
+#include "../gpu_perf.h"
 #include "../gpu_recorder.h"
 #include "../gpu_screenshot.h"
 #include "../gpu_tick.h"
+#include "../gpu_timeline.h"
 #include "../gpu_utils.h"
+#include "vg_lite_test_asset.h"
+#include "vg_lite_test_budget.h"
+#include "vg_lite_test_busy.h"
+#include "vg_lite_test_fault.h"
+#include "vg_lite_test_latency.h"
 #include "vg_lite_test_path.h"
+#include "vg_lite_test_ref.h"
+#include "vg_lite_test_roofline.h"
+#include "vg_lite_test_trace.h"
+#include "vg_lite_test_traffic.h"
 #include "vg_lite_test_utils.h"
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -47,23 +60,79 @@
 
 #define REF_IMAGES_DIR "/ref_images"
 
+/* Not every libc defines it */
+#ifndef PATH_MAX
+#define PATH_MAX 4096
+#endif
+
+/* Allowed difference between the GPU and the reference renderer */
+#define REF_RENDER_TOLERANCE 16
+#define REF_RENDER_MISMATCH_PERMILLE 10
+
+/* Phases measured by the performance counters */
+enum vg_lite_test_phase_e {
+    VG_LITE_TEST_PHASE_SETUP,
+    VG_LITE_TEST_PHASE_DRAW,
+    VG_LITE_TEST_PHASE_FINISH,
+    _VG_LITE_TEST_PHASE_LAST
+};
+
+/* Consecutive leaking runs of the same item that fail --leak-check, the first run may fill driver caches */
+#define LEAK_CHECK_STREAK 3
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+struct vg_lite_test_leak_s {
+    const struct vg_lite_test_item_s* item;
+    int streak;
+};
+
 struct vg_lite_test_context_s {
     struct gpu_test_context_s* gpu_ctx;
     struct gpu_buffer_s* target_gpu_buffer;
     struct gpu_buffer_s* src_gpu_buffer;
     vg_lite_buffer_t target_buffer;
     vg_lite_buffer_t src_buffer;
+    vg_lite_buffer_format_t target_format_default;
     struct vg_lite_test_path_s* path;
+    struct vg_lite_test_ref_s* ref;
+    struct vg_lite_test_fault_s* fault;
+    struct vg_lite_test_asset_s* asset;
+    struct vg_lite_test_busy_s* busy;
+    struct vg_lite_test_busy_stats_s busy_stats;
+    struct vg_lite_test_traffic_s* traffic;
+    struct vg_lite_test_traffic_stats_s traffic_stats;
+    struct vg_lite_test_roofline_s* roofline;
+    struct vg_lite_test_budget_s* budget;
+    struct gpu_perf_s* perf;
+    uint64_t perf_values[_VG_LITE_TEST_PHASE_LAST][_GPU_PERF_EVENT_LAST];
     vg_lite_matrix_t matrix;
     uint32_t setup_tick;
     uint32_t draw_tick;
     uint32_t finish_tick;
+    uint32_t mem_peak;
+    int32_t mem_leak;
+    const char* src_binding;
+    const struct vg_lite_test_item_s* item;
+    vg_lite_error_t error;
+    uint32_t item_start_tick;
+    uint32_t mem_before_setup;
+    uint32_t mem_after_draw;
+    struct gpu_cache_stats_s cache_base;
+    bool skipped;
+    bool busy_sampling;
+    bool pipelined;
+    bool is_slot;
+    struct vg_lite_test_leak_s* leaks;
+    int leak_count;
     char vg_error_remark_text[64];
     char screenshot_remark_text[192];
+    char ref_remark_text[192];
+    char fault_remark_text[128];
+    char budget_remark_text[128];
+    char target_tag[48];
     void* user_data;
 };
 
@@ -71,7 +140,13 @@ struct vg_lite_test_context_s {
  *  STATIC PROTOTYPES
  **********************/
 
+static struct vg_lite_test_context_s* vg_lite_test_context_alloc(struct gpu_test_context_s* gpu_ctx);
+static void vg_lite_test_context_alloc_target(struct vg_lite_test_context_s* ctx);
 static void vg_lite_test_context_cleanup(struct vg_lite_test_context_s* ctx);
+static bool vg_lite_test_context_prepare_target(struct vg_lite_test_context_s* ctx, vg_lite_buffer_format_t format);
+static void vg_lite_test_context_item_setup(struct vg_lite_test_context_s* ctx, const struct vg_lite_test_item_s* item, bool pipelined);
+static void vg_lite_test_context_item_draw(struct vg_lite_test_context_s* ctx);
+static bool vg_lite_test_context_item_complete(struct vg_lite_test_context_s* ctx);
 static void vg_lite_test_context_record(
     struct vg_lite_test_context_s* ctx,
     const struct vg_lite_test_item_s* item,
@@ -79,6 +154,22 @@ static void vg_lite_test_context_record(
     const char* result_str);
 static void vg_lite_test_context_error_to_remark(struct vg_lite_test_context_s* ctx, vg_lite_error_t error);
 static bool vg_lite_test_context_check_screenshot(struct vg_lite_test_context_s* ctx, const char* name);
+static struct gpu_buffer_s* vg_lite_test_context_get_ref_image(struct vg_lite_test_context_s* ctx);
+static bool vg_lite_test_context_check_reference(struct vg_lite_test_context_s* ctx);
+static void vg_lite_test_context_log_cache(const struct vg_lite_test_item_s* item, const struct gpu_cache_stats_s* stats);
+static void vg_lite_test_context_perf_start(struct vg_lite_test_context_s* ctx);
+static void vg_lite_test_context_perf_stop(struct vg_lite_test_context_s* ctx, enum vg_lite_test_phase_e phase);
+static int vg_lite_test_context_perf_to_string(struct vg_lite_test_context_s* ctx, char* buf, size_t size);
+static int vg_lite_test_context_busy_to_string(struct vg_lite_test_context_s* ctx, char* buf, size_t size);
+static float vg_lite_test_context_rate(uint64_t count, uint32_t time_us);
+static int vg_lite_test_context_roofline_to_string(struct vg_lite_test_context_s* ctx, char* buf, size_t size);
+static uint32_t vg_lite_test_context_get_mem_available(void);
+static bool vg_lite_test_context_check_memory(
+    struct vg_lite_test_context_s* ctx,
+    const struct vg_lite_test_item_s* item,
+    uint32_t before_setup,
+    uint32_t after_draw,
+    uint32_t after_teardown);
 
 /**********************
  *  STATIC VARIABLES
@@ -96,28 +187,38 @@ struct vg_lite_test_context_s* vg_lite_test_context_create(struct gpu_test_conte
 {
     GPU_ASSERT_NULL(gpu_ctx);
 
-    struct vg_lite_test_context_s* ctx = malloc(sizeof(struct vg_lite_test_context_s));
-    GPU_ASSERT_NULL(ctx);
-    memset(ctx, 0, sizeof(struct vg_lite_test_context_s));
-    ctx->gpu_ctx = gpu_ctx;
-    vg_lite_identity(&ctx->matrix);
-    vg_lite_scale(
-        gpu_ctx->param.target_width / (float)GPU_TEST_DESIGN_WIDTH,
-        gpu_ctx->param.target_height / (float)GPU_TEST_DESIGN_HEIGHT,
-        &ctx->matrix);
+    struct vg_lite_test_context_s* ctx = vg_lite_test_context_alloc(gpu_ctx);
 
-    if (gpu_ctx->target_buffer.data) {
-        GPU_LOG_INFO("Using external target buffer");
-        vg_lite_test_gpu_buffer_to_vg_buffer(&ctx->target_buffer, &gpu_ctx->target_buffer);
-    } else {
-        ctx->target_gpu_buffer = vg_lite_test_buffer_alloc(
-            &ctx->target_buffer,
-            ctx->gpu_ctx->param.target_width,
-            ctx->gpu_ctx->param.target_height,
-            VG_LITE_BGRA8888,
-            VG_LITE_TEST_STRIDE_AUTO);
+    /* Measure before any listener is registered, the benchmark calls are not test items */
+    if (gpu_ctx->param.roofline_en) {
+        ctx->roofline = vg_lite_test_roofline_create(gpu_ctx);
     }
 
+    /* Register the fault injector first, the skipped calls must not reach the reference renderer */
+    if (gpu_ctx->param.fault_spec) {
+        ctx->fault = vg_lite_test_fault_create(gpu_ctx->param.fault_spec);
+    }
+
+    if (gpu_ctx->param.ref_en) {
+        ctx->ref = vg_lite_test_ref_create(VG_LITE_TEST_REF_THREAD_AUTO);
+    }
+
+    if (gpu_ctx->param.perf_en) {
+        ctx->perf = gpu_perf_create();
+    }
+
+    if (gpu_ctx->param.asset_path) {
+        ctx->asset = vg_lite_test_asset_open(gpu_ctx->param.asset_path);
+    }
+
+    if (gpu_ctx->param.busy_sample_rate > 0) {
+        ctx->busy = vg_lite_test_busy_create(gpu_ctx->param.busy_sample_rate);
+    }
+
+    ctx->traffic = vg_lite_test_traffic_create();
+
+    ctx->budget = vg_lite_test_budget_create(gpu_ctx->param.budget_path, gpu_ctx->param.budget_update_spec);
+
     if (ctx->gpu_ctx->recorder) {
         gpu_recorder_write_string(ctx->gpu_ctx->recorder,
             "Testcase,"
@@ -125,11 +226,44 @@ struct vg_lite_test_context_s* vg_lite_test_context_create(struct gpu_test_conte
             "Target Format,Source Format,"
             "Target Address,Source Address,"
             "Target Area,Source Area,"
+            "Source Binding,"
             "Setup Time(ms),Draw Time(ms),Finish Time(ms),"
+            "Pixels Touched,Pixel Rate(MPix/s),Bytes Moved,Throughput(GB/s),"
+            "Memory Peak(bytes),Memory Leak(bytes),"
+            "Cache Ops,Cache Bytes,Cache Time(ms),"
             "VG-Lite Result,VG-Lite Remark,"
             "Screenshot Result,"
-            "Result"
-            "\n");
+            "Reference Result,"
+            "Fault Remark,"
+            "Result");
+
+        /* The counters are appended to keep the other columns in place */
+        if (ctx->perf) {
+            static const char* phase_names[_VG_LITE_TEST_PHASE_LAST] = { "Setup", "Draw", "Finish" };
+            for (int phase = 0; phase < _VG_LITE_TEST_PHASE_LAST; phase++) {
+                for (int event = 0; event < _GPU_PERF_EVENT_LAST; event++) {
+                    char column[64];
+                    snprintf(column, sizeof(column), ",%s %s", phase_names[phase], gpu_perf_event_string(event));
+                    gpu_recorder_write_string(ctx->gpu_ctx->recorder, column);
+                }
+            }
+        }
+
+        if (ctx->busy) {
+            gpu_recorder_write_string(ctx->gpu_ctx->recorder,
+                ",GPU Busy(%),GPU Busy Samples,"
+                "GPU Idle Gaps,GPU Idle Gap Total(ms),GPU Idle Gap Max(ms)");
+        }
+
+        if (ctx->roofline) {
+            gpu_recorder_write_string(ctx->gpu_ctx->recorder, ",Roofline(%)");
+        }
+
+        if (ctx->budget) {
+            gpu_recorder_write_string(ctx->gpu_ctx->recorder, ",Budget Remark");
+        }
+
+        gpu_recorder_write_string(ctx->gpu_ctx->recorder, "\n");
     }
 
     char path[256];
@@ -139,6 +273,27 @@ struct vg_lite_test_context_s* vg_lite_test_context_create(struct gpu_test_conte
     return ctx;
 }
 
+struct vg_lite_test_context_s* vg_lite_test_context_create_slot(struct vg_lite_test_context_s* ctx)
+{
+    GPU_ASSERT_NULL(ctx);
+
+    /* The reference renderer and the fault injector follow one item at a time, they stay with the first context */
+    struct vg_lite_test_context_s* slot = vg_lite_test_context_alloc(ctx->gpu_ctx);
+    slot->is_slot = true;
+    slot->asset = ctx->asset;
+    slot->busy = ctx->busy;
+    slot->traffic = ctx->traffic;
+    slot->roofline = ctx->roofline;
+    slot->budget = ctx->budget;
+    snprintf(slot->target_tag, sizeof(slot->target_tag), "%s", ctx->target_tag);
+
+    if (ctx->perf) {
+        slot->perf = gpu_perf_create();
+    }
+
+    return slot;
+}
+
 void vg_lite_test_context_destroy(struct vg_lite_test_context_s* ctx)
 {
     GPU_ASSERT_NULL(ctx);
@@ -157,60 +312,108 @@ void vg_lite_test_context_destroy(struct vg_lite_test_context_s* ctx)
         ctx->path = NULL;
     }
 
-    memset(ctx, 0, sizeof(struct vg_lite_test_context_s));
-    free(ctx);
-}
+    if (ctx->ref) {
+        vg_lite_test_ref_destroy(ctx->ref);
+        ctx->ref = NULL;
+    }
 
-bool vg_lite_test_context_run_item(struct vg_lite_test_context_s* ctx, const struct vg_lite_test_item_s* item)
-{
-    vg_lite_test_context_cleanup(ctx);
+    if (ctx->fault) {
+        vg_lite_test_fault_destroy(ctx->fault);
+        ctx->fault = NULL;
+    }
 
-    if (item->feature != gcFEATURE_BIT_VG_NONE && !vg_lite_query_feature(item->feature)) {
-        snprintf(ctx->vg_error_remark_text, sizeof(ctx->vg_error_remark_text), "Feature '%s' not supported", vg_lite_test_feature_string(item->feature));
-        GPU_LOG_WARN("Skipping test case: %s %s", item->name, ctx->vg_error_remark_text);
-        vg_lite_test_context_record(ctx, item, VG_LITE_NOT_SUPPORT, "SKIP");
-        return true;
+    if (ctx->perf) {
+        gpu_perf_delete(ctx->perf);
+        ctx->perf = NULL;
     }
 
-    GPU_LOG_INFO("Running test case: %s", item->name);
+    if (ctx->asset && !ctx->is_slot) {
+        vg_lite_test_asset_close(ctx->asset);
+    }
 
-    vg_lite_error_t error = VG_LITE_SUCCESS;
-    {
-        uint32_t start_tick = gpu_tick_get();
-        error = item->on_setup(ctx);
-        ctx->setup_tick = gpu_tick_elaps(start_tick);
+    ctx->asset = NULL;
+
+    if (ctx->busy && !ctx->is_slot) {
+        vg_lite_test_busy_destroy(ctx->busy);
     }
 
-    if (error == VG_LITE_SUCCESS) {
-        uint32_t start_tick = gpu_tick_get();
-        error = item->on_draw(ctx);
-        ctx->draw_tick = gpu_tick_elaps(start_tick);
+    ctx->busy = NULL;
+
+    if (ctx->traffic && !ctx->is_slot) {
+        vg_lite_test_traffic_destroy(ctx->traffic);
     }
 
-    if (error == VG_LITE_SUCCESS) {
-        uint32_t start_tick = gpu_tick_get();
-        error = vg_lite_finish();
-        ctx->finish_tick = gpu_tick_elaps(start_tick);
+    ctx->traffic = NULL;
+
+    if (ctx->roofline && !ctx->is_slot) {
+        vg_lite_test_roofline_destroy(ctx->roofline);
     }
 
-    if (item->on_teardown) {
-        item->on_teardown(ctx);
+    ctx->roofline = NULL;
+
+    if (ctx->budget && !ctx->is_slot) {
+        vg_lite_test_budget_destroy(ctx->budget);
     }
 
-    if (error == VG_LITE_SUCCESS) {
-        GPU_LOG_INFO("Test case '%s' render success", item->name);
-    } else {
-        GPU_LOG_ERROR("Test case '%s' render failed: %d (%s)", item->name, error, vg_lite_test_error_string(error));
-        vg_lite_test_context_error_to_remark(ctx, error);
+    ctx->budget = NULL;
+
+    if (ctx->leaks) {
+        free(ctx->leaks);
+        ctx->leaks = NULL;
     }
 
-    bool screenshot_cmp_pass = vg_lite_test_context_check_screenshot(ctx, item->name);
+    memset(ctx, 0, sizeof(struct vg_lite_test_context_s));
+    free(ctx);
+}
+
+void vg_lite_test_context_set_target(struct vg_lite_test_context_s* ctx, const char* tag)
+{
+    GPU_ASSERT_NULL(ctx);
+
+    /* The external framebuffer has a fixed geometry */
+    if (!ctx->target_gpu_buffer) {
+        return;
+    }
+
+    gpu_buffer_free(ctx->target_gpu_buffer);
+    ctx->target_gpu_buffer = NULL;
+    vg_lite_test_context_alloc_target(ctx);
+    snprintf(ctx->target_tag, sizeof(ctx->target_tag), "%s", tag ? tag : "");
+}
 
-    bool passed = (error == VG_LITE_SUCCESS && screenshot_cmp_pass);
+bool vg_lite_test_context_run_item(struct vg_lite_test_context_s* ctx, const struct vg_lite_test_item_s* item)
+{
+    GPU_ASSERT_NULL(ctx);
+    GPU_ASSERT_NULL(item);
 
-    vg_lite_test_context_record(ctx, item, error, passed ? "PASS" : "FAIL");
+    vg_lite_test_context_item_setup(ctx, item, false);
+    vg_lite_test_context_item_draw(ctx);
+    return vg_lite_test_context_item_complete(ctx);
+}
 
-    return passed;
+void vg_lite_test_context_begin_item(struct vg_lite_test_context_s* ctx, const struct vg_lite_test_item_s* item)
+{
+    GPU_ASSERT_NULL(ctx);
+    GPU_ASSERT_NULL(item);
+    GPU_ASSERT(ctx->ref == NULL && ctx->fault == NULL);
+
+    vg_lite_test_context_item_setup(ctx, item, true);
+}
+
+void vg_lite_test_context_submit_item(struct vg_lite_test_context_s* ctx)
+{
+    GPU_ASSERT_NULL(ctx);
+    GPU_ASSERT(ctx->pipelined);
+
+    vg_lite_test_context_item_draw(ctx);
+}
+
+bool vg_lite_test_context_end_item(struct vg_lite_test_context_s* ctx)
+{
+    GPU_ASSERT_NULL(ctx);
+    GPU_ASSERT(ctx->pipelined);
+
+    return vg_lite_test_context_item_complete(ctx);
 }
 
 vg_lite_buffer_t* vg_lite_test_context_get_target_buffer(struct vg_lite_test_context_s* ctx)
@@ -237,8 +440,9 @@ vg_lite_buffer_t* vg_lite_test_context_alloc_src_buffer(
     GPU_ASSERT(height > 0);
 
     /* Check if the source buffer is already created */
-    GPU_ASSERT(ctx->src_gpu_buffer == NULL);
+    GPU_ASSERT(ctx->src_buffer.memory == NULL);
     ctx->src_gpu_buffer = vg_lite_test_buffer_alloc(&ctx->src_buffer, width, height, format, stride);
+    ctx->src_binding = "ALLOC";
     return &ctx->src_buffer;
 }
 
@@ -267,6 +471,30 @@ void vg_lite_test_context_load_src_image(
 
     /* Make sure the buffer is flushed to memory */
     gpu_cache_flush(buffer->memory, buffer->stride * buffer->height);
+    ctx->src_binding = "COPY";
+}
+
+bool vg_lite_test_context_bind_src_image(
+    struct vg_lite_test_context_s* ctx,
+    const void* image_data,
+    uint32_t width,
+    uint32_t height,
+    vg_lite_buffer_format_t format,
+    uint32_t image_stride)
+{
+    GPU_ASSERT_NULL(ctx);
+    GPU_ASSERT(ctx->src_buffer.memory == NULL);
+
+    /* Constant data is never dirty in the cache, no flush needed */
+    if (vg_lite_test_buffer_wrap(&ctx->src_buffer, image_data, width, height, format, image_stride)) {
+        GPU_LOG_INFO("Source image %p bound without copy", image_data);
+        ctx->src_binding = "ZERO_COPY";
+        return true;
+    }
+
+    GPU_LOG_INFO("Source image %p copied", image_data);
+    vg_lite_test_context_load_src_image(ctx, image_data, width, height, format, image_stride);
+    return false;
 }
 
 void vg_lite_test_context_set_transform(struct vg_lite_test_context_s* ctx, const vg_lite_matrix_t* matrix)
@@ -302,6 +530,22 @@ struct vg_lite_test_path_s* vg_lite_test_context_get_path(struct vg_lite_test_co
     return ctx->path;
 }
 
+struct vg_lite_test_asset_s* vg_lite_test_context_get_asset(struct vg_lite_test_context_s* ctx)
+{
+    GPU_ASSERT_NULL(ctx);
+    return ctx->asset;
+}
+
+const struct vg_lite_test_param_s* vg_lite_test_context_get_param(struct vg_lite_test_context_s* ctx)
+{
+    GPU_ASSERT_NULL(ctx);
+    GPU_ASSERT_NULL(ctx->item);
+
+    /* The runner passes each variant as an item with a single entry */
+    GPU_ASSERT(ctx->item->params != NULL && ctx->item->param_count == 1);
+    return ctx->item->params;
+}
+
 void vg_lite_test_context_set_user_data(struct vg_lite_test_context_s* ctx, void* user_data)
 {
     GPU_ASSERT_NULL(ctx);
@@ -318,6 +562,40 @@ void* vg_lite_test_context_get_user_data(struct vg_lite_test_context_s* ctx)
  *   STATIC FUNCTIONS
  **********************/
 
+static struct vg_lite_test_context_s* vg_lite_test_context_alloc(struct gpu_test_context_s* gpu_ctx)
+{
+    struct vg_lite_test_context_s* ctx = malloc(sizeof(struct vg_lite_test_context_s));
+    GPU_ASSERT_NULL(ctx);
+    memset(ctx, 0, sizeof(struct vg_lite_test_context_s));
+    ctx->gpu_ctx = gpu_ctx;
+    vg_lite_test_context_alloc_target(ctx);
+    return ctx;
+}
+
+static void vg_lite_test_context_alloc_target(struct vg_lite_test_context_s* ctx)
+{
+    struct gpu_test_context_s* gpu_ctx = ctx->gpu_ctx;
+    vg_lite_identity(&ctx->matrix);
+    vg_lite_scale(
+        gpu_ctx->param.target_width / (float)GPU_TEST_DESIGN_WIDTH,
+        gpu_ctx->param.target_height / (float)GPU_TEST_DESIGN_HEIGHT,
+        &ctx->matrix);
+
+    if (gpu_ctx->target_buffer.data) {
+        GPU_LOG_INFO("Using external target buffer");
+        vg_lite_test_gpu_buffer_to_vg_buffer(&ctx->target_buffer, &gpu_ctx->target_buffer);
+    } else {
+        ctx->target_gpu_buffer = vg_lite_test_buffer_alloc(
+            &ctx->target_buffer,
+            gpu_ctx->param.target_width,
+            gpu_ctx->param.target_height,
+            vg_lite_test_gpu_format_to_vg_format(gpu_ctx->param.target_format),
+            VG_LITE_TEST_STRIDE_AUTO);
+    }
+
+    ctx->target_format_default = ctx->target_buffer.format;
+}
+
 static void vg_lite_test_context_cleanup(struct vg_lite_test_context_s* ctx)
 {
     GPU_ASSERT_NULL(ctx);
@@ -332,9 +610,21 @@ static void vg_lite_test_context_cleanup(struct vg_lite_test_context_s* ctx)
 
     ctx->vg_error_remark_text[0] = '\0';
     ctx->screenshot_remark_text[0] = '\0';
+    ctx->ref_remark_text[0] = '\0';
+    ctx->fault_remark_text[0] = '\0';
+    ctx->budget_remark_text[0] = '\0';
     ctx->setup_tick = 0;
     ctx->draw_tick = 0;
     ctx->finish_tick = 0;
+    ctx->mem_peak = 0;
+    ctx->mem_leak = 0;
+    ctx->src_binding = "";
+    ctx->item = NULL;
+    ctx->error = VG_LITE_SUCCESS;
+    ctx->skipped = false;
+    memset(&ctx->busy_stats, 0, sizeof(ctx->busy_stats));
+    memset(&ctx->traffic_stats, 0, sizeof(ctx->traffic_stats));
+    memset(ctx->perf_values, 0, sizeof(ctx->perf_values));
     ctx->user_data = NULL;
 
     if (ctx->src_gpu_buffer) {
@@ -347,6 +637,206 @@ static void vg_lite_test_context_cleanup(struct vg_lite_test_context_s* ctx)
     }
 }
 
+static bool vg_lite_test_context_prepare_target(struct vg_lite_test_context_s* ctx, vg_lite_buffer_format_t format)
+{
+    if (ctx->target_buffer.format == format) {
+        return true;
+    }
+
+    /* The external framebuffer keeps its own format */
+    if (!ctx->target_gpu_buffer) {
+        return false;
+    }
+
+    /* Consecutive variants usually share the target format, the buffer is only replaced when it changes */
+    gpu_buffer_free(ctx->target_gpu_buffer);
+    ctx->target_gpu_buffer = vg_lite_test_buffer_alloc(
+        &ctx->target_buffer,
+        ctx->gpu_ctx->param.target_width,
+        ctx->gpu_ctx->param.target_height,
+        format,
+        VG_LITE_TEST_STRIDE_AUTO);
+    return true;
+}
+
+static void vg_lite_test_context_item_setup(struct vg_lite_test_context_s* ctx, const struct vg_lite_test_item_s* item, bool pipelined)
+{
+    vg_lite_buffer_format_t target_format = item->params ? item->params->target_format : ctx->target_format_default;
+    bool target_ready = vg_lite_test_context_prepare_target(ctx, target_format);
+
+    /* The target clear of the cleanup is part of the item cache cost */
+    gpu_cache_get_stats(&ctx->cache_base);
+    vg_lite_test_context_cleanup(ctx);
+    ctx->item = item;
+    ctx->pipelined = pipelined;
+
+    /* The negative features are not GPU features */
+    if (!target_ready) {
+        snprintf(ctx->vg_error_remark_text, sizeof(ctx->vg_error_remark_text),
+            "Target format %s not available", vg_lite_test_buffer_format_string(target_format));
+    } else if (item->feature == gcFEATURE_BIT_VG_ASSET_PACK && !ctx->asset) {
+        snprintf(ctx->vg_error_remark_text, sizeof(ctx->vg_error_remark_text), "No asset pack loaded, see --asset");
+    } else if (item->feature >= 0 && !vg_lite_query_feature(item->feature)) {
+        snprintf(ctx->vg_error_remark_text, sizeof(ctx->vg_error_remark_text), "Feature '%s' not supported", vg_lite_test_feature_string(item->feature));
+    }
+
+    if (ctx->vg_error_remark_text[0] != '\0') {
+        GPU_LOG_WARN("Skipping test case: %s %s", item->name, ctx->vg_error_remark_text);
+        ctx->skipped = true;
+        return;
+    }
+
+    GPU_LOG_INFO("Running test case: %s", item->name);
+    ctx->item_start_tick = gpu_tick_get();
+
+    /* The per item trace and latency sections can not overlap, the pipelined runner brackets the whole run */
+    if (!pipelined) {
+        vg_lite_test_trace_item_begin(item->name);
+        vg_lite_test_latency_item_begin();
+    }
+
+    if (ctx->ref) {
+        vg_lite_test_ref_item_begin(ctx->ref);
+    }
+
+    if (ctx->fault) {
+        vg_lite_test_fault_item_begin(ctx->fault);
+    }
+
+    ctx->mem_before_setup = vg_lite_test_context_get_mem_available();
+    ctx->mem_after_draw = ctx->mem_before_setup;
+
+    /* The counters are started outside of the ticks to keep their syscalls out of the times */
+    vg_lite_test_context_perf_start(ctx);
+    uint32_t start_tick = gpu_tick_get();
+    ctx->error = item->on_setup(ctx);
+    ctx->setup_tick = gpu_tick_elaps(start_tick);
+    vg_lite_test_context_perf_stop(ctx, VG_LITE_TEST_PHASE_SETUP);
+    gpu_timeline_span("item", "setup", item->name, start_tick);
+}
+
+static void vg_lite_test_context_item_draw(struct vg_lite_test_context_s* ctx)
+{
+    if (ctx->skipped || ctx->error != VG_LITE_SUCCESS) {
+        return;
+    }
+
+    /* Sample from the first submission to the end of the finish, the setup is CPU work */
+    if (ctx->busy) {
+        vg_lite_test_busy_item_begin(ctx->busy);
+        ctx->busy_sampling = true;
+    }
+
+    vg_lite_test_traffic_begin(ctx->traffic);
+    vg_lite_test_context_perf_start(ctx);
+    uint32_t start_tick = gpu_tick_get();
+    ctx->error = ctx->item->on_draw(ctx);
+
+    /* Submit without waiting, the next item is set up while the GPU renders this one */
+    if (ctx->pipelined && ctx->error == VG_LITE_SUCCESS) {
+        ctx->error = vg_lite_flush();
+    }
+
+    ctx->draw_tick = gpu_tick_elaps(start_tick);
+    vg_lite_test_context_perf_stop(ctx, VG_LITE_TEST_PHASE_DRAW);
+    vg_lite_test_traffic_end(ctx->traffic, &ctx->traffic_stats);
+    gpu_timeline_span("item", "draw", ctx->item->name, start_tick);
+    ctx->mem_after_draw = vg_lite_test_context_get_mem_available();
+}
+
+static bool vg_lite_test_context_item_complete(struct vg_lite_test_context_s* ctx)
+{
+    const struct vg_lite_test_item_s* item = ctx->item;
+
+    if (ctx->skipped) {
+        vg_lite_test_context_record(ctx, item, VG_LITE_NOT_SUPPORT, "SKIP");
+        return true;
+    }
+
+    vg_lite_error_t error = ctx->error;
+
+    if (error == VG_LITE_SUCCESS) {
+        vg_lite_test_context_perf_start(ctx);
+        uint32_t start_tick = gpu_tick_get();
+        error = vg_lite_finish();
+        ctx->finish_tick = gpu_tick_elaps(start_tick);
+        vg_lite_test_context_perf_stop(ctx, VG_LITE_TEST_PHASE_FINISH);
+        gpu_timeline_span("item", "finish", item->name, start_tick);
+    }
+
+    if (ctx->busy_sampling) {
+        vg_lite_test_busy_item_end(ctx->busy, &ctx->busy_stats);
+        ctx->busy_sampling = false;
+        GPU_LOG_INFO("Test case '%s' GPU busy: %0.1f%% (%" PRIu32 " samples), %" PRIu32 " idle gaps, max %0.3f ms",
+            item->name,
+            vg_lite_test_busy_percent(&ctx->busy_stats),
+            ctx->busy_stats.samples,
+            ctx->busy_stats.gap_count,
+            ctx->busy_stats.gap_max_us / 1000.0f);
+    }
+
+    if (item->on_teardown) {
+        uint32_t start_tick = gpu_tick_get();
+        item->on_teardown(ctx);
+        gpu_timeline_span("item", "teardown", item->name, start_tick);
+    }
+
+    uint32_t mem_after_teardown = vg_lite_test_context_get_mem_available();
+
+    if (!ctx->pipelined) {
+        vg_lite_test_trace_item_end();
+        vg_lite_test_latency_item_end(item->name);
+    }
+
+    if (ctx->ref) {
+        vg_lite_test_ref_item_end(ctx->ref);
+    }
+
+    if (error == VG_LITE_SUCCESS) {
+        GPU_LOG_INFO("Test case '%s' render success", item->name);
+    } else {
+        GPU_LOG_ERROR("Test case '%s' render failed: %d (%s)", item->name, error, vg_lite_test_error_string(error));
+        gpu_timeline_instant("error", vg_lite_test_error_string(error), item->name);
+        vg_lite_test_context_error_to_remark(ctx, error);
+    }
+
+    bool screenshot_cmp_pass = vg_lite_test_context_check_screenshot(ctx, item->name);
+
+    bool ref_cmp_pass = vg_lite_test_context_check_reference(ctx);
+
+    /* The setup of the next item overlaps a pipelined item, its memory can not be told apart */
+    bool mem_check_pass = ctx->pipelined
+        || vg_lite_test_context_check_memory(ctx, item, ctx->mem_before_setup, ctx->mem_after_draw, mem_after_teardown);
+
+    bool passed = (error == VG_LITE_SUCCESS && screenshot_cmp_pass && ref_cmp_pass && mem_check_pass);
+
+    if (ctx->fault
+        && !vg_lite_test_fault_item_end(ctx->fault, passed, &ctx->target_buffer,
+            ctx->fault_remark_text, sizeof(ctx->fault_remark_text))) {
+        passed = false;
+    }
+
+    /* A slow item is only told apart from a broken one if it rendered correctly */
+    const char* result_str = passed ? "PASS" : "FAIL";
+    if (passed && ctx->budget
+        && !vg_lite_test_budget_check(ctx->budget, item->name, &ctx->target_buffer,
+            ctx->setup_tick, ctx->draw_tick, ctx->finish_tick,
+            ctx->budget_remark_text, sizeof(ctx->budget_remark_text))) {
+        GPU_LOG_ERROR("Test case '%s' over budget: %s", item->name, ctx->budget_remark_text);
+        result_str = "SLOW";
+        passed = false;
+    }
+
+    if (!passed) {
+        gpu_timeline_instant("error", result_str, item->name);
+    }
+
+    vg_lite_test_context_record(ctx, item, error, result_str);
+    gpu_timeline_span("item", item->name, result_str, ctx->item_start_tick);
+
+    return passed;
+}
+
 static void vg_lite_test_context_record(
     struct vg_lite_test_context_s* ctx,
     const struct vg_lite_test_item_s* item,
@@ -356,26 +846,60 @@ static void vg_lite_test_context_record(
     GPU_ASSERT_NULL(ctx);
     GPU_ASSERT_NULL(item);
 
+    /* Only the cache work since the item started, a pipelined item also counts the setup of the next one */
+    struct gpu_cache_stats_s cache_stats;
+    gpu_cache_get_stats(&cache_stats);
+    for (int op = 0; op < _GPU_CACHE_OP_LAST; op++) {
+        cache_stats.requests[op] -= ctx->cache_base.requests[op];
+        cache_stats.ops[op] -= ctx->cache_base.ops[op];
+        cache_stats.bytes[op] -= ctx->cache_base.bytes[op];
+        cache_stats.time_us[op] -= ctx->cache_base.time_us[op];
+    }
+
+    vg_lite_test_context_log_cache(item, &cache_stats);
+
     if (!ctx->gpu_ctx->recorder) {
         return;
     }
 
+    uint32_t cache_ops = 0;
+    uint64_t cache_bytes = 0;
+    uint32_t cache_time_us = 0;
+    for (int op = 0; op < _GPU_CACHE_OP_LAST; op++) {
+        cache_ops += cache_stats.ops[op];
+        cache_bytes += cache_stats.bytes[op];
+        cache_time_us += cache_stats.time_us[op];
+    }
+
+    /* The GPU work of an item spans its submission and the wait for it */
+    uint32_t gpu_time_us = ctx->draw_tick + ctx->finish_tick;
+
+    struct gpu_recorder_s* recorder = ctx->gpu_ctx->recorder;
+
+    /* Written in pieces, a long field or an optional column must not truncate the row and drop its newline */
+    gpu_recorder_write_string(recorder, item->name); /* Testcase */
+    gpu_recorder_write_string(recorder, ",");
+    gpu_recorder_write_string(recorder, item->instructions); /* Instructions */
+
     char result[512];
     snprintf(result, sizeof(result),
-        "%s," /* Testcase */
-        "%s," /* Instructions */
-        "%s,%s," /* Target Format, Source Format */
-        "%p,%p," /* Target Address, Source Address */
-        "%dx%d,%dx%d," /* Target Area, Source Area */
-        "%0.3f," /* Setup Time(ms) */
-        "%0.3f," /* Draw Time(ms) */
-        "%0.3f," /* Finish Time(ms) */
-        "%s," /* VG-Lite Result */
-        "%s," /* VG-Lite Remark */
-        "%s," /* Screenshot Result */
-        "%s\n", /* Result */
-        item->name,
-        item->instructions,
+        ",%s,%s" /* Target Format, Source Format */
+        ",%p,%p" /* Target Address, Source Address */
+        ",%dx%d,%dx%d" /* Target Area, Source Area */
+        ",%s" /* Source Binding */
+        ",%0.3f" /* Setup Time(ms) */
+        ",%0.3f" /* Draw Time(ms) */
+        ",%0.3f" /* Finish Time(ms) */
+        ",%" PRIu64 /* Pixels Touched */
+        ",%0.3f" /* Pixel Rate(MPix/s) */
+        ",%" PRIu64 /* Bytes Moved */
+        ",%0.3f" /* Throughput(GB/s) */
+        ",%" PRIu32 /* Memory Peak(bytes) */
+        ",%" PRId32 /* Memory Leak(bytes) */
+        ",%" PRIu32 /* Cache Ops */
+        ",%" PRIu64 /* Cache Bytes */
+        ",%0.3f" /* Cache Time(ms) */
+        ",%s", /* VG-Lite Result */
         vg_lite_test_buffer_format_string(ctx->target_buffer.format),
         vg_lite_test_buffer_format_string(ctx->src_buffer.format),
         ctx->target_buffer.memory,
@@ -384,15 +908,55 @@ static void vg_lite_test_context_record(
         (int)ctx->target_buffer.height,
         (int)ctx->src_buffer.width,
         (int)ctx->src_buffer.height,
+        ctx->src_binding,
         ctx->setup_tick / 1000.0f,
         ctx->draw_tick / 1000.0f,
         ctx->finish_tick / 1000.0f,
-        vg_lite_test_error_string(error),
-        ctx->vg_error_remark_text,
-        ctx->screenshot_remark_text,
-        result_str);
+        ctx->traffic_stats.pixels,
+        vg_lite_test_context_rate(ctx->traffic_stats.pixels, gpu_time_us),
+        ctx->traffic_stats.bytes,
+        vg_lite_test_context_rate(ctx->traffic_stats.bytes, gpu_time_us) / 1000.0f,
+        ctx->mem_peak,
+        ctx->mem_leak,
+        cache_ops,
+        cache_bytes,
+        cache_time_us / 1000.0f,
+        vg_lite_test_error_string(error));
+    gpu_recorder_write_string(recorder, result);
+
+    const char* remarks[] = {
+        ctx->vg_error_remark_text, /* VG-Lite Remark */
+        ctx->screenshot_remark_text, /* Screenshot Result */
+        ctx->ref_remark_text, /* Reference Result */
+        ctx->fault_remark_text, /* Fault Remark */
+        result_str, /* Result */
+    };
+
+    for (size_t i = 0; i < sizeof(remarks) / sizeof(remarks[0]); i++) {
+        gpu_recorder_write_string(recorder, ",");
+        gpu_recorder_write_string(recorder, remarks[i]);
+    }
+
+    /* Every counter of every phase fits, a uint64 is at most 20 digits */
+    char perf_str[_VG_LITE_TEST_PHASE_LAST * _GPU_PERF_EVENT_LAST * 24 + 1];
+    if (vg_lite_test_context_perf_to_string(ctx, perf_str, sizeof(perf_str)) > 0) {
+        gpu_recorder_write_string(recorder, perf_str);
+    }
 
-    gpu_recorder_write_string(ctx->gpu_ctx->recorder, result);
+    if (vg_lite_test_context_busy_to_string(ctx, result, sizeof(result)) > 0) {
+        gpu_recorder_write_string(recorder, result);
+    }
+
+    if (vg_lite_test_context_roofline_to_string(ctx, result, sizeof(result)) > 0) {
+        gpu_recorder_write_string(recorder, result);
+    }
+
+    if (ctx->budget) {
+        gpu_recorder_write_string(recorder, ",");
+        gpu_recorder_write_string(recorder, ctx->budget_remark_text); /* Budget Remark */
+    }
+
+    gpu_recorder_write_string(recorder, "\n");
 }
 
 static void vg_lite_test_context_error_to_remark(struct vg_lite_test_context_s* ctx, vg_lite_error_t error)
@@ -423,66 +987,276 @@ static bool vg_lite_test_context_check_screenshot(struct vg_lite_test_context_s*
         return true;
     }
 
-    bool retval = false;
-    char path[128];
-    snprintf(path, sizeof(path), "%s" REF_IMAGES_DIR "/%s.png", ctx->gpu_ctx->param.output_dir, name);
+    char path[PATH_MAX];
+    int len = snprintf(path, sizeof(path), "%s" REF_IMAGES_DIR "/%s%s.png", ctx->gpu_ctx->param.output_dir, name, ctx->target_tag);
+
+    /* A truncated path may alias the golden image of another variant */
+    if (len < 0 || (size_t)len >= sizeof(path)) {
+        snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text), "Path too long: %s%s", name, ctx->target_tag);
+        GPU_LOG_ERROR("%s", ctx->screenshot_remark_text);
+        return false;
+    }
+
+    /* The remarks name the image relative to the output directory, the log keeps the full path */
+    const char* file = path + strlen(ctx->gpu_ctx->param.output_dir);
 
     struct gpu_buffer_s target_buffer;
     vg_lite_test_vg_buffer_to_gpu_buffer(&target_buffer, &ctx->target_buffer);
 
-    struct gpu_buffer_s* loaded_buffer = gpu_screenshot_load(path);
-    if (!loaded_buffer) {
-        int ret = gpu_screenshot_save(path, &target_buffer);
+    struct gpu_screenshot_cmp_s cmp;
+    memset(&cmp, 0, sizeof(cmp));
+    cmp.full_metrics = ctx->gpu_ctx->param.full_metrics_en;
+
+    if (ctx->ref) {
+        /* The golden image may come from the reference renderer, allow the rasterization differences */
+        cmp.tolerance = REF_RENDER_TOLERANCE;
+        cmp.max_mismatch = (uint64_t)target_buffer.width * target_buffer.height * REF_RENDER_MISMATCH_PERMILLE / 1000;
+    }
+
+    enum gpu_screenshot_cmp_result_e result = gpu_screenshot_compare(path, &target_buffer, &cmp);
+
+    switch (result) {
+    case GPU_SCREENSHOT_CMP_MATCH:
+        GPU_LOG_INFO("Screenshot check PASS: %s", path);
+        snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text), "SUCCESS");
+        return true;
+
+    case GPU_SCREENSHOT_CMP_NOT_FOUND: {
+        /* Prefer the reference rendering, a faulty GPU must not create the golden image */
+        struct gpu_buffer_s* ref_image = vg_lite_test_context_get_ref_image(ctx);
+        int ret = gpu_screenshot_save(path, ref_image ? ref_image : &target_buffer);
+        GPU_LOG_INFO("Screenshot create: %s", path);
         snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text),
-            "Create: %s - %s", path, ret == 0 ? "SUCCESS" : "FAILED");
+            "Create%s: %s - %s", ref_image ? " from reference" : "", file, ret == 0 ? "SUCCESS" : "FAILED");
         return true;
     }
 
-    if (target_buffer.width != loaded_buffer->width || target_buffer.height != loaded_buffer->height) {
+    case GPU_SCREENSHOT_CMP_SIZE_MISMATCH:
         snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text),
             "Size not matched: %s target: W%dxH%d vs loaded: W%dxH%d",
-            path,
+            file,
             (int)target_buffer.width, (int)target_buffer.height,
-            (int)loaded_buffer->width, (int)loaded_buffer->height);
+            (int)cmp.golden_width, (int)cmp.golden_height);
+        GPU_LOG_ERROR("%s: %s", path, ctx->screenshot_remark_text);
+        return false;
 
-        GPU_LOG_ERROR("%s", ctx->screenshot_remark_text);
-        goto failed;
+    case GPU_SCREENSHOT_CMP_MISMATCH:
+        snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text),
+            "Pixel not match: %" PRIu32 " pixels over tolerance %" PRIu32 " in %" PRIu32 "/%d rows (max diff %" PRIu32 ") "
+            "first in (X%" PRId32 " Y%" PRId32 ") target: 0x%08" PRIX32 " vs loaded: 0x%08" PRIX32,
+            cmp.mismatch_count, cmp.tolerance, cmp.compared_rows, (int)target_buffer.height, cmp.max_diff,
+            cmp.first_x, cmp.first_y, cmp.first_pixel, cmp.first_golden_pixel);
+        GPU_LOG_ERROR("%s: %s", path, ctx->screenshot_remark_text);
+
+        len = snprintf(path, sizeof(path), "%s" REF_IMAGES_DIR "/%s%s_err.png", ctx->gpu_ctx->param.output_dir, name, ctx->target_tag);
+        if (len >= 0 && (size_t)len < sizeof(path)) {
+            gpu_screenshot_save(path, &target_buffer);
+        }
+        return false;
+
+    default:
+        snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text), "Read failed: %s", file);
+        GPU_LOG_ERROR("%s: %s", path, ctx->screenshot_remark_text);
+        return false;
     }
+}
+
+static struct gpu_buffer_s* vg_lite_test_context_get_ref_image(struct vg_lite_test_context_s* ctx)
+{
+    if (!ctx->ref || vg_lite_test_ref_get_unsupported(ctx->ref)) {
+        return NULL;
+    }
+
+    return vg_lite_test_ref_get_image(ctx->ref, &ctx->target_buffer);
+}
+
+static bool vg_lite_test_context_check_reference(struct vg_lite_test_context_s* ctx)
+{
+    if (!ctx->ref) {
+        return true;
+    }
+
+    struct gpu_buffer_s* ref_image = vg_lite_test_context_get_ref_image(ctx);
+    if (!ref_image) {
+        const char* reason = vg_lite_test_ref_get_unsupported(ctx->ref);
+        snprintf(ctx->ref_remark_text, sizeof(ctx->ref_remark_text),
+            "SKIP: %s", reason ? reason : "Target not drawn");
+        return true;
+    }
+
+    struct gpu_buffer_s target_buffer;
+    vg_lite_test_vg_buffer_to_gpu_buffer(&target_buffer, &ctx->target_buffer);
 
     /* Make sure the buffer fully loaded to memory */
     gpu_cache_invalidate(target_buffer.data, target_buffer.stride * target_buffer.height);
 
-    for (int y = 0; y < target_buffer.height; y++) {
-        for (int x = 0; x < target_buffer.width; x++) {
-            gpu_color_bgra8888_t target_pixel;
-            target_pixel.full = gpu_buffer_get_pixel(&target_buffer, x, y);
-
-            gpu_color_bgra8888_t loaded_pixel;
-            loaded_pixel.full = gpu_buffer_get_pixel(loaded_buffer, x, y);
-
-            /* Skip checking alpha channel */
-            if (target_pixel.ch.red != loaded_pixel.ch.red || target_pixel.ch.green != loaded_pixel.ch.green || target_pixel.ch.blue != loaded_pixel.ch.blue) {
-                snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text),
-                    "Pixel not match in (X%d Y%d) "
-                    "target: 0x%08" PRIX32 "(A%d R%d G%d B%d) vs "
-                    "loaded: 0x%08" PRIX32 "(A%d R%d G%d B%d)",
-                    x, y,
-                    target_pixel.full, target_pixel.ch.alpha, target_pixel.ch.red, target_pixel.ch.green, target_pixel.ch.blue,
-                    loaded_pixel.full, loaded_pixel.ch.alpha, loaded_pixel.ch.red, loaded_pixel.ch.green, loaded_pixel.ch.blue);
-                GPU_LOG_ERROR("%s", ctx->screenshot_remark_text);
-
-                snprintf(path, sizeof(path), "%s" REF_IMAGES_DIR "/%s_err.png", ctx->gpu_ctx->param.output_dir, name);
-                gpu_screenshot_save(path, &target_buffer);
-                goto failed;
+    bool retval = vg_lite_test_ref_compare(
+        &target_buffer, ref_image,
+        REF_RENDER_TOLERANCE, REF_RENDER_MISMATCH_PERMILLE,
+        ctx->ref_remark_text, sizeof(ctx->ref_remark_text));
+
+    if (retval) {
+        GPU_LOG_INFO("Reference check PASS: %s", ctx->ref_remark_text);
+    } else {
+        GPU_LOG_ERROR("Reference check FAIL: %s", ctx->ref_remark_text);
+    }
+
+    return retval;
+}
+
+static void vg_lite_test_context_log_cache(const struct vg_lite_test_item_s* item, const struct gpu_cache_stats_s* stats)
+{
+    for (int op = 0; op < _GPU_CACHE_OP_LAST; op++) {
+        if (stats->requests[op] == 0) {
+            continue;
+        }
+
+        GPU_LOG_INFO("Test case '%s' cache %s: %" PRIu32 " calls issued as %" PRIu32 " ops, %" PRIu64 " bytes, %" PRIu32 " us",
+            item->name, gpu_cache_op_string(op), stats->requests[op], stats->ops[op], stats->bytes[op], stats->time_us[op]);
+    }
+}
+
+static void vg_lite_test_context_perf_start(struct vg_lite_test_context_s* ctx)
+{
+    if (ctx->perf) {
+        gpu_perf_start(ctx->perf);
+    }
+}
+
+static void vg_lite_test_context_perf_stop(struct vg_lite_test_context_s* ctx, enum vg_lite_test_phase_e phase)
+{
+    if (ctx->perf) {
+        gpu_perf_stop(ctx->perf, ctx->perf_values[phase]);
+    }
+}
+
+static int vg_lite_test_context_perf_to_string(struct vg_lite_test_context_s* ctx, char* buf, size_t size)
+{
+    if (!ctx->perf) {
+        return 0;
+    }
+
+    size_t len = 0;
+    for (int phase = 0; phase < _VG_LITE_TEST_PHASE_LAST; phase++) {
+        for (int event = 0; event < _GPU_PERF_EVENT_LAST; event++) {
+            int ret;
+            if (gpu_perf_is_supported(ctx->perf, event)) {
+                ret = snprintf(buf + len, size - len, ",%" PRIu64, ctx->perf_values[phase][event]);
+            } else {
+                ret = snprintf(buf + len, size - len, ",N/A");
             }
+
+            if (ret < 0 || (size_t)ret >= size - len) {
+                return len;
+            }
+
+            len += ret;
         }
     }
 
-    retval = true;
-    GPU_LOG_INFO("Screenshot check PASS: %s", path);
-    snprintf(ctx->screenshot_remark_text, sizeof(ctx->screenshot_remark_text), "SUCCESS");
+    return len;
+}
 
-failed:
-    gpu_buffer_free(loaded_buffer);
-    return retval;
+static int vg_lite_test_context_busy_to_string(struct vg_lite_test_context_s* ctx, char* buf, size_t size)
+{
+    if (!ctx->busy) {
+        return 0;
+    }
+
+    const struct vg_lite_test_busy_stats_s* stats = &ctx->busy_stats;
+    int ret = snprintf(buf, size,
+        ",%0.1f" /* GPU Busy(%) */
+        ",%" PRIu32 /* GPU Busy Samples */
+        ",%" PRIu32 /* GPU Idle Gaps */
+        ",%0.3f" /* GPU Idle Gap Total(ms) */
+        ",%0.3f", /* GPU Idle Gap Max(ms) */
+        vg_lite_test_busy_percent(stats),
+        stats->samples,
+        stats->gap_count,
+        stats->gap_total_us / 1000.0f,
+        stats->gap_max_us / 1000.0f);
+
+    if (ret < 0 || (size_t)ret >= size) {
+        return 0;
+    }
+
+    return ret;
+}
+
+static float vg_lite_test_context_rate(uint64_t count, uint32_t time_us)
+{
+    /* Per microsecond is millions per second */
+    return time_us ? (float)count / time_us : 0.0f;
+}
+
+static int vg_lite_test_context_roofline_to_string(struct vg_lite_test_context_s* ctx, char* buf, size_t size)
+{
+    if (!ctx->roofline) {
+        return 0;
+    }
+
+    int ret = snprintf(buf, size, ",%0.1f", /* Roofline(%) */
+        vg_lite_test_roofline_percent(ctx->roofline, ctx->traffic_stats.bytes, ctx->draw_tick + ctx->finish_tick));
+
+    if (ret < 0 || (size_t)ret >= size) {
+        return 0;
+    }
+
+    return ret;
+}
+
+static uint32_t vg_lite_test_context_get_mem_available(void)
+{
+    vg_lite_uint32_t mem_size = 0;
+    VG_LITE_TEST_CHECK_ERROR(vg_lite_get_mem_size(&mem_size));
+    return (uint32_t)mem_size;
+}
+
+static bool vg_lite_test_context_check_memory(
+    struct vg_lite_test_context_s* ctx,
+    const struct vg_lite_test_item_s* item,
+    uint32_t before_setup,
+    uint32_t after_draw,
+    uint32_t after_teardown)
+{
+    /* Only the available size is known, the peak is the lowest sample */
+    uint32_t lowest = MATH_MIN(after_draw, after_teardown);
+    ctx->mem_peak = before_setup > lowest ? before_setup - lowest : 0;
+    ctx->mem_leak = (int32_t)(before_setup - after_teardown);
+
+    if (ctx->mem_leak != 0) {
+        GPU_LOG_WARN("Test case '%s' memory changed: %" PRId32 " bytes not released (peak %" PRIu32 " bytes)",
+            item->name, ctx->mem_leak, ctx->mem_peak);
+    }
+
+    if (!ctx->gpu_ctx->param.leak_check_en) {
+        return true;
+    }
+
+    struct vg_lite_test_leak_s* leak = NULL;
+    for (int i = 0; i < ctx->leak_count; i++) {
+        if (ctx->leaks[i].item == item) {
+            leak = &ctx->leaks[i];
+            break;
+        }
+    }
+
+    if (!leak) {
+        ctx->leaks = realloc(ctx->leaks, (ctx->leak_count + 1) * sizeof(struct vg_lite_test_leak_s));
+        GPU_ASSERT_NULL(ctx->leaks);
+        leak = &ctx->leaks[ctx->leak_count++];
+        leak->item = item;
+        leak->streak = 0;
+    }
+
+    leak->streak = ctx->mem_leak > 0 ? leak->streak + 1 : 0;
+
+    if (leak->streak >= LEAK_CHECK_STREAK) {
+        snprintf(ctx->vg_error_remark_text, sizeof(ctx->vg_error_remark_text),
+            "Memory grows for %d runs: %" PRId32 " bytes", leak->streak, ctx->mem_leak);
+        GPU_LOG_ERROR("Test case '%s' leak check FAIL: %s", item->name, ctx->vg_error_remark_text);
+        return false;
+    }
+
+    return true;
 }
@@ -33,6 +33,7 @@ extern "C" {
  *********************/
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <vg_lite.h>
 
 /*********************
@@ -41,6 +42,9 @@ extern "C" {
 
 #define gcFEATURE_BIT_VG_NONE -1
 
+/* Not a GPU feature, the item needs the asset pack given by --asset */
+#define gcFEATURE_BIT_VG_ASSET_PACK -2
+
 #define VG_LITE_TEST_CASE_ITEM_DEF(NAME, FEATURE, INSTRUCTIONS)  \
     struct vg_lite_test_item_s vg_lite_test_case_item_##NAME = { \
         .name = #NAME,                                           \
@@ -51,16 +55,41 @@ extern "C" {
         .on_teardown = on_teardown,                              \
     }
 
+/* The runner expands the item into one variant per entry of the parameter table */
+#define VG_LITE_TEST_CASE_ITEM_PARAM_DEF(NAME, FEATURE, INSTRUCTIONS, PARAMS) \
+    struct vg_lite_test_item_s vg_lite_test_case_item_##NAME = {             \
+        .name = #NAME,                                                       \
+        .instructions = INSTRUCTIONS,                                        \
+        .feature = gcFEATURE_BIT_VG_##FEATURE,                               \
+        .on_setup = on_setup,                                                \
+        .on_draw = on_draw,                                                  \
+        .on_teardown = on_teardown,                                          \
+        .params = PARAMS,                                                    \
+        .param_count = sizeof(PARAMS) / sizeof((PARAMS)[0]),                 \
+    }
+
 /**********************
  *      TYPEDEFS
  **********************/
 
 struct gpu_test_context_s;
 struct vg_lite_test_path_s;
+struct vg_lite_test_asset_s;
 struct vg_lite_test_context_s;
 
 typedef vg_lite_error_t (*vg_lite_test_func_t)(struct vg_lite_test_context_s* ctx);
 
+/* One variant of a parameterized item, every field must be set */
+struct vg_lite_test_param_s {
+    vg_lite_buffer_format_t target_format;
+    vg_lite_buffer_format_t src_format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t count;
+    vg_lite_blend_t blend;
+    vg_lite_filter_t filter;
+};
+
 struct vg_lite_test_item_s {
     const char* name;
     const char* instructions;
@@ -68,6 +97,8 @@ struct vg_lite_test_item_s {
     vg_lite_test_func_t on_setup;
     vg_lite_test_func_t on_draw;
     vg_lite_test_func_t on_teardown;
+    const struct vg_lite_test_param_s* params;
+    int param_count;
 };
 
 /**********************
@@ -87,6 +118,14 @@ struct vg_lite_test_context_s* vg_lite_test_context_create(struct gpu_test_conte
  */
 void vg_lite_test_context_destroy(struct vg_lite_test_context_s* ctx);
 
+/**
+ * @brief Reallocate the target buffer with the current target size and format of the parameters
+ * @param ctx The test context
+ * @param tag The suffix of the screenshot file names, NULL for none
+ * @note The external framebuffer is kept as is
+ */
+void vg_lite_test_context_set_target(struct vg_lite_test_context_s* ctx, const char* tag);
+
 /**
  * @brief Run a test case item
  * @param ctx The test context to use
@@ -95,6 +134,34 @@ void vg_lite_test_context_destroy(struct vg_lite_test_context_s* ctx);
  */
 bool vg_lite_test_context_run_item(struct vg_lite_test_context_s* ctx, const struct vg_lite_test_item_s* item);
 
+/**
+ * @brief Create another test context sharing the asset pack and the output of the given one, for pipelined runs
+ * @param ctx The test context to share from
+ * @return The new test context with its own target buffer, destroy it before the shared one
+ */
+struct vg_lite_test_context_s* vg_lite_test_context_create_slot(struct vg_lite_test_context_s* ctx);
+
+/**
+ * @brief Pipelined run, step 1: clean up the context and run the setup of a test case item
+ * @param ctx The test context to use, without reference renderer and fault injector
+ * @param item The test case item to run
+ */
+void vg_lite_test_context_begin_item(struct vg_lite_test_context_s* ctx, const struct vg_lite_test_item_s* item);
+
+/**
+ * @brief Pipelined run, step 2: draw the item and submit it to the GPU without waiting
+ * @param ctx The test context to use
+ */
+void vg_lite_test_context_submit_item(struct vg_lite_test_context_s* ctx);
+
+/**
+ * @brief Pipelined run, step 3: wait for the GPU, run the teardown, check and record the item
+ * @param ctx The test context to use
+ * @return True if the test case passed, false if it failed
+ * @note The items must be ended in the order they were begun
+ */
+bool vg_lite_test_context_end_item(struct vg_lite_test_context_s* ctx);
+
 /**
  * @brief Get the target buffer for the test case
  * @param ctx The test context to use
@@ -142,6 +209,24 @@ void vg_lite_test_context_load_src_image(
     vg_lite_buffer_format_t format,
     uint32_t image_stride);
 
+/**
+ * @brief Use constant image data as the source image of the test case without copying it
+ * @param ctx The test context to use
+ * @param image_data The image data, it must stay valid until the test case ends
+ * @param width The width of the image
+ * @param height The height of the image
+ * @param format The format of the image
+ * @param image_stride The stride of the image
+ * @return True if the data is used in place, false if it did not meet the buffer alignment and was copied
+ */
+bool vg_lite_test_context_bind_src_image(
+    struct vg_lite_test_context_s* ctx,
+    const void* image_data,
+    uint32_t width,
+    uint32_t height,
+    vg_lite_buffer_format_t format,
+    uint32_t image_stride);
+
 /**
  * @brief Set the transform for the test case
  * @param ctx The test context to use
@@ -170,6 +255,20 @@ struct vg_lite_test_path_s* vg_lite_test_context_init_path(struct vg_lite_test_c
  */
 struct vg_lite_test_path_s* vg_lite_test_context_get_path(struct vg_lite_test_context_s* ctx);
 
+/**
+ * @brief Get the asset pack given by --asset
+ * @param ctx The test context to use
+ * @return The asset pack, NULL if none is loaded
+ */
+struct vg_lite_test_asset_s* vg_lite_test_context_get_asset(struct vg_lite_test_context_s* ctx);
+
+/**
+ * @brief Get the parameters of the running variant of a parameterized item
+ * @param ctx The test context to use
+ * @return The parameters, the item must be defined with VG_LITE_TEST_CASE_ITEM_PARAM_DEF
+ */
+const struct vg_lite_test_param_s* vg_lite_test_context_get_param(struct vg_lite_test_context_s* ctx);
+
 /**
  * @brief Set the user data for the test context
  * @param ctx The test context to use
@@ -0,0 +1,482 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_crossover.h"
+#include "../gpu_assert.h"
+#include "../gpu_cache.h"
+#include "../gpu_context.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_recorder.h"
+#include "../gpu_tick.h"
+#include "vg_lite_test_path.h"
+#include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Minimum measuring time of each operation, size and path */
+#define CROSSOVER_BENCHMARK_TIME_MS 20
+
+/* The side of the measured squares grows by about sqrt(2), the area doubles */
+#define CROSSOVER_SIDE_MIN 1
+#define CROSSOVER_SIDE_STEP 1.4142f
+
+#define CROSSOVER_CLEAR_COLOR 0xFF336699
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum crossover_op_e {
+    CROSSOVER_OP_CLEAR,
+    CROSSOVER_OP_COPY,
+    CROSSOVER_OP_BLEND,
+    CROSSOVER_OP_FILL,
+    _CROSSOVER_OP_LAST
+};
+
+struct crossover_bench_s {
+    struct gpu_buffer_s* target_gpu_buffer;
+    struct gpu_buffer_s* src_gpu_buffer;
+    struct gpu_buffer_s* blend_src_gpu_buffer;
+    vg_lite_buffer_t target;
+    vg_lite_buffer_t src;
+
+    /* Premultiplied BGRA8888, the source of the blend */
+    vg_lite_buffer_t blend_src;
+
+    vg_lite_test_path_t* path;
+    vg_lite_matrix_t matrix;
+    vg_lite_rectangle_t rect;
+    uint32_t pixel_size;
+    uint8_t pixel[4];
+};
+
+typedef void (*crossover_cpu_cb_t)(struct crossover_bench_s* bench);
+typedef vg_lite_error_t (*crossover_gpu_cb_t)(struct crossover_bench_s* bench);
+
+struct crossover_op_s {
+    const char* name;
+
+    /* Upper case name of the generated threshold macros */
+    const char* macro_name;
+
+    crossover_cpu_cb_t cpu;
+    crossover_gpu_cb_t gpu;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static int32_t crossover_run_op(struct gpu_test_context_s* ctx, struct crossover_bench_s* bench,
+    const struct crossover_op_s* op, gpu_color_format_t format);
+static bool crossover_bench_init(struct crossover_bench_s* bench, gpu_color_format_t format, uint32_t width, uint32_t height);
+static void crossover_bench_deinit(struct crossover_bench_s* bench);
+static void crossover_set_rect(struct crossover_bench_s* bench, uint32_t side);
+static float crossover_measure(struct crossover_bench_s* bench, const struct crossover_op_s* op, bool gpu);
+static void crossover_cpu_fill(struct crossover_bench_s* bench);
+static void crossover_cpu_copy(struct crossover_bench_s* bench);
+static void crossover_cpu_blend(struct crossover_bench_s* bench);
+static vg_lite_error_t crossover_gpu_clear(struct crossover_bench_s* bench);
+static vg_lite_error_t crossover_gpu_copy(struct crossover_bench_s* bench);
+static vg_lite_error_t crossover_gpu_blend(struct crossover_bench_s* bench);
+static vg_lite_error_t crossover_gpu_fill(struct crossover_bench_s* bench);
+static int crossover_write_header(const char* path, const int32_t (*thresholds)[_CROSSOVER_OP_LAST],
+    const gpu_color_format_t* formats, int format_count);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const struct crossover_op_s crossover_ops[_CROSSOVER_OP_LAST] = {
+    [CROSSOVER_OP_CLEAR] = { "clear", "CLEAR", crossover_cpu_fill, crossover_gpu_clear },
+    [CROSSOVER_OP_COPY] = { "copy", "COPY", crossover_cpu_copy, crossover_gpu_copy },
+    [CROSSOVER_OP_BLEND] = { "blend", "BLEND", crossover_cpu_blend, crossover_gpu_blend },
+    [CROSSOVER_OP_FILL] = { "fill", "FILL", crossover_cpu_fill, crossover_gpu_fill },
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int vg_lite_test_crossover_run(struct gpu_test_context_s* ctx)
+{
+    GPU_ASSERT_NULL(ctx);
+
+    const int format_count = ctx->param.target_format_count;
+    int32_t thresholds[GPU_TEST_TARGET_SWEEP_MAX][_CROSSOVER_OP_LAST];
+
+    if (ctx->recorder) {
+        gpu_recorder_write_string(ctx->recorder,
+            "Operation,Format,Area,Pixels,CPU Time(us),GPU Time(us),Faster\n");
+    }
+
+    for (int i = 0; i < format_count; i++) {
+        const gpu_color_format_t format = ctx->param.target_formats[i];
+
+        struct crossover_bench_s bench;
+        if (!crossover_bench_init(&bench, format, ctx->param.target_width, ctx->param.target_height)) {
+            GPU_LOG_WARN("Crossover %s: format not supported", gpu_color_format_string(format));
+            for (int op = 0; op < _CROSSOVER_OP_LAST; op++) {
+                thresholds[i][op] = -1;
+            }
+            continue;
+        }
+
+        for (int op = 0; op < _CROSSOVER_OP_LAST; op++) {
+            thresholds[i][op] = crossover_run_op(ctx, &bench, &crossover_ops[op], format);
+        }
+
+        crossover_bench_deinit(&bench);
+    }
+
+    if (ctx->recorder) {
+        gpu_recorder_write_string(ctx->recorder, "\nOperation,Format,Crossover(px)\n");
+    }
+
+    for (int i = 0; i < format_count; i++) {
+        for (int op = 0; op < _CROSSOVER_OP_LAST; op++) {
+            const char* format_name = gpu_color_format_string(ctx->param.target_formats[i]);
+            GPU_LOG_WARN("Crossover %s %s: %" PRId32 " px%s",
+                crossover_ops[op].name, format_name, thresholds[i][op],
+                thresholds[i][op] < 0 ? " (the GPU is never faster)" : "");
+
+            if (ctx->recorder) {
+                char result[128];
+                snprintf(result, sizeof(result), "%s,%s,%" PRId32 "\n", crossover_ops[op].name, format_name, thresholds[i][op]);
+                gpu_recorder_write_string(ctx->recorder, result);
+            }
+        }
+    }
+
+    if (ctx->param.crossover_header_path) {
+        return crossover_write_header(ctx->param.crossover_header_path, thresholds, ctx->param.target_formats, format_count);
+    }
+
+    return 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static int32_t crossover_run_op(struct gpu_test_context_s* ctx, struct crossover_bench_s* bench,
+    const struct crossover_op_s* op, gpu_color_format_t format)
+{
+    /* The scalar blend kernel only handles the 16 and 32 bit targets */
+    if (op->cpu == crossover_cpu_blend && bench->pixel_size != 2 && bench->pixel_size != 4) {
+        GPU_LOG_WARN("Crossover %s %s: no CPU kernel", op->name, gpu_color_format_string(format));
+        return -1;
+    }
+
+    const uint32_t side_max = MATH_MIN(bench->target.width, bench->target.height);
+    int32_t crossover = -1;
+
+    for (uint32_t side = CROSSOVER_SIDE_MIN;; side = MATH_MAX(side + 1, (uint32_t)(side * CROSSOVER_SIDE_STEP + 0.5f))) {
+        side = MATH_MIN(side, side_max);
+        crossover_set_rect(bench, side);
+
+        float cpu_us = crossover_measure(bench, op, false);
+        float gpu_us = crossover_measure(bench, op, true);
+        if (gpu_us < 0) {
+            return -1;
+        }
+
+        /* The threshold is where the GPU starts winning for good, a lucky small size does not count */
+        int32_t area = side * side;
+        bool gpu_faster = gpu_us < cpu_us;
+        if (!gpu_faster) {
+            crossover = -1;
+        } else if (crossover < 0) {
+            crossover = area;
+        }
+
+        GPU_LOG_INFO("Crossover %s %s %" PRIu32 "x%" PRIu32 ": CPU %0.3f us, GPU %0.3f us",
+            op->name, gpu_color_format_string(format), side, side, cpu_us, gpu_us);
+
+        if (ctx->recorder) {
+            char result[128];
+            snprintf(result, sizeof(result), "%s,%s,%" PRIu32 "x%" PRIu32 ",%" PRId32 ",%0.3f,%0.3f,%s\n",
+                op->name, gpu_color_format_string(format), side, side, area, cpu_us, gpu_us, gpu_faster ? "GPU" : "CPU");
+            gpu_recorder_write_string(ctx->recorder, result);
+        }
+
+        if (side == side_max) {
+            break;
+        }
+    }
+
+    return crossover;
+}
+
+static bool crossover_bench_init(struct crossover_bench_s* bench, gpu_color_format_t format, uint32_t width, uint32_t height)
+{
+    memset(bench, 0, sizeof(struct crossover_bench_s));
+
+    const vg_lite_buffer_format_t vg_format = vg_lite_test_gpu_format_to_vg_format(format);
+    const uint32_t bpp = gpu_color_format_get_bpp(format);
+    if (bpp % 8 != 0 || bpp > 32) {
+        return false;
+    }
+
+    bench->pixel_size = bpp / 8;
+    bench->target_gpu_buffer = vg_lite_test_buffer_alloc(&bench->target, width, height, vg_format, VG_LITE_TEST_STRIDE_AUTO);
+    bench->src_gpu_buffer = vg_lite_test_buffer_alloc(&bench->src, width, height, vg_format, VG_LITE_TEST_STRIDE_AUTO);
+    bench->blend_src_gpu_buffer = vg_lite_test_buffer_alloc(&bench->blend_src, width, height, VG_LITE_BGRA8888, VG_LITE_TEST_STRIDE_AUTO);
+
+    /* Touch every page before measuring, the blend source is half transparent */
+    memset(bench->target.memory, 0, bench->target.stride * bench->target.height);
+    memset(bench->src.memory, 0x5A, bench->src.stride * bench->src.height);
+    memset(bench->blend_src.memory, 0x40, bench->blend_src.stride * bench->blend_src.height);
+    gpu_cache_flush(bench->target.memory, bench->target.stride * bench->target.height);
+    gpu_cache_flush(bench->src.memory, bench->src.stride * bench->src.height);
+    gpu_cache_flush(bench->blend_src.memory, bench->blend_src.stride * bench->blend_src.height);
+
+    /* Not the exact encoding of the clear color, the cost does not depend on it */
+    const uint32_t color = CROSSOVER_CLEAR_COLOR;
+    memcpy(bench->pixel, &color, sizeof(bench->pixel));
+
+    bench->path = vg_lite_test_path_create(VG_LITE_FP32);
+    vg_lite_identity(&bench->matrix);
+    return true;
+}
+
+static void crossover_bench_deinit(struct crossover_bench_s* bench)
+{
+    vg_lite_test_path_destroy(bench->path);
+    gpu_buffer_free(bench->target_gpu_buffer);
+    gpu_buffer_free(bench->src_gpu_buffer);
+    gpu_buffer_free(bench->blend_src_gpu_buffer);
+    memset(bench, 0, sizeof(struct crossover_bench_s));
+}
+
+static void crossover_set_rect(struct crossover_bench_s* bench, uint32_t side)
+{
+    bench->rect.x = 0;
+    bench->rect.y = 0;
+    bench->rect.width = side;
+    bench->rect.height = side;
+
+    vg_lite_test_path_reset(bench->path, VG_LITE_FP32);
+    vg_lite_test_path_append_rect(bench->path, 0, 0, side, side, 0);
+    vg_lite_test_path_end(bench->path);
+}
+
+static float crossover_measure(struct crossover_bench_s* bench, const struct crossover_op_s* op, bool gpu)
+{
+    const size_t flush_size = (bench->rect.height - 1) * bench->target.stride + bench->rect.width * bench->pixel_size;
+    uint32_t count = 0;
+    uint32_t elapsed = 0;
+    uint32_t start_tick = 0;
+
+    /* The first call warms up the caches and the command buffer, it is not counted */
+    for (int pass = 0; pass < 2; pass++) {
+        count = 0;
+        start_tick = gpu_tick_get();
+
+        do {
+            if (gpu) {
+                /* A UI layer that offloads one operation waits for it */
+                vg_lite_error_t error = op->gpu(bench);
+                if (error == VG_LITE_SUCCESS) {
+                    error = vg_lite_finish();
+                }
+
+                if (error != VG_LITE_SUCCESS) {
+                    GPU_LOG_WARN("Crossover %s failed: %d (%s)", op->name, error, vg_lite_test_error_string(error));
+                    return -1;
+                }
+            } else {
+                /* The GPU or the display reads the result, the CPU path pays for the flush */
+                op->cpu(bench);
+                gpu_cache_flush(bench->target.memory, flush_size);
+            }
+
+            count++;
+            elapsed = gpu_tick_elaps(start_tick);
+        } while (pass > 0 && elapsed < CROSSOVER_BENCHMARK_TIME_MS * 1000);
+    }
+
+    return (float)elapsed / count;
+}
+
+static void crossover_cpu_fill(struct crossover_bench_s* bench)
+{
+    const uint32_t width = bench->rect.width;
+    const uint32_t pixel_size = bench->pixel_size;
+    uint8_t* row = bench->target.memory;
+
+    for (uint32_t y = 0; y < (uint32_t)bench->rect.height; y++) {
+        switch (pixel_size) {
+        case 4: {
+            uint32_t* dst = (uint32_t*)row;
+            uint32_t value;
+            memcpy(&value, bench->pixel, sizeof(value));
+            for (uint32_t x = 0; x < width; x++) {
+                dst[x] = value;
+            }
+        } break;
+
+        case 2: {
+            uint16_t* dst = (uint16_t*)row;
+            uint16_t value;
+            memcpy(&value, bench->pixel, sizeof(value));
+            for (uint32_t x = 0; x < width; x++) {
+                dst[x] = value;
+            }
+        } break;
+
+        default: {
+            uint8_t* dst = row;
+            for (uint32_t x = 0; x < width; x++) {
+                memcpy(dst, bench->pixel, pixel_size);
+                dst += pixel_size;
+            }
+        } break;
+        }
+
+        row += bench->target.stride;
+    }
+}
+
+static void crossover_cpu_copy(struct crossover_bench_s* bench)
+{
+    const size_t row_size = bench->rect.width * bench->pixel_size;
+    uint8_t* dst = bench->target.memory;
+    const uint8_t* src = bench->src.memory;
+
+    for (uint32_t y = 0; y < (uint32_t)bench->rect.height; y++) {
+        memcpy(dst, src, row_size);
+        dst += bench->target.stride;
+        src += bench->src.stride;
+    }
+}
+
+static void crossover_cpu_blend(struct crossover_bench_s* bench)
+{
+    uint8_t* dst_row = bench->target.memory;
+    const uint8_t* src_row = bench->blend_src.memory;
+
+    /* Source over with a premultiplied source, the same as VG_LITE_BLEND_SRC_OVER */
+    for (uint32_t y = 0; y < (uint32_t)bench->rect.height; y++) {
+        const uint8_t* src = src_row;
+
+        if (bench->pixel_size == 4) {
+            uint8_t* dst = dst_row;
+            for (uint32_t x = 0; x < (uint32_t)bench->rect.width; x++) {
+                const uint32_t inv_alpha = 255 - src[3];
+                for (int c = 0; c < 4; c++) {
+                    dst[c] = src[c] + (dst[c] * inv_alpha + 127) / 255;
+                }
+
+                dst += 4;
+                src += 4;
+            }
+        } else {
+            uint16_t* dst = (uint16_t*)dst_row;
+            for (uint32_t x = 0; x < (uint32_t)bench->rect.width; x++) {
+                const uint32_t inv_alpha = 255 - src[3];
+                const uint32_t b = (dst[x] & 0x1F) << 3;
+                const uint32_t g = ((dst[x] >> 5) & 0x3F) << 2;
+                const uint32_t r = (dst[x] >> 11) << 3;
+                const uint32_t out_b = src[0] + (b * inv_alpha + 127) / 255;
+                const uint32_t out_g = src[1] + (g * inv_alpha + 127) / 255;
+                const uint32_t out_r = src[2] + (r * inv_alpha + 127) / 255;
+                dst[x] = (uint16_t)(((out_r >> 3) << 11) | ((out_g >> 2) << 5) | (out_b >> 3));
+                src += 4;
+            }
+        }
+
+        dst_row += bench->target.stride;
+        src_row += bench->blend_src.stride;
+    }
+}
+
+static vg_lite_error_t crossover_gpu_clear(struct crossover_bench_s* bench)
+{
+    return vg_lite_clear(&bench->target, &bench->rect, CROSSOVER_CLEAR_COLOR);
+}
+
+static vg_lite_error_t crossover_gpu_copy(struct crossover_bench_s* bench)
+{
+    return vg_lite_blit_rect(&bench->target, &bench->src, &bench->rect, &bench->matrix,
+        VG_LITE_BLEND_NONE, 0, VG_LITE_FILTER_POINT);
+}
+
+static vg_lite_error_t crossover_gpu_blend(struct crossover_bench_s* bench)
+{
+    return vg_lite_blit_rect(&bench->target, &bench->blend_src, &bench->rect, &bench->matrix,
+        VG_LITE_BLEND_SRC_OVER, 0, VG_LITE_FILTER_POINT);
+}
+
+static vg_lite_error_t crossover_gpu_fill(struct crossover_bench_s* bench)
+{
+    return vg_lite_draw(&bench->target, vg_lite_test_path_get_path(bench->path), VG_LITE_FILL_NON_ZERO,
+        &bench->matrix, VG_LITE_BLEND_NONE, CROSSOVER_CLEAR_COLOR);
+}
+
+static int crossover_write_header(const char* path, const int32_t (*thresholds)[_CROSSOVER_OP_LAST],
+    const gpu_color_format_t* formats, int format_count)
+{
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        GPU_LOG_ERROR("Open %s failed", path);
+        return -1;
+    }
+
+    fprintf(fp,
+        "/* Generated by gpu_test -m crossover, do not edit */\n"
+        "\n"
+        "#ifndef GPU_CROSSOVER_H\n"
+        "#define GPU_CROSSOVER_H\n"
+        "\n"
+        "/* Smallest area in pixels from which the GPU is faster than the CPU, -1 if it never is */\n");
+
+    for (int i = 0; i < format_count; i++) {
+        for (int op = 0; op < _CROSSOVER_OP_LAST; op++) {
+            fprintf(fp, thresholds[i][op] < 0 ? "#define GPU_CROSSOVER_%s_%s (%" PRId32 ")\n" : "#define GPU_CROSSOVER_%s_%s %" PRId32 "\n",
+                crossover_ops[op].macro_name, gpu_color_format_string(formats[i]), thresholds[i][op]);
+        }
+    }
+
+    fprintf(fp, "\n#endif /*GPU_CROSSOVER_H*/\n");
+    fclose(fp);
+
+    GPU_LOG_INFO("Crossover thresholds written to %s", path);
+    return 0;
+}
@@ -0,0 +1,584 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_fault.h"
+#include "../gpu_assert.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_tick.h"
+#include "../gpu_utils.h"
+#include "vg_lite_test_hook.h"
+#include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define FAULT_RULE_MAX 16
+
+/* Matches every hooked API */
+#define FAULT_API_ALL _VG_LITE_TEST_HOOK_API_LAST
+
+/* The rate is stored in parts per million */
+#define FAULT_RATE_SCALE 1000000
+
+/* Width of the buffers that hold the memory pressure */
+#define FAULT_PRESSURE_WIDTH 256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct fault_rule_s {
+    enum vg_lite_test_hook_api_e api;
+
+    /* The injected error, VG_LITE_SUCCESS for memory pressure */
+    vg_lite_error_t error;
+    uint32_t pressure_size;
+
+    /* Fire on the index-th matching call if not 0, else randomly at rate */
+    uint32_t index;
+    uint32_t rate;
+
+    uint32_t call_count;
+    uint32_t fire_count;
+};
+
+struct fault_state_s {
+    bool scissor_enabled;
+    vg_lite_int32_t scissor[4];
+};
+
+struct vg_lite_test_fault_s {
+    struct vg_lite_test_hook_listener_s listener;
+    struct fault_rule_s rules[FAULT_RULE_MAX];
+    int rule_count;
+    uint32_t random_state;
+
+    /* Memory pressure held until the current call returns */
+    vg_lite_buffer_t pressure_buffers[FAULT_RULE_MAX];
+    int pressure_count;
+
+    struct fault_state_s state;
+    struct fault_state_s item_begin_state;
+
+    /* Current item */
+    int item_injected;
+    uint32_t item_inject_tick;
+    bool item_clut_failed;
+    char item_fault_text[64];
+
+    /* Recovery of the last failed item with injected faults */
+    bool recovering;
+    uint32_t recover_start_tick;
+    int recover_failed_items;
+
+    /* Summary */
+    uint32_t injected_count;
+    uint32_t pressure_fail_count;
+    uint32_t faulted_items;
+    uint32_t tolerated_items;
+    uint32_t recovered_items;
+    uint32_t leaked_items;
+    uint64_t recover_time_sum;
+    uint32_t recover_time_max;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static vg_lite_error_t fault_on_call(const struct vg_lite_test_hook_call_s* call, void* user_data);
+static void fault_on_return(const struct vg_lite_test_hook_call_s* call, vg_lite_error_t error, void* user_data);
+static bool fault_parse_spec(struct vg_lite_test_fault_s* fault, const char* spec);
+static bool fault_parse_rule(struct vg_lite_test_fault_s* fault, char* str);
+static bool fault_state_is_default(const struct fault_state_s* state, const vg_lite_buffer_t* target);
+static bool fault_parse_api(const char* str, enum vg_lite_test_hook_api_e* api);
+static bool fault_parse_action(const char* str, struct fault_rule_s* rule);
+static bool fault_parse_trigger(const char* str, struct fault_rule_s* rule);
+static bool fault_rule_fire(struct vg_lite_test_fault_s* fault, struct fault_rule_s* rule);
+static void fault_pressure_alloc(struct vg_lite_test_fault_s* fault, uint32_t size);
+static void fault_pressure_release(struct vg_lite_test_fault_s* fault);
+static uint32_t fault_random(struct vg_lite_test_fault_s* fault);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const struct {
+    const char* name;
+    vg_lite_error_t error;
+} fault_error_map[] = {
+    { "oom", VG_LITE_OUT_OF_MEMORY },
+    { "resources", VG_LITE_OUT_OF_RESOURCES },
+    { "timeout", VG_LITE_TIMEOUT },
+    { "invalid", VG_LITE_INVALID_ARGUMENT },
+    { "generic", VG_LITE_GENERIC_IO },
+    { "not_support", VG_LITE_NOT_SUPPORT },
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct vg_lite_test_fault_s* vg_lite_test_fault_create(const char* spec)
+{
+    GPU_ASSERT_NULL(spec);
+
+    struct vg_lite_test_fault_s* fault = malloc(sizeof(struct vg_lite_test_fault_s));
+    GPU_ASSERT_NULL(fault);
+    memset(fault, 0, sizeof(struct vg_lite_test_fault_s));
+    fault->random_state = 1;
+
+    if (!fault_parse_spec(fault, spec)) {
+        GPU_LOG_ERROR("Invalid fault spec: %s", spec);
+        free(fault);
+        return NULL;
+    }
+
+    fault->listener.on_call = fault_on_call;
+    fault->listener.on_return = fault_on_return;
+    fault->listener.user_data = fault;
+    if (vg_lite_test_hook_add_listener(&fault->listener) != 0) {
+        GPU_LOG_ERROR("Register fault injector failed");
+    }
+
+    GPU_LOG_INFO("Fault injector created with %d rules", fault->rule_count);
+    return fault;
+}
+
+bool vg_lite_test_fault_check_spec(const char* spec)
+{
+    GPU_ASSERT_NULL(spec);
+
+    struct vg_lite_test_fault_s* fault = calloc(1, sizeof(struct vg_lite_test_fault_s));
+    GPU_ASSERT_NULL(fault);
+    bool valid = fault_parse_spec(fault, spec);
+    free(fault);
+    return valid;
+}
+
+void vg_lite_test_fault_destroy(struct vg_lite_test_fault_s* fault)
+{
+    GPU_ASSERT_NULL(fault);
+    vg_lite_test_hook_remove_listener(&fault->listener);
+    fault_pressure_release(fault);
+
+    GPU_LOG_INFO("Fault injection summary:");
+    for (int i = 0; i < fault->rule_count; i++) {
+        const struct fault_rule_s* rule = &fault->rules[i];
+        GPU_LOG_INFO("  rule %d: %s %s fired %" PRIu32 " / %" PRIu32 " calls",
+            i,
+            rule->api == FAULT_API_ALL ? "ALL" : vg_lite_test_hook_api_string(rule->api),
+            rule->error != VG_LITE_SUCCESS ? vg_lite_test_error_string(rule->error) : "PRESSURE",
+            rule->fire_count, rule->call_count);
+    }
+
+    GPU_LOG_INFO("  injected errors   : %" PRIu32, fault->injected_count);
+    GPU_LOG_INFO("  pressure failures : %" PRIu32, fault->pressure_fail_count);
+    GPU_LOG_INFO("  faulted items     : %" PRIu32, fault->faulted_items);
+    GPU_LOG_INFO("  tolerated items   : %" PRIu32, fault->tolerated_items);
+    GPU_LOG_INFO("  recovered         : %" PRIu32 ", avg %0.3f ms, max %0.3f ms",
+        fault->recovered_items,
+        fault->recovered_items ? fault->recover_time_sum / 1000.0 / fault->recovered_items : 0.0,
+        fault->recover_time_max / 1000.0);
+    GPU_LOG_INFO("  state leaked      : %" PRIu32, fault->leaked_items);
+
+    if (fault->recovering) {
+        GPU_LOG_WARN("Not recovered at exit, %d items failed since the last fault", fault->recover_failed_items);
+    }
+
+    memset(fault, 0, sizeof(struct vg_lite_test_fault_s));
+    free(fault);
+}
+
+void vg_lite_test_fault_item_begin(struct vg_lite_test_fault_s* fault)
+{
+    GPU_ASSERT_NULL(fault);
+    fault->item_begin_state = fault->state;
+    fault->item_injected = 0;
+    fault->item_inject_tick = 0;
+    fault->item_clut_failed = false;
+    fault->item_fault_text[0] = '\0';
+}
+
+bool vg_lite_test_fault_item_end(
+    struct vg_lite_test_fault_s* fault,
+    bool passed,
+    const vg_lite_buffer_t* target,
+    char* remark,
+    size_t remark_size)
+{
+    GPU_ASSERT_NULL(fault);
+    GPU_ASSERT_NULL(target);
+    GPU_ASSERT_NULL(remark);
+    remark[0] = '\0';
+
+    if (fault->item_injected == 0) {
+        if (!fault->recovering) {
+            return true;
+        }
+
+        if (!passed) {
+            fault->recover_failed_items++;
+            snprintf(remark, remark_size, "Not recovered: %d items failed", fault->recover_failed_items);
+            return true;
+        }
+
+        uint32_t recover_time = gpu_tick_elaps(fault->recover_start_tick);
+        fault->recovering = false;
+        fault->recovered_items++;
+        fault->recover_time_sum += recover_time;
+        fault->recover_time_max = MATH_MAX(fault->recover_time_max, recover_time);
+        snprintf(remark, remark_size, "Recovered in %0.3f ms after %d failed items",
+            recover_time / 1000.0, fault->recover_failed_items);
+        GPU_LOG_INFO("%s", remark);
+        return true;
+    }
+
+    fault->faulted_items++;
+
+    if (passed) {
+        /* The failed calls did not affect the result, e.g. pressure that did not run out of memory */
+        fault->tolerated_items++;
+    } else if (!fault->recovering) {
+        fault->recovering = true;
+        fault->recover_start_tick = fault->item_inject_tick;
+        fault->recover_failed_items = 1;
+    } else {
+        fault->recover_failed_items++;
+    }
+
+    int len = snprintf(remark, remark_size, "Injected %d: %s", fault->item_injected, fault->item_fault_text);
+
+    /* Restoring the full target scissor in the teardown is not a leak, nor is a state the item found */
+    const struct fault_state_s* begin = &fault->item_begin_state;
+    const struct fault_state_s* end = &fault->state;
+    bool scissor_changed = begin->scissor_enabled != end->scissor_enabled
+        || memcmp(begin->scissor, end->scissor, sizeof(begin->scissor)) != 0;
+    bool scissor_leaked = scissor_changed && !fault_state_is_default(end, target);
+
+    /* The GPU keeps the CLUT of the previous item if setting it failed */
+    bool clut_leaked = fault->item_clut_failed;
+
+    if (scissor_leaked || clut_leaked) {
+        fault->leaked_items++;
+        if (len > 0 && (size_t)len < remark_size) {
+            snprintf(remark + len, remark_size - len, "; leaked:%s%s",
+                scissor_leaked ? " scissor" : "",
+                clut_leaked ? " CLUT" : "");
+        }
+
+        GPU_LOG_ERROR("State leaked after fault: %s", remark);
+        return false;
+    }
+
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static vg_lite_error_t fault_on_call(const struct vg_lite_test_hook_call_s* call, void* user_data)
+{
+    struct vg_lite_test_fault_s* fault = user_data;
+    vg_lite_error_t error = VG_LITE_SUCCESS;
+
+    for (int i = 0; i < fault->rule_count; i++) {
+        struct fault_rule_s* rule = &fault->rules[i];
+        if (rule->api != FAULT_API_ALL && rule->api != call->api) {
+            continue;
+        }
+
+        if (!fault_rule_fire(fault, rule)) {
+            continue;
+        }
+
+        if (rule->error == VG_LITE_SUCCESS) {
+            fault_pressure_alloc(fault, rule->pressure_size);
+            continue;
+        }
+
+        /* The first error wins, the other rules still count the call */
+        if (error != VG_LITE_SUCCESS) {
+            continue;
+        }
+
+        error = rule->error;
+        fault->injected_count++;
+
+        if (fault->item_injected++ == 0) {
+            fault->item_inject_tick = gpu_tick_get();
+            snprintf(fault->item_fault_text, sizeof(fault->item_fault_text), "%s:%s #%" PRIu32,
+                vg_lite_test_hook_api_string(call->api), vg_lite_test_error_string(error), rule->call_count);
+        }
+
+        GPU_LOG_WARN("Inject %s into %s (call #%" PRIu32 ")",
+            vg_lite_test_error_string(error), vg_lite_test_hook_api_string(call->api), rule->call_count);
+    }
+
+    return error;
+}
+
+static void fault_on_return(const struct vg_lite_test_hook_call_s* call, vg_lite_error_t error, void* user_data)
+{
+    struct vg_lite_test_fault_s* fault = user_data;
+    fault_pressure_release(fault);
+
+    if (call->api == VG_LITE_TEST_HOOK_API_SET_CLUT && error != VG_LITE_SUCCESS) {
+        fault->item_clut_failed = true;
+    }
+
+    if (error != VG_LITE_SUCCESS) {
+        return;
+    }
+
+    /* Track the scissor state that survives across items */
+    switch (call->api) {
+    case VG_LITE_TEST_HOOK_API_SET_SCISSOR:
+        fault->state.scissor[0] = call->args.set_scissor.x;
+        fault->state.scissor[1] = call->args.set_scissor.y;
+        fault->state.scissor[2] = call->args.set_scissor.right;
+        fault->state.scissor[3] = call->args.set_scissor.bottom;
+        break;
+
+    case VG_LITE_TEST_HOOK_API_ENABLE_SCISSOR:
+        fault->state.scissor_enabled = true;
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DISABLE_SCISSOR:
+        fault->state.scissor_enabled = false;
+        break;
+
+    default:
+        break;
+    }
+}
+
+static bool fault_parse_spec(struct vg_lite_test_fault_s* fault, const char* spec)
+{
+    char* spec_copy = strdup(spec);
+    GPU_ASSERT_NULL(spec_copy);
+
+    bool valid = true;
+    char* saveptr = NULL;
+    for (char* str = strtok_r(spec_copy, ",", &saveptr); str; str = strtok_r(NULL, ",", &saveptr)) {
+        if (!fault_parse_rule(fault, str)) {
+            valid = false;
+            break;
+        }
+    }
+
+    free(spec_copy);
+    return valid && fault->rule_count > 0;
+}
+
+static bool fault_state_is_default(const struct fault_state_s* state, const vg_lite_buffer_t* target)
+{
+    if (!state->scissor_enabled) {
+        return true;
+    }
+
+    /* An enabled scissor that covers the whole target clips nothing */
+    return state->scissor[0] <= 0
+        && state->scissor[1] <= 0
+        && state->scissor[2] >= (vg_lite_int32_t)target->width
+        && state->scissor[3] >= (vg_lite_int32_t)target->height;
+}
+
+static bool fault_parse_rule(struct vg_lite_test_fault_s* fault, char* str)
+{
+    char* value = strchr(str, '=');
+    if (!value) {
+        GPU_LOG_ERROR("Missing '=' in fault rule: %s", str);
+        return false;
+    }
+
+    *value++ = '\0';
+
+    if (strcasecmp(str, "seed") == 0) {
+        /* 0 is a fixed point of xorshift */
+        fault->random_state = (uint32_t)strtoul(value, NULL, 0) | 1;
+        return true;
+    }
+
+    if (fault->rule_count >= FAULT_RULE_MAX) {
+        GPU_LOG_ERROR("Too many fault rules, max %d", FAULT_RULE_MAX);
+        return false;
+    }
+
+    char* trigger = strchr(value, '@');
+    if (!trigger) {
+        GPU_LOG_ERROR("Missing '@' in fault rule: %s=%s", str, value);
+        return false;
+    }
+
+    *trigger++ = '\0';
+
+    struct fault_rule_s* rule = &fault->rules[fault->rule_count];
+    memset(rule, 0, sizeof(struct fault_rule_s));
+
+    if (!fault_parse_api(str, &rule->api)
+        || !fault_parse_action(value, rule)
+        || !fault_parse_trigger(trigger, rule)) {
+        return false;
+    }
+
+    fault->rule_count++;
+    return true;
+}
+
+static bool fault_parse_api(const char* str, enum vg_lite_test_hook_api_e* api)
+{
+    if (strcasecmp(str, "all") == 0) {
+        *api = FAULT_API_ALL;
+        return true;
+    }
+
+    for (int i = 0; i < _VG_LITE_TEST_HOOK_API_LAST; i++) {
+        if (strcasecmp(str, vg_lite_test_hook_api_string((enum vg_lite_test_hook_api_e)i)) == 0) {
+            *api = (enum vg_lite_test_hook_api_e)i;
+            return true;
+        }
+    }
+
+    GPU_LOG_ERROR("Unknown fault API: %s", str);
+    return false;
+}
+
+static bool fault_parse_action(const char* str, struct fault_rule_s* rule)
+{
+    if (strncasecmp(str, "pressure:", 9) == 0) {
+        long size = strtol(str + 9, NULL, 0);
+        if (size <= 0) {
+            GPU_LOG_ERROR("Invalid pressure size: %s", str);
+            return false;
+        }
+
+        rule->error = VG_LITE_SUCCESS;
+        rule->pressure_size = (uint32_t)size;
+        return true;
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(fault_error_map); i++) {
+        if (strcasecmp(str, fault_error_map[i].name) == 0) {
+            rule->error = fault_error_map[i].error;
+            return true;
+        }
+    }
+
+    GPU_LOG_ERROR("Unknown fault action: %s", str);
+    return false;
+}
+
+static bool fault_parse_trigger(const char* str, struct fault_rule_s* rule)
+{
+    char* end = NULL;
+
+    if (strchr(str, '%')) {
+        double percent = strtod(str, &end);
+        if (end == str || *end != '%' || percent <= 0 || percent > 100) {
+            GPU_LOG_ERROR("Invalid fault rate: %s", str);
+            return false;
+        }
+
+        rule->rate = (uint32_t)(percent * (FAULT_RATE_SCALE / 100) + 0.5);
+        return true;
+    }
+
+    long index = strtol(str, &end, 0);
+    if (end == str || *end != '\0' || index <= 0) {
+        GPU_LOG_ERROR("Invalid fault call index: %s", str);
+        return false;
+    }
+
+    rule->index = (uint32_t)index;
+    return true;
+}
+
+static bool fault_rule_fire(struct vg_lite_test_fault_s* fault, struct fault_rule_s* rule)
+{
+    rule->call_count++;
+
+    bool fire = rule->index ? (rule->call_count == rule->index)
+                            : (fault_random(fault) % FAULT_RATE_SCALE < rule->rate);
+    if (fire) {
+        rule->fire_count++;
+    }
+
+    return fire;
+}
+
+static void fault_pressure_alloc(struct vg_lite_test_fault_s* fault, uint32_t size)
+{
+    GPU_ASSERT(fault->pressure_count < FAULT_RULE_MAX);
+
+    vg_lite_buffer_t* buffer = &fault->pressure_buffers[fault->pressure_count];
+    memset(buffer, 0, sizeof(vg_lite_buffer_t));
+    buffer->format = VG_LITE_BGRA8888;
+    buffer->width = FAULT_PRESSURE_WIDTH;
+    buffer->height = (size + FAULT_PRESSURE_WIDTH * sizeof(uint32_t) - 1) / (FAULT_PRESSURE_WIDTH * sizeof(uint32_t));
+
+    vg_lite_error_t error = vg_lite_allocate(buffer);
+    if (error != VG_LITE_SUCCESS) {
+        /* Already out of memory, the call runs under the pressure anyway */
+        fault->pressure_fail_count++;
+        GPU_LOG_WARN("Allocate %" PRIu32 " bytes of pressure failed: %d (%s)",
+            size, error, vg_lite_test_error_string(error));
+        return;
+    }
+
+    fault->pressure_count++;
+}
+
+static void fault_pressure_release(struct vg_lite_test_fault_s* fault)
+{
+    while (fault->pressure_count > 0) {
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_free(&fault->pressure_buffers[--fault->pressure_count]));
+    }
+}
+
+static uint32_t fault_random(struct vg_lite_test_fault_s* fault)
+{
+    /* xorshift32, reproducible with the same seed */
+    uint32_t x = fault->random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    fault->random_state = x;
+    return x;
+}
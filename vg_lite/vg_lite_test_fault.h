@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_FAULT_H
+#define VG_LITE_TEST_FAULT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_fault_s;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Create the fault injector and register it as a hook listener.
+ * @param spec Comma separated rules, each rule is "<api>=<action>@<trigger>" or "seed=<int>".
+ *             api: a hooked API name (draw, blit_rect, set_clut, finish, ...) or "all".
+ *             action: oom, resources, timeout, invalid, generic, not_support,
+ *                     or "pressure:<bytes>" to hold that much GPU memory during the call.
+ *             trigger: "<n>" for the n-th matching call, "<percent>%" for a random rate.
+ *             Example: "draw=oom@3,finish=timeout@0.5%,all=pressure:1048576@10%".
+ * @return The fault injector, NULL if the spec is invalid.
+ * @note Create it before the other listeners, a failed call is then not seen by them.
+ */
+struct vg_lite_test_fault_s* vg_lite_test_fault_create(const char* spec);
+
+/**
+ * @brief Check a fault spec without creating the injector.
+ * @param spec The fault spec, see vg_lite_test_fault_create.
+ * @return True if the spec is valid, false otherwise.
+ */
+bool vg_lite_test_fault_check_spec(const char* spec);
+
+/**
+ * @brief Unregister the fault injector, log the summary and free it.
+ * @param fault The fault injector.
+ */
+void vg_lite_test_fault_destroy(struct vg_lite_test_fault_s* fault);
+
+/**
+ * @brief Mark the beginning of a test case item, snapshots the scissor state.
+ * @param fault The fault injector.
+ */
+void vg_lite_test_fault_item_begin(struct vg_lite_test_fault_s* fault);
+
+/**
+ * @brief Mark the end of the current test case item.
+ * @param fault The fault injector.
+ * @param passed Whether the item passed.
+ * @param target The target buffer of the item, a scissor covering it counts as reset.
+ * @param remark Buffer for the injected faults, the leaked state and the recovery time.
+ * @param remark_size The size of the remark buffer.
+ * @return False if an item with injected faults leaked the scissor or CLUT state, true otherwise.
+ */
+bool vg_lite_test_fault_item_end(
+    struct vg_lite_test_fault_s* fault,
+    bool passed,
+    const vg_lite_buffer_t* target,
+    char* remark,
+    size_t remark_size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_FAULT_H*/
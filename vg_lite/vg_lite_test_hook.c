@@ -0,0 +1,425 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+/* Call the real vg_lite API from this file */
+#define VG_LITE_TEST_HOOK_IMPL
+#include "vg_lite_test_hook.h"
+#include "../gpu_assert.h"
+#include "../gpu_cache.h"
+#include "../gpu_log.h"
+#include "../gpu_tick.h"
+#include "../gpu_utils.h"
+#include "vg_lite_test_latency.h"
+#include <stddef.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define HOOK_API_ENUM_TO_STRING(e)    \
+    case (VG_LITE_TEST_HOOK_API_##e): \
+        return #e
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static vg_lite_error_t hook_call_begin(const struct vg_lite_test_hook_call_s* call);
+static void hook_call_end(const struct vg_lite_test_hook_call_s* call, vg_lite_error_t error);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const struct vg_lite_test_hook_listener_s* hook_listeners[VG_LITE_TEST_HOOK_LISTENER_MAX];
+static int hook_listener_count;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Only the real API is timed, the listeners are not part of the latency */
+#ifdef VG_LITE_TEST_LATENCY_ENABLE
+#define HOOK_CALL_REAL(call, func)                                          \
+    do {                                                                    \
+        uint32_t start_tick = gpu_tick_get();                               \
+        error = func;                                                       \
+        vg_lite_test_latency_record((call).api, gpu_tick_elaps(start_tick)); \
+    } while (0)
+#else
+#define HOOK_CALL_REAL(call, func) error = func
+#endif
+
+/* The deferred cache maintenance must complete before the GPU can read the memory */
+#define HOOK_INVOKE(call, func)                  \
+    do {                                         \
+        vg_lite_error_t error;                   \
+        gpu_cache_sync();                        \
+        if (hook_listener_count == 0) {          \
+            HOOK_CALL_REAL(call, func);          \
+            return error;                        \
+        }                                        \
+        error = hook_call_begin(&(call));        \
+        if (error == VG_LITE_SUCCESS) {          \
+            HOOK_CALL_REAL(call, func);          \
+        }                                        \
+        hook_call_end(&(call), error);           \
+        return error;                            \
+    } while (0)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int vg_lite_test_hook_add_listener(const struct vg_lite_test_hook_listener_s* listener)
+{
+    GPU_ASSERT_NULL(listener);
+
+    if (hook_listener_count >= (int)ARRAY_SIZE(hook_listeners)) {
+        GPU_LOG_ERROR("Too many hook listeners: %d", hook_listener_count);
+        return -1;
+    }
+
+    hook_listeners[hook_listener_count++] = listener;
+    return 0;
+}
+
+void vg_lite_test_hook_remove_listener(const struct vg_lite_test_hook_listener_s* listener)
+{
+    for (int i = 0; i < hook_listener_count; i++) {
+        if (hook_listeners[i] == listener) {
+            /* Keep the registration order of the remaining listeners */
+            for (int j = i; j < hook_listener_count - 1; j++) {
+                hook_listeners[j] = hook_listeners[j + 1];
+            }
+
+            hook_listeners[--hook_listener_count] = NULL;
+            return;
+        }
+    }
+
+    GPU_LOG_WARN("Hook listener %p not found", listener);
+}
+
+const char* vg_lite_test_hook_api_string(enum vg_lite_test_hook_api_e api)
+{
+    switch (api) {
+        HOOK_API_ENUM_TO_STRING(CLEAR);
+        HOOK_API_ENUM_TO_STRING(BLIT);
+        HOOK_API_ENUM_TO_STRING(BLIT_RECT);
+        HOOK_API_ENUM_TO_STRING(DRAW);
+        HOOK_API_ENUM_TO_STRING(DRAW_PATTERN);
+        HOOK_API_ENUM_TO_STRING(DRAW_GRAD);
+        HOOK_API_ENUM_TO_STRING(DRAW_LINEAR_GRAD);
+        HOOK_API_ENUM_TO_STRING(DRAW_RADIAL_GRAD);
+        HOOK_API_ENUM_TO_STRING(SET_SCISSOR);
+        HOOK_API_ENUM_TO_STRING(ENABLE_SCISSOR);
+        HOOK_API_ENUM_TO_STRING(DISABLE_SCISSOR);
+        HOOK_API_ENUM_TO_STRING(SET_CLUT);
+        HOOK_API_ENUM_TO_STRING(GAUSSIAN_FILTER);
+        HOOK_API_ENUM_TO_STRING(FLUSH);
+        HOOK_API_ENUM_TO_STRING(FINISH);
+    default:
+        break;
+    }
+
+    return "UNKNOW_API";
+}
+
+vg_lite_error_t vg_lite_test_hook_clear(
+    vg_lite_buffer_t* target,
+    vg_lite_rectangle_t* rect,
+    vg_lite_color_t color)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_CLEAR;
+    call.args.clear.target = target;
+    call.args.clear.rect = rect;
+    call.args.clear.color = color;
+    HOOK_INVOKE(call, vg_lite_clear(target, rect, color));
+}
+
+vg_lite_error_t vg_lite_test_hook_blit(
+    vg_lite_buffer_t* target,
+    vg_lite_buffer_t* source,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_BLIT;
+    call.args.blit.target = target;
+    call.args.blit.source = source;
+    call.args.blit.rect = NULL;
+    call.args.blit.matrix = matrix;
+    call.args.blit.blend = blend;
+    call.args.blit.color = color;
+    call.args.blit.filter = filter;
+    HOOK_INVOKE(call, vg_lite_blit(target, source, matrix, blend, color, filter));
+}
+
+vg_lite_error_t vg_lite_test_hook_blit_rect(
+    vg_lite_buffer_t* target,
+    vg_lite_buffer_t* source,
+    vg_lite_rectangle_t* rect,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_BLIT_RECT;
+    call.args.blit.target = target;
+    call.args.blit.source = source;
+    call.args.blit.rect = rect;
+    call.args.blit.matrix = matrix;
+    call.args.blit.blend = blend;
+    call.args.blit.color = color;
+    call.args.blit.filter = filter;
+    HOOK_INVOKE(call, vg_lite_blit_rect(target, source, rect, matrix, blend, color, filter));
+}
+
+vg_lite_error_t vg_lite_test_hook_draw(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_DRAW;
+    call.args.draw.target = target;
+    call.args.draw.path = path;
+    call.args.draw.fill_rule = fill_rule;
+    call.args.draw.matrix = matrix;
+    call.args.draw.blend = blend;
+    call.args.draw.color = color;
+    HOOK_INVOKE(call, vg_lite_draw(target, path, fill_rule, matrix, blend, color));
+}
+
+vg_lite_error_t vg_lite_test_hook_draw_pattern(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_buffer_t* pattern_image,
+    vg_lite_matrix_t* pattern_matrix,
+    vg_lite_blend_t blend,
+    vg_lite_pattern_mode_t pattern_mode,
+    vg_lite_color_t pattern_color,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_DRAW_PATTERN;
+    call.args.draw_pattern.target = target;
+    call.args.draw_pattern.path = path;
+    call.args.draw_pattern.fill_rule = fill_rule;
+    call.args.draw_pattern.path_matrix = path_matrix;
+    call.args.draw_pattern.pattern_image = pattern_image;
+    call.args.draw_pattern.pattern_matrix = pattern_matrix;
+    call.args.draw_pattern.blend = blend;
+    call.args.draw_pattern.pattern_mode = pattern_mode;
+    call.args.draw_pattern.pattern_color = pattern_color;
+    call.args.draw_pattern.color = color;
+    call.args.draw_pattern.filter = filter;
+    HOOK_INVOKE(call,
+        vg_lite_draw_pattern(
+            target, path, fill_rule, path_matrix,
+            pattern_image, pattern_matrix,
+            blend, pattern_mode, pattern_color, color, filter));
+}
+
+vg_lite_error_t vg_lite_test_hook_draw_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* matrix,
+    vg_lite_linear_gradient_t* grad,
+    vg_lite_blend_t blend)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_DRAW_GRAD;
+    call.args.draw_grad.target = target;
+    call.args.draw_grad.path = path;
+    call.args.draw_grad.fill_rule = fill_rule;
+    call.args.draw_grad.matrix = matrix;
+    call.args.draw_grad.grad = grad;
+    call.args.draw_grad.blend = blend;
+    HOOK_INVOKE(call, vg_lite_draw_grad(target, path, fill_rule, matrix, grad, blend));
+}
+
+vg_lite_error_t vg_lite_test_hook_draw_linear_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_ext_linear_gradient_t* grad,
+    vg_lite_color_t paint_color,
+    vg_lite_blend_t blend,
+    vg_lite_filter_t filter)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_DRAW_LINEAR_GRAD;
+    call.args.draw_linear_grad.target = target;
+    call.args.draw_linear_grad.path = path;
+    call.args.draw_linear_grad.fill_rule = fill_rule;
+    call.args.draw_linear_grad.path_matrix = path_matrix;
+    call.args.draw_linear_grad.grad = grad;
+    call.args.draw_linear_grad.paint_color = paint_color;
+    call.args.draw_linear_grad.blend = blend;
+    call.args.draw_linear_grad.filter = filter;
+    HOOK_INVOKE(call,
+        vg_lite_draw_linear_grad(
+            target, path, fill_rule, path_matrix,
+            grad, paint_color, blend, filter));
+}
+
+vg_lite_error_t vg_lite_test_hook_draw_radial_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_radial_gradient_t* grad,
+    vg_lite_color_t paint_color,
+    vg_lite_blend_t blend,
+    vg_lite_filter_t filter)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_DRAW_RADIAL_GRAD;
+    call.args.draw_radial_grad.target = target;
+    call.args.draw_radial_grad.path = path;
+    call.args.draw_radial_grad.fill_rule = fill_rule;
+    call.args.draw_radial_grad.path_matrix = path_matrix;
+    call.args.draw_radial_grad.grad = grad;
+    call.args.draw_radial_grad.paint_color = paint_color;
+    call.args.draw_radial_grad.blend = blend;
+    call.args.draw_radial_grad.filter = filter;
+    HOOK_INVOKE(call,
+        vg_lite_draw_radial_grad(
+            target, path, fill_rule, path_matrix,
+            grad, paint_color, blend, filter));
+}
+
+vg_lite_error_t vg_lite_test_hook_set_scissor(
+    vg_lite_int32_t x,
+    vg_lite_int32_t y,
+    vg_lite_int32_t right,
+    vg_lite_int32_t bottom)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_SET_SCISSOR;
+    call.args.set_scissor.x = x;
+    call.args.set_scissor.y = y;
+    call.args.set_scissor.right = right;
+    call.args.set_scissor.bottom = bottom;
+    HOOK_INVOKE(call, vg_lite_set_scissor(x, y, right, bottom));
+}
+
+vg_lite_error_t vg_lite_test_hook_enable_scissor(void)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_ENABLE_SCISSOR;
+    HOOK_INVOKE(call, vg_lite_enable_scissor());
+}
+
+vg_lite_error_t vg_lite_test_hook_disable_scissor(void)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_DISABLE_SCISSOR;
+    HOOK_INVOKE(call, vg_lite_disable_scissor());
+}
+
+vg_lite_error_t vg_lite_test_hook_set_CLUT(vg_lite_uint32_t count, vg_lite_uint32_t* colors)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_SET_CLUT;
+    call.args.set_clut.count = count;
+    call.args.set_clut.colors = colors;
+    HOOK_INVOKE(call, vg_lite_set_CLUT(count, colors));
+}
+
+vg_lite_error_t vg_lite_test_hook_gaussian_filter(vg_lite_float_t w0, vg_lite_float_t w1, vg_lite_float_t w2)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_GAUSSIAN_FILTER;
+    call.args.gaussian_filter.w0 = w0;
+    call.args.gaussian_filter.w1 = w1;
+    call.args.gaussian_filter.w2 = w2;
+    HOOK_INVOKE(call, vg_lite_gaussian_filter(w0, w1, w2));
+}
+
+vg_lite_error_t vg_lite_test_hook_flush(void)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_FLUSH;
+    HOOK_INVOKE(call, vg_lite_flush());
+}
+
+vg_lite_error_t vg_lite_test_hook_finish(void)
+{
+    struct vg_lite_test_hook_call_s call;
+    call.api = VG_LITE_TEST_HOOK_API_FINISH;
+    HOOK_INVOKE(call, vg_lite_finish());
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static vg_lite_error_t hook_call_begin(const struct vg_lite_test_hook_call_s* call)
+{
+    for (int i = 0; i < hook_listener_count; i++) {
+        const struct vg_lite_test_hook_listener_s* listener = hook_listeners[i];
+        if (!listener->on_call) {
+            continue;
+        }
+
+        vg_lite_error_t error = listener->on_call(call, listener->user_data);
+        if (error != VG_LITE_SUCCESS) {
+            return error;
+        }
+    }
+
+    return VG_LITE_SUCCESS;
+}
+
+static void hook_call_end(const struct vg_lite_test_hook_call_s* call, vg_lite_error_t error)
+{
+    for (int i = 0; i < hook_listener_count; i++) {
+        const struct vg_lite_test_hook_listener_s* listener = hook_listeners[i];
+        if (listener->on_return) {
+            listener->on_return(call, error, listener->user_data);
+        }
+    }
+}
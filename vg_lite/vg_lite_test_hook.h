@@ -0,0 +1,318 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_HOOK_H
+#define VG_LITE_TEST_HOOK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define VG_LITE_TEST_HOOK_LISTENER_MAX 8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum vg_lite_test_hook_api_e {
+    VG_LITE_TEST_HOOK_API_CLEAR,
+    VG_LITE_TEST_HOOK_API_BLIT,
+    VG_LITE_TEST_HOOK_API_BLIT_RECT,
+    VG_LITE_TEST_HOOK_API_DRAW,
+    VG_LITE_TEST_HOOK_API_DRAW_PATTERN,
+    VG_LITE_TEST_HOOK_API_DRAW_GRAD,
+    VG_LITE_TEST_HOOK_API_DRAW_LINEAR_GRAD,
+    VG_LITE_TEST_HOOK_API_DRAW_RADIAL_GRAD,
+    VG_LITE_TEST_HOOK_API_SET_SCISSOR,
+    VG_LITE_TEST_HOOK_API_ENABLE_SCISSOR,
+    VG_LITE_TEST_HOOK_API_DISABLE_SCISSOR,
+    VG_LITE_TEST_HOOK_API_SET_CLUT,
+    VG_LITE_TEST_HOOK_API_GAUSSIAN_FILTER,
+    VG_LITE_TEST_HOOK_API_FLUSH,
+    VG_LITE_TEST_HOOK_API_FINISH,
+    _VG_LITE_TEST_HOOK_API_LAST
+};
+
+struct vg_lite_test_hook_call_s {
+    enum vg_lite_test_hook_api_e api;
+    union {
+        struct {
+            vg_lite_buffer_t* target;
+            vg_lite_rectangle_t* rect;
+            vg_lite_color_t color;
+        } clear;
+
+        /* Shared by blit and blit_rect, rect is NULL for blit */
+        struct {
+            vg_lite_buffer_t* target;
+            vg_lite_buffer_t* source;
+            vg_lite_rectangle_t* rect;
+            vg_lite_matrix_t* matrix;
+            vg_lite_blend_t blend;
+            vg_lite_color_t color;
+            vg_lite_filter_t filter;
+        } blit;
+
+        struct {
+            vg_lite_buffer_t* target;
+            vg_lite_path_t* path;
+            vg_lite_fill_t fill_rule;
+            vg_lite_matrix_t* matrix;
+            vg_lite_blend_t blend;
+            vg_lite_color_t color;
+        } draw;
+
+        struct {
+            vg_lite_buffer_t* target;
+            vg_lite_path_t* path;
+            vg_lite_fill_t fill_rule;
+            vg_lite_matrix_t* path_matrix;
+            vg_lite_buffer_t* pattern_image;
+            vg_lite_matrix_t* pattern_matrix;
+            vg_lite_blend_t blend;
+            vg_lite_pattern_mode_t pattern_mode;
+            vg_lite_color_t pattern_color;
+            vg_lite_color_t color;
+            vg_lite_filter_t filter;
+        } draw_pattern;
+
+        struct {
+            vg_lite_buffer_t* target;
+            vg_lite_path_t* path;
+            vg_lite_fill_t fill_rule;
+            vg_lite_matrix_t* matrix;
+            vg_lite_linear_gradient_t* grad;
+            vg_lite_blend_t blend;
+        } draw_grad;
+
+        struct {
+            vg_lite_buffer_t* target;
+            vg_lite_path_t* path;
+            vg_lite_fill_t fill_rule;
+            vg_lite_matrix_t* path_matrix;
+            vg_lite_ext_linear_gradient_t* grad;
+            vg_lite_color_t paint_color;
+            vg_lite_blend_t blend;
+            vg_lite_filter_t filter;
+        } draw_linear_grad;
+
+        struct {
+            vg_lite_buffer_t* target;
+            vg_lite_path_t* path;
+            vg_lite_fill_t fill_rule;
+            vg_lite_matrix_t* path_matrix;
+            vg_lite_radial_gradient_t* grad;
+            vg_lite_color_t paint_color;
+            vg_lite_blend_t blend;
+            vg_lite_filter_t filter;
+        } draw_radial_grad;
+
+        struct {
+            vg_lite_int32_t x;
+            vg_lite_int32_t y;
+            vg_lite_int32_t right;
+            vg_lite_int32_t bottom;
+        } set_scissor;
+
+        struct {
+            vg_lite_uint32_t count;
+            vg_lite_uint32_t* colors;
+        } set_clut;
+
+        struct {
+            vg_lite_float_t w0;
+            vg_lite_float_t w1;
+            vg_lite_float_t w2;
+        } gaussian_filter;
+    } args;
+};
+
+struct vg_lite_test_hook_listener_s {
+    /**
+     * Called before the real API is executed. Returning anything other than
+     * VG_LITE_SUCCESS skips the real API and hands the error to the caller.
+     */
+    vg_lite_error_t (*on_call)(const struct vg_lite_test_hook_call_s* call, void* user_data);
+
+    /**
+     * Called after the real API returned (or was skipped).
+     */
+    void (*on_return)(const struct vg_lite_test_hook_call_s* call, vg_lite_error_t error, void* user_data);
+
+    void* user_data;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Register a listener for the hooked vg_lite API calls.
+ * @param listener The listener to register, must stay valid until removed.
+ * @return 0 on success, -1 if there are too many listeners.
+ */
+int vg_lite_test_hook_add_listener(const struct vg_lite_test_hook_listener_s* listener);
+
+/**
+ * @brief Unregister a listener.
+ * @param listener The listener to unregister.
+ */
+void vg_lite_test_hook_remove_listener(const struct vg_lite_test_hook_listener_s* listener);
+
+/**
+ * @brief Get the name of a hooked API.
+ * @param api The hooked API.
+ * @return The name of the API.
+ */
+const char* vg_lite_test_hook_api_string(enum vg_lite_test_hook_api_e api);
+
+vg_lite_error_t vg_lite_test_hook_clear(
+    vg_lite_buffer_t* target,
+    vg_lite_rectangle_t* rect,
+    vg_lite_color_t color);
+
+vg_lite_error_t vg_lite_test_hook_blit(
+    vg_lite_buffer_t* target,
+    vg_lite_buffer_t* source,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter);
+
+vg_lite_error_t vg_lite_test_hook_blit_rect(
+    vg_lite_buffer_t* target,
+    vg_lite_buffer_t* source,
+    vg_lite_rectangle_t* rect,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter);
+
+vg_lite_error_t vg_lite_test_hook_draw(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* matrix,
+    vg_lite_blend_t blend,
+    vg_lite_color_t color);
+
+vg_lite_error_t vg_lite_test_hook_draw_pattern(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_buffer_t* pattern_image,
+    vg_lite_matrix_t* pattern_matrix,
+    vg_lite_blend_t blend,
+    vg_lite_pattern_mode_t pattern_mode,
+    vg_lite_color_t pattern_color,
+    vg_lite_color_t color,
+    vg_lite_filter_t filter);
+
+vg_lite_error_t vg_lite_test_hook_draw_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* matrix,
+    vg_lite_linear_gradient_t* grad,
+    vg_lite_blend_t blend);
+
+vg_lite_error_t vg_lite_test_hook_draw_linear_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_ext_linear_gradient_t* grad,
+    vg_lite_color_t paint_color,
+    vg_lite_blend_t blend,
+    vg_lite_filter_t filter);
+
+vg_lite_error_t vg_lite_test_hook_draw_radial_grad(
+    vg_lite_buffer_t* target,
+    vg_lite_path_t* path,
+    vg_lite_fill_t fill_rule,
+    vg_lite_matrix_t* path_matrix,
+    vg_lite_radial_gradient_t* grad,
+    vg_lite_color_t paint_color,
+    vg_lite_blend_t blend,
+    vg_lite_filter_t filter);
+
+vg_lite_error_t vg_lite_test_hook_set_scissor(
+    vg_lite_int32_t x,
+    vg_lite_int32_t y,
+    vg_lite_int32_t right,
+    vg_lite_int32_t bottom);
+
+vg_lite_error_t vg_lite_test_hook_enable_scissor(void);
+
+vg_lite_error_t vg_lite_test_hook_disable_scissor(void);
+
+vg_lite_error_t vg_lite_test_hook_set_CLUT(vg_lite_uint32_t count, vg_lite_uint32_t* colors);
+
+vg_lite_error_t vg_lite_test_hook_gaussian_filter(vg_lite_float_t w0, vg_lite_float_t w1, vg_lite_float_t w2);
+
+vg_lite_error_t vg_lite_test_hook_flush(void);
+
+vg_lite_error_t vg_lite_test_hook_finish(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**
+ * Route the vg_lite calls of every source that includes this header through
+ * the hooks above. The hook implementation itself calls the real API.
+ */
+#ifndef VG_LITE_TEST_HOOK_IMPL
+#define vg_lite_clear vg_lite_test_hook_clear
+#define vg_lite_blit vg_lite_test_hook_blit
+#define vg_lite_blit_rect vg_lite_test_hook_blit_rect
+#define vg_lite_draw vg_lite_test_hook_draw
+#define vg_lite_draw_pattern vg_lite_test_hook_draw_pattern
+#define vg_lite_draw_grad vg_lite_test_hook_draw_grad
+#define vg_lite_draw_linear_grad vg_lite_test_hook_draw_linear_grad
+#define vg_lite_draw_radial_grad vg_lite_test_hook_draw_radial_grad
+#define vg_lite_set_scissor vg_lite_test_hook_set_scissor
+#define vg_lite_enable_scissor vg_lite_test_hook_enable_scissor
+#define vg_lite_disable_scissor vg_lite_test_hook_disable_scissor
+#define vg_lite_set_CLUT vg_lite_test_hook_set_CLUT
+#define vg_lite_gaussian_filter vg_lite_test_hook_gaussian_filter
+#define vg_lite_flush vg_lite_test_hook_flush
+#define vg_lite_finish vg_lite_test_hook_finish
+#endif /* VG_LITE_TEST_HOOK_IMPL */
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_HOOK_H*/
@@ -0,0 +1,245 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#ifdef VG_LITE_TEST_LATENCY_ENABLE
+
+#include "vg_lite_test_latency.h"
+#include "../gpu_assert.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_recorder.h"
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Each power of two range is split into 2^3 buckets, the error is below 12.5% */
+#define LATENCY_SUB_BUCKET_BITS 3
+#define LATENCY_SUB_BUCKET_COUNT (1 << LATENCY_SUB_BUCKET_BITS)
+
+/* Values below this are counted exactly */
+#define LATENCY_LINEAR_MAX (LATENCY_SUB_BUCKET_COUNT * 2)
+#define LATENCY_LINEAR_BITS (LATENCY_SUB_BUCKET_BITS + 1)
+
+#define LATENCY_BUCKET_COUNT (LATENCY_LINEAR_MAX + (32 - LATENCY_LINEAR_BITS) * LATENCY_SUB_BUCKET_COUNT)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_latency_hist_s {
+    uint32_t count;
+    uint32_t max;
+    uint64_t total;
+    uint32_t buckets[LATENCY_BUCKET_COUNT];
+};
+
+struct vg_lite_test_latency_s {
+    struct gpu_recorder_s* recorder;
+    bool started;
+    struct vg_lite_test_latency_hist_s item[_VG_LITE_TEST_HOOK_API_LAST];
+    struct vg_lite_test_latency_hist_s run[_VG_LITE_TEST_HOOK_API_LAST];
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static uint32_t latency_bucket_index(uint32_t value);
+static uint32_t latency_bucket_upper(uint32_t index);
+static uint32_t latency_percentile(const struct vg_lite_test_latency_hist_s* hist, uint32_t permille);
+static void latency_hist_merge(struct vg_lite_test_latency_hist_s* dest, const struct vg_lite_test_latency_hist_s* src);
+static void latency_write(const char* name, const struct vg_lite_test_latency_hist_s* hists, bool log);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static struct vg_lite_test_latency_s g_latency;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void vg_lite_test_latency_start(const char* output_dir)
+{
+    memset(&g_latency, 0, sizeof(g_latency));
+    g_latency.recorder = gpu_recorder_create(output_dir, "vg_lite_latency");
+    g_latency.started = true;
+
+    if (g_latency.recorder) {
+        gpu_recorder_write_string(g_latency.recorder,
+            "Testcase,API,Count,Total(ms),Mean(us),P50(us),P99(us),Max(us)\n");
+    }
+}
+
+void vg_lite_test_latency_stop(void)
+{
+    if (!g_latency.started) {
+        return;
+    }
+
+    latency_write("TOTAL", g_latency.run, true);
+
+    if (g_latency.recorder) {
+        gpu_recorder_delete(g_latency.recorder);
+    }
+
+    memset(&g_latency, 0, sizeof(g_latency));
+}
+
+void vg_lite_test_latency_item_begin(void)
+{
+    memset(g_latency.item, 0, sizeof(g_latency.item));
+}
+
+void vg_lite_test_latency_item_end(const char* name)
+{
+    if (!g_latency.started) {
+        return;
+    }
+
+    latency_write(name, g_latency.item, false);
+
+    for (int i = 0; i < _VG_LITE_TEST_HOOK_API_LAST; i++) {
+        latency_hist_merge(&g_latency.run[i], &g_latency.item[i]);
+    }
+}
+
+void vg_lite_test_latency_record(enum vg_lite_test_hook_api_e api, uint32_t elaps_us)
+{
+    struct vg_lite_test_latency_hist_s* hist = &g_latency.item[api];
+    hist->count++;
+    hist->total += elaps_us;
+    hist->max = MATH_MAX(hist->max, elaps_us);
+    hist->buckets[latency_bucket_index(elaps_us)]++;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t latency_bucket_index(uint32_t value)
+{
+    if (value < LATENCY_LINEAR_MAX) {
+        return value;
+    }
+
+    uint32_t msb = LATENCY_LINEAR_BITS;
+    while (msb < 31 && (value >> (msb + 1))) {
+        msb++;
+    }
+
+    uint32_t shift = msb - LATENCY_SUB_BUCKET_BITS;
+    uint32_t sub = (value >> shift) & (LATENCY_SUB_BUCKET_COUNT - 1);
+    return LATENCY_LINEAR_MAX + (msb - LATENCY_LINEAR_BITS) * LATENCY_SUB_BUCKET_COUNT + sub;
+}
+
+static uint32_t latency_bucket_upper(uint32_t index)
+{
+    if (index < LATENCY_LINEAR_MAX) {
+        return index;
+    }
+
+    uint32_t msb = (index - LATENCY_LINEAR_MAX) / LATENCY_SUB_BUCKET_COUNT + LATENCY_LINEAR_BITS;
+    uint32_t sub = (index - LATENCY_LINEAR_MAX) % LATENCY_SUB_BUCKET_COUNT;
+    uint32_t shift = msb - LATENCY_SUB_BUCKET_BITS;
+    uint32_t lower = (LATENCY_SUB_BUCKET_COUNT + sub) << shift;
+    return lower + ((1u << shift) - 1);
+}
+
+static uint32_t latency_percentile(const struct vg_lite_test_latency_hist_s* hist, uint32_t permille)
+{
+    if (hist->count == 0) {
+        return 0;
+    }
+
+    /* Rank of the sample, rounded up */
+    uint64_t rank = ((uint64_t)hist->count * permille + 999) / 1000;
+    uint64_t seen = 0;
+
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        seen += hist->buckets[i];
+        if (seen >= rank) {
+            /* The bucket bound may be above the largest sample */
+            return MATH_MIN(latency_bucket_upper(i), hist->max);
+        }
+    }
+
+    return hist->max;
+}
+
+static void latency_hist_merge(struct vg_lite_test_latency_hist_s* dest, const struct vg_lite_test_latency_hist_s* src)
+{
+    if (src->count == 0) {
+        return;
+    }
+
+    dest->count += src->count;
+    dest->total += src->total;
+    dest->max = MATH_MAX(dest->max, src->max);
+
+    for (uint32_t i = 0; i < LATENCY_BUCKET_COUNT; i++) {
+        dest->buckets[i] += src->buckets[i];
+    }
+}
+
+static void latency_write(const char* name, const struct vg_lite_test_latency_hist_s* hists, bool log)
+{
+    for (int api = 0; api < _VG_LITE_TEST_HOOK_API_LAST; api++) {
+        const struct vg_lite_test_latency_hist_s* hist = &hists[api];
+        if (hist->count == 0) {
+            continue;
+        }
+
+        uint32_t p50 = latency_percentile(hist, 500);
+        uint32_t p99 = latency_percentile(hist, 990);
+        double mean = (double)hist->total / hist->count;
+
+        if (log) {
+            GPU_LOG_INFO("%s %s: count %" PRIu32 ", total %0.3f ms, mean %0.1f us, p50 %" PRIu32 " us, p99 %" PRIu32 " us, max %" PRIu32 " us",
+                name, vg_lite_test_hook_api_string(api), hist->count, hist->total / 1000.0, mean, p50, p99, hist->max);
+        }
+
+        if (g_latency.recorder) {
+            char result[192];
+            snprintf(result, sizeof(result), "%s,%s,%" PRIu32 ",%0.3f,%0.1f,%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\n",
+                name, vg_lite_test_hook_api_string(api), hist->count, hist->total / 1000.0, mean, p50, p99, hist->max);
+            gpu_recorder_write_string(g_latency.recorder, result);
+        }
+    }
+}
+
+#endif /* VG_LITE_TEST_LATENCY_ENABLE */
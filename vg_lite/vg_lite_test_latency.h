@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_LATENCY_H
+#define VG_LITE_TEST_LATENCY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_hook.h"
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+#ifdef VG_LITE_TEST_LATENCY_ENABLE
+
+/**
+ * @brief Start collecting the latency of the hooked vg_lite calls.
+ * @param output_dir The directory of the latency report.
+ */
+void vg_lite_test_latency_start(const char* output_dir);
+
+/**
+ * @brief Write the latency of the whole run to the log and the report, then stop collecting.
+ */
+void vg_lite_test_latency_stop(void);
+
+/**
+ * @brief Clear the latency histograms of the current test case item.
+ */
+void vg_lite_test_latency_item_begin(void);
+
+/**
+ * @brief Write the latency of the current test case item to the report and merge it into the run.
+ * @param name The name of the test case item.
+ */
+void vg_lite_test_latency_item_end(const char* name);
+
+/**
+ * @brief Record the latency of a real vg_lite call, called by the hook layer.
+ * @param api The called API.
+ * @param elaps_us The time spent in the call in microseconds.
+ */
+void vg_lite_test_latency_record(enum vg_lite_test_hook_api_e api, uint32_t elaps_us);
+
+#else
+
+/* Compiled out, the hook layer does not take the timestamps either */
+#define vg_lite_test_latency_start(output_dir)
+#define vg_lite_test_latency_stop()
+#define vg_lite_test_latency_item_begin()
+#define vg_lite_test_latency_item_end(name)
+
+#endif /* VG_LITE_TEST_LATENCY_ENABLE */
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_LATENCY_H*/
@@ -0,0 +1,1559 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_ref.h"
+#include "../gpu_assert.h"
+#include "../gpu_buffer.h"
+#include "../gpu_cache.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "vg_lite_test_hook.h"
+#include "vg_lite_test_ref_raster.h"
+#include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define REF_THREAD_MAX 8
+#define REF_BAND_HEIGHT 16
+#define REF_GRAD_LUT_SIZE 256
+#define REF_CLUT_SIZE 256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum ref_paint_type_e {
+    REF_PAINT_COLOR,
+    REF_PAINT_IMAGE,
+    REF_PAINT_RAMP,
+    REF_PAINT_LINEAR,
+    REF_PAINT_RADIAL,
+};
+
+struct ref_image_s {
+    const uint8_t* memory;
+    const struct gpu_buffer_s* shadow;
+    vg_lite_buffer_format_t format;
+    int32_t stride;
+    bool tiled;
+    bool premultiplied;
+
+    /* Sampled area, the full image or the rectangle of blit_rect */
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+};
+
+struct ref_paint_s {
+    enum ref_paint_type_e type;
+
+    /* Premultiplied BGRA8888 */
+    uint32_t color;
+
+    /* Target pixel center to paint space */
+    float inv[3][3];
+
+    struct ref_image_s image;
+    vg_lite_filter_t filter;
+    vg_lite_pattern_mode_t pattern_mode;
+    uint32_t pattern_color;
+    bool multiply;
+    uint32_t multiply_color;
+
+    uint32_t lut[REF_GRAD_LUT_SIZE];
+    vg_lite_gradient_spreadmode_t spread;
+    vg_lite_linear_gradient_parameter_t linear;
+    vg_lite_radial_gradient_parameter_t radial;
+};
+
+struct ref_surface_s {
+    void* memory;
+    vg_lite_buffer_format_t format;
+    struct gpu_buffer_s* image;
+};
+
+struct ref_op_s {
+    struct ref_surface_s* surface;
+    vg_lite_fill_t fill_rule;
+    int32_t samples;
+    vg_lite_blend_t blend;
+    struct ref_paint_s paint;
+    int32_t clip_x0;
+    int32_t clip_y0;
+    int32_t clip_x1;
+    int32_t clip_y1;
+};
+
+struct ref_worker_s {
+    struct vg_lite_test_ref_s* ref;
+    pthread_t thread;
+    struct vg_lite_test_ref_scanline_s scanline;
+    uint8_t* coverage;
+    uint32_t* colors;
+};
+
+struct vg_lite_test_ref_s {
+    struct vg_lite_test_hook_listener_s listener;
+    bool active;
+    char unsupported[64];
+
+    struct ref_surface_s* surfaces;
+    uint32_t surface_count;
+
+    /* The GPU keeps these states across the items, so does the renderer */
+    bool scissor_en;
+    int32_t scissor[4];
+    uint32_t clut[4][REF_CLUT_SIZE];
+    int32_t gaussian[3];
+
+    struct vg_lite_test_ref_raster_s raster;
+    struct ref_op_s op;
+
+    /* Worker 0 is the calling thread */
+    struct ref_worker_s workers[REF_THREAD_MAX];
+    int worker_count;
+    int32_t width;
+    pthread_mutex_t lock;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;
+    uint32_t generation;
+    int32_t next_row;
+    int32_t end_row;
+    int running;
+    bool exit;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static vg_lite_error_t ref_on_call(const struct vg_lite_test_hook_call_s* call, void* user_data);
+static void ref_set_unsupported(struct vg_lite_test_ref_s* ref, const char* reason);
+static struct ref_surface_s* ref_surface_get(struct vg_lite_test_ref_s* ref, const vg_lite_buffer_t* buffer);
+static void ref_surface_clear(struct vg_lite_test_ref_s* ref);
+static bool ref_format_bits(vg_lite_buffer_format_t format, int32_t* bits);
+static uint32_t ref_decode(const struct vg_lite_test_ref_s* ref, const uint8_t* memory, int32_t stride, vg_lite_buffer_format_t format, bool tiled, int32_t x, int32_t y);
+static uint32_t ref_quantize(uint32_t color, vg_lite_buffer_format_t format);
+static uint32_t ref_color_to_bgra(vg_lite_color_t color);
+static uint32_t ref_premultiply(uint32_t color);
+static uint32_t ref_mul(uint32_t color, uint32_t factor);
+static uint32_t ref_mul_color(uint32_t a, uint32_t b);
+static bool ref_matrix_invert(const vg_lite_matrix_t* m, float inv[3][3]);
+static void ref_matrix_multiply(const vg_lite_matrix_t* a, const vg_lite_matrix_t* b, vg_lite_matrix_t* result);
+static int32_t ref_quality_samples(vg_lite_quality_t quality);
+static void ref_do_clear(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call);
+static void ref_do_blit(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call);
+static void ref_do_draw(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call);
+static void ref_do_draw_pattern(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call);
+static void ref_do_draw_grad(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call);
+static void ref_do_draw_ext_grad(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call);
+static bool ref_op_begin(struct vg_lite_test_ref_s* ref, vg_lite_buffer_t* target, vg_lite_blend_t blend);
+static bool ref_image_init(struct vg_lite_test_ref_s* ref, struct ref_image_s* image, vg_lite_buffer_t* buffer);
+static void ref_grad_lut_init(uint32_t* lut, const vg_lite_color_ramp_t* ramp, uint32_t count, bool pre_multiplied);
+static void ref_op_run(struct vg_lite_test_ref_s* ref);
+static void* ref_worker_thread(void* arg);
+static void ref_worker_run(struct ref_worker_s* worker);
+static void ref_render_band(struct ref_worker_s* worker, int32_t y_start, int32_t y_end);
+static void ref_paint_row(const struct vg_lite_test_ref_s* ref, const struct ref_paint_s* paint, int32_t y, int32_t x_start, int32_t x_end, uint32_t* colors);
+static uint32_t ref_image_sample(const struct vg_lite_test_ref_s* ref, const struct ref_paint_s* paint, float u, float v);
+static uint32_t ref_image_texel(const struct vg_lite_test_ref_s* ref, const struct ref_paint_s* paint, int32_t x, int32_t y);
+static uint32_t ref_grad_lookup(const struct ref_paint_s* paint, float t);
+static void ref_blend_row(const struct ref_op_s* op, uint32_t* dest, const uint32_t* colors, const uint8_t* coverage, int32_t x_start, int32_t x_end);
+static uint8_t ref_blend_channel(vg_lite_blend_t blend, uint32_t s, uint32_t sa, uint32_t d, uint32_t da, bool is_alpha);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/* Exact round(x / 255) for x in [0, 65535] */
+#define REF_DIV255(x) ((((x) + 128) + (((x) + 128) >> 8)) >> 8)
+
+#define REF_CH(c, shift) (((c) >> (shift)) & 0xFF)
+#define REF_BGRA(b, g, r, a) ((uint32_t)(b) | ((uint32_t)(g) << 8) | ((uint32_t)(r) << 16) | ((uint32_t)(a) << 24))
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct vg_lite_test_ref_s* vg_lite_test_ref_create(int thread_count)
+{
+    struct vg_lite_test_ref_s* ref = malloc(sizeof(struct vg_lite_test_ref_s));
+    GPU_ASSERT_NULL(ref);
+    memset(ref, 0, sizeof(struct vg_lite_test_ref_s));
+
+    if (thread_count <= VG_LITE_TEST_REF_THREAD_AUTO) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = cpus > 0 ? (int)cpus : 1;
+    }
+
+    ref->worker_count = MATH_CLAMP(thread_count, 1, REF_THREAD_MAX);
+
+    /* Until vg_lite_gaussian_filter is called the kernel keeps the center only */
+    ref->gaussian[0] = 256;
+    vg_lite_test_ref_raster_init(&ref->raster);
+
+    pthread_mutex_init(&ref->lock, NULL);
+    pthread_cond_init(&ref->start_cond, NULL);
+    pthread_cond_init(&ref->done_cond, NULL);
+
+    for (int i = 0; i < ref->worker_count; i++) {
+        ref->workers[i].ref = ref;
+    }
+
+    /* The calling thread works too, only the others need a thread */
+    for (int i = 1; i < ref->worker_count; i++) {
+        int ret = pthread_create(&ref->workers[i].thread, NULL, ref_worker_thread, &ref->workers[i]);
+        if (ret != 0) {
+            GPU_LOG_WARN("Create render thread %d failed: %d", i, ret);
+            ref->worker_count = i;
+            break;
+        }
+    }
+
+    ref->listener.on_call = ref_on_call;
+    ref->listener.user_data = ref;
+    if (vg_lite_test_hook_add_listener(&ref->listener) != 0) {
+        GPU_LOG_ERROR("Register reference renderer failed");
+    }
+
+    GPU_LOG_INFO("Reference renderer created with %d threads", ref->worker_count);
+    return ref;
+}
+
+void vg_lite_test_ref_destroy(struct vg_lite_test_ref_s* ref)
+{
+    GPU_ASSERT_NULL(ref);
+    vg_lite_test_hook_remove_listener(&ref->listener);
+
+    pthread_mutex_lock(&ref->lock);
+    ref->exit = true;
+    pthread_cond_broadcast(&ref->start_cond);
+    pthread_mutex_unlock(&ref->lock);
+
+    for (int i = 1; i < ref->worker_count; i++) {
+        pthread_join(ref->workers[i].thread, NULL);
+    }
+
+    for (int i = 0; i < ref->worker_count; i++) {
+        struct ref_worker_s* worker = &ref->workers[i];
+        if (worker->scanline.cells) {
+            vg_lite_test_ref_scanline_deinit(&worker->scanline);
+        }
+        free(worker->coverage);
+        free(worker->colors);
+    }
+
+    pthread_cond_destroy(&ref->done_cond);
+    pthread_cond_destroy(&ref->start_cond);
+    pthread_mutex_destroy(&ref->lock);
+
+    ref_surface_clear(ref);
+    free(ref->surfaces);
+    vg_lite_test_ref_raster_deinit(&ref->raster);
+
+    memset(ref, 0, sizeof(struct vg_lite_test_ref_s));
+    free(ref);
+}
+
+void vg_lite_test_ref_item_begin(struct vg_lite_test_ref_s* ref)
+{
+    GPU_ASSERT_NULL(ref);
+    ref_surface_clear(ref);
+    ref->unsupported[0] = '\0';
+    ref->active = true;
+}
+
+void vg_lite_test_ref_item_end(struct vg_lite_test_ref_s* ref)
+{
+    GPU_ASSERT_NULL(ref);
+    ref->active = false;
+}
+
+struct gpu_buffer_s* vg_lite_test_ref_get_image(struct vg_lite_test_ref_s* ref, const vg_lite_buffer_t* buffer)
+{
+    GPU_ASSERT_NULL(ref);
+    GPU_ASSERT_NULL(buffer);
+
+    for (uint32_t i = 0; i < ref->surface_count; i++) {
+        if (ref->surfaces[i].memory == buffer->memory) {
+            return ref->surfaces[i].image;
+        }
+    }
+
+    return NULL;
+}
+
+const char* vg_lite_test_ref_get_unsupported(struct vg_lite_test_ref_s* ref)
+{
+    GPU_ASSERT_NULL(ref);
+    return ref->unsupported[0] ? ref->unsupported : NULL;
+}
+
+bool vg_lite_test_ref_compare(
+    struct gpu_buffer_s* buffer,
+    struct gpu_buffer_s* ref_image,
+    int tolerance,
+    int max_mismatch_permille,
+    char* remark,
+    size_t remark_size)
+{
+    GPU_ASSERT_NULL(buffer);
+    GPU_ASSERT_NULL(ref_image);
+    GPU_ASSERT_NULL(remark);
+
+    if (buffer->width != ref_image->width || buffer->height != ref_image->height) {
+        snprintf(remark, remark_size, "Size not matched: W%dxH%d vs W%dxH%d",
+            (int)buffer->width, (int)buffer->height,
+            (int)ref_image->width, (int)ref_image->height);
+        return false;
+    }
+
+    uint32_t mismatch = 0;
+    int max_diff = 0;
+    int first_x = -1;
+    int first_y = -1;
+    gpu_color_bgra8888_t first_pixel = { 0 };
+    gpu_color_bgra8888_t first_ref_pixel = { 0 };
+
+    for (uint32_t y = 0; y < buffer->height; y++) {
+        for (uint32_t x = 0; x < buffer->width; x++) {
+            gpu_color_bgra8888_t pixel;
+            pixel.full = gpu_buffer_get_pixel(buffer, x, y);
+
+            gpu_color_bgra8888_t ref_pixel;
+            ref_pixel.full = gpu_buffer_get_pixel(ref_image, x, y);
+
+            /* Skip checking alpha channel */
+            int diff = MATH_MAX(
+                MATH_MAX(MATH_ABS(pixel.ch.red - ref_pixel.ch.red), MATH_ABS(pixel.ch.green - ref_pixel.ch.green)),
+                MATH_ABS(pixel.ch.blue - ref_pixel.ch.blue));
+
+            max_diff = MATH_MAX(max_diff, diff);
+            if (diff <= tolerance) {
+                continue;
+            }
+
+            if (mismatch == 0) {
+                first_x = x;
+                first_y = y;
+                first_pixel = pixel;
+                first_ref_pixel = ref_pixel;
+            }
+
+            mismatch++;
+        }
+    }
+
+    uint32_t total = buffer->width * buffer->height;
+    bool passed = (uint64_t)mismatch * 1000 <= (uint64_t)total * max_mismatch_permille;
+
+    if (mismatch == 0) {
+        snprintf(remark, remark_size, "SUCCESS (max diff %d)", max_diff);
+    } else {
+        snprintf(remark, remark_size,
+            "%s: %" PRIu32 "/%" PRIu32 " pixels over tolerance %d (max diff %d) "
+            "first in (X%d Y%d) 0x%08" PRIX32 " vs ref 0x%08" PRIX32,
+            passed ? "SUCCESS" : "Pixel not match",
+            mismatch, total, tolerance, max_diff,
+            first_x, first_y, first_pixel.full, first_ref_pixel.full);
+    }
+
+    return passed;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static vg_lite_error_t ref_on_call(const struct vg_lite_test_hook_call_s* call, void* user_data)
+{
+    struct vg_lite_test_ref_s* ref = user_data;
+
+    switch (call->api) {
+    case VG_LITE_TEST_HOOK_API_SET_SCISSOR:
+        ref->scissor[0] = call->args.set_scissor.x;
+        ref->scissor[1] = call->args.set_scissor.y;
+        ref->scissor[2] = call->args.set_scissor.right;
+        ref->scissor[3] = call->args.set_scissor.bottom;
+        ref->scissor_en = true;
+        return VG_LITE_SUCCESS;
+
+    case VG_LITE_TEST_HOOK_API_ENABLE_SCISSOR:
+        ref->scissor_en = true;
+        return VG_LITE_SUCCESS;
+
+    case VG_LITE_TEST_HOOK_API_DISABLE_SCISSOR:
+        ref->scissor_en = false;
+        return VG_LITE_SUCCESS;
+
+    case VG_LITE_TEST_HOOK_API_SET_CLUT: {
+        /* One table per index depth, selected by the entry count */
+        uint32_t count = call->args.set_clut.count;
+        int index = count <= 2 ? 0 : count <= 4 ? 1 : count <= 16 ? 2 : 3;
+        memset(ref->clut[index], 0, sizeof(ref->clut[index]));
+        memcpy(ref->clut[index], call->args.set_clut.colors, MATH_MIN(count, REF_CLUT_SIZE) * sizeof(uint32_t));
+        return VG_LITE_SUCCESS;
+    }
+
+    case VG_LITE_TEST_HOOK_API_GAUSSIAN_FILTER:
+        ref->gaussian[0] = (int32_t)(call->args.gaussian_filter.w0 * 256 + 0.5f);
+        ref->gaussian[1] = (int32_t)(call->args.gaussian_filter.w1 * 256 + 0.5f);
+        ref->gaussian[2] = (int32_t)(call->args.gaussian_filter.w2 * 256 + 0.5f);
+        return VG_LITE_SUCCESS;
+
+    default:
+        break;
+    }
+
+    if (!ref->active) {
+        return VG_LITE_SUCCESS;
+    }
+
+    switch (call->api) {
+    case VG_LITE_TEST_HOOK_API_CLEAR:
+        ref_do_clear(ref, call);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_BLIT:
+    case VG_LITE_TEST_HOOK_API_BLIT_RECT:
+        ref_do_blit(ref, call);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW:
+        ref_do_draw(ref, call);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_PATTERN:
+        ref_do_draw_pattern(ref, call);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_GRAD:
+        ref_do_draw_grad(ref, call);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_LINEAR_GRAD:
+    case VG_LITE_TEST_HOOK_API_DRAW_RADIAL_GRAD:
+        ref_do_draw_ext_grad(ref, call);
+        break;
+
+    default:
+        break;
+    }
+
+    /* Never change what the GPU is asked to do */
+    return VG_LITE_SUCCESS;
+}
+
+static void ref_set_unsupported(struct vg_lite_test_ref_s* ref, const char* reason)
+{
+    if (ref->unsupported[0]) {
+        return;
+    }
+
+    snprintf(ref->unsupported, sizeof(ref->unsupported), "%s", reason);
+    GPU_LOG_WARN("Reference renderer: %s", reason);
+}
+
+static struct ref_surface_s* ref_surface_get(struct vg_lite_test_ref_s* ref, const vg_lite_buffer_t* buffer)
+{
+    for (uint32_t i = 0; i < ref->surface_count; i++) {
+        struct ref_surface_s* surface = &ref->surfaces[i];
+        if (surface->memory == buffer->memory) {
+            if (surface->format == buffer->format
+                && surface->image->width == (uint32_t)buffer->width
+                && surface->image->height == (uint32_t)buffer->height) {
+                return surface;
+            }
+
+            /* Same memory reused as another buffer, start over from its content */
+            gpu_buffer_free(surface->image);
+            ref->surfaces[i] = ref->surfaces[--ref->surface_count];
+            break;
+        }
+    }
+
+    int32_t bits;
+    if (!ref_format_bits(buffer->format, &bits) || buffer->format == VG_LITE_L8 || bits < 8
+        || (buffer->format >= VG_LITE_INDEX_1 && buffer->format <= VG_LITE_INDEX_8)) {
+        char reason[64];
+        snprintf(reason, sizeof(reason), "Target format %s", vg_lite_test_buffer_format_string(buffer->format));
+        ref_set_unsupported(ref, reason);
+        return NULL;
+    }
+
+    ref->surfaces = realloc(ref->surfaces, (ref->surface_count + 1) * sizeof(struct ref_surface_s));
+    GPU_ASSERT_NULL(ref->surfaces);
+
+    struct ref_surface_s* surface = &ref->surfaces[ref->surface_count++];
+    surface->memory = buffer->memory;
+    surface->format = buffer->format;
+    surface->image = gpu_buffer_alloc(buffer->width, buffer->height, GPU_COLOR_FORMAT_BGRA8888, buffer->width * sizeof(uint32_t), 64);
+    GPU_ASSERT_NULL(surface->image);
+
+    /* Start from what the buffer holds, the GPU blends over it too */
+    gpu_cache_invalidate(buffer->memory, buffer->stride * buffer->height);
+    for (int32_t y = 0; y < buffer->height; y++) {
+        uint32_t* row = (uint32_t*)((uint8_t*)surface->image->data + y * surface->image->stride);
+        for (int32_t x = 0; x < buffer->width; x++) {
+            row[x] = ref_decode(ref, buffer->memory, buffer->stride, buffer->format, buffer->tiled == VG_LITE_TILED, x, y);
+        }
+    }
+
+    return surface;
+}
+
+static void ref_surface_clear(struct vg_lite_test_ref_s* ref)
+{
+    for (uint32_t i = 0; i < ref->surface_count; i++) {
+        gpu_buffer_free(ref->surfaces[i].image);
+    }
+
+    ref->surface_count = 0;
+}
+
+static bool ref_format_bits(vg_lite_buffer_format_t format, int32_t* bits)
+{
+    switch (format) {
+    case VG_LITE_BGRA8888:
+    case VG_LITE_BGRX8888:
+    case VG_LITE_RGBA8888:
+    case VG_LITE_RGBX8888:
+    case VG_LITE_ARGB8888:
+    case VG_LITE_XRGB8888:
+    case VG_LITE_ABGR8888:
+    case VG_LITE_XBGR8888:
+        *bits = 32;
+        return true;
+
+    case VG_LITE_BGR888:
+    case VG_LITE_RGB888:
+    case VG_LITE_BGRA5658:
+    case VG_LITE_RGBA5658:
+    case VG_LITE_ABGR8565:
+    case VG_LITE_ARGB8565:
+        *bits = 24;
+        return true;
+
+    case VG_LITE_BGR565:
+    case VG_LITE_RGB565:
+        *bits = 16;
+        return true;
+
+    case VG_LITE_A8:
+    case VG_LITE_L8:
+    case VG_LITE_INDEX_8:
+        *bits = 8;
+        return true;
+
+    case VG_LITE_A4:
+    case VG_LITE_INDEX_4:
+        *bits = 4;
+        return true;
+
+    case VG_LITE_INDEX_2:
+        *bits = 2;
+        return true;
+
+    case VG_LITE_INDEX_1:
+        *bits = 1;
+        return true;
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+static uint32_t ref_decode(const struct vg_lite_test_ref_s* ref, const uint8_t* memory, int32_t stride, vg_lite_buffer_format_t format, bool tiled, int32_t x, int32_t y)
+{
+    int32_t bits = 0;
+    ref_format_bits(format, &bits);
+
+    const uint8_t* p;
+    uint32_t index = 0;
+    if (bits < 8) {
+        /* Packed pixels start from the least significant bits */
+        int32_t bit = x * bits;
+        index = (memory[y * stride + bit / 8] >> (bit % 8)) & ((1 << bits) - 1);
+        p = NULL;
+    } else if (tiled) {
+        /* 4x4 pixel tiles, a row of tiles spans 4 lines of the stride */
+        int32_t bytes = bits / 8;
+        p = memory + (y & ~3) * stride + ((x & ~3) * 4 + (y & 3) * 4 + (x & 3)) * bytes;
+    } else {
+        p = memory + y * stride + x * (bits / 8);
+    }
+
+    switch (format) {
+    case VG_LITE_BGRA8888:
+        return REF_BGRA(p[0], p[1], p[2], p[3]);
+    case VG_LITE_BGRX8888:
+        return REF_BGRA(p[0], p[1], p[2], 0xFF);
+    case VG_LITE_RGBA8888:
+        return REF_BGRA(p[2], p[1], p[0], p[3]);
+    case VG_LITE_RGBX8888:
+        return REF_BGRA(p[2], p[1], p[0], 0xFF);
+    case VG_LITE_ARGB8888:
+        return REF_BGRA(p[3], p[2], p[1], p[0]);
+    case VG_LITE_XRGB8888:
+        return REF_BGRA(p[3], p[2], p[1], 0xFF);
+    case VG_LITE_ABGR8888:
+        return REF_BGRA(p[1], p[2], p[3], p[0]);
+    case VG_LITE_XBGR8888:
+        return REF_BGRA(p[1], p[2], p[3], 0xFF);
+    case VG_LITE_BGR888:
+        return REF_BGRA(p[0], p[1], p[2], 0xFF);
+    case VG_LITE_RGB888:
+        return REF_BGRA(p[2], p[1], p[0], 0xFF);
+
+    case VG_LITE_BGR565:
+    case VG_LITE_RGB565:
+    case VG_LITE_BGRA5658:
+    case VG_LITE_RGBA5658:
+    case VG_LITE_ABGR8565:
+    case VG_LITE_ARGB8565: {
+        bool alpha_first = format == VG_LITE_ABGR8565 || format == VG_LITE_ARGB8565;
+        const uint8_t* c = alpha_first ? p + 1 : p;
+        uint32_t v = c[0] | (c[1] << 8);
+        uint32_t lo = ((v & 0x1F) * 527 + 23) >> 6;
+        uint32_t mid = (((v >> 5) & 0x3F) * 259 + 33) >> 6;
+        uint32_t hi = ((v >> 11) * 527 + 23) >> 6;
+        uint32_t alpha = 0xFF;
+        if (format != VG_LITE_BGR565 && format != VG_LITE_RGB565) {
+            alpha = alpha_first ? p[0] : p[2];
+        }
+
+        /* BGR variants keep blue in the low bits */
+        bool bgr = format == VG_LITE_BGR565 || format == VG_LITE_BGRA5658 || format == VG_LITE_ABGR8565;
+        return bgr ? REF_BGRA(lo, mid, hi, alpha) : REF_BGRA(hi, mid, lo, alpha);
+    }
+
+    case VG_LITE_A8:
+        return REF_BGRA(0, 0, 0, p[0]);
+    case VG_LITE_L8:
+        return REF_BGRA(p[0], p[0], p[0], 0xFF);
+    case VG_LITE_A4:
+        return REF_BGRA(0, 0, 0, index * 0x11);
+
+    case VG_LITE_INDEX_1:
+        return ref->clut[0][index];
+    case VG_LITE_INDEX_2:
+        return ref->clut[1][index];
+    case VG_LITE_INDEX_4:
+        return ref->clut[2][index];
+    case VG_LITE_INDEX_8:
+        return ref->clut[3][p[0]];
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+static uint32_t ref_quantize(uint32_t color, vg_lite_buffer_format_t format)
+{
+    /* Round trip through the precision the GPU can store */
+    switch (format) {
+    case VG_LITE_BGRX8888:
+    case VG_LITE_RGBX8888:
+    case VG_LITE_XRGB8888:
+    case VG_LITE_XBGR8888:
+    case VG_LITE_BGR888:
+    case VG_LITE_RGB888:
+        return color | 0xFF000000;
+
+    case VG_LITE_BGR565:
+    case VG_LITE_RGB565:
+    case VG_LITE_BGRA5658:
+    case VG_LITE_RGBA5658:
+    case VG_LITE_ABGR8565:
+    case VG_LITE_ARGB8565: {
+        uint32_t b = REF_CH(color, 0) >> 3;
+        uint32_t g = REF_CH(color, 8) >> 2;
+        uint32_t r = REF_CH(color, 16) >> 3;
+        uint32_t a = REF_CH(color, 24);
+        if (format == VG_LITE_BGR565 || format == VG_LITE_RGB565) {
+            a = 0xFF;
+        }
+        return REF_BGRA((b * 527 + 23) >> 6, (g * 259 + 33) >> 6, (r * 527 + 23) >> 6, a);
+    }
+
+    case VG_LITE_A8:
+        return color & 0xFF000000;
+
+    default:
+        break;
+    }
+
+    return color;
+}
+
+static uint32_t ref_color_to_bgra(vg_lite_color_t color)
+{
+    /* vg_lite_color_t is 0xAABBGGRR */
+    return REF_BGRA(REF_CH(color, 16), REF_CH(color, 8), REF_CH(color, 0), REF_CH(color, 24));
+}
+
+static uint32_t ref_premultiply(uint32_t color)
+{
+    uint32_t a = REF_CH(color, 24);
+    return (ref_mul(color, a) & 0x00FFFFFF) | (color & 0xFF000000);
+}
+
+static uint32_t ref_mul(uint32_t color, uint32_t factor)
+{
+    /* Two channels per 32-bit lane, each one rounded exactly like REF_DIV255 */
+    uint32_t rb = (color & 0x00FF00FF) * factor + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    uint32_t ag = ((color >> 8) & 0x00FF00FF) * factor + 0x00800080;
+    ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static uint32_t ref_mul_color(uint32_t a, uint32_t b)
+{
+    return REF_BGRA(
+        REF_DIV255(REF_CH(a, 0) * REF_CH(b, 0)),
+        REF_DIV255(REF_CH(a, 8) * REF_CH(b, 8)),
+        REF_DIV255(REF_CH(a, 16) * REF_CH(b, 16)),
+        REF_DIV255(REF_CH(a, 24) * REF_CH(b, 24)));
+}
+
+static bool ref_matrix_invert(const vg_lite_matrix_t* m, float inv[3][3])
+{
+    double a = m->m[0][0], b = m->m[0][1], c = m->m[0][2];
+    double d = m->m[1][0], e = m->m[1][1], f = m->m[1][2];
+    double g = m->m[2][0], h = m->m[2][1], i = m->m[2][2];
+
+    double det = a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
+    if (det > -1e-12 && det < 1e-12) {
+        return false;
+    }
+
+    inv[0][0] = (float)((e * i - f * h) / det);
+    inv[0][1] = (float)((c * h - b * i) / det);
+    inv[0][2] = (float)((b * f - c * e) / det);
+    inv[1][0] = (float)((f * g - d * i) / det);
+    inv[1][1] = (float)((a * i - c * g) / det);
+    inv[1][2] = (float)((c * d - a * f) / det);
+    inv[2][0] = (float)((d * h - e * g) / det);
+    inv[2][1] = (float)((b * g - a * h) / det);
+    inv[2][2] = (float)((a * e - b * d) / det);
+    return true;
+}
+
+static void ref_matrix_multiply(const vg_lite_matrix_t* a, const vg_lite_matrix_t* b, vg_lite_matrix_t* result)
+{
+    vg_lite_matrix_t tmp;
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            tmp.m[row][col] = a->m[row][0] * b->m[0][col]
+                + a->m[row][1] * b->m[1][col]
+                + a->m[row][2] * b->m[2][col];
+        }
+    }
+
+    *result = tmp;
+}
+
+static int32_t ref_quality_samples(vg_lite_quality_t quality)
+{
+    switch (quality) {
+    case VG_LITE_HIGH:
+        return 16;
+    case VG_LITE_UPPER:
+        return 8;
+    case VG_LITE_MEDIUM:
+        return 4;
+    default:
+        break;
+    }
+
+    return 1;
+}
+
+static void ref_do_clear(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call)
+{
+    struct ref_surface_s* surface = ref_surface_get(ref, call->args.clear.target);
+    if (!surface) {
+        return;
+    }
+
+    int32_t x0 = 0;
+    int32_t y0 = 0;
+    int32_t x1 = surface->image->width;
+    int32_t y1 = surface->image->height;
+
+    /* The clear color is written as it is, no blending and no scissor */
+    const vg_lite_rectangle_t* rect = call->args.clear.rect;
+    if (rect) {
+        x0 = MATH_MAX(x0, rect->x);
+        y0 = MATH_MAX(y0, rect->y);
+        x1 = MATH_MIN(x1, rect->x + rect->width);
+        y1 = MATH_MIN(y1, rect->y + rect->height);
+    }
+
+    uint32_t color = ref_quantize(ref_color_to_bgra(call->args.clear.color), surface->format);
+    for (int32_t y = y0; y < y1; y++) {
+        uint32_t* row = (uint32_t*)((uint8_t*)surface->image->data + y * surface->image->stride);
+        for (int32_t x = x0; x < x1; x++) {
+            row[x] = color;
+        }
+    }
+}
+
+static void ref_do_blit(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call)
+{
+    if (!ref_op_begin(ref, call->args.blit.target, call->args.blit.blend)) {
+        return;
+    }
+
+    struct ref_op_s* op = &ref->op;
+    struct ref_paint_s* paint = &op->paint;
+    vg_lite_buffer_t* source = call->args.blit.source;
+    if (!ref_image_init(ref, &paint->image, source)) {
+        return;
+    }
+
+    /* blit_rect draws the source rectangle at the origin of the matrix */
+    const vg_lite_rectangle_t* rect = call->args.blit.rect;
+    if (rect) {
+        paint->image.x = MATH_CLAMP(rect->x, 0, source->width);
+        paint->image.y = MATH_CLAMP(rect->y, 0, source->height);
+        paint->image.width = MATH_CLAMP(rect->width, 0, source->width - paint->image.x);
+        paint->image.height = MATH_CLAMP(rect->height, 0, source->height - paint->image.y);
+    }
+
+    if (paint->image.width == 0 || paint->image.height == 0
+        || !ref_matrix_invert(call->args.blit.matrix, paint->inv)) {
+        return;
+    }
+
+    paint->type = REF_PAINT_IMAGE;
+    paint->filter = call->args.blit.filter;
+    paint->pattern_mode = VG_LITE_PATTERN_PAD;
+    paint->multiply = source->image_mode == VG_LITE_MULTIPLY_IMAGE_MODE;
+    paint->multiply_color = ref_color_to_bgra(call->args.blit.color);
+
+    op->fill_rule = VG_LITE_FILL_NON_ZERO;
+    op->samples = ref_quality_samples(VG_LITE_HIGH);
+    vg_lite_test_ref_raster_add_rect(&ref->raster, paint->image.width, paint->image.height, call->args.blit.matrix);
+    ref_op_run(ref);
+}
+
+static void ref_do_draw(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call)
+{
+    if (!ref_op_begin(ref, call->args.draw.target, call->args.draw.blend)) {
+        return;
+    }
+
+    struct ref_op_s* op = &ref->op;
+    op->paint.type = REF_PAINT_COLOR;
+    op->paint.color = ref_premultiply(ref_color_to_bgra(call->args.draw.color));
+    op->fill_rule = call->args.draw.fill_rule;
+    op->samples = ref_quality_samples(call->args.draw.path->quality);
+    vg_lite_test_ref_raster_add_path(&ref->raster, call->args.draw.path, call->args.draw.matrix);
+    ref_op_run(ref);
+}
+
+static void ref_do_draw_pattern(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call)
+{
+    if (!ref_op_begin(ref, call->args.draw_pattern.target, call->args.draw_pattern.blend)) {
+        return;
+    }
+
+    struct ref_op_s* op = &ref->op;
+    struct ref_paint_s* paint = &op->paint;
+    vg_lite_buffer_t* image = call->args.draw_pattern.pattern_image;
+    if (!ref_image_init(ref, &paint->image, image)
+        || !ref_matrix_invert(call->args.draw_pattern.pattern_matrix, paint->inv)) {
+        return;
+    }
+
+    paint->type = REF_PAINT_IMAGE;
+    paint->filter = call->args.draw_pattern.filter;
+    paint->pattern_mode = call->args.draw_pattern.pattern_mode;
+    paint->pattern_color = ref_premultiply(ref_color_to_bgra(call->args.draw_pattern.pattern_color));
+    paint->multiply = image->image_mode == VG_LITE_MULTIPLY_IMAGE_MODE;
+    paint->multiply_color = ref_color_to_bgra(call->args.draw_pattern.color);
+
+    op->fill_rule = call->args.draw_pattern.fill_rule;
+    op->samples = ref_quality_samples(call->args.draw_pattern.path->quality);
+    vg_lite_test_ref_raster_add_path(&ref->raster, call->args.draw_pattern.path, call->args.draw_pattern.path_matrix);
+    ref_op_run(ref);
+}
+
+static void ref_do_draw_grad(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call)
+{
+    if (!ref_op_begin(ref, call->args.draw_grad.target, call->args.draw_grad.blend)) {
+        return;
+    }
+
+    struct ref_op_s* op = &ref->op;
+    struct ref_paint_s* paint = &op->paint;
+    const vg_lite_linear_gradient_t* grad = call->args.draw_grad.grad;
+
+    /* The ramp runs along the x axis of the gradient matrix, from 0 to 255 */
+    vg_lite_matrix_t matrix;
+    ref_matrix_multiply(call->args.draw_grad.matrix, &grad->matrix, &matrix);
+    if (grad->count == 0 || !ref_matrix_invert(&matrix, paint->inv)) {
+        return;
+    }
+
+    uint32_t count = MATH_MIN(grad->count, VLC_MAX_GRADIENT_STOPS);
+    for (int32_t i = 0; i < REF_GRAD_LUT_SIZE; i++) {
+        uint32_t k = 0;
+        while (k < count && (int32_t)grad->stops[k] < i) {
+            k++;
+        }
+
+        /* Legacy gradient colors are 0xAARRGGBB, the same layout as BGRA8888 */
+        uint32_t color;
+        if (k == 0) {
+            color = grad->colors[0];
+        } else if (k == count) {
+            color = grad->colors[count - 1];
+        } else {
+            int32_t s0 = grad->stops[k - 1];
+            int32_t s1 = grad->stops[k];
+            uint32_t w = (uint32_t)(((i - s0) * 255 + (s1 - s0) / 2) / (s1 - s0));
+            uint32_t c0 = grad->colors[k - 1];
+            uint32_t c1 = grad->colors[k];
+            color = REF_BGRA(
+                REF_DIV255(REF_CH(c0, 0) * (255 - w) + REF_CH(c1, 0) * w),
+                REF_DIV255(REF_CH(c0, 8) * (255 - w) + REF_CH(c1, 8) * w),
+                REF_DIV255(REF_CH(c0, 16) * (255 - w) + REF_CH(c1, 16) * w),
+                REF_DIV255(REF_CH(c0, 24) * (255 - w) + REF_CH(c1, 24) * w));
+        }
+
+        paint->lut[i] = ref_premultiply(color);
+    }
+
+    paint->type = REF_PAINT_RAMP;
+    paint->spread = VG_LITE_GRADIENT_SPREAD_PAD;
+    op->fill_rule = call->args.draw_grad.fill_rule;
+    op->samples = ref_quality_samples(call->args.draw_grad.path->quality);
+    vg_lite_test_ref_raster_add_path(&ref->raster, call->args.draw_grad.path, call->args.draw_grad.matrix);
+    ref_op_run(ref);
+}
+
+static void ref_do_draw_ext_grad(struct vg_lite_test_ref_s* ref, const struct vg_lite_test_hook_call_s* call)
+{
+    /* The linear and radial calls only differ by the gradient type */
+    bool linear = call->api == VG_LITE_TEST_HOOK_API_DRAW_LINEAR_GRAD;
+    vg_lite_buffer_t* target = linear ? call->args.draw_linear_grad.target : call->args.draw_radial_grad.target;
+    vg_lite_path_t* path = linear ? call->args.draw_linear_grad.path : call->args.draw_radial_grad.path;
+    vg_lite_matrix_t* path_matrix = linear ? call->args.draw_linear_grad.path_matrix : call->args.draw_radial_grad.path_matrix;
+    vg_lite_fill_t fill_rule = linear ? call->args.draw_linear_grad.fill_rule : call->args.draw_radial_grad.fill_rule;
+    vg_lite_blend_t blend = linear ? call->args.draw_linear_grad.blend : call->args.draw_radial_grad.blend;
+
+    if (!ref_op_begin(ref, target, blend)) {
+        return;
+    }
+
+    struct ref_op_s* op = &ref->op;
+    struct ref_paint_s* paint = &op->paint;
+    vg_lite_matrix_t matrix;
+
+    if (linear) {
+        const vg_lite_ext_linear_gradient_t* grad = call->args.draw_linear_grad.grad;
+        ref_matrix_multiply(path_matrix, &grad->matrix, &matrix);
+        ref_grad_lut_init(paint->lut, grad->color_ramp, grad->ramp_length, grad->pre_multiplied);
+        paint->type = REF_PAINT_LINEAR;
+        paint->spread = grad->spread_mode;
+        paint->linear = grad->linear_grad;
+    } else {
+        const vg_lite_radial_gradient_t* grad = call->args.draw_radial_grad.grad;
+        ref_matrix_multiply(path_matrix, &grad->matrix, &matrix);
+        ref_grad_lut_init(paint->lut, grad->color_ramp, grad->ramp_length, grad->pre_multiplied);
+        paint->type = REF_PAINT_RADIAL;
+        paint->spread = grad->spread_mode;
+        paint->radial = grad->radial_grad;
+    }
+
+    if (!ref_matrix_invert(&matrix, paint->inv)) {
+        return;
+    }
+
+    op->fill_rule = fill_rule;
+    op->samples = ref_quality_samples(path->quality);
+    vg_lite_test_ref_raster_add_path(&ref->raster, path, path_matrix);
+    ref_op_run(ref);
+}
+
+static bool ref_op_begin(struct vg_lite_test_ref_s* ref, vg_lite_buffer_t* target, vg_lite_blend_t blend)
+{
+    struct ref_op_s* op = &ref->op;
+    memset(op, 0, sizeof(struct ref_op_s));
+    vg_lite_test_ref_raster_reset(&ref->raster);
+
+    op->surface = ref_surface_get(ref, target);
+    if (!op->surface) {
+        return false;
+    }
+
+    op->blend = blend;
+    op->clip_x1 = op->surface->image->width;
+    op->clip_y1 = op->surface->image->height;
+
+    if (ref->scissor_en) {
+        op->clip_x0 = MATH_MAX(op->clip_x0, ref->scissor[0]);
+        op->clip_y0 = MATH_MAX(op->clip_y0, ref->scissor[1]);
+        op->clip_x1 = MATH_MIN(op->clip_x1, ref->scissor[2]);
+        op->clip_y1 = MATH_MIN(op->clip_y1, ref->scissor[3]);
+    }
+
+    return op->clip_x0 < op->clip_x1 && op->clip_y0 < op->clip_y1;
+}
+
+static bool ref_image_init(struct vg_lite_test_ref_s* ref, struct ref_image_s* image, vg_lite_buffer_t* buffer)
+{
+    int32_t bits;
+    if (!ref_format_bits(buffer->format, &bits) || (buffer->tiled == VG_LITE_TILED && bits < 8)) {
+        char reason[64];
+        snprintf(reason, sizeof(reason), "Source format %s%s",
+            vg_lite_test_buffer_format_string(buffer->format),
+            buffer->tiled == VG_LITE_TILED ? " tiled" : "");
+        ref_set_unsupported(ref, reason);
+        return false;
+    }
+
+    memset(image, 0, sizeof(struct ref_image_s));
+    image->memory = buffer->memory;
+    image->shadow = vg_lite_test_ref_get_image(ref, buffer);
+    image->format = buffer->format;
+    image->stride = buffer->stride;
+    image->tiled = buffer->tiled == VG_LITE_TILED;
+    image->premultiplied = buffer->premultiplied;
+    image->width = buffer->width;
+    image->height = buffer->height;
+
+    if (!image->shadow) {
+        /* Written by the CPU, make sure the lines are not stale */
+        gpu_cache_invalidate(buffer->memory, buffer->stride * buffer->height);
+    }
+
+    return true;
+}
+
+static void ref_grad_lut_init(uint32_t* lut, const vg_lite_color_ramp_t* ramp, uint32_t count, bool pre_multiplied)
+{
+    count = MATH_MIN(count, MAX_COLOR_RAMP_STOPS);
+    if (count == 0) {
+        memset(lut, 0, REF_GRAD_LUT_SIZE * sizeof(uint32_t));
+        return;
+    }
+
+    for (int32_t i = 0; i < REF_GRAD_LUT_SIZE; i++) {
+        float t = (i + 0.5f) / REF_GRAD_LUT_SIZE;
+        uint32_t k = 0;
+        while (k < count && ramp[k].stop < t) {
+            k++;
+        }
+
+        const vg_lite_color_ramp_t* c0 = &ramp[k == 0 ? 0 : k - 1];
+        const vg_lite_color_ramp_t* c1 = &ramp[k == count ? count - 1 : k];
+        float w = 0;
+        if (c0 != c1 && c1->stop > c0->stop) {
+            w = (t - c0->stop) / (c1->stop - c0->stop);
+        }
+
+        float a0 = pre_multiplied ? c0->alpha : 1;
+        float a1 = pre_multiplied ? c1->alpha : 1;
+        float ch[4] = {
+            c0->blue * a0 + (c1->blue * a1 - c0->blue * a0) * w,
+            c0->green * a0 + (c1->green * a1 - c0->green * a0) * w,
+            c0->red * a0 + (c1->red * a1 - c0->red * a0) * w,
+            c0->alpha + (c1->alpha - c0->alpha) * w,
+        };
+
+        uint8_t v[4];
+        for (int j = 0; j < 4; j++) {
+            v[j] = (uint8_t)(MATH_CLAMP(ch[j], 0.0f, 1.0f) * 255 + 0.5f);
+        }
+
+        /* Premultiplied ramps were interpolated premultiplied already */
+        uint32_t color = REF_BGRA(v[0], v[1], v[2], v[3]);
+        lut[i] = pre_multiplied ? color : ref_premultiply(color);
+    }
+}
+
+static void ref_op_run(struct vg_lite_test_ref_s* ref)
+{
+    struct ref_op_s* op = &ref->op;
+
+    if (ref->raster.unsupported) {
+        ref_set_unsupported(ref, "Path arc");
+    }
+
+    if (ref->raster.edge_count == 0) {
+        return;
+    }
+
+    /* Scratch memory follows the widest surface seen so far */
+    int32_t width = op->surface->image->width;
+    if (width > ref->width) {
+        ref->width = width;
+        for (int i = 0; i < ref->worker_count; i++) {
+            struct ref_worker_s* worker = &ref->workers[i];
+            if (worker->scanline.cells) {
+                vg_lite_test_ref_scanline_deinit(&worker->scanline);
+            }
+            vg_lite_test_ref_scanline_init(&worker->scanline, width);
+            worker->coverage = realloc(worker->coverage, width);
+            GPU_ASSERT_NULL(worker->coverage);
+            worker->colors = realloc(worker->colors, width * sizeof(uint32_t));
+            GPU_ASSERT_NULL(worker->colors);
+        }
+    }
+
+    int32_t y_start = MATH_MAX(op->clip_y0, ref->raster.min_y >> VG_LITE_TEST_REF_RASTER_SHIFT);
+    int32_t y_end = MATH_MIN(op->clip_y1, (ref->raster.max_y + VG_LITE_TEST_REF_RASTER_ONE - 1) >> VG_LITE_TEST_REF_RASTER_SHIFT);
+    if (y_start >= y_end) {
+        return;
+    }
+
+    pthread_mutex_lock(&ref->lock);
+    ref->next_row = y_start;
+    ref->end_row = y_end;
+    ref->running = ref->worker_count - 1;
+    ref->generation++;
+    pthread_cond_broadcast(&ref->start_cond);
+    pthread_mutex_unlock(&ref->lock);
+
+    ref_worker_run(&ref->workers[0]);
+
+    pthread_mutex_lock(&ref->lock);
+    while (ref->running > 0) {
+        pthread_cond_wait(&ref->done_cond, &ref->lock);
+    }
+    pthread_mutex_unlock(&ref->lock);
+}
+
+static void* ref_worker_thread(void* arg)
+{
+    struct ref_worker_s* worker = arg;
+    struct vg_lite_test_ref_s* ref = worker->ref;
+    uint32_t generation = 0;
+
+    pthread_mutex_lock(&ref->lock);
+    while (true) {
+        while (ref->generation == generation && !ref->exit) {
+            pthread_cond_wait(&ref->start_cond, &ref->lock);
+        }
+
+        if (ref->exit) {
+            break;
+        }
+
+        generation = ref->generation;
+        pthread_mutex_unlock(&ref->lock);
+
+        ref_worker_run(worker);
+
+        pthread_mutex_lock(&ref->lock);
+        if (--ref->running == 0) {
+            pthread_cond_signal(&ref->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&ref->lock);
+
+    return NULL;
+}
+
+static void ref_worker_run(struct ref_worker_s* worker)
+{
+    struct vg_lite_test_ref_s* ref = worker->ref;
+
+    /* Bands are handed out in order, every pixel only depends on its own row */
+    while (true) {
+        pthread_mutex_lock(&ref->lock);
+        int32_t y_start = ref->next_row;
+        ref->next_row += REF_BAND_HEIGHT;
+        int32_t y_end = MATH_MIN(ref->next_row, ref->end_row);
+        pthread_mutex_unlock(&ref->lock);
+
+        if (y_start >= y_end) {
+            break;
+        }
+
+        ref_render_band(worker, y_start, y_end);
+    }
+}
+
+static void ref_render_band(struct ref_worker_s* worker, int32_t y_start, int32_t y_end)
+{
+    const struct vg_lite_test_ref_s* ref = worker->ref;
+    const struct ref_op_s* op = &ref->op;
+    struct gpu_buffer_s* image = op->surface->image;
+
+    vg_lite_test_ref_scanline_select_band(&worker->scanline, &ref->raster, y_start, y_end);
+
+    for (int32_t y = y_start; y < y_end; y++) {
+        int32_t x_start;
+        int32_t x_end;
+        if (!vg_lite_test_ref_scanline_render(
+                &worker->scanline, y, op->samples, op->fill_rule,
+                op->clip_x0, op->clip_x1, worker->coverage, &x_start, &x_end)) {
+            continue;
+        }
+
+        ref_paint_row(ref, &op->paint, y, x_start, x_end, worker->colors);
+
+        uint32_t* dest = (uint32_t*)((uint8_t*)image->data + y * image->stride);
+        ref_blend_row(op, dest, worker->colors, worker->coverage, x_start, x_end);
+    }
+}
+
+static void ref_paint_row(const struct vg_lite_test_ref_s* ref, const struct ref_paint_s* paint, int32_t y, int32_t x_start, int32_t x_end, uint32_t* colors)
+{
+    if (paint->type == REF_PAINT_COLOR) {
+        for (int32_t x = x_start; x < x_end; x++) {
+            colors[x] = paint->color;
+        }
+        return;
+    }
+
+    const float py = y + 0.5f;
+    for (int32_t x = x_start; x < x_end; x++) {
+        /* Paints are sampled at the pixel center */
+        const float px = x + 0.5f;
+        float u = paint->inv[0][0] * px + paint->inv[0][1] * py + paint->inv[0][2];
+        float v = paint->inv[1][0] * px + paint->inv[1][1] * py + paint->inv[1][2];
+        float w = paint->inv[2][0] * px + paint->inv[2][1] * py + paint->inv[2][2];
+        if (w != 1.0f && w != 0.0f) {
+            u /= w;
+            v /= w;
+        }
+
+        switch (paint->type) {
+        case REF_PAINT_IMAGE:
+            colors[x] = ref_image_sample(ref, paint, u, v);
+            break;
+
+        case REF_PAINT_RAMP:
+            colors[x] = ref_grad_lookup(paint, u / REF_GRAD_LUT_SIZE);
+            break;
+
+        case REF_PAINT_LINEAR: {
+            const vg_lite_linear_gradient_parameter_t* p = &paint->linear;
+            float dx = p->X1 - p->X0;
+            float dy = p->Y1 - p->Y0;
+            float len2 = dx * dx + dy * dy;
+            float t = len2 > 0 ? ((u - p->X0) * dx + (v - p->Y0) * dy) / len2 : 0;
+            colors[x] = ref_grad_lookup(paint, t);
+            break;
+        }
+
+        case REF_PAINT_RADIAL: {
+            const vg_lite_radial_gradient_parameter_t* p = &paint->radial;
+            float fx = p->fx - p->cx;
+            float fy = p->fy - p->cy;
+
+            /* Keep the focal point inside the circle like the spec asks for */
+            float f2 = fx * fx + fy * fy;
+            float r2 = p->r * p->r;
+            if (f2 > r2 * 0.99f * 0.99f) {
+                float scale = p->r * 0.99f / MATH_SQRTF(f2);
+                fx *= scale;
+                fy *= scale;
+                f2 = fx * fx + fy * fy;
+            }
+
+            /* Solve |f + (d / t) - c| = r for the ramp position t of d = p - f */
+            float dx = u - p->cx - fx;
+            float dy = v - p->cy - fy;
+            float d2 = dx * dx + dy * dy;
+            float b = -(dx * fx + dy * fy);
+            float a = r2 - f2;
+            float den = b + MATH_SQRTF(b * b + a * d2);
+            float t = den > 0 ? d2 / den : 0;
+            colors[x] = ref_grad_lookup(paint, t);
+            break;
+        }
+
+        default:
+            colors[x] = 0;
+            break;
+        }
+    }
+}
+
+static uint32_t ref_image_sample(const struct vg_lite_test_ref_s* ref, const struct ref_paint_s* paint, float u, float v)
+{
+    if (paint->filter == VG_LITE_FILTER_POINT) {
+        return ref_image_texel(ref, paint, (int32_t)floorf(u), (int32_t)floorf(v));
+    }
+
+    if (paint->filter == VG_LITE_FILTER_GAUSSIAN) {
+        int32_t ix = (int32_t)floorf(u);
+        int32_t iy = (int32_t)floorf(v);
+        uint32_t acc[4] = { 0 };
+        int32_t sum = 0;
+
+        /* w0 weights the center, w1 the 4 edges and w2 the 4 corners */
+        for (int32_t dy = -1; dy <= 1; dy++) {
+            for (int32_t dx = -1; dx <= 1; dx++) {
+                int32_t weight = ref->gaussian[MATH_ABS(dx) + MATH_ABS(dy)];
+                uint32_t texel = ref_image_texel(ref, paint, ix + dx, iy + dy);
+                for (int i = 0; i < 4; i++) {
+                    acc[i] += REF_CH(texel, i * 8) * weight;
+                }
+                sum += weight;
+            }
+        }
+
+        if (sum <= 0) {
+            return 0;
+        }
+
+        return REF_BGRA(
+            MATH_MIN((acc[0] + sum / 2) / sum, 255),
+            MATH_MIN((acc[1] + sum / 2) / sum, 255),
+            MATH_MIN((acc[2] + sum / 2) / sum, 255),
+            MATH_MIN((acc[3] + sum / 2) / sum, 255));
+    }
+
+    /* Bilinear with 8-bit weights, interpolated premultiplied */
+    int32_t fu = (int32_t)floorf((u - 0.5f) * 256);
+    int32_t fv = (int32_t)floorf((v - 0.5f) * 256);
+    int32_t ix = fu >> 8;
+    int32_t iy = fv >> 8;
+    uint32_t wx = fu & 0xFF;
+    uint32_t wy = fv & 0xFF;
+
+    uint32_t c00 = ref_image_texel(ref, paint, ix, iy);
+    uint32_t c10 = ref_image_texel(ref, paint, ix + 1, iy);
+    uint32_t c01 = ref_image_texel(ref, paint, ix, iy + 1);
+    uint32_t c11 = ref_image_texel(ref, paint, ix + 1, iy + 1);
+
+    uint32_t result = 0;
+    for (int i = 0; i < 32; i += 8) {
+        uint32_t top = REF_CH(c00, i) * (256 - wx) + REF_CH(c10, i) * wx;
+        uint32_t bottom = REF_CH(c01, i) * (256 - wx) + REF_CH(c11, i) * wx;
+        uint32_t value = (top * (256 - wy) + bottom * wy + 32768) >> 16;
+        result |= MATH_MIN(value, 255) << i;
+    }
+
+    return result;
+}
+
+static uint32_t ref_image_texel(const struct vg_lite_test_ref_s* ref, const struct ref_paint_s* paint, int32_t x, int32_t y)
+{
+    const struct ref_image_s* image = &paint->image;
+    bool inside = x >= 0 && x < image->width && y >= 0 && y < image->height;
+
+    if (!inside) {
+        switch (paint->pattern_mode) {
+        case VG_LITE_PATTERN_COLOR:
+            return paint->pattern_color;
+
+        case VG_LITE_PATTERN_REPEAT:
+            x = ((x % image->width) + image->width) % image->width;
+            y = ((y % image->height) + image->height) % image->height;
+            break;
+
+        case VG_LITE_PATTERN_REFLECT:
+            x = ((x % (2 * image->width)) + 2 * image->width) % (2 * image->width);
+            y = ((y % (2 * image->height)) + 2 * image->height) % (2 * image->height);
+            x = x < image->width ? x : 2 * image->width - 1 - x;
+            y = y < image->height ? y : 2 * image->height - 1 - y;
+            break;
+
+        default:
+            x = MATH_CLAMP(x, 0, image->width - 1);
+            y = MATH_CLAMP(y, 0, image->height - 1);
+            break;
+        }
+    }
+
+    x += image->x;
+    y += image->y;
+
+    /* Images drawn by the GPU earlier in the item are read from the reference */
+    uint32_t color;
+    if (image->shadow) {
+        color = ((const uint32_t*)((const uint8_t*)image->shadow->data + y * image->shadow->stride))[x];
+    } else {
+        color = ref_decode(ref, image->memory, image->stride, image->format, image->tiled, x, y);
+    }
+
+    /* Alpha only images are white */
+    if (image->format == VG_LITE_A8 || image->format == VG_LITE_A4) {
+        color |= 0x00FFFFFF;
+    }
+
+    if (image->premultiplied) {
+        uint32_t a = REF_CH(color, 24);
+        color = REF_BGRA(MATH_MIN(REF_CH(color, 0), a), MATH_MIN(REF_CH(color, 8), a), MATH_MIN(REF_CH(color, 16), a), a);
+    } else {
+        color = ref_premultiply(color);
+    }
+
+    if (paint->multiply) {
+        color = ref_mul_color(color, paint->multiply_color);
+
+        /* A color brighter than its alpha must not push a channel over the alpha */
+        uint32_t a = REF_CH(color, 24);
+        color = REF_BGRA(MATH_MIN(REF_CH(color, 0), a), MATH_MIN(REF_CH(color, 8), a), MATH_MIN(REF_CH(color, 16), a), a);
+    }
+
+    return color;
+}
+
+static uint32_t ref_grad_lookup(const struct ref_paint_s* paint, float t)
+{
+    switch (paint->spread) {
+    case VG_LITE_GRADIENT_SPREAD_FILL:
+        if (t < 0 || t > 1) {
+            return 0;
+        }
+        break;
+
+    case VG_LITE_GRADIENT_SPREAD_REPEAT:
+        t -= floorf(t);
+        break;
+
+    case VG_LITE_GRADIENT_SPREAD_REFLECT:
+        t -= 2 * floorf(t / 2);
+        t = t > 1 ? 2 - t : t;
+        break;
+
+    default:
+        break;
+    }
+
+    int32_t index = (int32_t)floorf(MATH_CLAMP(t, 0.0f, 1.0f) * REF_GRAD_LUT_SIZE);
+    return paint->lut[MATH_MIN(index, REF_GRAD_LUT_SIZE - 1)];
+}
+
+static void ref_blend_row(const struct ref_op_s* op, uint32_t* dest, const uint32_t* colors, const uint8_t* coverage, int32_t x_start, int32_t x_end)
+{
+    const vg_lite_buffer_format_t format = op->surface->format;
+
+    if (op->blend == VG_LITE_BLEND_SRC_OVER || op->blend == VG_LITE_BLEND_NORMAL_LVGL) {
+        /* The hot path: S * cov + D * (1 - Sa * cov), four channels at once */
+        for (int32_t x = x_start; x < x_end; x++) {
+            uint32_t src = ref_mul(colors[x], coverage[x]);
+            uint32_t result = src + ref_mul(dest[x], 255 - (src >> 24));
+            dest[x] = ref_quantize(result, format);
+        }
+        return;
+    }
+
+    for (int32_t x = x_start; x < x_end; x++) {
+        uint32_t cov = coverage[x];
+        if (cov == 0) {
+            continue;
+        }
+
+        uint32_t s = colors[x];
+        uint32_t d = dest[x];
+        uint32_t sa = REF_CH(s, 24);
+        uint32_t da = REF_CH(d, 24);
+        uint32_t result = 0;
+
+        for (int i = 0; i < 32; i += 8) {
+            uint32_t dc = REF_CH(d, i);
+            uint32_t bc = ref_blend_channel(op->blend, REF_CH(s, i), sa, dc, da, i == 24);
+
+            /* Partial coverage mixes the blended result with the old pixel */
+            result |= REF_DIV255(bc * cov + dc * (255 - cov)) << i;
+        }
+
+        dest[x] = ref_quantize(result, format);
+    }
+}
+
+static uint8_t ref_blend_channel(vg_lite_blend_t blend, uint32_t s, uint32_t sa, uint32_t d, uint32_t da, bool is_alpha)
+{
+    /* Premultiplied values, the separable modes use the SRC_OVER alpha */
+    int32_t src_over = s + REF_DIV255(d * (255 - sa));
+    int32_t value;
+
+    switch (blend) {
+    case VG_LITE_BLEND_NONE:
+        value = s;
+        break;
+    case VG_LITE_BLEND_DST_OVER:
+        value = REF_DIV255(s * (255 - da)) + d;
+        break;
+    case VG_LITE_BLEND_SRC_IN:
+        value = REF_DIV255(s * da);
+        break;
+    case VG_LITE_BLEND_DST_IN:
+        value = REF_DIV255(d * sa);
+        break;
+    case VG_LITE_BLEND_MULTIPLY:
+        value = is_alpha ? src_over : REF_DIV255(s * (255 - da)) + REF_DIV255(d * (255 - sa)) + REF_DIV255(s * d);
+        break;
+    case VG_LITE_BLEND_SCREEN:
+        value = s + d - REF_DIV255(s * d);
+        break;
+    case VG_LITE_BLEND_DARKEN:
+        value = is_alpha ? src_over : MATH_MIN(REF_DIV255(s * da), REF_DIV255(d * sa)) + REF_DIV255(s * (255 - da)) + REF_DIV255(d * (255 - sa));
+        break;
+    case VG_LITE_BLEND_LIGHTEN:
+        value = is_alpha ? src_over : MATH_MAX(REF_DIV255(s * da), REF_DIV255(d * sa)) + REF_DIV255(s * (255 - da)) + REF_DIV255(d * (255 - sa));
+        break;
+    case VG_LITE_BLEND_ADDITIVE:
+        value = s + d;
+        break;
+    case VG_LITE_BLEND_SUBTRACT:
+        value = REF_DIV255(d * (255 - s));
+        break;
+    case VG_LITE_BLEND_ADDITIVE_LVGL:
+        value = is_alpha ? src_over : (int32_t)(s + d);
+        break;
+    case VG_LITE_BLEND_SUBTRACT_LVGL:
+        value = is_alpha ? src_over : (int32_t)d - (int32_t)s;
+        break;
+    case VG_LITE_BLEND_MULTIPLY_LVGL:
+        value = is_alpha ? src_over : REF_DIV255(s * d) + REF_DIV255(d * (255 - sa));
+        break;
+    default:
+        value = src_over;
+        break;
+    }
+
+    return (uint8_t)MATH_CLAMP(value, 0, 255);
+}
@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_REF_H
+#define VG_LITE_TEST_REF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Auto select the worker count from the online CPUs */
+#define VG_LITE_TEST_REF_THREAD_AUTO 0
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_buffer_s;
+struct vg_lite_test_ref_s;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Create the software reference renderer.
+ * @param thread_count The number of render threads, or VG_LITE_TEST_REF_THREAD_AUTO.
+ * @return The reference renderer.
+ * @note The renderer mirrors the hooked vg_lite calls between item begin and end.
+ */
+struct vg_lite_test_ref_s* vg_lite_test_ref_create(int thread_count);
+
+/**
+ * @brief Destroy the software reference renderer.
+ * @param ref The reference renderer.
+ */
+void vg_lite_test_ref_destroy(struct vg_lite_test_ref_s* ref);
+
+/**
+ * @brief Start mirroring the calls of a test item, previous results are dropped.
+ * @param ref The reference renderer.
+ */
+void vg_lite_test_ref_item_begin(struct vg_lite_test_ref_s* ref);
+
+/**
+ * @brief Stop mirroring the calls of the current test item.
+ * @param ref The reference renderer.
+ */
+void vg_lite_test_ref_item_end(struct vg_lite_test_ref_s* ref);
+
+/**
+ * @brief Get the reference rendering of a buffer.
+ * @param ref The reference renderer.
+ * @param buffer The vg_lite buffer, matched by its memory.
+ * @return The BGRA8888 reference image, or NULL if the item never drew to the buffer.
+ */
+struct gpu_buffer_s* vg_lite_test_ref_get_image(struct vg_lite_test_ref_s* ref, const vg_lite_buffer_t* buffer);
+
+/**
+ * @brief Get why the current item can not be rendered exactly.
+ * @param ref The reference renderer.
+ * @return The reason, or NULL if every call of the item is supported.
+ */
+const char* vg_lite_test_ref_get_unsupported(struct vg_lite_test_ref_s* ref);
+
+/**
+ * @brief Compare a buffer against an image with a per channel tolerance, the alpha channel is skipped.
+ * @param buffer The buffer to check.
+ * @param ref_image The expected image.
+ * @param tolerance The maximum difference of a color channel.
+ * @param max_mismatch_permille The number of mismatched pixels allowed per thousand.
+ * @param remark The text buffer to describe the result.
+ * @param remark_size The size of the text buffer.
+ * @return True if the buffer matches the image.
+ */
+bool vg_lite_test_ref_compare(
+    struct gpu_buffer_s* buffer,
+    struct gpu_buffer_s* ref_image,
+    int tolerance,
+    int max_mismatch_permille,
+    char* remark,
+    size_t remark_size);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_REF_H*/
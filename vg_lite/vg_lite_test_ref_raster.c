@@ -0,0 +1,644 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_ref_raster.h"
+#include "../gpu_assert.h"
+#include "../gpu_math.h"
+#include "vg_lite_test_path.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Maximum distance between a flattened curve and the real one, in 1/256 pixel */
+#define RASTER_FLATTEN_TOLERANCE 26
+
+#define RASTER_CURVE_SEGMENTS_MAX 64
+
+/* Keep the coordinates far away from overflowing the 24.8 edge math */
+#define RASTER_COORD_LIMIT (1 << 22)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct raster_point_s {
+    int32_t x;
+    int32_t y;
+};
+
+struct raster_walker_s {
+    struct vg_lite_test_ref_raster_s* raster;
+    const vg_lite_matrix_t* matrix;
+
+    /* Path space positions, relative ops and smooth curves need them untransformed */
+    float start_x;
+    float start_y;
+    float cur_x;
+    float cur_y;
+    float ctrl_x;
+    float ctrl_y;
+    uint8_t last_op;
+    bool has_subpath;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void raster_add_edge(struct vg_lite_test_ref_raster_s* raster, struct raster_point_s p0, struct raster_point_s p1);
+static struct raster_point_s raster_transform(const vg_lite_matrix_t* matrix, float x, float y);
+static int64_t raster_div_round(int64_t a, int64_t b);
+static int32_t raster_curve_segments(int32_t dev, int32_t scale);
+static void raster_add_quad(struct vg_lite_test_ref_raster_s* raster, const struct raster_point_s p[3]);
+static void raster_add_cubic(struct vg_lite_test_ref_raster_s* raster, const struct raster_point_s p[4]);
+static void raster_walker_line_to(struct raster_walker_s* walker, float x, float y);
+static void raster_walker_close(struct raster_walker_s* walker);
+static void raster_walker_quad_to(struct raster_walker_s* walker, float cx, float cy, float x, float y);
+static void raster_walker_cubic_to(struct raster_walker_s* walker, float c1x, float c1y, float c2x, float c2y, float x, float y);
+static void raster_path_iter_cb(void* user_data, uint8_t op_code, const float* data, uint32_t len);
+static void raster_sort_crossings(struct vg_lite_test_ref_crossing_s* crossings, uint32_t count);
+static void raster_add_span(struct vg_lite_test_ref_scanline_s* scanline, int32_t samples, int32_t xa, int32_t xb);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void vg_lite_test_ref_raster_init(struct vg_lite_test_ref_raster_s* raster)
+{
+    GPU_ASSERT_NULL(raster);
+    memset(raster, 0, sizeof(struct vg_lite_test_ref_raster_s));
+    vg_lite_test_ref_raster_reset(raster);
+}
+
+void vg_lite_test_ref_raster_deinit(struct vg_lite_test_ref_raster_s* raster)
+{
+    GPU_ASSERT_NULL(raster);
+    free(raster->edges);
+    memset(raster, 0, sizeof(struct vg_lite_test_ref_raster_s));
+}
+
+void vg_lite_test_ref_raster_reset(struct vg_lite_test_ref_raster_s* raster)
+{
+    GPU_ASSERT_NULL(raster);
+    raster->edge_count = 0;
+    raster->min_y = INT32_MAX;
+    raster->max_y = INT32_MIN;
+    raster->unsupported = false;
+}
+
+void vg_lite_test_ref_raster_add_path(struct vg_lite_test_ref_raster_s* raster, const vg_lite_path_t* path, const vg_lite_matrix_t* matrix)
+{
+    GPU_ASSERT_NULL(raster);
+    GPU_ASSERT_NULL(path);
+    GPU_ASSERT_NULL(matrix);
+
+    struct raster_walker_s walker;
+    memset(&walker, 0, sizeof(walker));
+    walker.raster = raster;
+    walker.matrix = matrix;
+    walker.last_op = VLC_OP_END;
+
+    vg_lite_test_path_for_each_data(path, raster_path_iter_cb, &walker);
+
+    /* Paths without a trailing END or CLOSE are still filled as closed */
+    raster_walker_close(&walker);
+}
+
+void vg_lite_test_ref_raster_add_rect(struct vg_lite_test_ref_raster_s* raster, float width, float height, const vg_lite_matrix_t* matrix)
+{
+    GPU_ASSERT_NULL(raster);
+    GPU_ASSERT_NULL(matrix);
+
+    struct raster_point_s p[4] = {
+        raster_transform(matrix, 0, 0),
+        raster_transform(matrix, width, 0),
+        raster_transform(matrix, width, height),
+        raster_transform(matrix, 0, height),
+    };
+
+    for (int i = 0; i < 4; i++) {
+        raster_add_edge(raster, p[i], p[(i + 1) % 4]);
+    }
+}
+
+void vg_lite_test_ref_scanline_init(struct vg_lite_test_ref_scanline_s* scanline, int32_t width)
+{
+    GPU_ASSERT_NULL(scanline);
+    GPU_ASSERT(width > 0);
+    memset(scanline, 0, sizeof(struct vg_lite_test_ref_scanline_s));
+
+    /* Spans ending exactly on the right border touch one more cell */
+    scanline->cells = calloc(width + 2, sizeof(int32_t));
+    GPU_ASSERT_NULL(scanline->cells);
+    scanline->runs = calloc(width + 2, sizeof(int32_t));
+    GPU_ASSERT_NULL(scanline->runs);
+    scanline->width = width;
+}
+
+void vg_lite_test_ref_scanline_deinit(struct vg_lite_test_ref_scanline_s* scanline)
+{
+    GPU_ASSERT_NULL(scanline);
+    free(scanline->band_edges);
+    free(scanline->crossings);
+    free(scanline->cells);
+    free(scanline->runs);
+    memset(scanline, 0, sizeof(struct vg_lite_test_ref_scanline_s));
+}
+
+void vg_lite_test_ref_scanline_select_band(
+    struct vg_lite_test_ref_scanline_s* scanline,
+    const struct vg_lite_test_ref_raster_s* raster,
+    int32_t y_start,
+    int32_t y_end)
+{
+    GPU_ASSERT_NULL(scanline);
+    GPU_ASSERT_NULL(raster);
+
+    if (scanline->band_edge_capacity < raster->edge_count) {
+        scanline->band_edge_capacity = raster->edge_count;
+        scanline->band_edges = realloc(scanline->band_edges, scanline->band_edge_capacity * sizeof(scanline->band_edges[0]));
+        GPU_ASSERT_NULL(scanline->band_edges);
+        scanline->crossings = realloc(scanline->crossings, scanline->band_edge_capacity * sizeof(scanline->crossings[0]));
+        GPU_ASSERT_NULL(scanline->crossings);
+        scanline->crossing_capacity = scanline->band_edge_capacity;
+    }
+
+    const int32_t band_y0 = y_start * VG_LITE_TEST_REF_RASTER_ONE;
+    const int32_t band_y1 = y_end * VG_LITE_TEST_REF_RASTER_ONE;
+
+    scanline->band_edge_count = 0;
+    for (uint32_t i = 0; i < raster->edge_count; i++) {
+        const struct vg_lite_test_ref_edge_s* edge = &raster->edges[i];
+        if (edge->y0 < band_y1 && edge->y1 > band_y0) {
+            scanline->band_edges[scanline->band_edge_count++] = edge;
+        }
+    }
+}
+
+bool vg_lite_test_ref_scanline_render(
+    struct vg_lite_test_ref_scanline_s* scanline,
+    int32_t y,
+    int32_t samples,
+    vg_lite_fill_t fill_rule,
+    int32_t clip_x0,
+    int32_t clip_x1,
+    uint8_t* coverage,
+    int32_t* x_start,
+    int32_t* x_end)
+{
+    GPU_ASSERT_NULL(scanline);
+    GPU_ASSERT_NULL(coverage);
+    GPU_ASSERT(samples > 0);
+    GPU_ASSERT(clip_x0 >= 0 && clip_x1 <= scanline->width);
+
+    if (clip_x0 >= clip_x1 || scanline->band_edge_count == 0) {
+        return false;
+    }
+
+    const int32_t span_min = clip_x0 * VG_LITE_TEST_REF_RASTER_ONE;
+    const int32_t span_max = clip_x1 * VG_LITE_TEST_REF_RASTER_ONE;
+    int32_t touched_min = INT32_MAX;
+    int32_t touched_max = INT32_MIN;
+
+    for (int32_t s = 0; s < samples; s++) {
+        /* Sub-scanlines are evenly spread inside the row, one sample sits on the pixel center */
+        const int32_t sample_y = y * VG_LITE_TEST_REF_RASTER_ONE
+            + ((2 * s + 1) * VG_LITE_TEST_REF_RASTER_ONE) / (2 * samples);
+
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < scanline->band_edge_count; i++) {
+            const struct vg_lite_test_ref_edge_s* edge = scanline->band_edges[i];
+            if (sample_y < edge->y0 || sample_y >= edge->y1) {
+                continue;
+            }
+
+            int64_t dx = (int64_t)(edge->x1 - edge->x0) * (sample_y - edge->y0);
+            struct vg_lite_test_ref_crossing_s* crossing = &scanline->crossings[count++];
+            crossing->x = edge->x0 + (int32_t)raster_div_round(dx, edge->y1 - edge->y0);
+            crossing->winding = edge->winding;
+        }
+
+        if (count < 2) {
+            continue;
+        }
+
+        raster_sort_crossings(scanline->crossings, count);
+
+        int32_t winding = 0;
+        for (uint32_t i = 0; i + 1 < count; i++) {
+            winding += scanline->crossings[i].winding;
+
+            bool inside = fill_rule == VG_LITE_FILL_EVEN_ODD ? (winding & 1) : (winding != 0);
+            if (!inside) {
+                continue;
+            }
+
+            int32_t xa = MATH_CLAMP(scanline->crossings[i].x, span_min, span_max);
+            int32_t xb = MATH_CLAMP(scanline->crossings[i + 1].x, span_min, span_max);
+            if (xa >= xb) {
+                continue;
+            }
+
+            raster_add_span(scanline, samples, xa, xb);
+            touched_min = MATH_MIN(touched_min, xa >> VG_LITE_TEST_REF_RASTER_SHIFT);
+            touched_max = MATH_MAX(touched_max, xb >> VG_LITE_TEST_REF_RASTER_SHIFT);
+        }
+    }
+
+    if (touched_min > touched_max) {
+        return false;
+    }
+
+    /* A span ending on the clip border leaves an empty cell right after the clip */
+    touched_max = MATH_MIN(touched_max, clip_x1 - 1);
+
+    /* Resolve the accumulated coverage, this loop is free of branches to let the compiler vectorize it */
+    const int32_t full = samples * VG_LITE_TEST_REF_RASTER_ONE;
+    int32_t acc = 0;
+    for (int32_t x = touched_min; x <= touched_max; x++) {
+        acc += scanline->runs[x];
+        int32_t value = acc + scanline->cells[x];
+        value = (value * 255 + full / 2) / full;
+        coverage[x] = (uint8_t)MATH_MIN(value, 255);
+    }
+
+    /* Leave the scratch cells zeroed for the next row */
+    memset(&scanline->cells[touched_min], 0, (touched_max - touched_min + 3) * sizeof(int32_t));
+    memset(&scanline->runs[touched_min], 0, (touched_max - touched_min + 3) * sizeof(int32_t));
+
+    *x_start = touched_min;
+    *x_end = touched_max + 1;
+    return true;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void raster_add_edge(struct vg_lite_test_ref_raster_s* raster, struct raster_point_s p0, struct raster_point_s p1)
+{
+    /* Horizontal edges never cross a sub-scanline */
+    if (p0.y == p1.y) {
+        return;
+    }
+
+    if (raster->edge_count >= raster->edge_capacity) {
+        raster->edge_capacity = raster->edge_capacity ? raster->edge_capacity * 2 : 64;
+        raster->edges = realloc(raster->edges, raster->edge_capacity * sizeof(struct vg_lite_test_ref_edge_s));
+        GPU_ASSERT_NULL(raster->edges);
+    }
+
+    struct vg_lite_test_ref_edge_s* edge = &raster->edges[raster->edge_count++];
+    if (p0.y < p1.y) {
+        edge->x0 = p0.x;
+        edge->y0 = p0.y;
+        edge->x1 = p1.x;
+        edge->y1 = p1.y;
+        edge->winding = 1;
+    } else {
+        edge->x0 = p1.x;
+        edge->y0 = p1.y;
+        edge->x1 = p0.x;
+        edge->y1 = p0.y;
+        edge->winding = -1;
+    }
+
+    raster->min_y = MATH_MIN(raster->min_y, edge->y0);
+    raster->max_y = MATH_MAX(raster->max_y, edge->y1);
+}
+
+static struct raster_point_s raster_transform(const vg_lite_matrix_t* matrix, float x, float y)
+{
+    float tx = matrix->m[0][0] * x + matrix->m[0][1] * y + matrix->m[0][2];
+    float ty = matrix->m[1][0] * x + matrix->m[1][1] * y + matrix->m[1][2];
+    float w = matrix->m[2][0] * x + matrix->m[2][1] * y + matrix->m[2][2];
+
+    if (w != 1.0f && w != 0.0f) {
+        tx /= w;
+        ty /= w;
+    }
+
+    /* Snap to the 24.8 grid as early as possible, everything after this is integer math */
+    tx = MATH_CLAMP(tx * VG_LITE_TEST_REF_RASTER_ONE, -RASTER_COORD_LIMIT, RASTER_COORD_LIMIT);
+    ty = MATH_CLAMP(ty * VG_LITE_TEST_REF_RASTER_ONE, -RASTER_COORD_LIMIT, RASTER_COORD_LIMIT);
+
+    struct raster_point_s point = {
+        (int32_t)(tx < 0 ? tx - 0.5f : tx + 0.5f),
+        (int32_t)(ty < 0 ? ty - 0.5f : ty + 0.5f),
+    };
+    return point;
+}
+
+static int64_t raster_div_round(int64_t a, int64_t b)
+{
+    /* Round half away from zero, the same on every platform */
+    if (b < 0) {
+        a = -a;
+        b = -b;
+    }
+
+    return a >= 0 ? (a + b / 2) / b : -((-a + b / 2) / b);
+}
+
+static int32_t raster_curve_segments(int32_t dev, int32_t scale)
+{
+    /* The flattening error shrinks with the square of the segment count */
+    int64_t target = ((int64_t)dev * scale) / (4 * RASTER_FLATTEN_TOLERANCE);
+    int32_t n = 1;
+    while (n < RASTER_CURVE_SEGMENTS_MAX && (int64_t)n * n < target) {
+        n++;
+    }
+
+    return n;
+}
+
+static void raster_add_quad(struct vg_lite_test_ref_raster_s* raster, const struct raster_point_s p[3])
+{
+    int32_t dev = MATH_MAX(
+        MATH_ABS(p[0].x - 2 * p[1].x + p[2].x),
+        MATH_ABS(p[0].y - 2 * p[1].y + p[2].y));
+    const int64_t n = raster_curve_segments(dev, 1);
+    const int64_t nn = n * n;
+
+    struct raster_point_s prev = p[0];
+    for (int64_t i = 1; i <= n; i++) {
+        const int64_t a = (n - i) * (n - i);
+        const int64_t b = 2 * i * (n - i);
+        const int64_t c = i * i;
+
+        struct raster_point_s cur = {
+            (int32_t)raster_div_round(a * p[0].x + b * p[1].x + c * p[2].x, nn),
+            (int32_t)raster_div_round(a * p[0].y + b * p[1].y + c * p[2].y, nn),
+        };
+        raster_add_edge(raster, prev, cur);
+        prev = cur;
+    }
+}
+
+static void raster_add_cubic(struct vg_lite_test_ref_raster_s* raster, const struct raster_point_s p[4])
+{
+    int32_t dev = MATH_MAX(
+        MATH_MAX(MATH_ABS(p[0].x - 2 * p[1].x + p[2].x), MATH_ABS(p[0].y - 2 * p[1].y + p[2].y)),
+        MATH_MAX(MATH_ABS(p[1].x - 2 * p[2].x + p[3].x), MATH_ABS(p[1].y - 2 * p[2].y + p[3].y)));
+    const int64_t n = raster_curve_segments(dev, 3);
+    const int64_t nnn = n * n * n;
+
+    struct raster_point_s prev = p[0];
+    for (int64_t i = 1; i <= n; i++) {
+        const int64_t j = n - i;
+        const int64_t a = j * j * j;
+        const int64_t b = 3 * i * j * j;
+        const int64_t c = 3 * i * i * j;
+        const int64_t d = i * i * i;
+
+        struct raster_point_s cur = {
+            (int32_t)raster_div_round(a * p[0].x + b * p[1].x + c * p[2].x + d * p[3].x, nnn),
+            (int32_t)raster_div_round(a * p[0].y + b * p[1].y + c * p[2].y + d * p[3].y, nnn),
+        };
+        raster_add_edge(raster, prev, cur);
+        prev = cur;
+    }
+}
+
+static void raster_walker_line_to(struct raster_walker_s* walker, float x, float y)
+{
+    raster_add_edge(
+        walker->raster,
+        raster_transform(walker->matrix, walker->cur_x, walker->cur_y),
+        raster_transform(walker->matrix, x, y));
+    walker->cur_x = x;
+    walker->cur_y = y;
+    walker->has_subpath = true;
+}
+
+static void raster_walker_close(struct raster_walker_s* walker)
+{
+    if (walker->has_subpath) {
+        raster_walker_line_to(walker, walker->start_x, walker->start_y);
+    }
+
+    walker->has_subpath = false;
+}
+
+static void raster_walker_quad_to(struct raster_walker_s* walker, float cx, float cy, float x, float y)
+{
+    const struct raster_point_s p[3] = {
+        raster_transform(walker->matrix, walker->cur_x, walker->cur_y),
+        raster_transform(walker->matrix, cx, cy),
+        raster_transform(walker->matrix, x, y),
+    };
+    raster_add_quad(walker->raster, p);
+
+    walker->ctrl_x = cx;
+    walker->ctrl_y = cy;
+    walker->cur_x = x;
+    walker->cur_y = y;
+    walker->has_subpath = true;
+}
+
+static void raster_walker_cubic_to(struct raster_walker_s* walker, float c1x, float c1y, float c2x, float c2y, float x, float y)
+{
+    const struct raster_point_s p[4] = {
+        raster_transform(walker->matrix, walker->cur_x, walker->cur_y),
+        raster_transform(walker->matrix, c1x, c1y),
+        raster_transform(walker->matrix, c2x, c2y),
+        raster_transform(walker->matrix, x, y),
+    };
+    raster_add_cubic(walker->raster, p);
+
+    walker->ctrl_x = c2x;
+    walker->ctrl_y = c2y;
+    walker->cur_x = x;
+    walker->cur_y = y;
+    walker->has_subpath = true;
+}
+
+static void raster_path_iter_cb(void* user_data, uint8_t op_code, const float* data, uint32_t len)
+{
+    struct raster_walker_s* walker = user_data;
+
+    /* Relative ops carry offsets from the current point */
+    float ox = 0;
+    float oy = 0;
+    switch (op_code) {
+    case VLC_OP_MOVE_REL:
+    case VLC_OP_LINE_REL:
+    case VLC_OP_QUAD_REL:
+    case VLC_OP_CUBIC_REL:
+    case VLC_OP_HLINE_REL:
+    case VLC_OP_VLINE_REL:
+    case VLC_OP_SQUAD_REL:
+    case VLC_OP_SCUBIC_REL:
+    case VLC_OP_SCCWARC_REL:
+    case VLC_OP_SCWARC_REL:
+    case VLC_OP_LCCWARC_REL:
+    case VLC_OP_LCWARC_REL:
+        ox = walker->cur_x;
+        oy = walker->cur_y;
+        break;
+    default:
+        break;
+    }
+
+    /* Smooth curves mirror the previous control point only after a curve of the same kind */
+    bool prev_quad = walker->last_op == VLC_OP_QUAD || walker->last_op == VLC_OP_QUAD_REL
+        || walker->last_op == VLC_OP_SQUAD || walker->last_op == VLC_OP_SQUAD_REL;
+    bool prev_cubic = walker->last_op == VLC_OP_CUBIC || walker->last_op == VLC_OP_CUBIC_REL
+        || walker->last_op == VLC_OP_SCUBIC || walker->last_op == VLC_OP_SCUBIC_REL;
+    float mirror_x = walker->cur_x;
+    float mirror_y = walker->cur_y;
+    if ((op_code == VLC_OP_SQUAD || op_code == VLC_OP_SQUAD_REL) ? prev_quad : prev_cubic) {
+        mirror_x = 2 * walker->cur_x - walker->ctrl_x;
+        mirror_y = 2 * walker->cur_y - walker->ctrl_y;
+    }
+
+    switch (op_code) {
+    case VLC_OP_END:
+    case VLC_OP_CLOSE:
+        raster_walker_close(walker);
+        walker->cur_x = walker->start_x;
+        walker->cur_y = walker->start_y;
+        break;
+
+    case VLC_OP_MOVE:
+    case VLC_OP_MOVE_REL:
+        raster_walker_close(walker);
+        walker->start_x = walker->cur_x = ox + data[0];
+        walker->start_y = walker->cur_y = oy + data[1];
+        break;
+
+    case VLC_OP_LINE:
+    case VLC_OP_LINE_REL:
+        raster_walker_line_to(walker, ox + data[0], oy + data[1]);
+        break;
+
+    case VLC_OP_HLINE:
+    case VLC_OP_HLINE_REL:
+        raster_walker_line_to(walker, ox + data[0], walker->cur_y);
+        break;
+
+    case VLC_OP_VLINE:
+    case VLC_OP_VLINE_REL:
+        raster_walker_line_to(walker, walker->cur_x, oy + data[0]);
+        break;
+
+    case VLC_OP_QUAD:
+    case VLC_OP_QUAD_REL:
+        raster_walker_quad_to(walker, ox + data[0], oy + data[1], ox + data[2], oy + data[3]);
+        break;
+
+    case VLC_OP_SQUAD:
+    case VLC_OP_SQUAD_REL:
+        raster_walker_quad_to(walker, mirror_x, mirror_y, ox + data[0], oy + data[1]);
+        break;
+
+    case VLC_OP_CUBIC:
+    case VLC_OP_CUBIC_REL:
+        raster_walker_cubic_to(walker, ox + data[0], oy + data[1], ox + data[2], oy + data[3], ox + data[4], oy + data[5]);
+        break;
+
+    case VLC_OP_SCUBIC:
+    case VLC_OP_SCUBIC_REL:
+        raster_walker_cubic_to(walker, mirror_x, mirror_y, ox + data[0], oy + data[1], ox + data[2], oy + data[3]);
+        break;
+
+    case VLC_OP_SCCWARC:
+    case VLC_OP_SCCWARC_REL:
+    case VLC_OP_SCWARC:
+    case VLC_OP_SCWARC_REL:
+    case VLC_OP_LCCWARC:
+    case VLC_OP_LCCWARC_REL:
+    case VLC_OP_LCWARC:
+    case VLC_OP_LCWARC_REL:
+        /* Arguments: rx, ry, rotation, x, y */
+        walker->raster->unsupported = true;
+        raster_walker_line_to(walker, ox + data[3], oy + data[4]);
+        break;
+
+    default:
+        /* BREAK and unknown ops do not draw anything */
+        break;
+    }
+
+    walker->last_op = op_code;
+}
+
+static void raster_sort_crossings(struct vg_lite_test_ref_crossing_s* crossings, uint32_t count)
+{
+    /* Insertion sort, the lists are short and mostly sorted already */
+    for (uint32_t i = 1; i < count; i++) {
+        struct vg_lite_test_ref_crossing_s key = crossings[i];
+        uint32_t j = i;
+        while (j > 0 && crossings[j - 1].x > key.x) {
+            crossings[j] = crossings[j - 1];
+            j--;
+        }
+        crossings[j] = key;
+    }
+}
+
+static void raster_add_span(struct vg_lite_test_ref_scanline_s* scanline, int32_t samples, int32_t xa, int32_t xb)
+{
+    const int32_t one = VG_LITE_TEST_REF_RASTER_ONE;
+    const int32_t half = one / 2;
+    const int32_t shift = VG_LITE_TEST_REF_RASTER_SHIFT;
+
+    if (samples == 1) {
+        /* Point sampling: the pixels whose center lies inside the span */
+        int32_t ia = (xa - half + one - 1) >> shift;
+        int32_t ib = (xb - half + one - 1) >> shift;
+        if (ia < ib) {
+            scanline->runs[ia] += one;
+            scanline->runs[ib] -= one;
+        }
+        return;
+    }
+
+    /* Exact horizontal area, full pixels go to the run-length differences */
+    int32_t ia = xa >> shift;
+    int32_t ib = xb >> shift;
+    if (ia == ib) {
+        scanline->cells[ia] += xb - xa;
+        return;
+    }
+
+    scanline->cells[ia] += one - (xa & (one - 1));
+    scanline->runs[ia + 1] += one;
+    scanline->runs[ib] -= one;
+    scanline->cells[ib] += xb & (one - 1);
+}
@@ -0,0 +1,183 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_REF_RASTER_H
+#define VG_LITE_TEST_REF_RASTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <vg_lite.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Edge coordinates are 24.8 fixed point */
+#define VG_LITE_TEST_REF_RASTER_SHIFT 8
+#define VG_LITE_TEST_REF_RASTER_ONE (1 << VG_LITE_TEST_REF_RASTER_SHIFT)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_ref_edge_s {
+    int32_t x0;
+    int32_t y0;
+    int32_t x1;
+    int32_t y1;
+    int32_t winding;
+};
+
+struct vg_lite_test_ref_crossing_s {
+    int32_t x;
+    int32_t winding;
+};
+
+struct vg_lite_test_ref_raster_s {
+    struct vg_lite_test_ref_edge_s* edges;
+    uint32_t edge_count;
+    uint32_t edge_capacity;
+    int32_t min_y;
+    int32_t max_y;
+    bool unsupported;
+};
+
+/* Per-thread scratch memory, one row of the target at a time */
+struct vg_lite_test_ref_scanline_s {
+    const struct vg_lite_test_ref_edge_s** band_edges;
+    uint32_t band_edge_count;
+    uint32_t band_edge_capacity;
+    struct vg_lite_test_ref_crossing_s* crossings;
+    uint32_t crossing_capacity;
+    int32_t* cells;
+    int32_t* runs;
+    int32_t width;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Initialize an empty edge list.
+ * @param raster The raster to initialize.
+ */
+void vg_lite_test_ref_raster_init(struct vg_lite_test_ref_raster_s* raster);
+
+/**
+ * @brief Free the memory of an edge list.
+ * @param raster The raster to deinitialize.
+ */
+void vg_lite_test_ref_raster_deinit(struct vg_lite_test_ref_raster_s* raster);
+
+/**
+ * @brief Drop all edges, keeping the memory for the next shape.
+ * @param raster The raster to reset.
+ */
+void vg_lite_test_ref_raster_reset(struct vg_lite_test_ref_raster_s* raster);
+
+/**
+ * @brief Flatten a path into edges in target space.
+ * @param raster The raster to add the edges to.
+ * @param path The path to flatten, every sub-path is closed implicitly.
+ * @param matrix The path to target transformation.
+ * @note Arcs are approximated by a line and flag the raster as unsupported.
+ */
+void vg_lite_test_ref_raster_add_path(struct vg_lite_test_ref_raster_s* raster, const vg_lite_path_t* path, const vg_lite_matrix_t* matrix);
+
+/**
+ * @brief Add a transformed rectangle, used for the image area of blits.
+ * @param raster The raster to add the edges to.
+ * @param width The width of the rectangle.
+ * @param height The height of the rectangle.
+ * @param matrix The rectangle to target transformation.
+ */
+void vg_lite_test_ref_raster_add_rect(struct vg_lite_test_ref_raster_s* raster, float width, float height, const vg_lite_matrix_t* matrix);
+
+/**
+ * @brief Initialize the scratch memory of a worker.
+ * @param scanline The scanline to initialize.
+ * @param width The width of the widest target.
+ */
+void vg_lite_test_ref_scanline_init(struct vg_lite_test_ref_scanline_s* scanline, int32_t width);
+
+/**
+ * @brief Free the scratch memory of a worker.
+ * @param scanline The scanline to deinitialize.
+ */
+void vg_lite_test_ref_scanline_deinit(struct vg_lite_test_ref_scanline_s* scanline);
+
+/**
+ * @brief Collect the edges touching a band of rows.
+ * @param scanline The worker scratch memory.
+ * @param raster The edge list.
+ * @param y_start The first row of the band.
+ * @param y_end The row after the last row of the band.
+ */
+void vg_lite_test_ref_scanline_select_band(
+    struct vg_lite_test_ref_scanline_s* scanline,
+    const struct vg_lite_test_ref_raster_s* raster,
+    int32_t y_start,
+    int32_t y_end);
+
+/**
+ * @brief Compute the coverage of one row from the selected band edges.
+ * @param scanline The worker scratch memory.
+ * @param y The row to render.
+ * @param samples The number of sub-scanlines per row, 1 samples the pixel centers only.
+ * @param fill_rule The fill rule.
+ * @param clip_x0 The first column to render.
+ * @param clip_x1 The column after the last column to render.
+ * @param coverage The coverage output (0 - 255), indexed by the column.
+ * @param x_start The first column written to the coverage.
+ * @param x_end The column after the last column written to the coverage.
+ * @return True if any column of the row is covered.
+ */
+bool vg_lite_test_ref_scanline_render(
+    struct vg_lite_test_ref_scanline_s* scanline,
+    int32_t y,
+    int32_t samples,
+    vg_lite_fill_t fill_rule,
+    int32_t clip_x0,
+    int32_t clip_x1,
+    uint8_t* coverage,
+    int32_t* x_start,
+    int32_t* x_end);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_REF_RASTER_H*/
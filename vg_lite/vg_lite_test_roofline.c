@@ -0,0 +1,343 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_roofline.h"
+#include "../gpu_assert.h"
+#include "../gpu_cache.h"
+#include "../gpu_context.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_recorder.h"
+#include "../gpu_tick.h"
+#include "vg_lite_test_path.h"
+#include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/* Minimum measuring time of each operation and size */
+#define ROOFLINE_BENCHMARK_TIME_MS 50
+
+/* The region grows by this factor from ROOFLINE_SIZE_MIN to the full target */
+#define ROOFLINE_SIZE_MIN 1024
+#define ROOFLINE_SIZE_STEP 4
+
+/* GPU calls submitted before waiting, a wait per call would only measure the latency */
+#define ROOFLINE_GPU_BATCH 8
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+enum roofline_op_e {
+    ROOFLINE_OP_CPU_MEMSET,
+    ROOFLINE_OP_CPU_MEMCPY,
+    ROOFLINE_OP_GPU_CLEAR,
+    ROOFLINE_OP_GPU_BLIT,
+    ROOFLINE_OP_GPU_FILL,
+    _ROOFLINE_OP_LAST
+};
+
+struct roofline_bench_s {
+    struct gpu_buffer_s* target_gpu_buffer;
+    struct gpu_buffer_s* src_gpu_buffer;
+    vg_lite_buffer_t target;
+    vg_lite_buffer_t src;
+    vg_lite_test_path_t* path;
+    vg_lite_matrix_t matrix;
+
+    /* The measured region, at the top left of the buffers */
+    vg_lite_rectangle_t rect;
+    uint32_t region_bytes;
+};
+
+typedef vg_lite_error_t (*roofline_op_cb_t)(struct roofline_bench_s* bench);
+
+struct roofline_op_s {
+    const char* name;
+    bool gpu;
+
+    /* Times the region is accessed per call, a copy reads and writes it */
+    uint32_t access;
+    roofline_op_cb_t run;
+};
+
+struct vg_lite_test_roofline_s {
+    float peak_gbps[_ROOFLINE_OP_LAST];
+    float gpu_peak_gbps;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static vg_lite_error_t roofline_cpu_memset(struct roofline_bench_s* bench);
+static vg_lite_error_t roofline_cpu_memcpy(struct roofline_bench_s* bench);
+static vg_lite_error_t roofline_gpu_clear(struct roofline_bench_s* bench);
+static vg_lite_error_t roofline_gpu_blit(struct roofline_bench_s* bench);
+static vg_lite_error_t roofline_gpu_fill(struct roofline_bench_s* bench);
+static void roofline_set_region(struct roofline_bench_s* bench, uint32_t size);
+static bool roofline_measure(struct roofline_bench_s* bench, const struct roofline_op_s* op, uint32_t* loops, uint32_t* time_us);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static const struct roofline_op_s roofline_ops[_ROOFLINE_OP_LAST] = {
+    [ROOFLINE_OP_CPU_MEMSET] = { "cpu_memset", false, 1, roofline_cpu_memset },
+    [ROOFLINE_OP_CPU_MEMCPY] = { "cpu_memcpy", false, 2, roofline_cpu_memcpy },
+    [ROOFLINE_OP_GPU_CLEAR] = { "gpu_clear", true, 1, roofline_gpu_clear },
+    [ROOFLINE_OP_GPU_BLIT] = { "gpu_blit", true, 2, roofline_gpu_blit },
+    [ROOFLINE_OP_GPU_FILL] = { "gpu_fill", true, 1, roofline_gpu_fill },
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct vg_lite_test_roofline_s* vg_lite_test_roofline_create(struct gpu_test_context_s* gpu_ctx)
+{
+    GPU_ASSERT_NULL(gpu_ctx);
+
+    struct vg_lite_test_roofline_s* roofline = malloc(sizeof(struct vg_lite_test_roofline_s));
+    GPU_ASSERT_NULL(roofline);
+    memset(roofline, 0, sizeof(struct vg_lite_test_roofline_s));
+
+    const vg_lite_buffer_format_t format = vg_lite_test_gpu_format_to_vg_format(gpu_ctx->param.target_format);
+
+    struct roofline_bench_s bench;
+    memset(&bench, 0, sizeof(bench));
+    bench.target_gpu_buffer = vg_lite_test_buffer_alloc(
+        &bench.target, gpu_ctx->param.target_width, gpu_ctx->param.target_height, format, VG_LITE_TEST_STRIDE_AUTO);
+    bench.src_gpu_buffer = vg_lite_test_buffer_alloc(
+        &bench.src, gpu_ctx->param.target_width, gpu_ctx->param.target_height, format, VG_LITE_TEST_STRIDE_AUTO);
+    bench.path = vg_lite_test_path_create(VG_LITE_FP32);
+    vg_lite_identity(&bench.matrix);
+
+    /* Touch every page before measuring */
+    memset(bench.src.memory, 0x5A, bench.src.stride * bench.src.height);
+    gpu_cache_flush(bench.src.memory, bench.src.stride * bench.src.height);
+
+    struct gpu_recorder_s* recorder = gpu_recorder_create(gpu_ctx->param.output_dir, "roofline");
+    if (recorder) {
+        gpu_recorder_write_string(recorder,
+            "Operation,Format,Region(bytes),Area,Loops,Time(ms),Throughput(GB/s),Pixel Rate(MPix/s)\n");
+    }
+
+    const uint32_t full_size = bench.target.stride * bench.target.height;
+    GPU_LOG_INFO("Roofline: %s %dx%d, %" PRIu32 " bytes",
+        vg_lite_test_buffer_format_string(format), (int)bench.target.width, (int)bench.target.height, full_size);
+
+    for (int i = 0; i < _ROOFLINE_OP_LAST; i++) {
+        const struct roofline_op_s* op = &roofline_ops[i];
+
+        for (uint32_t size = ROOFLINE_SIZE_MIN;; size *= ROOFLINE_SIZE_STEP) {
+            size = MATH_MIN(size, full_size);
+            roofline_set_region(&bench, size);
+
+            uint32_t loops = 0;
+            uint32_t time_us = 0;
+            if (!roofline_measure(&bench, op, &loops, &time_us)) {
+                break;
+            }
+
+            /* Bytes per microsecond is MB/s */
+            double bytes = (double)loops * bench.region_bytes * op->access;
+            float gbps = time_us ? bytes / time_us / 1000.0 : 0.0f;
+            float mpix = time_us ? (double)loops * bench.rect.width * bench.rect.height / time_us : 0.0f;
+            roofline->peak_gbps[i] = MATH_MAX(roofline->peak_gbps[i], gbps);
+
+            GPU_LOG_INFO("Roofline %s %" PRIu32 " bytes (%dx%d): %0.3f GB/s, %0.1f MPix/s",
+                op->name, bench.region_bytes, (int)bench.rect.width, (int)bench.rect.height, gbps, mpix);
+
+            if (recorder) {
+                char result[256];
+                snprintf(result, sizeof(result), "%s,%s,%" PRIu32 ",%dx%d,%" PRIu32 ",%0.3f,%0.3f,%0.1f\n",
+                    op->name,
+                    vg_lite_test_buffer_format_string(format),
+                    bench.region_bytes,
+                    (int)bench.rect.width,
+                    (int)bench.rect.height,
+                    loops,
+                    time_us / 1000.0f,
+                    gbps,
+                    mpix);
+                gpu_recorder_write_string(recorder, result);
+            }
+
+            if (size == full_size) {
+                break;
+            }
+        }
+
+        if (op->gpu) {
+            roofline->gpu_peak_gbps = MATH_MAX(roofline->gpu_peak_gbps, roofline->peak_gbps[i]);
+        }
+    }
+
+    if (recorder) {
+        gpu_recorder_delete(recorder);
+    }
+
+    vg_lite_test_path_destroy(bench.path);
+    gpu_buffer_free(bench.target_gpu_buffer);
+    gpu_buffer_free(bench.src_gpu_buffer);
+
+    GPU_LOG_WARN("Roofline peak: memset %0.3f, memcpy %0.3f, clear %0.3f, blit %0.3f, fill %0.3f GB/s",
+        roofline->peak_gbps[ROOFLINE_OP_CPU_MEMSET],
+        roofline->peak_gbps[ROOFLINE_OP_CPU_MEMCPY],
+        roofline->peak_gbps[ROOFLINE_OP_GPU_CLEAR],
+        roofline->peak_gbps[ROOFLINE_OP_GPU_BLIT],
+        roofline->peak_gbps[ROOFLINE_OP_GPU_FILL]);
+
+    return roofline;
+}
+
+void vg_lite_test_roofline_destroy(struct vg_lite_test_roofline_s* roofline)
+{
+    GPU_ASSERT_NULL(roofline);
+    free(roofline);
+}
+
+float vg_lite_test_roofline_percent(const struct vg_lite_test_roofline_s* roofline, uint64_t bytes, uint32_t time_us)
+{
+    GPU_ASSERT_NULL(roofline);
+    if (time_us == 0 || roofline->gpu_peak_gbps <= 0.0f) {
+        return 0.0f;
+    }
+
+    float gbps = (double)bytes / time_us / 1000.0;
+    return gbps * 100.0f / roofline->gpu_peak_gbps;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static vg_lite_error_t roofline_cpu_memset(struct roofline_bench_s* bench)
+{
+    memset(bench->target.memory, 0xA5, bench->region_bytes);
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t roofline_cpu_memcpy(struct roofline_bench_s* bench)
+{
+    memcpy(bench->target.memory, bench->src.memory, bench->region_bytes);
+    return VG_LITE_SUCCESS;
+}
+
+static vg_lite_error_t roofline_gpu_clear(struct roofline_bench_s* bench)
+{
+    return vg_lite_clear(&bench->target, &bench->rect, 0xFF336699);
+}
+
+static vg_lite_error_t roofline_gpu_blit(struct roofline_bench_s* bench)
+{
+    return vg_lite_blit_rect(&bench->target, &bench->src, &bench->rect, &bench->matrix,
+        VG_LITE_BLEND_NONE, 0, VG_LITE_FILTER_POINT);
+}
+
+static vg_lite_error_t roofline_gpu_fill(struct roofline_bench_s* bench)
+{
+    return vg_lite_draw(&bench->target, vg_lite_test_path_get_path(bench->path), VG_LITE_FILL_NON_ZERO,
+        &bench->matrix, VG_LITE_BLEND_NONE, 0xFF996633);
+}
+
+static void roofline_set_region(struct roofline_bench_s* bench, uint32_t size)
+{
+    uint32_t mul, div, align;
+    vg_lite_test_buffer_format_bytes(bench->target.format, &mul, &div, &align);
+
+    /* Full rows first, a small region is a part of the first row */
+    uint32_t pixels = MATH_MAX(size * div / mul, 1);
+    uint32_t width = MATH_MIN(pixels, (uint32_t)bench->target.width);
+    uint32_t height = MATH_CLAMP(pixels / width, 1, (uint32_t)bench->target.height);
+
+    bench->rect.x = 0;
+    bench->rect.y = 0;
+    bench->rect.width = width;
+    bench->rect.height = height;
+    bench->region_bytes = width * height * mul / div;
+
+    vg_lite_test_path_reset(bench->path, VG_LITE_FP32);
+    vg_lite_test_path_append_rect(bench->path, 0, 0, width, height, 0);
+    vg_lite_test_path_end(bench->path);
+}
+
+static bool roofline_measure(struct roofline_bench_s* bench, const struct roofline_op_s* op, uint32_t* loops, uint32_t* time_us)
+{
+    const int batch = op->gpu ? ROOFLINE_GPU_BATCH : 1;
+    uint32_t count = 0;
+    uint32_t elapsed = 0;
+    uint32_t start_tick = 0;
+
+    /* The first batch warms up the caches and the command buffer, it is not counted */
+    for (int pass = 0; pass < 2; pass++) {
+        count = 0;
+        start_tick = gpu_tick_get();
+
+        do {
+            for (int i = 0; i < batch; i++) {
+                vg_lite_error_t error = op->run(bench);
+                if (error != VG_LITE_SUCCESS) {
+                    GPU_LOG_WARN("Roofline %s failed: %d (%s)", op->name, error, vg_lite_test_error_string(error));
+                    vg_lite_finish();
+                    return false;
+                }
+            }
+
+            if (op->gpu) {
+                vg_lite_error_t error = vg_lite_finish();
+                if (error != VG_LITE_SUCCESS) {
+                    GPU_LOG_WARN("Roofline %s finish failed: %d (%s)", op->name, error, vg_lite_test_error_string(error));
+                    return false;
+                }
+            }
+
+            count += batch;
+            elapsed = gpu_tick_elaps(start_tick);
+        } while (pass > 0 && elapsed < ROOFLINE_BENCHMARK_TIME_MS * 1000);
+    }
+
+    /* Write the CPU results back before the GPU uses the buffer */
+    if (!op->gpu) {
+        gpu_cache_flush(bench->target.memory, bench->region_bytes);
+    }
+
+    *loops = count;
+    *time_us = elapsed;
+    return true;
+}
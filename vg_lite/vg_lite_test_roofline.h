@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_ROOFLINE_H
+#define VG_LITE_TEST_ROOFLINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_test_context_s;
+struct vg_lite_test_roofline_s;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Measure the memory bandwidth of the CPU and the GPU on buffers of the target size and format.
+ * @param gpu_ctx The GPU test context.
+ * @return The measured roofline.
+ * @note memset, memcpy, vg_lite_clear, 1:1 vg_lite_blit_rect and a solid rectangle vg_lite_draw are measured
+ *       from 1 KB up to the full target, the table is written to report_roofline.csv.
+ */
+struct vg_lite_test_roofline_s* vg_lite_test_roofline_create(struct gpu_test_context_s* gpu_ctx);
+
+/**
+ * @brief Destroy the roofline.
+ * @param roofline The roofline.
+ */
+void vg_lite_test_roofline_destroy(struct vg_lite_test_roofline_s* roofline);
+
+/**
+ * @brief Get the fraction of the GPU roofline reached by a test item.
+ * @param roofline The roofline.
+ * @param bytes The bytes moved by the item.
+ * @param time_us The time the GPU took.
+ * @return The percentage of the best GPU bandwidth measured, 0 if there is none.
+ */
+float vg_lite_test_roofline_percent(const struct vg_lite_test_roofline_s* roofline, uint64_t bytes, uint32_t time_us);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_ROOFLINE_H*/
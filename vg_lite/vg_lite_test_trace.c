@@ -0,0 +1,1450 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_trace.h"
+#include "../gpu_assert.h"
+#include "../gpu_buffer.h"
+#include "../gpu_cache.h"
+#include "../gpu_context.h"
+#include "../gpu_log.h"
+#include "../gpu_math.h"
+#include "../gpu_recorder.h"
+#include "../gpu_tick.h"
+#include "../gpu_utils.h"
+#include "vg_lite_test_hook.h"
+#include "vg_lite_test_utils.h"
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define TRACE_MAGIC "VGLT"
+#define TRACE_VERSION 1
+
+/* Every record payload is padded to this size */
+#define TRACE_ALIGN 4
+
+#define TRACE_ID_NONE UINT32_MAX
+
+/* Entries of the color lookup table of an INDEX_8 image */
+#define TRACE_CLUT_MAX 256
+
+#define TRACE_HASH_INIT 0xCBF29CE484222325ULL
+#define TRACE_HASH_PRIME 0x100000001B3ULL
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * The trace file is a header followed by records. Each record is a
+ * trace_record_header_s and a payload of host endian 32-bit words.
+ *
+ * Blobs (image contents), paths and gradients are resources shared by the
+ * whole trace and deduplicated by hash. Slots bind a blob to the memory of a
+ * buffer referenced by an item, they only live until the end of the item.
+ */
+enum trace_record_type_e {
+    TRACE_RECORD_ITEM_BEGIN = 1,
+    TRACE_RECORD_ITEM_END,
+    TRACE_RECORD_BLOB,
+    TRACE_RECORD_SLOT,
+    TRACE_RECORD_PATH,
+    TRACE_RECORD_GRAD,
+    TRACE_RECORD_LINEAR_GRAD,
+    TRACE_RECORD_RADIAL_GRAD,
+    TRACE_RECORD_CALL,
+};
+
+struct trace_file_header_s {
+    char magic[4];
+    uint32_t version;
+    uint32_t reserved[2];
+};
+
+struct trace_record_header_s {
+    uint16_t type;
+    uint16_t api;
+    uint32_t size;
+};
+
+struct trace_data_s {
+    uint8_t* data;
+    uint32_t size;
+    uint32_t capacity;
+};
+
+struct trace_resource_s {
+    uint64_t hash;
+    uint32_t size;
+    uint16_t type;
+};
+
+struct trace_writer_s {
+    FILE* fp;
+    bool item_active;
+    bool write_error;
+    struct trace_data_s call_data;
+    struct trace_data_s res_data;
+    struct trace_resource_s* resources;
+    uint32_t resource_count;
+    uint32_t resource_capacity;
+    const void** slots;
+    uint32_t slot_count;
+    uint32_t slot_capacity;
+    uint32_t item_count;
+    uint32_t call_count;
+    uint64_t file_size;
+    struct vg_lite_test_hook_listener_s listener;
+};
+
+struct trace_reader_s {
+    const uint8_t* cur;
+    const uint8_t* end;
+    bool error;
+};
+
+struct trace_replay_resource_s {
+    uint16_t type;
+    uint32_t size;
+    const void* data;
+    void* object;
+};
+
+struct trace_replay_slot_s {
+    struct gpu_buffer_s* gpu_buffer;
+    vg_lite_buffer_t buffer;
+};
+
+struct trace_replay_s {
+    struct gpu_test_context_s* gpu_ctx;
+    uint8_t* file_data;
+    size_t file_size;
+    struct trace_replay_resource_s* resources;
+    uint32_t resource_count;
+    struct trace_replay_slot_s* slots;
+    uint32_t slot_count;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static vg_lite_error_t trace_on_call(const struct vg_lite_test_hook_call_s* call, void* user_data);
+static void trace_emit(
+    enum trace_record_type_e type,
+    uint16_t api,
+    const void* head,
+    uint32_t head_size,
+    const void* tail,
+    uint32_t tail_size);
+static bool trace_next_record(
+    const uint8_t** pos,
+    const uint8_t* end,
+    struct trace_record_header_s* header,
+    const uint8_t** payload);
+static bool trace_replay_load(struct trace_replay_s* replay, const char* path);
+static bool trace_replay_prepare(struct trace_replay_s* replay);
+static void trace_replay_delete_resources(struct trace_replay_s* replay);
+static bool trace_replay_run_item(struct trace_replay_s* replay, const char* name, const uint8_t** pos);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static struct trace_writer_s trace_writer;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+bool vg_lite_test_trace_start(const char* path)
+{
+    GPU_ASSERT_NULL(path);
+
+    if (trace_writer.fp) {
+        GPU_LOG_WARN("Trace already started");
+        return false;
+    }
+
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        GPU_LOG_ERROR("Open trace file %s failed", path);
+        return false;
+    }
+
+    struct trace_file_header_s header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+
+    if (fwrite(&header, sizeof(header), 1, fp) != 1) {
+        GPU_LOG_ERROR("Write trace header to %s failed", path);
+        fclose(fp);
+        return false;
+    }
+
+    memset(&trace_writer, 0, sizeof(trace_writer));
+    trace_writer.fp = fp;
+    trace_writer.file_size = sizeof(header);
+    trace_writer.listener.on_call = trace_on_call;
+
+    if (vg_lite_test_hook_add_listener(&trace_writer.listener) < 0) {
+        fclose(fp);
+        memset(&trace_writer, 0, sizeof(trace_writer));
+        return false;
+    }
+
+    GPU_LOG_INFO("Trace started: %s", path);
+    return true;
+}
+
+void vg_lite_test_trace_stop(void)
+{
+    if (!trace_writer.fp) {
+        return;
+    }
+
+    vg_lite_test_trace_item_end();
+    vg_lite_test_hook_remove_listener(&trace_writer.listener);
+    fclose(trace_writer.fp);
+
+    GPU_LOG_INFO("Trace stopped: %" PRIu32 " items, %" PRIu32 " calls, %" PRIu32 " resources, %" PRIu64 " bytes",
+        trace_writer.item_count,
+        trace_writer.call_count,
+        trace_writer.resource_count,
+        trace_writer.file_size);
+
+    free(trace_writer.call_data.data);
+    free(trace_writer.res_data.data);
+    free(trace_writer.resources);
+    free(trace_writer.slots);
+    memset(&trace_writer, 0, sizeof(trace_writer));
+}
+
+void vg_lite_test_trace_item_begin(const char* name)
+{
+    GPU_ASSERT_NULL(name);
+
+    if (!trace_writer.fp) {
+        return;
+    }
+
+    if (trace_writer.item_active) {
+        GPU_LOG_WARN("Previous item not ended before '%s'", name);
+        vg_lite_test_trace_item_end();
+    }
+
+    trace_emit(TRACE_RECORD_ITEM_BEGIN, 0, name, strlen(name), NULL, 0);
+    trace_writer.item_active = true;
+    trace_writer.slot_count = 0;
+    trace_writer.item_count++;
+}
+
+void vg_lite_test_trace_item_end(void)
+{
+    if (!trace_writer.fp || !trace_writer.item_active) {
+        return;
+    }
+
+    trace_emit(TRACE_RECORD_ITEM_END, 0, NULL, 0, NULL, 0);
+    trace_writer.item_active = false;
+    trace_writer.slot_count = 0;
+    fflush(trace_writer.fp);
+}
+
+int vg_lite_test_trace_replay(struct gpu_test_context_s* ctx, const char* path)
+{
+    GPU_ASSERT_NULL(ctx);
+    GPU_ASSERT_NULL(path);
+
+    struct trace_replay_s replay;
+    memset(&replay, 0, sizeof(replay));
+    replay.gpu_ctx = ctx;
+
+    int retval = -1;
+    if (!trace_replay_load(&replay, path) || !trace_replay_prepare(&replay)) {
+        goto failed;
+    }
+
+    if (ctx->recorder) {
+        gpu_recorder_write_string(ctx->recorder,
+            "Testcase,"
+            "Calls,"
+            "Setup Time(ms),Draw Time(ms),Finish Time(ms),"
+            "VG-Lite Result,"
+            "Result"
+            "\n");
+    }
+
+    const uint8_t* end = replay.file_data + replay.file_size;
+    const uint8_t* pos = replay.file_data + sizeof(struct trace_file_header_s);
+    struct trace_record_header_s header;
+    const uint8_t* payload;
+    int total_count = 0;
+    int failed_count = 0;
+
+    while (trace_next_record(&pos, end, &header, &payload)) {
+        if (header.type != TRACE_RECORD_ITEM_BEGIN) {
+            continue;
+        }
+
+        char name[64];
+        snprintf(name, sizeof(name), "%.*s", (int)header.size, (const char*)payload);
+
+        total_count++;
+        if (!trace_replay_run_item(&replay, name, &pos)) {
+            failed_count++;
+        }
+    }
+
+    GPU_LOG_WARN("Replay result: %d failed / %d total", failed_count, total_count);
+    retval = failed_count == 0 ? 0 : -1;
+
+failed:
+    trace_replay_delete_resources(&replay);
+    free(replay.file_data);
+    return retval;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint64_t trace_hash(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* p = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= TRACE_HASH_PRIME;
+    }
+
+    return hash;
+}
+
+static void trace_array_reserve(void** array, uint32_t* capacity, uint32_t count, size_t elem_size)
+{
+    if (count <= *capacity) {
+        return;
+    }
+
+    uint32_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < count) {
+        new_capacity *= 2;
+    }
+
+    void* new_array = realloc(*array, new_capacity * elem_size);
+    GPU_ASSERT_NULL(new_array);
+    *array = new_array;
+    *capacity = new_capacity;
+}
+
+/* Payload builder */
+
+static void trace_data_put(struct trace_data_s* d, const void* data, uint32_t size)
+{
+    trace_array_reserve((void**)&d->data, &d->capacity, d->size + size, 1);
+    memcpy(d->data + d->size, data, size);
+    d->size += size;
+}
+
+static void trace_data_put_u32(struct trace_data_s* d, uint32_t value)
+{
+    trace_data_put(d, &value, sizeof(value));
+}
+
+static void trace_data_put_f32(struct trace_data_s* d, float value)
+{
+    trace_data_put(d, &value, sizeof(value));
+}
+
+static void trace_data_put_matrix(struct trace_data_s* d, const vg_lite_matrix_t* matrix)
+{
+    trace_data_put_u32(d, matrix != NULL);
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            trace_data_put_f32(d, matrix ? matrix->m[i][j] : 0.0f);
+        }
+    }
+}
+
+static void trace_data_put_rect(struct trace_data_s* d, const vg_lite_rectangle_t* rect)
+{
+    trace_data_put_u32(d, rect != NULL);
+    trace_data_put_u32(d, rect ? (uint32_t)rect->x : 0);
+    trace_data_put_u32(d, rect ? (uint32_t)rect->y : 0);
+    trace_data_put_u32(d, rect ? (uint32_t)rect->width : 0);
+    trace_data_put_u32(d, rect ? (uint32_t)rect->height : 0);
+}
+
+/* Writer */
+
+static void trace_emit(
+    enum trace_record_type_e type,
+    uint16_t api,
+    const void* head,
+    uint32_t head_size,
+    const void* tail,
+    uint32_t tail_size)
+{
+    static const uint8_t padding[TRACE_ALIGN] = { 0 };
+
+    struct trace_record_header_s header;
+    header.type = type;
+    header.api = api;
+    header.size = head_size + tail_size;
+    uint32_t padding_size = GPU_ALIGN_UP(header.size, TRACE_ALIGN) - header.size;
+
+    bool ok = fwrite(&header, sizeof(header), 1, trace_writer.fp) == 1;
+    ok = ok && (head_size == 0 || fwrite(head, head_size, 1, trace_writer.fp) == 1);
+    ok = ok && (tail_size == 0 || fwrite(tail, tail_size, 1, trace_writer.fp) == 1);
+    ok = ok && (padding_size == 0 || fwrite(padding, padding_size, 1, trace_writer.fp) == 1);
+
+    if (!ok && !trace_writer.write_error) {
+        GPU_LOG_ERROR("Write trace record failed, the trace will be incomplete");
+        trace_writer.write_error = true;
+    }
+
+    trace_writer.file_size += sizeof(header) + header.size + padding_size;
+}
+
+/**
+ * Look up a resource by its content hash.
+ * @return The resource ID, and whether the resource is new.
+ */
+static uint32_t trace_resource_get(enum trace_record_type_e type, uint64_t hash, uint32_t size, bool* is_new)
+{
+    for (uint32_t i = 0; i < trace_writer.resource_count; i++) {
+        const struct trace_resource_s* res = &trace_writer.resources[i];
+        if (res->hash == hash && res->size == size && res->type == type) {
+            *is_new = false;
+            return i;
+        }
+    }
+
+    trace_array_reserve(
+        (void**)&trace_writer.resources,
+        &trace_writer.resource_capacity,
+        trace_writer.resource_count + 1,
+        sizeof(struct trace_resource_s));
+
+    struct trace_resource_s* res = &trace_writer.resources[trace_writer.resource_count];
+    res->hash = hash;
+    res->size = size;
+    res->type = type;
+    *is_new = true;
+    return trace_writer.resource_count++;
+}
+
+static uint32_t trace_blob_get(const void* data, uint32_t size)
+{
+    uint64_t hash = trace_hash(TRACE_HASH_INIT, data, size);
+
+    bool is_new;
+    uint32_t id = trace_resource_get(TRACE_RECORD_BLOB, hash, size, &is_new);
+    if (is_new) {
+        uint32_t head[4] = { id, size, (uint32_t)hash, (uint32_t)(hash >> 32) };
+        trace_emit(TRACE_RECORD_BLOB, 0, head, sizeof(head), data, size);
+    }
+
+    return id;
+}
+
+/**
+ * Resources described by res_data (first word is the ID placeholder) and an
+ * optional tail. The ID is patched in before the record is emitted.
+ */
+static uint32_t trace_res_data_commit(enum trace_record_type_e type, const void* tail, uint32_t tail_size)
+{
+    struct trace_data_s* d = &trace_writer.res_data;
+    uint64_t hash = trace_hash(TRACE_HASH_INIT, d->data + sizeof(uint32_t), d->size - sizeof(uint32_t));
+    hash = trace_hash(hash, tail, tail_size);
+
+    bool is_new;
+    uint32_t id = trace_resource_get(type, hash, d->size + tail_size, &is_new);
+    if (is_new) {
+        memcpy(d->data, &id, sizeof(id));
+        trace_emit(type, 0, d->data, d->size, tail, tail_size);
+    }
+
+    return id;
+}
+
+static uint32_t trace_path_get(const vg_lite_path_t* path)
+{
+    if (!path) {
+        return TRACE_ID_NONE;
+    }
+
+    struct trace_data_s* d = &trace_writer.res_data;
+    d->size = 0;
+    trace_data_put_u32(d, TRACE_ID_NONE);
+    trace_data_put_u32(d, path->format);
+    trace_data_put_u32(d, path->quality);
+    for (int i = 0; i < 4; i++) {
+        trace_data_put_f32(d, path->bounding_box[i]);
+    }
+    trace_data_put_u32(d, path->path_length);
+
+    return trace_res_data_commit(TRACE_RECORD_PATH, path->path, path->path ? path->path_length : 0);
+}
+
+static uint32_t trace_grad_get(const vg_lite_linear_gradient_t* grad)
+{
+    if (!grad) {
+        return TRACE_ID_NONE;
+    }
+
+    struct trace_data_s* d = &trace_writer.res_data;
+    d->size = 0;
+    trace_data_put_u32(d, TRACE_ID_NONE);
+    trace_data_put_u32(d, grad->count);
+    trace_data_put(d, grad->colors, sizeof(grad->colors));
+    trace_data_put(d, grad->stops, sizeof(grad->stops));
+    trace_data_put_matrix(d, &grad->matrix);
+
+    return trace_res_data_commit(TRACE_RECORD_GRAD, NULL, 0);
+}
+
+static uint32_t trace_linear_grad_get(const vg_lite_ext_linear_gradient_t* grad)
+{
+    if (!grad) {
+        return TRACE_ID_NONE;
+    }
+
+    uint32_t count = MATH_MIN(grad->ramp_length, MAX_COLOR_RAMP_STOPS);
+
+    struct trace_data_s* d = &trace_writer.res_data;
+    d->size = 0;
+    trace_data_put_u32(d, TRACE_ID_NONE);
+    trace_data_put_u32(d, count);
+    trace_data_put_f32(d, grad->linear_grad.X0);
+    trace_data_put_f32(d, grad->linear_grad.Y0);
+    trace_data_put_f32(d, grad->linear_grad.X1);
+    trace_data_put_f32(d, grad->linear_grad.Y1);
+    trace_data_put_u32(d, grad->spread_mode);
+    trace_data_put_u32(d, grad->pre_multiplied);
+    trace_data_put_matrix(d, &grad->matrix);
+
+    return trace_res_data_commit(TRACE_RECORD_LINEAR_GRAD, grad->color_ramp, count * sizeof(vg_lite_color_ramp_t));
+}
+
+static uint32_t trace_radial_grad_get(const vg_lite_radial_gradient_t* grad)
+{
+    if (!grad) {
+        return TRACE_ID_NONE;
+    }
+
+    uint32_t count = MATH_MIN(grad->ramp_length, MAX_COLOR_RAMP_STOPS);
+
+    struct trace_data_s* d = &trace_writer.res_data;
+    d->size = 0;
+    trace_data_put_u32(d, TRACE_ID_NONE);
+    trace_data_put_u32(d, count);
+    trace_data_put_f32(d, grad->radial_grad.cx);
+    trace_data_put_f32(d, grad->radial_grad.cy);
+    trace_data_put_f32(d, grad->radial_grad.r);
+    trace_data_put_f32(d, grad->radial_grad.fx);
+    trace_data_put_f32(d, grad->radial_grad.fy);
+    trace_data_put_u32(d, grad->spread_mode);
+    trace_data_put_u32(d, grad->pre_multiplied);
+    trace_data_put_matrix(d, &grad->matrix);
+
+    return trace_res_data_commit(TRACE_RECORD_RADIAL_GRAD, grad->color_ramp, count * sizeof(vg_lite_color_ramp_t));
+}
+
+/**
+ * Bind the memory of a buffer to a slot of the current item. The content is
+ * captured the first time the memory is referenced.
+ */
+static uint32_t trace_slot_get(const vg_lite_buffer_t* buffer)
+{
+    for (uint32_t i = 0; i < trace_writer.slot_count; i++) {
+        if (trace_writer.slots[i] == buffer->memory) {
+            return i;
+        }
+    }
+
+    uint32_t size = buffer->stride * buffer->height;
+
+    /* Make sure the content written by the GPU is visible to the CPU */
+    gpu_cache_invalidate(buffer->memory, size);
+    uint32_t blob_id = trace_blob_get(buffer->memory, size);
+
+    trace_array_reserve(
+        (void**)&trace_writer.slots,
+        &trace_writer.slot_capacity,
+        trace_writer.slot_count + 1,
+        sizeof(const void*));
+
+    uint32_t slot_id = trace_writer.slot_count++;
+    trace_writer.slots[slot_id] = buffer->memory;
+
+    uint32_t head[6] = {
+        slot_id,
+        blob_id,
+        (uint32_t)buffer->width,
+        (uint32_t)buffer->height,
+        (uint32_t)buffer->stride,
+        (uint32_t)buffer->format,
+    };
+    trace_emit(TRACE_RECORD_SLOT, 0, head, sizeof(head), NULL, 0);
+    return slot_id;
+}
+
+static void trace_data_put_buffer(struct trace_data_s* d, const vg_lite_buffer_t* buffer)
+{
+    if (!buffer || !buffer->memory) {
+        trace_data_put_u32(d, TRACE_ID_NONE);
+        for (int i = 0; i < 7; i++) {
+            trace_data_put_u32(d, 0);
+        }
+        return;
+    }
+
+    trace_data_put_u32(d, trace_slot_get(buffer));
+    trace_data_put_u32(d, buffer->width);
+    trace_data_put_u32(d, buffer->height);
+    trace_data_put_u32(d, buffer->stride);
+    trace_data_put_u32(d, buffer->format);
+    trace_data_put_u32(d, buffer->tiled);
+    trace_data_put_u32(d, buffer->image_mode);
+    trace_data_put_u32(d, buffer->transparency_mode);
+}
+
+static vg_lite_error_t trace_on_call(const struct vg_lite_test_hook_call_s* call, void* user_data)
+{
+    if (!trace_writer.item_active) {
+        return VG_LITE_SUCCESS;
+    }
+
+    struct trace_data_s* d = &trace_writer.call_data;
+    d->size = 0;
+
+    switch (call->api) {
+    case VG_LITE_TEST_HOOK_API_CLEAR:
+        trace_data_put_buffer(d, call->args.clear.target);
+        trace_data_put_rect(d, call->args.clear.rect);
+        trace_data_put_u32(d, call->args.clear.color);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_BLIT:
+    case VG_LITE_TEST_HOOK_API_BLIT_RECT:
+        trace_data_put_buffer(d, call->args.blit.target);
+        trace_data_put_buffer(d, call->args.blit.source);
+        trace_data_put_rect(d, call->args.blit.rect);
+        trace_data_put_matrix(d, call->args.blit.matrix);
+        trace_data_put_u32(d, call->args.blit.blend);
+        trace_data_put_u32(d, call->args.blit.color);
+        trace_data_put_u32(d, call->args.blit.filter);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW:
+        trace_data_put_buffer(d, call->args.draw.target);
+        trace_data_put_u32(d, trace_path_get(call->args.draw.path));
+        trace_data_put_u32(d, call->args.draw.fill_rule);
+        trace_data_put_matrix(d, call->args.draw.matrix);
+        trace_data_put_u32(d, call->args.draw.blend);
+        trace_data_put_u32(d, call->args.draw.color);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_PATTERN:
+        trace_data_put_buffer(d, call->args.draw_pattern.target);
+        trace_data_put_u32(d, trace_path_get(call->args.draw_pattern.path));
+        trace_data_put_u32(d, call->args.draw_pattern.fill_rule);
+        trace_data_put_matrix(d, call->args.draw_pattern.path_matrix);
+        trace_data_put_buffer(d, call->args.draw_pattern.pattern_image);
+        trace_data_put_matrix(d, call->args.draw_pattern.pattern_matrix);
+        trace_data_put_u32(d, call->args.draw_pattern.blend);
+        trace_data_put_u32(d, call->args.draw_pattern.pattern_mode);
+        trace_data_put_u32(d, call->args.draw_pattern.pattern_color);
+        trace_data_put_u32(d, call->args.draw_pattern.color);
+        trace_data_put_u32(d, call->args.draw_pattern.filter);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_GRAD:
+        trace_data_put_buffer(d, call->args.draw_grad.target);
+        trace_data_put_u32(d, trace_path_get(call->args.draw_grad.path));
+        trace_data_put_u32(d, call->args.draw_grad.fill_rule);
+        trace_data_put_matrix(d, call->args.draw_grad.matrix);
+        trace_data_put_u32(d, trace_grad_get(call->args.draw_grad.grad));
+        trace_data_put_u32(d, call->args.draw_grad.blend);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_LINEAR_GRAD:
+        trace_data_put_buffer(d, call->args.draw_linear_grad.target);
+        trace_data_put_u32(d, trace_path_get(call->args.draw_linear_grad.path));
+        trace_data_put_u32(d, call->args.draw_linear_grad.fill_rule);
+        trace_data_put_matrix(d, call->args.draw_linear_grad.path_matrix);
+        trace_data_put_u32(d, trace_linear_grad_get(call->args.draw_linear_grad.grad));
+        trace_data_put_u32(d, call->args.draw_linear_grad.paint_color);
+        trace_data_put_u32(d, call->args.draw_linear_grad.blend);
+        trace_data_put_u32(d, call->args.draw_linear_grad.filter);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_RADIAL_GRAD:
+        trace_data_put_buffer(d, call->args.draw_radial_grad.target);
+        trace_data_put_u32(d, trace_path_get(call->args.draw_radial_grad.path));
+        trace_data_put_u32(d, call->args.draw_radial_grad.fill_rule);
+        trace_data_put_matrix(d, call->args.draw_radial_grad.path_matrix);
+        trace_data_put_u32(d, trace_radial_grad_get(call->args.draw_radial_grad.grad));
+        trace_data_put_u32(d, call->args.draw_radial_grad.paint_color);
+        trace_data_put_u32(d, call->args.draw_radial_grad.blend);
+        trace_data_put_u32(d, call->args.draw_radial_grad.filter);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_SET_SCISSOR:
+        trace_data_put_u32(d, (uint32_t)call->args.set_scissor.x);
+        trace_data_put_u32(d, (uint32_t)call->args.set_scissor.y);
+        trace_data_put_u32(d, (uint32_t)call->args.set_scissor.right);
+        trace_data_put_u32(d, (uint32_t)call->args.set_scissor.bottom);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_SET_CLUT:
+        trace_data_put_u32(d, call->args.set_clut.count);
+        if (call->args.set_clut.colors) {
+            trace_data_put(d, call->args.set_clut.colors, call->args.set_clut.count * sizeof(vg_lite_uint32_t));
+        }
+        break;
+
+    case VG_LITE_TEST_HOOK_API_GAUSSIAN_FILTER:
+        trace_data_put_f32(d, call->args.gaussian_filter.w0);
+        trace_data_put_f32(d, call->args.gaussian_filter.w1);
+        trace_data_put_f32(d, call->args.gaussian_filter.w2);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_ENABLE_SCISSOR:
+    case VG_LITE_TEST_HOOK_API_DISABLE_SCISSOR:
+    case VG_LITE_TEST_HOOK_API_FLUSH:
+    case VG_LITE_TEST_HOOK_API_FINISH:
+        break;
+
+    default:
+        GPU_LOG_WARN("Unsupported API for trace: %s", vg_lite_test_hook_api_string(call->api));
+        return VG_LITE_SUCCESS;
+    }
+
+    trace_emit(TRACE_RECORD_CALL, call->api, d->data, d->size, NULL, 0);
+    trace_writer.call_count++;
+    return VG_LITE_SUCCESS;
+}
+
+/* Reader */
+
+static const void* trace_reader_get(struct trace_reader_s* r, uint32_t size)
+{
+    if (r->error || (size_t)(r->end - r->cur) < size) {
+        r->error = true;
+        return NULL;
+    }
+
+    const void* data = r->cur;
+    r->cur += size;
+    return data;
+}
+
+/**
+ * Get an array whose count comes from the file, the count is bounded before
+ * the multiplication so it cannot wrap on 32-bit targets.
+ */
+static const void* trace_reader_get_array(struct trace_reader_s* r, uint32_t count, uint32_t max_count, uint32_t elem_size)
+{
+    if (count > max_count) {
+        r->error = true;
+        return NULL;
+    }
+
+    return trace_reader_get(r, count * elem_size);
+}
+
+static uint32_t trace_reader_get_u32(struct trace_reader_s* r)
+{
+    uint32_t value = 0;
+    const void* data = trace_reader_get(r, sizeof(value));
+    if (data) {
+        memcpy(&value, data, sizeof(value));
+    }
+
+    return value;
+}
+
+static float trace_reader_get_f32(struct trace_reader_s* r)
+{
+    float value = 0;
+    const void* data = trace_reader_get(r, sizeof(value));
+    if (data) {
+        memcpy(&value, data, sizeof(value));
+    }
+
+    return value;
+}
+
+static vg_lite_matrix_t* trace_reader_get_matrix(struct trace_reader_s* r, vg_lite_matrix_t* matrix)
+{
+    bool present = trace_reader_get_u32(r);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            matrix->m[i][j] = trace_reader_get_f32(r);
+        }
+    }
+
+    return present ? matrix : NULL;
+}
+
+static vg_lite_rectangle_t* trace_reader_get_rect(struct trace_reader_s* r, vg_lite_rectangle_t* rect)
+{
+    bool present = trace_reader_get_u32(r);
+    rect->x = (int32_t)trace_reader_get_u32(r);
+    rect->y = (int32_t)trace_reader_get_u32(r);
+    rect->width = (int32_t)trace_reader_get_u32(r);
+    rect->height = (int32_t)trace_reader_get_u32(r);
+    return present ? rect : NULL;
+}
+
+static bool trace_next_record(
+    const uint8_t** pos,
+    const uint8_t* end,
+    struct trace_record_header_s* header,
+    const uint8_t** payload)
+{
+    if ((size_t)(end - *pos) < sizeof(struct trace_record_header_s)) {
+        return false;
+    }
+
+    memcpy(header, *pos, sizeof(struct trace_record_header_s));
+    size_t record_size = sizeof(struct trace_record_header_s) + GPU_ALIGN_UP(header->size, TRACE_ALIGN);
+    if ((size_t)(end - *pos) < record_size) {
+        GPU_LOG_ERROR("Truncated trace record: type %d, size %" PRIu32, header->type, header->size);
+        return false;
+    }
+
+    *payload = *pos + sizeof(struct trace_record_header_s);
+    *pos += record_size;
+    return true;
+}
+
+/* Replay */
+
+static void* trace_replay_get_object(struct trace_replay_s* replay, uint32_t id, enum trace_record_type_e type)
+{
+    if (id == TRACE_ID_NONE) {
+        return NULL;
+    }
+
+    if (id >= replay->resource_count || replay->resources[id].type != type) {
+        GPU_LOG_ERROR("Invalid resource ID: %" PRIu32 " for type %d", id, type);
+        return NULL;
+    }
+
+    return replay->resources[id].object;
+}
+
+static vg_lite_buffer_t* trace_replay_get_buffer(struct trace_replay_s* replay, struct trace_reader_s* r, vg_lite_buffer_t* buffer)
+{
+    uint32_t slot_id = trace_reader_get_u32(r);
+    uint32_t desc[7];
+    for (int i = 0; i < 7; i++) {
+        desc[i] = trace_reader_get_u32(r);
+    }
+
+    if (slot_id == TRACE_ID_NONE) {
+        return NULL;
+    }
+
+    if (slot_id >= replay->slot_count || !replay->slots[slot_id].gpu_buffer) {
+        GPU_LOG_ERROR("Invalid slot ID: %" PRIu32, slot_id);
+        r->error = true;
+        return NULL;
+    }
+
+    /* The descriptor may differ between calls referencing the same memory */
+    *buffer = replay->slots[slot_id].buffer;
+    buffer->width = desc[0];
+    buffer->height = desc[1];
+    buffer->stride = desc[2];
+    buffer->format = (vg_lite_buffer_format_t)desc[3];
+    buffer->tiled = (vg_lite_buffer_layout_t)desc[4];
+    buffer->image_mode = (vg_lite_buffer_image_mode_t)desc[5];
+    buffer->transparency_mode = (vg_lite_buffer_transparency_mode_t)desc[6];
+    return buffer;
+}
+
+static bool trace_replay_create_resource(
+    struct trace_replay_s* replay,
+    const struct trace_record_header_s* header,
+    const uint8_t* payload)
+{
+    struct trace_reader_s r = { payload, payload + header->size, false };
+    uint32_t id = trace_reader_get_u32(&r);
+
+    if (id != replay->resource_count) {
+        GPU_LOG_ERROR("Unexpected resource ID: %" PRIu32 ", expected %" PRIu32, id, replay->resource_count);
+        return false;
+    }
+
+    struct trace_replay_resource_s* res = &replay->resources[replay->resource_count++];
+    res->type = header->type;
+
+    switch (header->type) {
+    case TRACE_RECORD_BLOB: {
+        res->size = trace_reader_get_u32(&r);
+        trace_reader_get_u32(&r); /* hash low */
+        trace_reader_get_u32(&r); /* hash high */
+        res->data = trace_reader_get(&r, res->size);
+    } break;
+
+    case TRACE_RECORD_PATH: {
+        vg_lite_format_t format = (vg_lite_format_t)trace_reader_get_u32(&r);
+        vg_lite_quality_t quality = (vg_lite_quality_t)trace_reader_get_u32(&r);
+        float bbox[4];
+        for (int i = 0; i < 4; i++) {
+            bbox[i] = trace_reader_get_f32(&r);
+        }
+        uint32_t length = trace_reader_get_u32(&r);
+        const void* data = trace_reader_get(&r, length);
+        if (r.error) {
+            break;
+        }
+
+        vg_lite_path_t* path = calloc(1, sizeof(vg_lite_path_t));
+        GPU_ASSERT_NULL(path);
+        res->object = path;
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_init_path(
+            path, format, quality, length, (void*)data,
+            bbox[0], bbox[1], bbox[2], bbox[3]));
+    } break;
+
+    case TRACE_RECORD_GRAD: {
+        vg_lite_uint32_t count = trace_reader_get_u32(&r);
+        vg_lite_uint32_t colors[VLC_MAX_GRADIENT_STOPS];
+        vg_lite_uint32_t stops[VLC_MAX_GRADIENT_STOPS];
+        const void* colors_data = trace_reader_get(&r, sizeof(colors));
+        const void* stops_data = trace_reader_get(&r, sizeof(stops));
+        vg_lite_matrix_t matrix;
+        trace_reader_get_matrix(&r, &matrix);
+        if (count > VLC_MAX_GRADIENT_STOPS) {
+            r.error = true;
+        }
+
+        if (r.error) {
+            break;
+        }
+
+        memcpy(colors, colors_data, sizeof(colors));
+        memcpy(stops, stops_data, sizeof(stops));
+
+        vg_lite_linear_gradient_t* grad = calloc(1, sizeof(vg_lite_linear_gradient_t));
+        GPU_ASSERT_NULL(grad);
+        res->object = grad;
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_init_grad(grad));
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_set_grad(grad, count, colors, stops));
+        *vg_lite_get_grad_matrix(grad) = matrix;
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_update_grad(grad));
+    } break;
+
+    case TRACE_RECORD_LINEAR_GRAD: {
+        vg_lite_uint32_t count = trace_reader_get_u32(&r);
+        vg_lite_linear_gradient_parameter_t param;
+        param.X0 = trace_reader_get_f32(&r);
+        param.Y0 = trace_reader_get_f32(&r);
+        param.X1 = trace_reader_get_f32(&r);
+        param.Y1 = trace_reader_get_f32(&r);
+        vg_lite_gradient_spreadmode_t spread_mode = (vg_lite_gradient_spreadmode_t)trace_reader_get_u32(&r);
+        vg_lite_uint8_t pre_multiplied = trace_reader_get_u32(&r);
+        vg_lite_matrix_t matrix;
+        trace_reader_get_matrix(&r, &matrix);
+        const void* ramp = trace_reader_get_array(&r, count, MAX_COLOR_RAMP_STOPS, sizeof(vg_lite_color_ramp_t));
+        if (r.error) {
+            break;
+        }
+
+        vg_lite_ext_linear_gradient_t* grad = calloc(1, sizeof(vg_lite_ext_linear_gradient_t));
+        GPU_ASSERT_NULL(grad);
+        res->object = grad;
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_set_linear_grad(
+            grad, count, (vg_lite_color_ramp_t*)ramp, param, spread_mode, pre_multiplied));
+        *vg_lite_get_linear_grad_matrix(grad) = matrix;
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_update_linear_grad(grad));
+    } break;
+
+    case TRACE_RECORD_RADIAL_GRAD: {
+        vg_lite_uint32_t count = trace_reader_get_u32(&r);
+        vg_lite_radial_gradient_parameter_t param;
+        param.cx = trace_reader_get_f32(&r);
+        param.cy = trace_reader_get_f32(&r);
+        param.r = trace_reader_get_f32(&r);
+        param.fx = trace_reader_get_f32(&r);
+        param.fy = trace_reader_get_f32(&r);
+        vg_lite_gradient_spreadmode_t spread_mode = (vg_lite_gradient_spreadmode_t)trace_reader_get_u32(&r);
+        vg_lite_uint8_t pre_multiplied = trace_reader_get_u32(&r);
+        vg_lite_matrix_t matrix;
+        trace_reader_get_matrix(&r, &matrix);
+        const void* ramp = trace_reader_get_array(&r, count, MAX_COLOR_RAMP_STOPS, sizeof(vg_lite_color_ramp_t));
+        if (r.error) {
+            break;
+        }
+
+        vg_lite_radial_gradient_t* grad = calloc(1, sizeof(vg_lite_radial_gradient_t));
+        GPU_ASSERT_NULL(grad);
+        res->object = grad;
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_set_radial_grad(
+            grad, count, (vg_lite_color_ramp_t*)ramp, param, spread_mode, pre_multiplied));
+        *vg_lite_get_radial_grad_matrix(grad) = matrix;
+        VG_LITE_TEST_CHECK_ERROR(vg_lite_update_radial_grad(grad));
+    } break;
+
+    default:
+        GPU_LOG_ERROR("Unknown resource type: %d", header->type);
+        return false;
+    }
+
+    if (r.error) {
+        GPU_LOG_ERROR("Malformed resource record: ID %" PRIu32 ", type %d", id, header->type);
+        return false;
+    }
+
+    return true;
+}
+
+static void trace_replay_delete_resources(struct trace_replay_s* replay)
+{
+    for (uint32_t i = 0; i < replay->resource_count; i++) {
+        struct trace_replay_resource_s* res = &replay->resources[i];
+        if (!res->object) {
+            continue;
+        }
+
+        switch (res->type) {
+        case TRACE_RECORD_PATH:
+            VG_LITE_TEST_CHECK_ERROR(vg_lite_clear_path(res->object));
+            break;
+
+        case TRACE_RECORD_GRAD:
+            VG_LITE_TEST_CHECK_ERROR(vg_lite_clear_grad(res->object));
+            break;
+
+        case TRACE_RECORD_LINEAR_GRAD:
+            VG_LITE_TEST_CHECK_ERROR(vg_lite_clear_linear_grad(res->object));
+            break;
+
+        case TRACE_RECORD_RADIAL_GRAD:
+            VG_LITE_TEST_CHECK_ERROR(vg_lite_clear_radial_grad(res->object));
+            break;
+
+        default:
+            break;
+        }
+
+        free(res->object);
+        res->object = NULL;
+    }
+
+    free(replay->resources);
+    replay->resources = NULL;
+    replay->resource_count = 0;
+}
+
+static bool trace_replay_load(struct trace_replay_s* replay, const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        GPU_LOG_ERROR("Open trace file %s failed", path);
+        return false;
+    }
+
+    bool retval = false;
+    long file_size = 0;
+    if (fseek(fp, 0, SEEK_END) != 0 || (file_size = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET) != 0) {
+        GPU_LOG_ERROR("Get size of trace file %s failed", path);
+        goto failed;
+    }
+
+    if ((size_t)file_size < sizeof(struct trace_file_header_s)) {
+        GPU_LOG_ERROR("Trace file %s is too small: %ld bytes", path, file_size);
+        goto failed;
+    }
+
+    replay->file_data = malloc(file_size);
+    GPU_ASSERT_NULL(replay->file_data);
+    replay->file_size = file_size;
+
+    if (fread(replay->file_data, file_size, 1, fp) != 1) {
+        GPU_LOG_ERROR("Read trace file %s failed", path);
+        goto failed;
+    }
+
+    struct trace_file_header_s header;
+    memcpy(&header, replay->file_data, sizeof(header));
+    if (memcmp(header.magic, TRACE_MAGIC, sizeof(header.magic)) != 0 || header.version != TRACE_VERSION) {
+        GPU_LOG_ERROR("Invalid trace file %s: version %" PRIu32, path, header.version);
+        goto failed;
+    }
+
+    GPU_LOG_INFO("Trace file %s loaded: %ld bytes", path, file_size);
+    retval = true;
+
+failed:
+    fclose(fp);
+    return retval;
+}
+
+/**
+ * Create all the shared resources before any item is executed, so the
+ * timing of the items only covers the recorded calls.
+ */
+static bool trace_replay_prepare(struct trace_replay_s* replay)
+{
+    const uint8_t* end = replay->file_data + replay->file_size;
+    const uint8_t* pos = replay->file_data + sizeof(struct trace_file_header_s);
+    struct trace_record_header_s header;
+    const uint8_t* payload;
+    uint32_t count = 0;
+
+    while (trace_next_record(&pos, end, &header, &payload)) {
+        if (header.type >= TRACE_RECORD_BLOB && header.type <= TRACE_RECORD_RADIAL_GRAD && header.type != TRACE_RECORD_SLOT) {
+            count++;
+        }
+    }
+
+    replay->resources = calloc(count ? count : 1, sizeof(struct trace_replay_resource_s));
+    GPU_ASSERT_NULL(replay->resources);
+
+    pos = replay->file_data + sizeof(struct trace_file_header_s);
+    while (trace_next_record(&pos, end, &header, &payload)) {
+        if (header.type >= TRACE_RECORD_BLOB && header.type <= TRACE_RECORD_RADIAL_GRAD && header.type != TRACE_RECORD_SLOT) {
+            if (!trace_replay_create_resource(replay, &header, payload)) {
+                return false;
+            }
+        }
+    }
+
+    GPU_LOG_INFO("Trace resources created: %" PRIu32, replay->resource_count);
+    return true;
+}
+
+static bool trace_replay_create_slot(struct trace_replay_s* replay, const uint8_t* payload, uint32_t size)
+{
+    struct trace_reader_s r = { payload, payload + size, false };
+    uint32_t slot_id = trace_reader_get_u32(&r);
+    uint32_t blob_id = trace_reader_get_u32(&r);
+    uint32_t width = trace_reader_get_u32(&r);
+    uint32_t height = trace_reader_get_u32(&r);
+    uint32_t stride = trace_reader_get_u32(&r);
+    vg_lite_buffer_format_t format = (vg_lite_buffer_format_t)trace_reader_get_u32(&r);
+
+    if (r.error || blob_id >= replay->resource_count || replay->resources[blob_id].type != TRACE_RECORD_BLOB) {
+        GPU_LOG_ERROR("Malformed slot record: slot %" PRIu32 ", blob %" PRIu32, slot_id, blob_id);
+        return false;
+    }
+
+    /* The writer numbers the slots of an item in order */
+    if (slot_id != replay->slot_count) {
+        GPU_LOG_ERROR("Unexpected slot ID: %" PRIu32 ", expected %" PRIu32, slot_id, replay->slot_count);
+        return false;
+    }
+
+    /* The blob is the captured content of the whole buffer, it bounds the size of the buffer */
+    const struct trace_replay_resource_s* blob = &replay->resources[blob_id];
+    if (!vg_lite_test_buffer_format_is_valid(format)
+        || width == 0 || height == 0
+        || stride < vg_lite_test_buffer_row_size(format, width)
+        || (uint64_t)stride * height > blob->size) {
+        GPU_LOG_ERROR("Invalid slot %" PRIu32 " buffer: W%" PRIu32 "xH%" PRIu32 " stride %" PRIu32 " format 0x%" PRIx32 ", blob %" PRIu32 " bytes",
+            slot_id, width, height, stride, (uint32_t)format, blob->size);
+        return false;
+    }
+
+    replay->slots = realloc(replay->slots, (replay->slot_count + 1) * sizeof(struct trace_replay_slot_s));
+    GPU_ASSERT_NULL(replay->slots);
+
+    struct trace_replay_slot_s* slot = &replay->slots[replay->slot_count++];
+    memset(slot, 0, sizeof(struct trace_replay_slot_s));
+    slot->gpu_buffer = vg_lite_test_buffer_alloc(&slot->buffer, width, height, format, stride);
+
+    uint32_t buffer_size = slot->buffer.stride * slot->buffer.height;
+    memcpy(slot->buffer.memory, blob->data, MATH_MIN(blob->size, buffer_size));
+    gpu_cache_flush(slot->buffer.memory, buffer_size);
+    return true;
+}
+
+static void trace_replay_delete_slots(struct trace_replay_s* replay)
+{
+    for (uint32_t i = 0; i < replay->slot_count; i++) {
+        if (replay->slots[i].gpu_buffer) {
+            gpu_buffer_free(replay->slots[i].gpu_buffer);
+        }
+    }
+
+    free(replay->slots);
+    replay->slots = NULL;
+    replay->slot_count = 0;
+}
+
+static vg_lite_error_t trace_replay_call(
+    struct trace_replay_s* replay,
+    enum vg_lite_test_hook_api_e api,
+    const uint8_t* payload,
+    uint32_t size)
+{
+    struct trace_reader_s r = { payload, payload + size, false };
+    vg_lite_buffer_t target_storage;
+    vg_lite_buffer_t source_storage;
+    vg_lite_matrix_t matrix_storage;
+    vg_lite_matrix_t pattern_matrix_storage;
+    vg_lite_rectangle_t rect_storage;
+
+    /* Decode everything before the call, so only the API itself is timed by the caller */
+#define TRACE_REPLAY_INVOKE(func) \
+    do {                          \
+        if (r.error) {            \
+            goto malformed;       \
+        }                         \
+        return func;              \
+    } while (0)
+
+    switch (api) {
+    case VG_LITE_TEST_HOOK_API_CLEAR: {
+        vg_lite_buffer_t* target = trace_replay_get_buffer(replay, &r, &target_storage);
+        vg_lite_rectangle_t* rect = trace_reader_get_rect(&r, &rect_storage);
+        vg_lite_color_t color = trace_reader_get_u32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_clear(target, rect, color));
+    }
+
+    case VG_LITE_TEST_HOOK_API_BLIT:
+    case VG_LITE_TEST_HOOK_API_BLIT_RECT: {
+        vg_lite_buffer_t* target = trace_replay_get_buffer(replay, &r, &target_storage);
+        vg_lite_buffer_t* source = trace_replay_get_buffer(replay, &r, &source_storage);
+        vg_lite_rectangle_t* rect = trace_reader_get_rect(&r, &rect_storage);
+        vg_lite_matrix_t* matrix = trace_reader_get_matrix(&r, &matrix_storage);
+        vg_lite_blend_t blend = (vg_lite_blend_t)trace_reader_get_u32(&r);
+        vg_lite_color_t color = trace_reader_get_u32(&r);
+        vg_lite_filter_t filter = (vg_lite_filter_t)trace_reader_get_u32(&r);
+        if (api == VG_LITE_TEST_HOOK_API_BLIT) {
+            TRACE_REPLAY_INVOKE(vg_lite_blit(target, source, matrix, blend, color, filter));
+        }
+        TRACE_REPLAY_INVOKE(vg_lite_blit_rect(target, source, rect, matrix, blend, color, filter));
+    }
+
+    case VG_LITE_TEST_HOOK_API_DRAW: {
+        vg_lite_buffer_t* target = trace_replay_get_buffer(replay, &r, &target_storage);
+        vg_lite_path_t* path = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_PATH);
+        vg_lite_fill_t fill_rule = (vg_lite_fill_t)trace_reader_get_u32(&r);
+        vg_lite_matrix_t* matrix = trace_reader_get_matrix(&r, &matrix_storage);
+        vg_lite_blend_t blend = (vg_lite_blend_t)trace_reader_get_u32(&r);
+        vg_lite_color_t color = trace_reader_get_u32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_draw(target, path, fill_rule, matrix, blend, color));
+    }
+
+    case VG_LITE_TEST_HOOK_API_DRAW_PATTERN: {
+        vg_lite_buffer_t* target = trace_replay_get_buffer(replay, &r, &target_storage);
+        vg_lite_path_t* path = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_PATH);
+        vg_lite_fill_t fill_rule = (vg_lite_fill_t)trace_reader_get_u32(&r);
+        vg_lite_matrix_t* path_matrix = trace_reader_get_matrix(&r, &matrix_storage);
+        vg_lite_buffer_t* pattern_image = trace_replay_get_buffer(replay, &r, &source_storage);
+        vg_lite_matrix_t* pattern_matrix = trace_reader_get_matrix(&r, &pattern_matrix_storage);
+        vg_lite_blend_t blend = (vg_lite_blend_t)trace_reader_get_u32(&r);
+        vg_lite_pattern_mode_t pattern_mode = (vg_lite_pattern_mode_t)trace_reader_get_u32(&r);
+        vg_lite_color_t pattern_color = trace_reader_get_u32(&r);
+        vg_lite_color_t color = trace_reader_get_u32(&r);
+        vg_lite_filter_t filter = (vg_lite_filter_t)trace_reader_get_u32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_draw_pattern(
+            target, path, fill_rule, path_matrix,
+            pattern_image, pattern_matrix,
+            blend, pattern_mode, pattern_color, color, filter));
+    }
+
+    case VG_LITE_TEST_HOOK_API_DRAW_GRAD: {
+        vg_lite_buffer_t* target = trace_replay_get_buffer(replay, &r, &target_storage);
+        vg_lite_path_t* path = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_PATH);
+        vg_lite_fill_t fill_rule = (vg_lite_fill_t)trace_reader_get_u32(&r);
+        vg_lite_matrix_t* matrix = trace_reader_get_matrix(&r, &matrix_storage);
+        vg_lite_linear_gradient_t* grad = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_GRAD);
+        vg_lite_blend_t blend = (vg_lite_blend_t)trace_reader_get_u32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_draw_grad(target, path, fill_rule, matrix, grad, blend));
+    }
+
+    case VG_LITE_TEST_HOOK_API_DRAW_LINEAR_GRAD: {
+        vg_lite_buffer_t* target = trace_replay_get_buffer(replay, &r, &target_storage);
+        vg_lite_path_t* path = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_PATH);
+        vg_lite_fill_t fill_rule = (vg_lite_fill_t)trace_reader_get_u32(&r);
+        vg_lite_matrix_t* path_matrix = trace_reader_get_matrix(&r, &matrix_storage);
+        vg_lite_ext_linear_gradient_t* grad = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_LINEAR_GRAD);
+        vg_lite_color_t paint_color = trace_reader_get_u32(&r);
+        vg_lite_blend_t blend = (vg_lite_blend_t)trace_reader_get_u32(&r);
+        vg_lite_filter_t filter = (vg_lite_filter_t)trace_reader_get_u32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_draw_linear_grad(
+            target, path, fill_rule, path_matrix, grad, paint_color, blend, filter));
+    }
+
+    case VG_LITE_TEST_HOOK_API_DRAW_RADIAL_GRAD: {
+        vg_lite_buffer_t* target = trace_replay_get_buffer(replay, &r, &target_storage);
+        vg_lite_path_t* path = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_PATH);
+        vg_lite_fill_t fill_rule = (vg_lite_fill_t)trace_reader_get_u32(&r);
+        vg_lite_matrix_t* path_matrix = trace_reader_get_matrix(&r, &matrix_storage);
+        vg_lite_radial_gradient_t* grad = trace_replay_get_object(replay, trace_reader_get_u32(&r), TRACE_RECORD_RADIAL_GRAD);
+        vg_lite_color_t paint_color = trace_reader_get_u32(&r);
+        vg_lite_blend_t blend = (vg_lite_blend_t)trace_reader_get_u32(&r);
+        vg_lite_filter_t filter = (vg_lite_filter_t)trace_reader_get_u32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_draw_radial_grad(
+            target, path, fill_rule, path_matrix, grad, paint_color, blend, filter));
+    }
+
+    case VG_LITE_TEST_HOOK_API_SET_SCISSOR: {
+        vg_lite_int32_t x = (int32_t)trace_reader_get_u32(&r);
+        vg_lite_int32_t y = (int32_t)trace_reader_get_u32(&r);
+        vg_lite_int32_t right = (int32_t)trace_reader_get_u32(&r);
+        vg_lite_int32_t bottom = (int32_t)trace_reader_get_u32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_set_scissor(x, y, right, bottom));
+    }
+
+    case VG_LITE_TEST_HOOK_API_ENABLE_SCISSOR:
+        TRACE_REPLAY_INVOKE(vg_lite_enable_scissor());
+
+    case VG_LITE_TEST_HOOK_API_DISABLE_SCISSOR:
+        TRACE_REPLAY_INVOKE(vg_lite_disable_scissor());
+
+    case VG_LITE_TEST_HOOK_API_SET_CLUT: {
+        vg_lite_uint32_t count = trace_reader_get_u32(&r);
+        const void* colors = trace_reader_get_array(&r, count, TRACE_CLUT_MAX, sizeof(vg_lite_uint32_t));
+        TRACE_REPLAY_INVOKE(vg_lite_set_CLUT(count, (vg_lite_uint32_t*)colors));
+    }
+
+    case VG_LITE_TEST_HOOK_API_GAUSSIAN_FILTER: {
+        vg_lite_float_t w0 = trace_reader_get_f32(&r);
+        vg_lite_float_t w1 = trace_reader_get_f32(&r);
+        vg_lite_float_t w2 = trace_reader_get_f32(&r);
+        TRACE_REPLAY_INVOKE(vg_lite_gaussian_filter(w0, w1, w2));
+    }
+
+    case VG_LITE_TEST_HOOK_API_FLUSH:
+        TRACE_REPLAY_INVOKE(vg_lite_flush());
+
+    case VG_LITE_TEST_HOOK_API_FINISH:
+        TRACE_REPLAY_INVOKE(vg_lite_finish());
+
+    default:
+        GPU_LOG_ERROR("Unsupported API in trace: %d", api);
+        return VG_LITE_NOT_SUPPORT;
+    }
+
+#undef TRACE_REPLAY_INVOKE
+
+malformed:
+    GPU_LOG_ERROR("Malformed call record: %s", vg_lite_test_hook_api_string(api));
+    return VG_LITE_INVALID_ARGUMENT;
+}
+
+/**
+ * Replay the records of one item, pos points to the record after ITEM_BEGIN
+ * and is moved past the matching ITEM_END.
+ */
+static bool trace_replay_run_item(struct trace_replay_s* replay, const char* name, const uint8_t** pos)
+{
+    const uint8_t* end = replay->file_data + replay->file_size;
+    const uint8_t* item_pos = *pos;
+    struct trace_record_header_s header;
+    const uint8_t* payload;
+    vg_lite_error_t error = VG_LITE_SUCCESS;
+    uint32_t call_count = 0;
+    uint32_t setup_tick = 0;
+    uint32_t draw_tick = 0;
+    uint32_t finish_tick = 0;
+
+    GPU_LOG_INFO("Replaying test case: %s", name);
+
+    /* Setup: upload the content of every buffer referenced by the item */
+    uint32_t start_tick = gpu_tick_get();
+    while (trace_next_record(pos, end, &header, &payload) && header.type != TRACE_RECORD_ITEM_END) {
+        if (header.type == TRACE_RECORD_SLOT && !trace_replay_create_slot(replay, payload, header.size)) {
+            error = VG_LITE_INVALID_ARGUMENT;
+            break;
+        }
+    }
+    setup_tick = gpu_tick_elaps(start_tick);
+
+    /* Draw: re-issue the calls in order, the finish calls are timed separately */
+    const uint8_t* call_pos = item_pos;
+    while (error == VG_LITE_SUCCESS
+        && trace_next_record(&call_pos, end, &header, &payload)
+        && header.type != TRACE_RECORD_ITEM_END) {
+        if (header.type != TRACE_RECORD_CALL) {
+            continue;
+        }
+
+        start_tick = gpu_tick_get();
+        error = trace_replay_call(replay, (enum vg_lite_test_hook_api_e)header.api, payload, header.size);
+        uint32_t elaps = gpu_tick_elaps(start_tick);
+
+        if (header.api == VG_LITE_TEST_HOOK_API_FINISH) {
+            finish_tick += elaps;
+        } else {
+            draw_tick += elaps;
+        }
+
+        call_count++;
+
+        if (error != VG_LITE_SUCCESS) {
+            GPU_LOG_ERROR("Replay '%s' call #%" PRIu32 " %s failed: %d (%s)",
+                name, call_count, vg_lite_test_hook_api_string((enum vg_lite_test_hook_api_e)header.api),
+                error, vg_lite_test_error_string(error));
+        }
+    }
+
+    trace_replay_delete_slots(replay);
+
+    if (replay->gpu_ctx->recorder) {
+        char result[256];
+        snprintf(result, sizeof(result),
+            "%s," /* Testcase */
+            "%" PRIu32 "," /* Calls */
+            "%0.3f," /* Setup Time(ms) */
+            "%0.3f," /* Draw Time(ms) */
+            "%0.3f," /* Finish Time(ms) */
+            "%s," /* VG-Lite Result */
+            "%s\n", /* Result */
+            name,
+            call_count,
+            setup_tick / 1000.0f,
+            draw_tick / 1000.0f,
+            finish_tick / 1000.0f,
+            vg_lite_test_error_string(error),
+            error == VG_LITE_SUCCESS ? "PASS" : "FAIL");
+        gpu_recorder_write_string(replay->gpu_ctx->recorder, result);
+    }
+
+    return error == VG_LITE_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_TRACE_H
+#define VG_LITE_TEST_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdbool.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct gpu_test_context_s;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Start capturing the hooked vg_lite calls into a trace file.
+ * @param path The path of the trace file.
+ * @return True if the trace file was created, false otherwise.
+ */
+bool vg_lite_test_trace_start(const char* path);
+
+/**
+ * @brief Stop capturing and close the trace file.
+ */
+void vg_lite_test_trace_stop(void);
+
+/**
+ * @brief Mark the beginning of a test case item in the trace.
+ * @param name The name of the test case item.
+ * @note Calls outside of an item are not captured. Does nothing if tracing is not started.
+ */
+void vg_lite_test_trace_item_begin(const char* name);
+
+/**
+ * @brief Mark the end of the current test case item in the trace.
+ */
+void vg_lite_test_trace_item_end(void);
+
+/**
+ * @brief Replay a trace file and record the timing of every item.
+ * @param ctx The GPU test context.
+ * @param path The path of the trace file.
+ * @return 0 on success, -1 if the trace could not be loaded or any item failed.
+ */
+int vg_lite_test_trace_replay(struct gpu_test_context_s* ctx, const char* path);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_TRACE_H*/
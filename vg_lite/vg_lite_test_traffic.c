@@ -0,0 +1,244 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "vg_lite_test_traffic.h"
+#include "../gpu_assert.h"
+#include "../gpu_log.h"
+#include "vg_lite_test_hook.h"
+#include "vg_lite_test_utils.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_traffic_s {
+    struct vg_lite_test_hook_listener_s listener;
+    struct vg_lite_test_traffic_stats_s stats;
+    bool active;
+};
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void traffic_on_return(const struct vg_lite_test_hook_call_s* call, vg_lite_error_t error, void* user_data);
+static uint64_t traffic_area(const vg_lite_buffer_t* target, float x, float y, float w, float h, const vg_lite_matrix_t* matrix);
+static uint64_t traffic_path_area(const vg_lite_buffer_t* target, const vg_lite_path_t* path, const vg_lite_matrix_t* matrix);
+static void traffic_add(struct vg_lite_test_traffic_s* traffic, uint64_t area,
+    const vg_lite_buffer_t* target, vg_lite_blend_t blend, const vg_lite_buffer_t* source);
+static uint32_t traffic_format_bits(vg_lite_buffer_format_t format);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+struct vg_lite_test_traffic_s* vg_lite_test_traffic_create(void)
+{
+    struct vg_lite_test_traffic_s* traffic = malloc(sizeof(struct vg_lite_test_traffic_s));
+    GPU_ASSERT_NULL(traffic);
+    memset(traffic, 0, sizeof(struct vg_lite_test_traffic_s));
+
+    traffic->listener.on_return = traffic_on_return;
+    traffic->listener.user_data = traffic;
+    if (vg_lite_test_hook_add_listener(&traffic->listener) != 0) {
+        GPU_LOG_ERROR("Register traffic estimator failed");
+    }
+
+    return traffic;
+}
+
+void vg_lite_test_traffic_destroy(struct vg_lite_test_traffic_s* traffic)
+{
+    GPU_ASSERT_NULL(traffic);
+    vg_lite_test_hook_remove_listener(&traffic->listener);
+    free(traffic);
+}
+
+void vg_lite_test_traffic_begin(struct vg_lite_test_traffic_s* traffic)
+{
+    GPU_ASSERT_NULL(traffic);
+    memset(&traffic->stats, 0, sizeof(traffic->stats));
+    traffic->active = true;
+}
+
+void vg_lite_test_traffic_end(struct vg_lite_test_traffic_s* traffic, struct vg_lite_test_traffic_stats_s* stats)
+{
+    GPU_ASSERT_NULL(traffic);
+    GPU_ASSERT_NULL(stats);
+    traffic->active = false;
+    *stats = traffic->stats;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void traffic_on_return(const struct vg_lite_test_hook_call_s* call, vg_lite_error_t error, void* user_data)
+{
+    struct vg_lite_test_traffic_s* traffic = user_data;
+
+    /* The listeners are shared by all contexts, only count the calls of the current item */
+    if (!traffic->active || error != VG_LITE_SUCCESS) {
+        return;
+    }
+
+    switch (call->api) {
+    case VG_LITE_TEST_HOOK_API_CLEAR: {
+        const vg_lite_buffer_t* target = call->args.clear.target;
+        const vg_lite_rectangle_t* rect = call->args.clear.rect;
+        uint64_t area = rect
+            ? traffic_area(target, rect->x, rect->y, rect->width, rect->height, NULL)
+            : traffic_area(target, 0, 0, target->width, target->height, NULL);
+        traffic_add(traffic, area, target, VG_LITE_BLEND_NONE, NULL);
+    } break;
+
+    case VG_LITE_TEST_HOOK_API_BLIT:
+    case VG_LITE_TEST_HOOK_API_BLIT_RECT: {
+        const vg_lite_buffer_t* source = call->args.blit.source;
+        const vg_lite_rectangle_t* rect = call->args.blit.rect;
+        uint64_t area = rect
+            ? traffic_area(call->args.blit.target, 0, 0, rect->width, rect->height, call->args.blit.matrix)
+            : traffic_area(call->args.blit.target, 0, 0, source->width, source->height, call->args.blit.matrix);
+        traffic_add(traffic, area, call->args.blit.target, call->args.blit.blend, source);
+    } break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW:
+        traffic_add(traffic,
+            traffic_path_area(call->args.draw.target, call->args.draw.path, call->args.draw.matrix),
+            call->args.draw.target, call->args.draw.blend, NULL);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_PATTERN:
+        traffic_add(traffic,
+            traffic_path_area(call->args.draw_pattern.target, call->args.draw_pattern.path, call->args.draw_pattern.path_matrix),
+            call->args.draw_pattern.target, call->args.draw_pattern.blend, call->args.draw_pattern.pattern_image);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_GRAD:
+        traffic_add(traffic,
+            traffic_path_area(call->args.draw_grad.target, call->args.draw_grad.path, call->args.draw_grad.matrix),
+            call->args.draw_grad.target, call->args.draw_grad.blend, NULL);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_LINEAR_GRAD:
+        traffic_add(traffic,
+            traffic_path_area(call->args.draw_linear_grad.target, call->args.draw_linear_grad.path, call->args.draw_linear_grad.path_matrix),
+            call->args.draw_linear_grad.target, call->args.draw_linear_grad.blend, NULL);
+        break;
+
+    case VG_LITE_TEST_HOOK_API_DRAW_RADIAL_GRAD:
+        traffic_add(traffic,
+            traffic_path_area(call->args.draw_radial_grad.target, call->args.draw_radial_grad.path, call->args.draw_radial_grad.path_matrix),
+            call->args.draw_radial_grad.target, call->args.draw_radial_grad.blend, NULL);
+        break;
+
+    default:
+        break;
+    }
+}
+
+static uint64_t traffic_area(const vg_lite_buffer_t* target, float x, float y, float w, float h, const vg_lite_matrix_t* matrix)
+{
+    float px[4] = { x, x + w, x + w, x };
+    float py[4] = { y, y, y + h, y + h };
+
+    if (matrix) {
+        for (int i = 0; i < 4; i++) {
+            vg_lite_test_transform_point(&px[i], &py[i], matrix);
+        }
+    }
+
+    float x1 = px[0], x2 = px[0], y1 = py[0], y2 = py[0];
+    for (int i = 1; i < 4; i++) {
+        x1 = px[i] < x1 ? px[i] : x1;
+        x2 = px[i] > x2 ? px[i] : x2;
+        y1 = py[i] < y1 ? py[i] : y1;
+        y2 = py[i] > y2 ? py[i] : y2;
+    }
+
+    /* Clip to the target */
+    x1 = x1 < 0 ? 0 : x1;
+    y1 = y1 < 0 ? 0 : y1;
+    x2 = x2 > target->width ? target->width : x2;
+    y2 = y2 > target->height ? target->height : y2;
+
+    if (x2 <= x1 || y2 <= y1) {
+        return 0;
+    }
+
+    return (uint64_t)(x2 - x1) * (uint64_t)(y2 - y1);
+}
+
+static uint64_t traffic_path_area(const vg_lite_buffer_t* target, const vg_lite_path_t* path, const vg_lite_matrix_t* matrix)
+{
+    return traffic_area(
+        target,
+        path->bounding_box[0],
+        path->bounding_box[1],
+        path->bounding_box[2] - path->bounding_box[0],
+        path->bounding_box[3] - path->bounding_box[1],
+        matrix);
+}
+
+static void traffic_add(struct vg_lite_test_traffic_s* traffic, uint64_t area,
+    const vg_lite_buffer_t* target, vg_lite_blend_t blend, const vg_lite_buffer_t* source)
+{
+    uint64_t bits = traffic_format_bits(target->format);
+
+    /* Blending reads the target before writing it back */
+    if (blend != VG_LITE_BLEND_NONE) {
+        bits *= 2;
+    }
+
+    if (source) {
+        bits += traffic_format_bits(source->format);
+    }
+
+    traffic->stats.pixels += area;
+    traffic->stats.bytes += area * bits / 8;
+}
+
+static uint32_t traffic_format_bits(vg_lite_buffer_format_t format)
+{
+    uint32_t mul, div, align;
+    vg_lite_test_buffer_format_bytes(format, &mul, &div, &align);
+    return mul * 8 / div;
+}
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 - 2025 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef VG_LITE_TEST_TRAFFIC_H
+#define VG_LITE_TEST_TRAFFIC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include <stdint.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct vg_lite_test_traffic_s;
+
+struct vg_lite_test_traffic_stats_s {
+    /* Target pixels covered by the draw calls, overdraw counted every time */
+    uint64_t pixels;
+
+    /* Target writes, target reads of blending and source reads */
+    uint64_t bytes;
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * @brief Create an estimator of the memory traffic of the hooked draw calls.
+ * @return The estimator.
+ * @note The estimate uses the bounding boxes of the draws clipped to the target, one source pixel is read per target pixel.
+ */
+struct vg_lite_test_traffic_s* vg_lite_test_traffic_create(void);
+
+/**
+ * @brief Destroy the estimator.
+ * @param traffic The estimator.
+ */
+void vg_lite_test_traffic_destroy(struct vg_lite_test_traffic_s* traffic);
+
+/**
+ * @brief Clear the statistics and start counting the draw calls.
+ * @param traffic The estimator.
+ */
+void vg_lite_test_traffic_begin(struct vg_lite_test_traffic_s* traffic);
+
+/**
+ * @brief Stop counting the draw calls.
+ * @param traffic The estimator.
+ * @param stats The traffic since vg_lite_test_traffic_begin.
+ */
+void vg_lite_test_traffic_end(struct vg_lite_test_traffic_s* traffic, struct vg_lite_test_traffic_stats_s* stats);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*VG_LITE_TEST_TRAFFIC_H*/
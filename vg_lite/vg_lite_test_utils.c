@@ -31,6 +31,7 @@
 #include "../gpu_utils.h"
 #include <inttypes.h>
 #include <stdbool.h>
+#include <stdio.h>
 #include <string.h>
 
 /*********************
@@ -49,6 +50,14 @@
     case (gcFEATURE_BIT_VG_##e):  \
         return #e
 
+#define BLEND_ENUM_TO_STRING(e) \
+    case (VG_LITE_BLEND_##e):   \
+        return #e
+
+#define FILTER_ENUM_TO_STRING(e) \
+    case (VG_LITE_FILTER_##e):    \
+        return #e
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -57,14 +66,11 @@
  *  STATIC PROTOTYPES
  **********************/
 
-static void vg_lite_test_buffer_format_bytes(
-    vg_lite_buffer_format_t format,
-    uint32_t* mul,
-    uint32_t* div,
-    uint32_t* bytes_align);
-
 static enum gpu_color_format_e vg_lite_test_vg_format_to_gpu_format(vg_lite_buffer_format_t format);
-static vg_lite_buffer_format_t vg_lite_test_gpu_format_to_vg_format(enum gpu_color_format_e format);
+static bool vg_lite_test_buffer_format_info(vg_lite_buffer_format_t format, uint32_t* mul, uint32_t* div, uint32_t* bytes_align);
+static uint32_t vg_lite_test_buffer_get_width(uint32_t width);
+static uint32_t vg_lite_test_buffer_get_stride(uint32_t width, vg_lite_buffer_format_t format, uint32_t* align);
+static void vg_lite_test_buffer_init(vg_lite_buffer_t* buffer, void* memory, uint32_t width, uint32_t height, vg_lite_buffer_format_t format, uint32_t stride);
 
 /**********************
  *  STATIC VARIABLES
@@ -80,23 +86,9 @@ static vg_lite_buffer_format_t vg_lite_test_gpu_format_to_vg_format(enum gpu_col
 
 void vg_lite_test_dump_info(void)
 {
-    char name[64];
-    vg_lite_uint32_t chip_id;
-    vg_lite_uint32_t chip_rev;
-    vg_lite_uint32_t cid;
-    vg_lite_get_product_info(name, &chip_id, &chip_rev);
-    vg_lite_get_register(0x30, &cid);
-    GPU_LOG_INFO("Product Info: %s"
-                 " | Chip ID: 0x%" PRIx32
-                 " | Revision: 0x%" PRIx32
-                 " | CID: 0x%" PRIx32,
-        name, (uint32_t)chip_id, (uint32_t)chip_rev, (uint32_t)cid);
-
-    vg_lite_info_t info;
-    vg_lite_get_info(&info);
-    GPU_LOG_INFO("VGLite API version: 0x%" PRIx32, (uint32_t)info.api_version);
-    GPU_LOG_INFO("VGLite API header version: 0x%" PRIx32, (uint32_t)info.header_version);
-    GPU_LOG_INFO("VGLite release version: 0x%" PRIx32, (uint32_t)info.release_version);
+    char str[256];
+    vg_lite_test_info_to_string(str, sizeof(str));
+    GPU_LOG_INFO("Product Info: %s", str);
 
     for (int feature = 0; feature < gcFEATURE_COUNT; feature++) {
         vg_lite_uint32_t ret = vg_lite_query_feature((vg_lite_feature_t)feature);
@@ -110,6 +102,33 @@ void vg_lite_test_dump_info(void)
     GPU_LOG_INFO("Memory size: %" PRId32 " Bytes", (uint32_t)mem_size);
 }
 
+int vg_lite_test_info_to_string(char* buf, size_t size)
+{
+    GPU_ASSERT_NULL(buf);
+
+    char name[64] = { 0 };
+    vg_lite_uint32_t chip_id = 0;
+    vg_lite_uint32_t chip_rev = 0;
+    vg_lite_uint32_t cid = 0;
+    vg_lite_get_product_info(name, &chip_id, &chip_rev);
+    vg_lite_get_register(0x30, &cid);
+
+    vg_lite_info_t info;
+    memset(&info, 0, sizeof(info));
+    vg_lite_get_info(&info);
+
+    /* No commas, the line is also a field of the CSV reports */
+    return snprintf(buf, size, "%s"
+                               " | Chip ID: 0x%" PRIx32
+                               " | Revision: 0x%" PRIx32
+                               " | CID: 0x%" PRIx32
+                               " | API: 0x%" PRIx32
+                               " | Header: 0x%" PRIx32
+                               " | Release: 0x%" PRIx32,
+        name, (uint32_t)chip_id, (uint32_t)chip_rev, (uint32_t)cid,
+        (uint32_t)info.api_version, (uint32_t)info.header_version, (uint32_t)info.release_version);
+}
+
 void vg_lite_test_error_dump_info(vg_lite_error_t error)
 {
     GPU_LOG_INFO("Error code: %d(%s)", (int)error, vg_lite_test_error_string(error));
@@ -228,39 +247,46 @@ const char* vg_lite_test_feature_string(vg_lite_feature_t feature)
 struct gpu_buffer_s* vg_lite_test_buffer_alloc(vg_lite_buffer_t* buffer, uint32_t width, uint32_t height, vg_lite_buffer_format_t format, uint32_t stride)
 {
     GPU_ASSERT_NULL(buffer);
-    if (vg_lite_query_feature(gcFEATURE_BIT_VG_16PIXELS_ALIGN)) {
-        width = GPU_ALIGN_UP(width, 16);
-    }
+    width = vg_lite_test_buffer_get_width(width);
 
     if (stride == VG_LITE_TEST_STRIDE_AUTO) {
-        uint32_t mul, div, align;
-        vg_lite_test_buffer_format_bytes(format, &mul, &div, &align);
-
-        stride = GPU_ALIGN_UP(((width * mul + div - 1) / div), align);
+        uint32_t align;
+        stride = vg_lite_test_buffer_get_stride(width, format, &align);
     }
 
     struct gpu_buffer_s* gpu_buffer = gpu_buffer_alloc(
-        width, height, vg_lite_test_vg_format_to_gpu_format(format), stride, 64);
+        width, height, vg_lite_test_vg_format_to_gpu_format(format), stride, VG_LITE_TEST_BUFFER_ALIGN);
 
-    memset(buffer, 0, sizeof(vg_lite_buffer_t));
-    buffer->memory = gpu_buffer->data;
-    buffer->address = (vg_lite_uint32_t)(uintptr_t)buffer->memory;
-    buffer->width = width;
-    buffer->height = height;
-    buffer->format = format;
-    buffer->stride = stride;
+    vg_lite_test_buffer_init(buffer, gpu_buffer->data, width, height, format, stride);
+    return gpu_buffer;
+}
 
-    buffer->tiled = VG_LITE_LINEAR;
-    buffer->transparency_mode = VG_LITE_IMAGE_OPAQUE;
+bool vg_lite_test_buffer_wrap(vg_lite_buffer_t* buffer, const void* data, uint32_t width, uint32_t height, vg_lite_buffer_format_t format, uint32_t stride)
+{
+    GPU_ASSERT_NULL(buffer);
+    GPU_ASSERT_NULL(data);
 
-    if (format == VG_LITE_A4 || format == VG_LITE_A8) {
-        GPU_LOG_INFO("Alpha format: %d, use multiply image mode", (int)format);
-        buffer->image_mode = VG_LITE_MULTIPLY_IMAGE_MODE;
-    } else {
-        buffer->image_mode = VG_LITE_NORMAL_IMAGE_MODE;
+    if ((uintptr_t)data % VG_LITE_TEST_BUFFER_ALIGN != 0) {
+        GPU_LOG_INFO("Image data %p not aligned to %d bytes", data, VG_LITE_TEST_BUFFER_ALIGN);
+        return false;
     }
 
-    return gpu_buffer;
+    /* The padding pixels of an aligned width are not part of the image data */
+    if (vg_lite_test_buffer_get_width(width) != width) {
+        GPU_LOG_INFO("Image width %" PRIu32 " not aligned to 16 pixels", width);
+        return false;
+    }
+
+    uint32_t align;
+    uint32_t min_stride = vg_lite_test_buffer_get_stride(width, format, &align);
+    if (stride < min_stride || stride % align != 0) {
+        GPU_LOG_INFO("Image stride %" PRIu32 " not aligned to %" PRIu32 " bytes", stride, align);
+        return false;
+    }
+
+    /* The GPU only reads the source image */
+    vg_lite_test_buffer_init(buffer, (void*)data, width, height, format, stride);
+    return true;
 }
 
 void vg_lite_test_vg_buffer_to_gpu_buffer(struct gpu_buffer_s* gpu_buffer, const vg_lite_buffer_t* vg_buffer)
@@ -354,6 +380,45 @@ const char* vg_lite_test_buffer_format_string(vg_lite_buffer_format_t format)
     return "-";
 }
 
+const char* vg_lite_test_blend_string(vg_lite_blend_t blend)
+{
+    switch (blend) {
+        BLEND_ENUM_TO_STRING(NONE);
+        BLEND_ENUM_TO_STRING(SRC_OVER);
+        BLEND_ENUM_TO_STRING(DST_OVER);
+        BLEND_ENUM_TO_STRING(SRC_IN);
+        BLEND_ENUM_TO_STRING(DST_IN);
+        BLEND_ENUM_TO_STRING(MULTIPLY);
+        BLEND_ENUM_TO_STRING(SCREEN);
+        BLEND_ENUM_TO_STRING(DARKEN);
+        BLEND_ENUM_TO_STRING(LIGHTEN);
+        BLEND_ENUM_TO_STRING(ADDITIVE);
+        BLEND_ENUM_TO_STRING(SUBTRACT);
+        BLEND_ENUM_TO_STRING(NORMAL_LVGL);
+        BLEND_ENUM_TO_STRING(ADDITIVE_LVGL);
+        BLEND_ENUM_TO_STRING(SUBTRACT_LVGL);
+        BLEND_ENUM_TO_STRING(MULTIPLY_LVGL);
+    default:
+        break;
+    }
+
+    return "-";
+}
+
+const char* vg_lite_test_filter_string(vg_lite_filter_t filter)
+{
+    switch (filter) {
+        FILTER_ENUM_TO_STRING(POINT);
+        FILTER_ENUM_TO_STRING(LINEAR);
+        FILTER_ENUM_TO_STRING(BI_LINEAR);
+        FILTER_ENUM_TO_STRING(GAUSSIAN);
+    default:
+        break;
+    }
+
+    return "-";
+}
+
 vg_lite_error_t vg_lite_test_idle_flush(void)
 {
     vg_lite_uint32_t is_gpu_idle = 0;
@@ -400,11 +465,58 @@ void vg_lite_test_transform_retangle(vg_lite_rectangle_t* rect, const vg_lite_ma
     rect->height = trans_y2 - trans_y1 + 1;
 }
 
+void vg_lite_test_buffer_format_bytes(
+    vg_lite_buffer_format_t format,
+    uint32_t* mul,
+    uint32_t* div,
+    uint32_t* bytes_align)
+{
+    if (!vg_lite_test_buffer_format_info(format, mul, div, bytes_align)) {
+        GPU_LOG_ERROR("unsupport color format: 0x%" PRIx32, (uint32_t)format);
+        GPU_ASSERT(false);
+    }
+}
+
+bool vg_lite_test_buffer_format_is_valid(vg_lite_buffer_format_t format)
+{
+    uint32_t mul, div, bytes_align;
+    return vg_lite_test_buffer_format_info(format, &mul, &div, &bytes_align);
+}
+
+uint64_t vg_lite_test_buffer_row_size(vg_lite_buffer_format_t format, uint32_t width)
+{
+    uint32_t mul, div, bytes_align;
+    vg_lite_test_buffer_format_bytes(format, &mul, &div, &bytes_align);
+    return ((uint64_t)width * mul + div - 1) / div;
+}
+
+vg_lite_buffer_format_t vg_lite_test_gpu_format_to_vg_format(enum gpu_color_format_e format)
+{
+#define COLOR_FORMAT_MATCH(FMT)  \
+    case GPU_COLOR_FORMAT_##FMT: \
+        return VG_LITE_##FMT;
+
+    switch (format) {
+        COLOR_FORMAT_MATCH(BGR565);
+        COLOR_FORMAT_MATCH(BGR888);
+        COLOR_FORMAT_MATCH(BGRA8888);
+        COLOR_FORMAT_MATCH(BGRX8888);
+        COLOR_FORMAT_MATCH(BGRA5658);
+
+    default:
+        break;
+    }
+
+#undef COLOR_FORMAT_MATCH
+
+    return VG_LITE_BGRA8888;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static void vg_lite_test_buffer_format_bytes(
+static bool vg_lite_test_buffer_format_info(
     vg_lite_buffer_format_t format,
     uint32_t* mul,
     uint32_t* div,
@@ -487,39 +599,54 @@ static void vg_lite_test_buffer_format_bytes(
         *mul = 3;
         break;
     default:
-        GPU_LOG_ERROR("unsupport color format: 0x%" PRIx32, (uint32_t)format);
-        GPU_ASSERT(false);
-        break;
+        return false;
     }
+
+    return true;
 }
 
-static enum gpu_color_format_e vg_lite_test_vg_format_to_gpu_format(vg_lite_buffer_format_t format)
+static uint32_t vg_lite_test_buffer_get_width(uint32_t width)
 {
-#define COLOR_FORMAT_MATCH(FMT) \
-    case VG_LITE_##FMT:         \
-        return GPU_COLOR_FORMAT_##FMT;
+    if (vg_lite_query_feature(gcFEATURE_BIT_VG_16PIXELS_ALIGN)) {
+        width = GPU_ALIGN_UP(width, 16);
+    }
 
-    switch (format) {
-        COLOR_FORMAT_MATCH(BGR565);
-        COLOR_FORMAT_MATCH(BGR888);
-        COLOR_FORMAT_MATCH(BGRA8888);
-        COLOR_FORMAT_MATCH(BGRX8888);
-        COLOR_FORMAT_MATCH(BGRA5658);
+    return width;
+}
 
-    default:
-        break;
-    }
+static uint32_t vg_lite_test_buffer_get_stride(uint32_t width, vg_lite_buffer_format_t format, uint32_t* align)
+{
+    uint32_t mul, div;
+    vg_lite_test_buffer_format_bytes(format, &mul, &div, align);
+    return GPU_ALIGN_UP(((width * mul + div - 1) / div), *align);
+}
 
-#undef COLOR_FORMAT_MATCH
+static void vg_lite_test_buffer_init(vg_lite_buffer_t* buffer, void* memory, uint32_t width, uint32_t height, vg_lite_buffer_format_t format, uint32_t stride)
+{
+    memset(buffer, 0, sizeof(vg_lite_buffer_t));
+    buffer->memory = memory;
+    buffer->address = (vg_lite_uint32_t)(uintptr_t)buffer->memory;
+    buffer->width = width;
+    buffer->height = height;
+    buffer->format = format;
+    buffer->stride = stride;
 
-    return GPU_COLOR_FORMAT_UNKNOWN;
+    buffer->tiled = VG_LITE_LINEAR;
+    buffer->transparency_mode = VG_LITE_IMAGE_OPAQUE;
+
+    if (format == VG_LITE_A4 || format == VG_LITE_A8) {
+        GPU_LOG_INFO("Alpha format: %d, use multiply image mode", (int)format);
+        buffer->image_mode = VG_LITE_MULTIPLY_IMAGE_MODE;
+    } else {
+        buffer->image_mode = VG_LITE_NORMAL_IMAGE_MODE;
+    }
 }
 
-static vg_lite_buffer_format_t vg_lite_test_gpu_format_to_vg_format(enum gpu_color_format_e format)
+static enum gpu_color_format_e vg_lite_test_vg_format_to_gpu_format(vg_lite_buffer_format_t format)
 {
-#define COLOR_FORMAT_MATCH(FMT)  \
-    case GPU_COLOR_FORMAT_##FMT: \
-        return VG_LITE_##FMT;
+#define COLOR_FORMAT_MATCH(FMT) \
+    case VG_LITE_##FMT:         \
+        return GPU_COLOR_FORMAT_##FMT;
 
     switch (format) {
         COLOR_FORMAT_MATCH(BGR565);
@@ -534,5 +661,5 @@ static vg_lite_buffer_format_t vg_lite_test_gpu_format_to_vg_format(enum gpu_col
 
 #undef COLOR_FORMAT_MATCH
 
-    return VG_LITE_BGRA8888;
+    return GPU_COLOR_FORMAT_UNKNOWN;
 }
@@ -30,6 +30,8 @@
 
 #include "../gpu_buffer.h"
 #include "../gpu_log.h"
+#include "vg_lite_test_hook.h"
+#include <stdbool.h>
 #include <vg_lite.h>
 
 #ifdef __cplusplus
@@ -61,6 +63,9 @@ extern "C" {
 
 #define VG_LITE_TEST_STRIDE_AUTO 0
 
+/* Start address alignment of the buffers given to the GPU */
+#define VG_LITE_TEST_BUFFER_ALIGN 64
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -74,6 +79,14 @@ extern "C" {
  */
 void vg_lite_test_dump_info(void);
 
+/**
+ * @brief Format the product, chip and driver versions on one line.
+ * @param buf The buffer to write to.
+ * @param size The size of the buffer.
+ * @return The number of characters written, as snprintf.
+ */
+int vg_lite_test_info_to_string(char* buf, size_t size);
+
 /**
  * @brief Get the error string.
  * @param error The error code.
@@ -105,6 +118,19 @@ void vg_lite_test_error_dump_info(vg_lite_error_t error);
  */
 struct gpu_buffer_s* vg_lite_test_buffer_alloc(vg_lite_buffer_t* buffer, uint32_t width, uint32_t height, vg_lite_buffer_format_t format, uint32_t stride);
 
+/**
+ * @brief Use existing image data as a VG Lite buffer without copying it.
+ * @param buffer The VG Lite buffer to be set up.
+ * @param data The image data, it must stay valid while the buffer is used.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param format The format of the image.
+ * @param stride The stride of the image.
+ * @return True if the data meets the address, width and stride alignment of vg_lite_test_buffer_alloc.
+ *         The buffer is not touched otherwise and the data has to be copied.
+ */
+bool vg_lite_test_buffer_wrap(vg_lite_buffer_t* buffer, const void* data, uint32_t width, uint32_t height, vg_lite_buffer_format_t format, uint32_t stride);
+
 /**
  * @brief Convert a VG Lite buffer to a GPU buffer.
  * @param gpu_buffer The GPU buffer to be copied.
@@ -119,6 +145,37 @@ void vg_lite_test_vg_buffer_to_gpu_buffer(struct gpu_buffer_s* gpu_buffer, const
  */
 void vg_lite_test_gpu_buffer_to_vg_buffer(vg_lite_buffer_t* vg_buffer, const struct gpu_buffer_s* gpu_buffer);
 
+/**
+ * @brief Get the size of a pixel of a VG Lite buffer format, a pixel takes mul / div bytes.
+ * @param format The VG Lite buffer format.
+ * @param mul The multiplier of the pixel size.
+ * @param div The divider of the pixel size.
+ * @param bytes_align The alignment of the stride in bytes.
+ */
+void vg_lite_test_buffer_format_bytes(vg_lite_buffer_format_t format, uint32_t* mul, uint32_t* div, uint32_t* bytes_align);
+
+/**
+ * @brief Check if a VG Lite buffer format is known by the buffer helpers.
+ * @param format The VG Lite buffer format.
+ * @return True if the format can be passed to vg_lite_test_buffer_alloc.
+ */
+bool vg_lite_test_buffer_format_is_valid(vg_lite_buffer_format_t format);
+
+/**
+ * @brief Get the bytes of the pixels of one row, without the stride alignment.
+ * @param format The VG Lite buffer format, it must be valid.
+ * @param width The width in pixels.
+ * @return The row size in bytes.
+ */
+uint64_t vg_lite_test_buffer_row_size(vg_lite_buffer_format_t format, uint32_t width);
+
+/**
+ * @brief Convert a GPU color format to a VG Lite buffer format.
+ * @param format The GPU color format.
+ * @return The VG Lite buffer format, VG_LITE_BGRA8888 if there is no match.
+ */
+vg_lite_buffer_format_t vg_lite_test_gpu_format_to_vg_format(enum gpu_color_format_e format);
+
 /**
  * @breif Convert a VG Lite buffer format to a string.
  * @param format The VG Lite buffer format.
@@ -126,6 +183,20 @@ void vg_lite_test_gpu_buffer_to_vg_buffer(vg_lite_buffer_t* vg_buffer, const str
  */
 const char* vg_lite_test_buffer_format_string(vg_lite_buffer_format_t format);
 
+/**
+ * @brief Convert a VG Lite blend mode to a string.
+ * @param blend The VG Lite blend mode.
+ * @return The string of the blend mode without the VG_LITE_BLEND_ prefix.
+ */
+const char* vg_lite_test_blend_string(vg_lite_blend_t blend);
+
+/**
+ * @brief Convert a VG Lite image filter to a string.
+ * @param filter The VG Lite image filter.
+ * @return The string of the filter without the VG_LITE_FILTER_ prefix.
+ */
+const char* vg_lite_test_filter_string(vg_lite_filter_t filter);
+
 /**
  * @breif Flush the GPU command queue if GPU is idle.
  * @return VG_LITE_SUCCESS if the flush is successful, otherwise the error code.